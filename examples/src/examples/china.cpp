@@ -7,9 +7,11 @@
 
 #include <framework/programContext.hpp>
 #include <framework/model.hpp>
+#include <framework/switchSolution.hpp>
 
 #include <solutionInterface/taskFunctions.hpp>
 #include <solutionInterface/uniformLocations.hpp>
+#include <studentSolution/commandStream.hpp>
 
 #include <examples/shadowModel.hpp>
 
@@ -26,8 +28,8 @@ class Method: public ::Method{
     ModelData     modelData;
     Model         model;
 
-    CommandBuffer modelCB;
-    CommandBuffer drawCB;
+    CommandStream modelCB;
+    CommandStream drawCB;
 };
 
 using namespace glm;
@@ -50,13 +52,15 @@ Method::Method(GPUMemory&m,MethodConstructionData const*): ::Method(m){
   prg1.vs2fs[2] = AttribType::VEC2;
   prg1.vs2fs[3] = AttribType::VEC4;
 
+  bool recorded = true;
   //draw scene
-  pushBindFramebufferCommand(drawCB,0);
-  pushBindProgramCommand    (drawCB,0);
-  pushClearColorCommand     (drawCB,glm::vec4(0xd4,0x6d,0x63,0xff)/255.f);
-  pushClearDepthCommand     (drawCB,10e10f);
-  pushSetDrawIdCommand      (drawCB,0);
-  pushSubCommand            (drawCB,&modelCB);
+  recorded &= pushBindFramebufferCommand(drawCB,0);
+  recorded &= pushBindProgramCommand    (drawCB,0);
+  recorded &= pushClearColorCommand     (drawCB,glm::vec4(0xd4,0x6d,0x63,0xff)/255.f);
+  recorded &= pushClearDepthCommand     (drawCB,10e10f);
+  recorded &= pushSetDrawIdCommand      (drawCB,0);
+  recorded &= pushSubCommand            (drawCB,&modelCB);
+  if(!recorded)std::cerr << "china: the commands do not fit into the command stream" << std::endl;
 
 }
 
@@ -122,11 +122,13 @@ Method::Method(GPUMemory&m,MethodConstructionData const*): ::Method(m){
   a1.stride     = sizeof(Vertex)     ;
   a1.offset     = sizeof(glm::vec2)  ;
 
-  pushClearColorCommand          (commandBuffer,glm::vec4(.1,.1,.1,1));
-  pushClearDepthCommand          (commandBuffer,10e10f);
-  pushBindProgramCommand    (commandBuffer,0);
-  pushBindVertexArrayCommand(commandBuffer,0);
-  pushDrawCommand           (commandBuffer,(NX-1)*(NY-1)*6);
+  bool recorded = true;
+  recorded &= pushClearColorCommand          (commandBuffer,glm::vec4(.1,.1,.1,1));
+  recorded &= pushClearDepthCommand          (commandBuffer,10e10f);
+  recorded &= pushBindProgramCommand    (commandBuffer,0);
+  recorded &= pushBindVertexArrayCommand(commandBuffer,0);
+  recorded &= pushDrawCommand           (commandBuffer,(NX-1)*(NY-1)*6);
+  if(!recorded)std::cerr << "czFlag: the commands do not fit into the command buffer" << std::endl;
 
 }
 
@@ -93,23 +93,25 @@ Method::Method(GPUMemory&m,MethodConstructionData const*): ::Method(m){
   m.framebuffers[1].width  = m.textures[0].width;
   m.framebuffers[1].height = m.textures[0].height;
 
-  pushBindFramebufferCommand(commandBuffer,1);
-  pushClearColorCommand(commandBuffer,glm::vec4(.0,.0,0,1));
-  pushClearDepthCommand(commandBuffer,10e10f);
+  bool recorded = true;
+  recorded &= pushBindFramebufferCommand(commandBuffer,1);
+  recorded &= pushClearColorCommand(commandBuffer,glm::vec4(.0,.0,0,1));
+  recorded &= pushClearDepthCommand(commandBuffer,10e10f);
   mem.programs[0].vertexShader   = box_vs;
   mem.programs[0].fragmentShader = box_fs;
   mem.programs[0].vs2fs[3]       = AttribType::VEC4;
-  pushBindProgramCommand(commandBuffer,0);
-  pushDrawCommand(commandBuffer,6*2*3);
+  recorded &= pushBindProgramCommand(commandBuffer,0);
+  recorded &= pushDrawCommand(commandBuffer,6*2*3);
 
-  pushBindFramebufferCommand(commandBuffer,0);
-  pushClearColorCommand(commandBuffer,glm::vec4(.0,.0,0,1));
-  pushClearDepthCommand(commandBuffer,10e10f);
+  recorded &= pushBindFramebufferCommand(commandBuffer,0);
+  recorded &= pushClearColorCommand(commandBuffer,glm::vec4(.0,.0,0,1));
+  recorded &= pushClearDepthCommand(commandBuffer,10e10f);
   mem.programs[1].vertexShader   = vfx_vs;
   mem.programs[1].fragmentShader = vfx_fs;
   mem.programs[1].vs2fs[0]       = AttribType::VEC2;
-  pushBindProgramCommand(commandBuffer,1);
-  pushDrawCommand(commandBuffer,6);
+  recorded &= pushBindProgramCommand(commandBuffer,1);
+  recorded &= pushDrawCommand(commandBuffer,6);
+  if(!recorded)std::cerr << "edge detect: the commands do not fit into the command buffer" << std::endl;
 }
 
 Method::~Method(){
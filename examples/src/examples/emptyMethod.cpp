@@ -15,7 +15,9 @@ class Method: public ::Method{
 
 
 Method::Method(GPUMemory&m,MethodConstructionData const*): ::Method(m){
-  pushClearColorCommand(commandBuffer,glm::vec4(.5,.2,0,1));
+  bool recorded = true;
+  recorded &= pushClearColorCommand(commandBuffer,glm::vec4(.5,.2,0,1));
+  if(!recorded)std::cerr << "empty window: the commands do not fit into the command buffer" << std::endl;
 }
 
 Method::~Method(){
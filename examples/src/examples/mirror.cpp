@@ -7,9 +7,11 @@
 
 #include <framework/programContext.hpp>
 #include <framework/model.hpp>
+#include <framework/switchSolution.hpp>
 
 #include <solutionInterface/taskFunctions.hpp>
 #include <solutionInterface/uniformLocations.hpp>
+#include <studentSolution/commandStream.hpp>
 
 #include <examples/shadowModel.hpp>
 
@@ -56,8 +58,8 @@ class Method: public ::Method{
     ModelData     modelData;
     Model         model;
 
-    CommandBuffer modelCB;
-    CommandBuffer drawCB;
+    CommandStream modelCB;
+    CommandStream drawCB;
     struct UserData{
       GPUMemory*mem = nullptr;
     }userData;
@@ -155,54 +157,56 @@ Method::Method(GPUMemory&m,MethodConstructionData const*): ::Method(m){
 
   userData.mem = &this->mem;
 
+  bool recorded = true;
   //clear frame
-  pushBindFramebufferCommand   (drawCB,0);
-  pushClearColorCommand        (drawCB,glm::vec4(0x00,0x20,0x20,0xff)/255.f);
-  pushClearDepthCommand        (drawCB);
-  pushClearStencilCommand      (drawCB);
+  recorded &= pushBindFramebufferCommand   (drawCB,0);
+  recorded &= pushClearColorCommand        (drawCB,glm::vec4(0x00,0x20,0x20,0xff)/255.f);
+  recorded &= pushClearDepthCommand        (drawCB);
+  recorded &= pushClearStencilCommand      (drawCB);
 
   //draw scene
-  pushUserCommand              (drawCB,moveModelRight,&userData);
-  pushBindProgramCommand       (drawCB,1);
-  pushSetDrawIdCommand         (drawCB,0);
-  pushBlockWritesCommand       (drawCB,false,false,true);
-  pushSetFrontFaceCommand      (drawCB,true);
-  pushSetStencilCommand        (drawCB,ignoreStencil);
-  pushSubCommand               (drawCB,&modelCB);
+  recorded &= pushUserCommand              (drawCB,moveModelRight,&userData);
+  recorded &= pushBindProgramCommand       (drawCB,1);
+  recorded &= pushSetDrawIdCommand         (drawCB,0);
+  recorded &= pushBlockWritesCommand       (drawCB,false,false,true);
+  recorded &= pushSetFrontFaceCommand      (drawCB,true);
+  recorded &= pushSetStencilCommand        (drawCB,ignoreStencil);
+  recorded &= pushSubCommand               (drawCB,&modelCB);
 
   //draw mirror
-  pushUserCommand              (drawCB,moveModelLeft,&userData);
-  pushBindProgramCommand       (drawCB,0);
-  pushBlockWritesCommand       (drawCB,true,true,false);
-  pushSetStencilCommand        (drawCB,drawToStencil);
-  pushSetBackfaceCullingCommand(drawCB,true);
-  pushDrawCommand              (drawCB,6);
+  recorded &= pushUserCommand              (drawCB,moveModelLeft,&userData);
+  recorded &= pushBindProgramCommand       (drawCB,0);
+  recorded &= pushBlockWritesCommand       (drawCB,true,true,false);
+  recorded &= pushSetStencilCommand        (drawCB,drawToStencil);
+  recorded &= pushSetBackfaceCullingCommand(drawCB,true);
+  recorded &= pushDrawCommand              (drawCB,6);
 
   //draw mirror image
-  pushUserCommand              (drawCB,mirrorModel,&userData);
-  pushUserCommand              (drawCB,moveModelRight,&userData);
-  pushBindProgramCommand       (drawCB,1);
-  pushSetDrawIdCommand         (drawCB,0);
-  pushBlockWritesCommand       (drawCB,false,false,true);
-  pushSetFrontFaceCommand      (drawCB,false);
-  pushSetStencilCommand        (drawCB,useStencil);
-  pushSubCommand               (drawCB,&modelCB);
+  recorded &= pushUserCommand              (drawCB,mirrorModel,&userData);
+  recorded &= pushUserCommand              (drawCB,moveModelRight,&userData);
+  recorded &= pushBindProgramCommand       (drawCB,1);
+  recorded &= pushSetDrawIdCommand         (drawCB,0);
+  recorded &= pushBlockWritesCommand       (drawCB,false,false,true);
+  recorded &= pushSetFrontFaceCommand      (drawCB,false);
+  recorded &= pushSetStencilCommand        (drawCB,useStencil);
+  recorded &= pushSubCommand               (drawCB,&modelCB);
 
   //draw back side of the mirror
-  pushUserCommand              (drawCB,moveModelLeft,&userData);
-  pushBindProgramCommand       (drawCB,0);
-  pushBlockWritesCommand       (drawCB,false,false,true);
-  pushSetStencilCommand        (drawCB,ignoreStencil);
-  pushSetBackfaceCullingCommand(drawCB,true);
-  pushSetFrontFaceCommand      (drawCB,false);
-  pushDrawCommand              (drawCB,6);
+  recorded &= pushUserCommand              (drawCB,moveModelLeft,&userData);
+  recorded &= pushBindProgramCommand       (drawCB,0);
+  recorded &= pushBlockWritesCommand       (drawCB,false,false,true);
+  recorded &= pushSetStencilCommand        (drawCB,ignoreStencil);
+  recorded &= pushSetBackfaceCullingCommand(drawCB,true);
+  recorded &= pushSetFrontFaceCommand      (drawCB,false);
+  recorded &= pushDrawCommand              (drawCB,6);
 
   //draw blue tint over the mirror
-  pushBindProgramCommand       (drawCB,2);
-  pushBlockWritesCommand       (drawCB,false,false,true);
-  pushSetStencilCommand        (drawCB,ignoreStencil);
-  pushSetFrontFaceCommand      (drawCB,true);
-  pushDrawCommand              (drawCB,6);
+  recorded &= pushBindProgramCommand       (drawCB,2);
+  recorded &= pushBlockWritesCommand       (drawCB,false,false,true);
+  recorded &= pushSetStencilCommand        (drawCB,ignoreStencil);
+  recorded &= pushSetFrontFaceCommand      (drawCB,true);
+  recorded &= pushDrawCommand              (drawCB,6);
+  if(!recorded)std::cerr << "mirror: the commands do not fit into the command stream" << std::endl;
 
 }
 
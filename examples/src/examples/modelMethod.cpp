@@ -6,6 +6,7 @@
  */
 
 #include <framework/model.hpp>
+#include <framework/switchSolution.hpp>
 #include <framework/programContext.hpp>
 #include <solutionInterface/taskFunctions.hpp>
 #include <solutionInterface/uniformLocations.hpp>
@@ -28,10 +29,12 @@ Method::Method(GPUMemory&m,MethodConstructionData const*): ::Method(m){
   mem.programs[0].vs2fs[1]       = AttribType::VEC3;
   mem.programs[0].vs2fs[2]       = AttribType::VEC2;
 
-  pushClearColorCommand(drawCB,glm::vec4(0.1,0.15,0.1,1.));
-  pushClearDepthCommand(drawCB,10e10f);
-  pushBindProgramCommand(drawCB,0);
-  pushSubCommand(drawCB,&modelCB);
+  bool recorded = true;
+  recorded &= pushClearColorCommand(drawCB,glm::vec4(0.1,0.15,0.1,1.));
+  recorded &= pushClearDepthCommand(drawCB,10e10f);
+  recorded &= pushBindProgramCommand(drawCB,0);
+  recorded &= pushSubCommand(drawCB,&modelCB);
+  if(!recorded)std::cerr << "model loader: the commands do not fit into the command stream" << std::endl;
 
 }
 
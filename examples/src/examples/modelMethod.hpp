@@ -2,6 +2,7 @@
 
 #include <framework/method.hpp>
 #include <framework/model.hpp>
+#include <studentSolution/commandStream.hpp>
 
 namespace modelMethod{
 
@@ -18,8 +19,8 @@ class Method: public ::Method{
     virtual void onDraw(SceneParam const&sceneParam) override;
     ModelData     modelData;
     Model         model;
-    CommandBuffer modelCB;
-    CommandBuffer drawCB;
+    CommandStream modelCB;
+    CommandStream drawCB;
 };
 
 }
@@ -7,6 +7,7 @@
 
 #include <framework/programContext.hpp>
 #include <framework/model.hpp>
+#include <framework/switchSolution.hpp>
 
 #include <solutionInterface/taskFunctions.hpp>
 #include <solutionInterface/uniformLocations.hpp>
@@ -54,20 +55,22 @@ Method::Method(GPUMemory&m,MethodConstructionData const*): ::Method(m){
   m.framebuffers[1].width  = m.textures[shadowMapId].width;
   m.framebuffers[1].height = m.textures[shadowMapId].height;
 
+  bool recorded = true;
   //draw shadow map
-  pushBindFramebufferCommand(drawCB,1);
-  pushBindProgramCommand    (drawCB,0);
-  pushClearColorCommand     (drawCB);
-  pushClearDepthCommand     (drawCB);
-  pushSubCommand            (drawCB,&modelCB);
+  recorded &= pushBindFramebufferCommand(drawCB,1);
+  recorded &= pushBindProgramCommand    (drawCB,0);
+  recorded &= pushClearColorCommand     (drawCB);
+  recorded &= pushClearDepthCommand     (drawCB);
+  recorded &= pushSubCommand            (drawCB,&modelCB);
 
   //draw scene
-  pushBindFramebufferCommand(drawCB,0);
-  pushBindProgramCommand    (drawCB,1);
-  pushClearColorCommand     (drawCB,glm::vec4(0.4f,0.f,.2f,1.f));
-  pushClearDepthCommand     (drawCB);
-  pushSetDrawIdCommand      (drawCB,0);
-  pushSubCommand            (drawCB,&modelCB);
+  recorded &= pushBindFramebufferCommand(drawCB,0);
+  recorded &= pushBindProgramCommand    (drawCB,1);
+  recorded &= pushClearColorCommand     (drawCB,glm::vec4(0.4f,0.f,.2f,1.f));
+  recorded &= pushClearDepthCommand     (drawCB);
+  recorded &= pushSetDrawIdCommand      (drawCB,0);
+  recorded &= pushSubCommand            (drawCB,&modelCB);
+  if(!recorded)std::cerr << "parrots: the commands do not fit into the command stream" << std::endl;
 
   lightProj = glm::ortho(-30.f,+30.f,-30.f,+30.f,0.f,1000.f);
   lightBias = glm::scale(glm::vec3(.5f,.5f,1.f))*glm::translate(glm::vec3(1,1,0));
@@ -2,6 +2,7 @@
 
 #include <framework/method.hpp>
 #include <framework/model.hpp>
+#include <studentSolution/commandStream.hpp>
 namespace parrotsMethod{
 
 class Method: public ::Method{
@@ -15,8 +16,8 @@ class Method: public ::Method{
     ModelData     modelData;
     Model         model;
 
-    CommandBuffer modelCB;
-    CommandBuffer drawCB;
+    CommandStream modelCB;
+    CommandStream drawCB;
     TextureData   shadowMap;
 
     glm::mat4     lightProj;
@@ -119,11 +119,13 @@ Method::Method(GPUMemory&m,MethodConstructionData const*): ::Method(m){
   mem.vertexArrays[0].indexOffset   = 0                ;
   mem.vertexArrays[0].indexType     = IndexType::U32;
 
-  pushClearColorCommand(commandBuffer,glm::vec4(.5,.5,.5,1));
-  pushClearDepthCommand(commandBuffer,10e10f);
-  pushBindProgramCommand(commandBuffer,0);
-  pushBindVertexArrayCommand(commandBuffer,0);
-  pushDrawCommand (commandBuffer,sizeof(bunnyIndices)/sizeof(VertexIndex));
+  bool recorded = true;
+  recorded &= pushClearColorCommand(commandBuffer,glm::vec4(.5,.5,.5,1));
+  recorded &= pushClearDepthCommand(commandBuffer,10e10f);
+  recorded &= pushBindProgramCommand(commandBuffer,0);
+  recorded &= pushBindVertexArrayCommand(commandBuffer,0);
+  recorded &= pushDrawCommand (commandBuffer,sizeof(bunnyIndices)/sizeof(VertexIndex));
+  if(!recorded)std::cerr << "phong bunny: the commands do not fit into the command buffer" << std::endl;
 }
 
 
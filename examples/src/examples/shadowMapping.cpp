@@ -13,6 +13,7 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include <framework/programContext.hpp>
+#include <studentSolution/fragmentShaderTraits.hpp>
 
 
 namespace shadowMappingMethod{
@@ -77,6 +78,9 @@ void createShadowMap_vs(OutVertex&outVertex,InVertex const&inVertex,ShaderInterf
 void createShadowMap_fs(OutFragment&,InFragment const&,ShaderInterface const&){
 }
 
+// the shadow map has no color buffer, so the GPU can skip this shader
+static bool const createShadowMap_fsDeclared = (declareColorOnlyFragmentShader(createShadowMap_fs),true);
+
 // vertex shader pro výpočet stínu
 void scene_vs(OutVertex&outVertex,InVertex const&inVertex,ShaderInterface const&si){
   // číslo vrcholu
@@ -131,6 +135,7 @@ void scene_fs(OutFragment&outFragment,InFragment const&inFragment,ShaderInterfac
 Method::Method(GPUMemory&m,MethodConstructionData const*): ::Method(m){
   // vytvoření stínové mapy (data)
   shadowMap = TextureData(m.framebuffers[0].width,m.framebuffers[0].height,1,Image::F32);
+  shadowMap.convertFormat();
 
   // program pro vytvoření stínové mapy
   auto&prg0 = m.programs[0];
@@ -150,19 +155,21 @@ Method::Method(GPUMemory&m,MethodConstructionData const*): ::Method(m){
   m.framebuffers[1].width  = m.textures[1].width;
   m.framebuffers[1].height = m.textures[1].height;
 
+  bool recorded = true;
   // vykreslení stínové mapy
-  pushBindFramebufferCommand(commandBuffer,1);
-  pushBindProgramCommand(commandBuffer,0);
-  pushClearColorCommand(commandBuffer,glm::vec4(0,0,0,1));
-  pushClearDepthCommand(commandBuffer);
-  pushDrawCommand(commandBuffer,12);
+  recorded &= pushBindFramebufferCommand(commandBuffer,1);
+  recorded &= pushBindProgramCommand(commandBuffer,0);
+  recorded &= pushClearColorCommand(commandBuffer,glm::vec4(0,0,0,1));
+  recorded &= pushClearDepthCommand(commandBuffer);
+  recorded &= pushDrawCommand(commandBuffer,12);
 
   // vykreslení scény
-  pushBindFramebufferCommand(commandBuffer,0);
-  pushBindProgramCommand(commandBuffer,1);
-  pushClearColorCommand(commandBuffer,glm::vec4(0,0,0,1));
-  pushClearDepthCommand(commandBuffer);
-  pushDrawCommand(commandBuffer,12);
+  recorded &= pushBindFramebufferCommand(commandBuffer,0);
+  recorded &= pushBindProgramCommand(commandBuffer,1);
+  recorded &= pushClearColorCommand(commandBuffer,glm::vec4(0,0,0,1));
+  recorded &= pushClearDepthCommand(commandBuffer);
+  recorded &= pushDrawCommand(commandBuffer,12);
+  if(!recorded)std::cerr << "shadowMapping: the commands do not fit into the command buffer" << std::endl;
 }
 
 // časovač
@@ -7,11 +7,13 @@
 
 #include <framework/programContext.hpp>
 #include <framework/model.hpp>
+#include <framework/switchSolution.hpp>
 
 #include <solutionInterface/taskFunctions.hpp>
 #include <solutionInterface/uniformLocations.hpp>
 
 #include <examples/shadowModel.hpp>
+#include <studentSolution/fragmentShaderTraits.hpp>
 
 namespace shadowModelMethod{
 
@@ -27,12 +29,16 @@ void createShadowMap_vs(OutVertex&outVertex,InVertex const&inVertex,ShaderInterf
 void createShadowMap_fs(OutFragment&,InFragment const&,ShaderInterface const&){
 }
 
+// the shadow map has no color buffer, so the GPU can skip this shader
+static bool const createShadowMap_fsDeclared = (declareColorOnlyFragmentShader(createShadowMap_fs),true);
+
 #ifndef CMAKE_ROOT_DIR
 #define CMAKE_ROOT_DIR "."
 #endif
 
 Method::Method(GPUMemory&m,MethodConstructionData const*): ::Method(m){
   shadowMap = TextureData(1024,1024,1,Image::F32);
+  shadowMap.convertFormat();
 
   modelData.load(CMAKE_ROOT_DIR "/resources/models/izg_tf2.glb");
   modelData.createModelView(model);
@@ -55,20 +61,22 @@ Method::Method(GPUMemory&m,MethodConstructionData const*): ::Method(m){
   m.framebuffers[1].width  = m.textures[shadowMapId].width;
   m.framebuffers[1].height = m.textures[shadowMapId].height;
 
+  bool recorded = true;
   //draw shadow map
-  pushBindFramebufferCommand(drawCB,1);
-  pushBindProgramCommand    (drawCB,0);
-  pushClearColorCommand     (drawCB);
-  pushClearDepthCommand     (drawCB);
-  pushSubCommand            (drawCB,&modelCB);
+  recorded &= pushBindFramebufferCommand(drawCB,1);
+  recorded &= pushBindProgramCommand    (drawCB,0);
+  recorded &= pushClearColorCommand     (drawCB);
+  recorded &= pushClearDepthCommand     (drawCB);
+  recorded &= pushSubCommand            (drawCB,&modelCB);
 
   //draw scene
-  pushBindFramebufferCommand(drawCB,0);
-  pushBindProgramCommand    (drawCB,1);
-  pushClearColorCommand     (drawCB,glm::vec4(0.4f,0.f,.2f,1.f));
-  pushClearDepthCommand     (drawCB);
-  pushSetDrawIdCommand      (drawCB,0);
-  pushSubCommand            (drawCB,&modelCB);
+  recorded &= pushBindFramebufferCommand(drawCB,0);
+  recorded &= pushBindProgramCommand    (drawCB,1);
+  recorded &= pushClearColorCommand     (drawCB,glm::vec4(0.4f,0.f,.2f,1.f));
+  recorded &= pushClearDepthCommand     (drawCB);
+  recorded &= pushSetDrawIdCommand      (drawCB,0);
+  recorded &= pushSubCommand            (drawCB,&modelCB);
+  if(!recorded)std::cerr << "shadowModel: the commands do not fit into the command stream" << std::endl;
 
   lightProj = glm::ortho(-100.f,+100.f,-100.f,+100.f,0.f,1000.f);
   lightBias = glm::scale(glm::vec3(.5f,.5f,1.f))*glm::translate(glm::vec3(1,1,0));
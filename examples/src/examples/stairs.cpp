@@ -95,10 +95,12 @@ Method::Method(GPUMemory&m,MethodConstructionData const*): ::Method(m){
   mem.programs[0].fragmentShader = fragmentShader;
   mem.programs[0].vs2fs[0]       = AttribType::UINT;
 
-  pushClearColorCommand(commandBuffer,glm::vec4(.1,.1,.1,1));
-  pushClearDepthCommand(commandBuffer,10e10f);
-  pushBindProgramCommand(commandBuffer,0);
-  pushDrawCommand (commandBuffer,6*6*100);
+  bool recorded = true;
+  recorded &= pushClearColorCommand(commandBuffer,glm::vec4(.1,.1,.1,1));
+  recorded &= pushClearDepthCommand(commandBuffer,10e10f);
+  recorded &= pushBindProgramCommand(commandBuffer,0);
+  recorded &= pushDrawCommand (commandBuffer,6*6*100);
+  if(!recorded)std::cerr << "stairs: the commands do not fit into the command buffer" << std::endl;
 }
 
 void Method::onUpdate(float dt){
@@ -7,9 +7,11 @@
 
 #include <framework/programContext.hpp>
 #include <framework/model.hpp>
+#include <framework/switchSolution.hpp>
 
 #include <solutionInterface/taskFunctions.hpp>
 #include <solutionInterface/uniformLocations.hpp>
+#include <studentSolution/commandStream.hpp>
 
 #include <examples/shadowModel.hpp>
 
@@ -41,8 +43,8 @@ class Method: public ::Method{
     ModelData     modelData;
     Model         model;
 
-    CommandBuffer modelCB;
-    CommandBuffer drawCB;
+    CommandStream modelCB;
+    CommandStream drawCB;
 };
 
 using namespace glm;
@@ -91,22 +93,24 @@ Method::Method(GPUMemory&m,MethodConstructionData const*): ::Method(m){
   useStencil.func =  StencilFunc::EQUAL;
   useStencil.refValue = 1;
 
+  bool recorded = true;
   //draw scene
-  pushBindFramebufferCommand(drawCB,0);
-  pushClearColorCommand     (drawCB,glm::vec4(0xd4,0x6d,0x63,0xff)/255.f);
-  pushClearDepthCommand     (drawCB);
-  pushClearStencilCommand   (drawCB);
-
-  pushBindProgramCommand    (drawCB,0);
-  pushBlockWritesCommand    (drawCB,true,true,false);
-  pushSetStencilCommand     (drawCB,drawToStencil);
-  pushDrawCommand           (drawCB,3);
-
-  pushBindProgramCommand    (drawCB,1);
-  pushSetDrawIdCommand      (drawCB,0);
-  pushBlockWritesCommand    (drawCB,false,false,true);
-  pushSetStencilCommand     (drawCB,useStencil);
-  pushSubCommand            (drawCB,&modelCB);
+  recorded &= pushBindFramebufferCommand(drawCB,0);
+  recorded &= pushClearColorCommand     (drawCB,glm::vec4(0xd4,0x6d,0x63,0xff)/255.f);
+  recorded &= pushClearDepthCommand     (drawCB);
+  recorded &= pushClearStencilCommand   (drawCB);
+
+  recorded &= pushBindProgramCommand    (drawCB,0);
+  recorded &= pushBlockWritesCommand    (drawCB,true,true,false);
+  recorded &= pushSetStencilCommand     (drawCB,drawToStencil);
+  recorded &= pushDrawCommand           (drawCB,3);
+
+  recorded &= pushBindProgramCommand    (drawCB,1);
+  recorded &= pushSetDrawIdCommand      (drawCB,0);
+  recorded &= pushBlockWritesCommand    (drawCB,false,false,true);
+  recorded &= pushSetStencilCommand     (drawCB,useStencil);
+  recorded &= pushSubCommand            (drawCB,&modelCB);
+  if(!recorded)std::cerr << "stencil triangle: the commands do not fit into the command stream" << std::endl;
 
 }
 
@@ -72,10 +72,12 @@ Method::Method(GPUMemory&m,MethodConstructionData const*): ::Method(m){
   mem.programs[0].fragmentShader = fragmentShader;
   mem.programs[0].vs2fs[0]       = AttribType::VEC2;//tex coords
 
-  pushClearColorCommand(commandBuffer,glm::vec4(0,0,0,1));
-  pushClearDepthCommand(commandBuffer,10e10f);
-  pushBindProgramCommand(commandBuffer,0);
-  pushDrawCommand (commandBuffer,6);
+  bool recorded = true;
+  recorded &= pushClearColorCommand(commandBuffer,glm::vec4(0,0,0,1));
+  recorded &= pushClearDepthCommand(commandBuffer,10e10f);
+  recorded &= pushBindProgramCommand(commandBuffer,0);
+  recorded &= pushDrawCommand (commandBuffer,6);
+  if(!recorded)std::cerr << "funny project: the commands do not fit into the command buffer" << std::endl;
 }
 
 /**
@@ -70,9 +70,11 @@ Method::Method(GPUMemory&m,MethodConstructionData const*): ::Method(m){
   mem.programs[0].fragmentShader = fragmentShader;
   mem.programs[0].vs2fs[3]       = AttribType::VEC4;
 
-  pushClearColorCommand(commandBuffer,glm::vec4(.1,.1,.1,1));
-  pushClearDepthCommand(commandBuffer,10e10f);
-  pushDrawCommand (commandBuffer,3);
+  bool recorded = true;
+  recorded &= pushClearColorCommand(commandBuffer,glm::vec4(.1,.1,.1,1));
+  recorded &= pushClearDepthCommand(commandBuffer,10e10f);
+  recorded &= pushDrawCommand (commandBuffer,3);
+  if(!recorded)std::cerr << "triangle3D: the commands do not fit into the command buffer" << std::endl;
 }
 
 /**
@@ -73,11 +73,13 @@ Method::Method(GPUMemory&m,MethodConstructionData const*): ::Method(m){
   mem.vertexArrays[0].vertexAttrib[0].stride   = sizeof(float)*2    ;
   mem.vertexArrays[0].vertexAttrib[0].offset   = 0                  ;
 
-  pushClearColorCommand     (commandBuffer,glm::vec4(0));
-  pushClearDepthCommand     (commandBuffer,10e10f      );
-  pushBindProgramCommand    (commandBuffer,0           );
-  pushBindVertexArrayCommand(commandBuffer,0           );
-  pushDrawCommand           (commandBuffer,3*4         );
+  bool recorded = true;
+  recorded &= pushClearColorCommand     (commandBuffer,glm::vec4(0));
+  recorded &= pushClearDepthCommand     (commandBuffer,10e10f      );
+  recorded &= pushBindProgramCommand    (commandBuffer,0           );
+  recorded &= pushBindVertexArrayCommand(commandBuffer,0           );
+  recorded &= pushDrawCommand           (commandBuffer,3*4         );
+  if(!recorded)std::cerr << "triangleBuffer: the commands do not fit into the command buffer" << std::endl;
 }
 
 
@@ -56,10 +56,12 @@ Method::Method(GPUMemory&m,MethodConstructionData const*): ::Method(m){
   mem.programs[0].vertexShader   = vertexShader;
   mem.programs[0].fragmentShader = fragmentShader;
 
-  pushClearColorCommand(commandBuffer,glm::vec4(.1,.1,.1,1));
-  pushClearDepthCommand(commandBuffer,10e10f);
-  pushBindProgramCommand(commandBuffer,0);
-  pushDrawCommand (commandBuffer,3);
+  bool recorded = true;
+  recorded &= pushClearColorCommand(commandBuffer,glm::vec4(.1,.1,.1,1));
+  recorded &= pushClearDepthCommand(commandBuffer,10e10f);
+  recorded &= pushBindProgramCommand(commandBuffer,0);
+  recorded &= pushDrawCommand (commandBuffer,3);
+  if(!recorded)std::cerr << "Triangle Clip2: the commands do not fit into the command buffer" << std::endl;
 }
 
 void Method::onDraw(SceneParam const&){
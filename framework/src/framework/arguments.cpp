@@ -1,5 +1,8 @@
 #include<framework/arguments.hpp>
 
+#include<algorithm>
+#include<iostream>
+
 #ifndef CMAKE_ROOT_DIR
 /**
  * location of project
@@ -14,9 +17,15 @@ Arguments::Arguments(int argc,char*argv[]){
   runConformanceTests = args->isPresent("-c"                   ,"runs conformance tests");
   selectedTest        = args->geti32   ("--test"               ,-1,"run only this selected test");
   takeScreenShot      = args->isPresent("-s"                   ,"takes screenshot of app");
+  headless            = args->isPresent("--headless"           ,"renders frames of --method at --window-size without window (SDL video is not initialized)");
+  headlessFrames      = args->getu32   ("--headless-frames"    ,1   ,"number of frames rendered by --headless");
+  headlessOutput      = args->gets     ("--headless-output"    ,std::string(CMAKE_ROOT_DIR)+"/frame%04d.png","PNG files written by --headless (%d or %0Nd is replaced by the frame number), \"-\" writes raw 8-bit RGB frames (top row first) to stdout");
+  cameraPath          = args->gets     ("--camera-path"        ,""  ,"camera keyframes of --headless, each line: frame xAngle yAngle distance (degrees, linearly interpolated)");
   upToTest            = args->isPresent("--up-to-test"         ,"run all tests up to selected test by --test argument");
   method              = args->getu32   ("--method"             ,0,"selects a rendering method");
   modelFile           = args->gets     ("--model"              ,std::string(CMAKE_ROOT_DIR)+"/resources/models/fin.glb"             ,"model file in gltf/glb format");
+  modelCache          = args->isPresent("--model-cache"        ,"load models from binary caches next to them (<model>.izgcache, memory mapped, created on first load, rebuilt when the model changes)");
+  buildModelCache     = args->isPresent("--build-model-cache"  ,"create binary caches of --model (a glTF file or a directory with glTF files) and exit");
   imageFile           = args->gets     ("--img"                ,std::string(CMAKE_ROOT_DIR)+"/resources/images/onceAliveNowForgottenAndDead.png","texture file for texturedQuadMethod"                 );
   perfTests           = args->getu32   ("-f"                   ,10,"number of frames that are tests during performance tests");
   mseThreshold        = args->getf32   ("--mse"                ,40,"mse threshold for image to image test");
@@ -25,8 +34,47 @@ Arguments::Arguments(int argc,char*argv[]){
   verboseMemoryOutput = args->geti32   ("--verboseMemoryOutput",1,"this will force test to print deep memory informations");
   idToBreak           = args->getu32   ("--idToBreak"          ,1000000,"internal usages (used to test the tests...)");
   lineToBreak         = args->getu32   ("--lineToBreak"        ,1234567,"internal usages (used to test the tests...)");
+  threads             = args->getu32   ("--threads"            ,1,"number of rasterization threads (0 = all hardware threads, 1 = serial rasterizer)");
+  tileSize            = args->getu32   ("--tile-size"          ,64,"size of screen tiles (in pixels) for tile-binned rasterization, rounded to a multiple of 8");
+  tiled               = args->isPresent("--tiled"              ,"use tile-binned rasterization even with one thread");
+  noSimd              = args->isPresent("--no-simd"            ,"evaluate edge functions per pixel instead of SIMD blocks");
+  noHierarchy         = args->isPresent("--no-hierarchy"       ,"do not classify tiles/blocks as outside/inside/partial");
+  noDepthOnly         = args->isPresent("--no-depth-only"      ,"interpolate attributes and run color-only fragment shaders even when the draw writes no color (shadow maps)");
+  hiZ                 = args->isPresent("--hi-z"               ,"reject triangles and tiles behind the per-tile max depth (hierarchical depth buffer)");
+  eagerInterpolation  = args->isPresent("--eager-interpolation","interpolate attributes of every fragment before the stencil and depth tests");
+  quadShading         = args->isPresent("--quad-shading"       ,"rasterize and shade 2x2 pixel quads, attribute derivatives are differences of the quad");
+  fixedPoint          = args->isPresent("--fixed-point"        ,"snap vertices to 1/256 pixel and rasterize with integer edge functions");
+  vertexCache         = args->isPresent("--vertex-cache"       ,"shade each unique vertex of an indexed draw only once (post-transform cache)");
+  batchedVertices     = args->isPresent("--batched-vertices"   ,"fetch and shade vertices in batches (uses batch vertex shaders when available)");
+  genericFragmentOps  = args->isPresent("--generic-fragment-ops","run per-fragment operations without specialization for the draw state");
+  deferredClears      = args->isPresent("--deferred-clears"    ,"record clears per screen tile and write them on first touch or at the end of the frame");
+  compiledCommands    = args->isPresent("--compiled-commands"  ,"compile command buffer trees into cached flat plans (inlined sub-commands, redundant state removed, clears folded)");
+  stats               = args->isPresent("--stats"              ,"measure time spent in pipeline stages (reported with pipeline counters by -p)");
+  textureFilter       = args->gets     ("--texture-filter"     ,"nearest","filtering of model textures: nearest (full resolution), bilinear or trilinear (mipmapped, level selected by screen-space derivatives)");
+  textureLayout       = args->gets     ("--texture-layout"     ,"linear" ,"memory layout loaded textures are converted to: linear (rows of texels) or tiled (4x4 texel tiles, neighbouring rows share cache lines)");
+  traceFile           = args->gets     ("--trace"              ,""  ,"write timeline of executed commands to this JSON file (Chrome trace format, open in chrome://tracing or ui.perfetto.dev)");
+  traceFrames         = args->getu32   ("--trace-frames"       ,10  ,"number of frames recorded by --trace (0 = until the application ends)");
+  runBenchmark        = args->isPresent("--benchmark"          ,"runs benchmark suite (every method and every model from resources/models at every size)");
+  benchSizes          = args->geti32v  ("--bench-sizes"        ,{320,240,640,480},"pairs of width and height measured by --benchmark");
+  benchWarmup         = args->getu32   ("--bench-warmup"       ,2   ,"number of frames rendered before each measurement of --benchmark");
+  benchFrames         = args->getu32   ("--bench-frames"       ,5   ,"number of measured frames of each case of --benchmark");
+  benchOutput         = args->gets     ("--bench-output"       ,""  ,"write results of --benchmark to this file (.json or .csv)");
+  benchBaseline       = args->gets     ("--bench-baseline"     ,""  ,"compare results of --benchmark to this file (.json or .csv written by --bench-output), regressions fail the run");
+  benchThreshold      = args->getf32   ("--bench-threshold"    ,10  ,"allowed slowdown of the median frame time against --bench-baseline [%]");
+  benchFilter         = args->gets     ("--bench-filter"       ,""  ,"run only benchmark cases whose name contains this string");
+  runStageBenchmarks  = args->isPresent("--stage-benchmarks"   ,"runs Catch2 microbenchmarks of single pipeline stages (clipping, rasterization, vertex assembly, interpolation, stencil, texture reads, clears)");
+  stageBenchmarks     = args->gets     ("--stage-filter"       ,"[benchmark]","Catch2 test spec selecting --stage-benchmarks (e.g. [vertex], [raster], [fragment], [clear])");
+  benchSamples        = args->getu32   ("--bench-samples"      ,100 ,"number of samples of each benchmark of --stage-benchmarks");
+
 
 
+  // tiles are made of whole 8x8 Hi-Z tiles (and thus of whole 2x2 quads)
+  uint32_t const tileAlignment = 8;
+  if(tileSize == 0 || tileSize % tileAlignment != 0){
+    uint32_t const rounded = std::max((tileSize + tileAlignment/2) / tileAlignment,1u) * tileAlignment;
+    std::cerr << "warning: --tile-size " << tileSize << " is not a positive multiple of " << tileAlignment << ", using " << rounded << std::endl;
+    tileSize = rounded;
+  }
 
   auto printHelp  = args->isPresent("-h"    ,"prints help");
   printHelp |= args->isPresent("--help","prints help");
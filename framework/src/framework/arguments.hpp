@@ -33,6 +33,12 @@ class Arguments{
   bool runPerformanceTests;///< should we run performance tests
   bool runConformanceTests;///< sould we run conformance tests
   bool takeScreenShot;///< should we take a screnshot
+  bool headless;///< should we render frames without window
+  uint32_t headlessFrames;///< number of frames rendered without window
+  std::string headlessOutput;///< PNG file pattern of frames rendered without window ("-" = raw RGB on stdout)
+  std::string cameraPath;///< file with camera keyframes of frames rendered without window
+  bool modelCache = false;///< load models from binary caches (created on demand)
+  bool buildModelCache;///< create binary caches of models and exit
   bool stop = false; ///< should we immediately stop
   uint32_t perfTests; ///< number of frames in performance tests
   int      selectedTest; ///< selected conformance test
@@ -43,5 +49,36 @@ class Arguments{
   int32_t  verboseMemoryOutput;///< if you want to see deep information about memory during test, set this to true
   size_t   idToBreak;///< internal usage
   size_t   lineToBreak;///< internal usage
+  uint32_t threads;///< number of rasterization threads (0 = all hardware threads)
+  uint32_t tileSize;///< size of screen tiles for tile-binned rasterization (positive multiple of 8)
+  bool     tiled;///< force tile-binned rasterization
+  bool     noSimd;///< use scalar (per pixel) edge function evaluation
+  bool     noHierarchy;///< disable hierarchical tile/block classification
+  bool     noDepthOnly;///< always interpolate and shade fragments of draws without color writes
+  bool     hiZ;///< reject tiles behind the hierarchical depth buffer
+  bool     eagerInterpolation;///< interpolate attributes before the stencil and depth tests
+  bool     quadShading;///< rasterize and shade 2x2 pixel quads
+  bool     fixedPoint;///< rasterize with sub-pixel snapped integer edge functions
+  bool     vertexCache;///< reuse vertex shader outputs of indexed draws
+  bool     batchedVertices;///< fetch and shade vertices in batches
+  bool     genericFragmentOps;///< do not specialize per-fragment operations for the draw state
+  bool     deferredClears;///< clear screen tiles on first touch
+  bool     compiledCommands;///< execute command buffers as cached flat plans
+  bool     stats;///< measure time of pipeline stages
+  std::string textureFilter;///< filtering of model textures (nearest, bilinear, trilinear)
+  std::string textureLayout;///< memory layout of loaded textures (linear, tiled)
+  std::string traceFile;///< timeline of executed commands is written to this file (empty = no trace)
+  uint32_t traceFrames;///< number of frames in the timeline
+  bool     runBenchmark;///< should we run the benchmark suite
+  std::vector<int32_t>benchSizes;///< pairs of width and height measured by the benchmark suite
+  uint32_t benchWarmup;///< frames rendered before each benchmark measurement
+  uint32_t benchFrames;///< measured frames of each benchmark case
+  std::string benchOutput;///< benchmark results are written to this file (.json or .csv)
+  std::string benchBaseline;///< benchmark results are compared to this file (.json or .csv)
+  float    benchThreshold;///< allowed slowdown against the baseline [%]
+  std::string benchFilter;///< only benchmark cases containing this string are measured
+  bool     runStageBenchmarks;///< should we run microbenchmarks of pipeline stages
+  std::string stageBenchmarks;///< Catch2 test spec selecting stage microbenchmarks
+  uint32_t benchSamples;///< number of samples of each stage microbenchmark
 };
 
@@ -1,10 +1,22 @@
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
+#include <thread>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/quaternion.hpp>
 
 #include <framework/model.hpp>
+#include <framework/modelCache.hpp>
+#include <framework/programContext.hpp>
+#include <framework/textureData.hpp>
 #include <libs/tiny_gltf/tiny_gltf.h>
+#include <libs/stb_image/stb_image.h>
+#include <studentSolution/gpuSettings.hpp>
+#include <studentSolution/shaderFunctions.hpp>
+#include <studentSolution/threadPool.hpp>
 
 namespace tests{
 void printModel(Model const&model);
@@ -38,21 +50,147 @@ std::string accesstorType2Str(int i){
 
 class ModelDataImpl{
   public:
-    ModelDataImpl(){}
-    ~ModelDataImpl(){}
+    ModelDataImpl(){loader.SetImageLoader(deferImageDecoding,this);}
+    ~ModelDataImpl(){waitForImageDecoding();releaseMipmaps();}
     void load(std::string const&fileName);
-    void createModelView(Model&model);
+    void loadGLTF(std::string const&fileName);
+    static bool deferImageDecoding(tinygltf::Image*image,int const imageIdx,std::string*err,std::string*warn,int reqWidth,int reqHeight,unsigned char const*bytes,int size,void*userData);
+    void startImageDecoding();
+    void waitForImageDecoding();
+    bool buildCache(std::string const&fileName);
+    std::vector<std::string>getSourceFiles(std::string const&fileName)const;
+    void createModelView(Model&model,bool mipmaps = true);
     void createModelViewRoots   (Model&res);
     void createModelViewTextures(Model&res);
     void createModelViewBuffers (Model&res);
     void createModelViewMeshes  (Model&res);
+    void createModelViewMipmaps (Model&res);
+    void releaseMipmaps();
 
     bool               wasModelLoaded = false;
     tinygltf::Model    model                 ;
     tinygltf::TinyGLTF loader                ;
+    MappedModelCache   cache                 ;
+    std::vector<std::vector<unsigned char>>encodedImages;///< encoded files of images indexed by image (empty = nothing to decode)
+    std::thread        imageDecoding         ;///< decodes encodedImages into model.images
+    std::vector<std::vector<uint8_t>>mipBackings;///< pixels of levels 1.. of every texture
+    std::vector<std::vector<Texture>>mipLevels  ;///< mip chains of textures, attached to the textures of model views
 };
 
 void ModelDataImpl::load(std::string const&fileName){
+  releaseMipmaps();
+  if(!ProgramContext::get().args.modelCache){
+    loadGLTF(fileName);
+    return;
+  }
+
+  //on demand cache - it is created by the first load and mapped by the next ones
+  if(!cache.open(getModelCacheFile(fileName),fileName) && !buildCache(fileName))
+    return;
+
+  model          = tinygltf::Model();
+  wasModelLoaded = true;
+}
+
+bool ModelDataImpl::buildCache(std::string const&fileName){
+  loadGLTF(fileName);
+  if(!wasModelLoaded)return false;
+
+  Model view;
+  createModelView(view,false);
+  auto const cacheFile = getModelCacheFile(fileName);
+  bool const written = writeModelCache(cacheFile,view,getSourceFiles(fileName));
+  free(view);
+
+  return written && cache.open(cacheFile,fileName);
+}
+
+std::vector<std::string>ModelDataImpl::getSourceFiles(std::string const&fileName)const{
+  std::vector<std::string>sources = {fileName};
+
+  auto const dir = fileName.substr(0,fileName.find_last_of("/\\")+1);
+  auto const addUri = [&](std::string const&uri){
+    if(uri.empty() || uri.rfind("data:",0) == 0)return;
+    //uri is percent-encoded (e.g. %20 is space)
+    std::string decoded;
+    for(size_t i=0;i<uri.size();++i){
+      if(uri[i] == '%' && i+2 < uri.size() && std::isxdigit((unsigned char)uri[i+1]) && std::isxdigit((unsigned char)uri[i+2])){
+        decoded += (char)std::stoi(uri.substr(i+1,2),nullptr,16);
+        i += 2;
+      }else
+        decoded += uri[i];
+    }
+    sources.push_back(dir + decoded);
+  };
+  for(auto const&buffer:model.buffers)addUri(buffer.uri);
+  for(auto const&image :model.images )addUri(image .uri);
+  return sources;
+}
+
+/**
+ * @brief This function replaces image loader of tinygltf.
+ * It only reads the header and allocates the image, pixels are decoded in parallel by startImageDecoding.
+ * The result is the same as tinygltf::LoadImageData (4 channels, 16 bits if the file has them).
+ */
+bool ModelDataImpl::deferImageDecoding(tinygltf::Image*image,int const imageIdx,std::string*err,std::string*,int reqWidth,int reqHeight,unsigned char const*bytes,int size,void*userData){
+  auto*self = reinterpret_cast<ModelDataImpl*>(userData);
+
+  int w = 0,h = 0,comp = 0;
+  if(!stbi_info_from_memory(bytes,size,&w,&h,&comp) || w < 1 || h < 1 ||
+     (reqWidth > 0 && reqWidth != w) || (reqHeight > 0 && reqHeight != h)){
+    if(err)(*err) += "Unknown or invalid image data for image[" + std::to_string(imageIdx) + "] name = \"" + image->name + "\".\n";
+    return false;
+  }
+  bool const is16 = stbi_is_16_bit_from_memory(bytes,size);
+
+  image->width      = w;
+  image->height     = h;
+  image->component  = 4;
+  image->bits       = is16 ? 16 : 8;
+  image->pixel_type = is16 ? TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT : TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE;
+  image->image.resize((size_t)w*h*image->component*(image->bits/8));
+
+  if(self->encodedImages.size() <= (size_t)imageIdx)self->encodedImages.resize((size_t)imageIdx+1);
+  self->encodedImages[imageIdx].assign(bytes,bytes+size);
+  return true;
+}
+
+void ModelDataImpl::startImageDecoding(){
+  //images are decoded in the background, model view waits for them in createModelViewTextures
+  imageDecoding = std::thread([this]{
+    ThreadPool pool(std::max(std::thread::hardware_concurrency(),1u));
+    pool.parallelFor((uint32_t)encodedImages.size(),[this](uint32_t i,uint32_t){
+      auto&encoded = encodedImages[i];
+      if(encoded.empty())return;
+      auto&img = model.images[i];
+
+      int w = 0,h = 0,comp = 0;
+      void*data = img.bits == 16 ?
+        (void*)stbi_load_16_from_memory(encoded.data(),(int)encoded.size(),&w,&h,&comp,img.component):
+        (void*)stbi_load_from_memory   (encoded.data(),(int)encoded.size(),&w,&h,&comp,img.component);
+      if(data && w == img.width && h == img.height)
+        std::memcpy(img.image.data(),data,img.image.size());
+      else{
+        //the texture stays empty (no texels), reads of it return zeros
+        std::cerr << "model: image[" << i << "] " << img.uri << " cannot be decoded" << std::endl;
+        img.width  = 0;
+        img.height = 0;
+        std::vector<unsigned char>().swap(img.image);
+      }
+      stbi_image_free(data);
+      std::vector<unsigned char>().swap(encoded);
+    });
+  });
+}
+
+void ModelDataImpl::waitForImageDecoding(){
+  if(imageDecoding.joinable())imageDecoding.join();
+  encodedImages.clear();
+}
+
+void ModelDataImpl::loadGLTF(std::string const&fileName){
+  waitForImageDecoding();
+  releaseMipmaps();
   std::string err;
   std::string warn;
   if(fileName.find(".glb")==fileName.length()-4)
@@ -61,8 +199,13 @@ void ModelDataImpl::load(std::string const&fileName){
   if(fileName.find(".gltf")==fileName.length()-5)
     wasModelLoaded = loader.LoadASCIIFromFile(&model, &err, &warn, fileName.c_str());
 
-  if(!wasModelLoaded)
+  if(!wasModelLoaded){
     std::cerr << "model: " << fileName << "was not loaded" << std::endl;
+    encodedImages.clear();
+    return;
+  }
+
+  startImageDecoding();
 }
 
 void loadMatrix(Node*outNode,tinygltf::Node const&root){
@@ -90,12 +233,18 @@ void loadMatrix(Node*outNode,tinygltf::Node const&root){
   }
 }
 
-void ModelDataImpl::createModelView(Model&res){
+void ModelDataImpl::createModelView(Model&res,bool mipmaps){
   if(!wasModelLoaded)return;
-  createModelViewRoots   (res);
-  createModelViewTextures(res);
-  createModelViewBuffers (res);
-  createModelViewMeshes  (res);
+  if(cache.isOpen())
+    cache.createModelView(res);
+  else{
+    //textures are the last ones, so the view is built while images are being decoded
+    createModelViewRoots   (res);
+    createModelViewBuffers (res);
+    createModelViewMeshes  (res);
+    createModelViewTextures(res);
+  }
+  if(mipmaps)createModelViewMipmaps(res);
 }
 
 void createNode(Node*outNode,tinygltf::Node const&root,tinygltf::Model const&model){
@@ -124,19 +273,52 @@ void createModelViewTexture(Texture&tex,tinygltf::Image const&img){
   tex.width             = img.width;
   tex.height            = img.height;
   tex.img.channels      = img.component;
-  tex.img.data          = (void*)img.image.data();
+  tex.img.data          = img.image.empty() ? nullptr : (void*)img.image.data();
   tex.img.bytesPerPixel = img.component;
   tex.img.format        = Image::U8;
   tex.img.pitch         = img.width*img.component;
 }
 
 void ModelDataImpl::createModelViewTextures(Model&res){
+  waitForImageDecoding();
   res.nofTextures = model.images.size();
   res.textures    = new Texture[res.nofTextures];
   for(size_t i=0;i<res.nofTextures;++i)
     createModelViewTexture(res.textures[i],model.images[i]);
 }
 
+void ModelDataImpl::createModelViewMipmaps(Model&res){
+  //every view points to the same images, so the chains are created only once
+  //nearest filtering never reads above level 0, so only filtered reads get full chains
+  if(mipLevels.empty() && res.nofTextures != 0){
+    auto const layout    = getGPUSettings().textureLayout;
+    bool const mipmapped = getGPUSettings().textureFilter != TextureFilter::NEAREST;
+    mipBackings.resize(res.nofTextures);
+    mipLevels  .resize(res.nofTextures);
+    ThreadPool pool(std::max(std::thread::hardware_concurrency(),1u));
+    pool.parallelFor((uint32_t)res.nofTextures,[&](uint32_t i,uint32_t){
+      if(!res.textures[i].img.data)return;
+      if(mipmapped)createMipmaps(res.textures[i],mipBackings[i],mipLevels[i]);
+      else         mipLevels[i] = {res.textures[i]};
+      if(layout != ImageLayout::LINEAR)convertLayout(mipLevels[i],mipBackings[i],ImageLayout::LINEAR,layout);
+    });
+
+    for(auto const&levels:mipLevels)
+      if(!levels.empty())student_setTextureMipmaps(levels[0],levels.data(),(uint32_t)levels.size(),layout);
+  }
+
+  //converted chains do not share level 0 with the images
+  for(size_t i=0;i<mipLevels.size() && i<res.nofTextures;++i)
+    if(!mipLevels[i].empty())res.textures[i] = mipLevels[i][0];
+}
+
+void ModelDataImpl::releaseMipmaps(){
+  for(auto const&levels:mipLevels)
+    if(!levels.empty())student_removeTextureMipmaps(levels[0]);
+  mipLevels  .clear();
+  mipBackings.clear();
+}
+
 void ModelDataImpl::createModelViewBuffers(Model&res){
   res.nofBuffers = model.buffers.size();
   res.buffers = new Buffer[res.nofBuffers];
@@ -292,6 +474,31 @@ void ModelData::load(std::string const&fileName){
   impl->load(fileName);
 }
 
+bool ModelData::buildCache(std::string const&fileName){
+  return impl->buildCache(fileName);
+}
+
+bool buildModelCaches(std::string const&path){
+  std::vector<std::string>files;
+  if(std::filesystem::is_directory(path)){
+    for(auto const&entry:std::filesystem::recursive_directory_iterator(path)){
+      auto const extension = entry.path().extension().string();
+      if(entry.is_regular_file() && (extension == ".gltf" || extension == ".glb"))
+        files.push_back(entry.path().string());
+    }
+  }else
+    files.push_back(path);
+
+  bool success = true;
+  for(auto const&file:files){
+    ModelData modelData;
+    bool const built = modelData.buildCache(file);
+    std::cerr << "model cache: " << (built ? "stored " : "FAILED ") << getModelCacheFile(file) << std::endl;
+    success &= built;
+  }
+  return success;
+}
+
 ModelData::ModelData(){
   impl = new ModelDataImpl();
 }
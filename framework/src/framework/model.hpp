@@ -11,9 +11,19 @@ class ModelData{
   public:
     ModelData();
     void load(std::string const&fileName);
+    bool buildCache(std::string const&fileName);
     ~ModelData();
     void createModelView(Model&model);
   private:
     friend class ModelDataImpl;
     ModelDataImpl*impl = nullptr;
 };
+
+/**
+ * @brief This function creates binary caches of models (see ModelData::load with --model-cache)
+ *
+ * @param path glTF model or directory searched recursively for glTF models
+ *
+ * @return false if any cache could not be created
+ */
+bool buildModelCaches(std::string const&path);
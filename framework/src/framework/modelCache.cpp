@@ -0,0 +1,388 @@
+#include<cstring>
+#include<filesystem>
+#include<fstream>
+#include<iostream>
+
+#if defined(_WIN32)
+#include<windows.h>
+#else
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#endif
+
+#include<framework/modelCache.hpp>
+
+namespace{
+
+char     const cacheMagic[8] = {'I','Z','G','M','O','D','E','L'};
+uint32_t const cacheVersion  = 2 ;
+uint64_t const alignment     = 64;///< alignment of sections, buffers and textures in the file
+
+struct CacheHeader{
+  char     magic[8]       ;
+  uint32_t version        ;
+  uint32_t sizeofMesh     ;///< layout check - meshes and textures are stored as they are in memory
+  uint32_t sizeofTexture  ;
+  uint32_t padding        ;
+  uint64_t fileSize       ;
+  uint64_t nofSources     ;
+  uint64_t sourcesOffset  ;
+  uint64_t nofRoots       ;
+  uint64_t nofNodes       ;
+  uint64_t nodesOffset    ;
+  uint64_t nofMeshes      ;
+  uint64_t meshesOffset   ;
+  uint64_t nofBuffers     ;
+  uint64_t buffersOffset  ;
+  uint64_t nofTextures    ;
+  uint64_t texturesOffset ;
+};
+
+/**
+ * @brief Source file of the model, the first one is the model file itself
+ */
+struct CachedSource{
+  uint64_t hash        ;
+  uint64_t fileSize    ;
+  int64_t  writeTime   ;///< last write time (ticks of std::filesystem::file_time_type)
+  uint64_t nameOffset  ;///< name relative to directory of the model file
+  uint64_t nameLength  ;
+};
+
+/**
+ * @brief Node of the flattened tree, roots are the first nodes, children of a node are stored together
+ */
+struct CachedNode{
+  glm::mat4 modelMatrix;
+  int32_t   mesh       ;
+  int32_t   padding    ;
+  uint64_t  nofChildren;
+  uint64_t  firstChild ;
+};
+
+struct CachedBuffer{
+  uint64_t offset;
+  uint64_t size  ;
+};
+
+struct CachedTexture{
+  Texture  texture;///< texture with data set to nullptr
+  uint64_t offset ;
+  uint64_t size   ;
+};
+
+uint64_t align(uint64_t offset){
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+bool isInFile(uint64_t offset,uint64_t size,uint64_t fileSize){
+  return offset <= fileSize && size <= fileSize - offset;
+}
+
+/**
+ * @brief Checks that an array lies in the file, count*elementSize is never computed (it may overflow for corrupted headers)
+ */
+bool isArrayInFile(uint64_t offset,uint64_t count,uint64_t elementSize,uint64_t fileSize){
+  return offset <= fileSize && count <= (fileSize - offset) / elementSize;
+}
+
+bool getFileStamp(std::string const&fileName,uint64_t&fileSize,int64_t&writeTime){
+  std::error_code error;
+  fileSize  = (uint64_t)std::filesystem::file_size(fileName,error);
+  if(error)return false;
+  writeTime = (int64_t)std::filesystem::last_write_time(fileName,error).time_since_epoch().count();
+  return !error;
+}
+
+class CacheWriter{
+  public:
+    CacheWriter(std::string const&fileName):file(fileName,std::ios::binary){}
+    uint64_t write(void const*data,uint64_t size){
+      pad();
+      auto const offset = position;
+      file.write((char const*)data,(std::streamsize)size);
+      position += size;
+      return offset;
+    }
+    void pad(){
+      static char const zeros[alignment] = {};
+      auto const aligned = align(position);
+      file.write(zeros,(std::streamsize)(aligned - position));
+      position = aligned;
+    }
+    std::ofstream file        ;
+    uint64_t      position = 0;
+};
+
+}
+
+bool hashFile(std::string const&fileName,uint64_t&hash){
+  std::ifstream file(fileName,std::ios::binary);
+  if(!file)return false;
+
+  //FNV-1a over 64-bit words
+  uint64_t const prime = 0x100000001b3ull;
+  hash = 0xcbf29ce484222325ull;
+  std::vector<char>chunk(1<<20);
+  while(file){
+    file.read(chunk.data(),(std::streamsize)chunk.size());
+    auto const n = (size_t)file.gcount();
+    size_t i = 0;
+    for(;i+8<=n;i+=8){
+      uint64_t word;
+      std::memcpy(&word,chunk.data()+i,8);
+      hash = (hash ^ word) * prime;
+    }
+    for(;i<n;++i)
+      hash = (hash ^ (uint8_t)chunk[i]) * prime;
+    hash = (hash ^ n) * prime;
+  }
+  return true;
+}
+
+std::string getModelCacheFile(std::string const&modelFile){
+  return modelFile + ".izgcache";
+}
+
+bool writeModelCache(std::string const&cacheFile,Model const&model,std::vector<std::string>const&sources){
+  if(sources.empty())return false;
+  auto const modelDir = std::filesystem::path(sources.front()).parent_path();
+
+  //written into temporary file and renamed, so other processes never map unfinished cache
+  auto const tmpFile = cacheFile + ".tmp";
+  {
+    CacheWriter writer(tmpFile);
+    if(!writer.file){
+      std::cerr << "model cache: cannot write " << cacheFile << std::endl;
+      return false;
+    }
+
+    CacheHeader header = {};
+    writer.write(&header,sizeof(header));
+
+    std::vector<CachedSource>cachedSources;
+    std::string names;
+    for(auto const&source:sources){
+      CachedSource s;
+      if(!getFileStamp(source,s.fileSize,s.writeTime) || !hashFile(source,s.hash))continue;
+      auto const name = std::filesystem::relative(source,modelDir).generic_string();
+      s.nameOffset = names.size();
+      s.nameLength = name.size();
+      names += name;
+      cachedSources.push_back(s);
+    }
+    auto const namesOffset = writer.write(names.data(),names.size());
+    for(auto&s:cachedSources)s.nameOffset += namesOffset;
+    header.nofSources    = cachedSources.size();
+    header.sourcesOffset = writer.write(cachedSources.data(),sizeof(CachedSource)*cachedSources.size());
+
+    //breadth-first order - roots first and children of every node next to each other
+    std::vector<Node const*>nodes;
+    for(size_t i=0;i<model.nofRoots;++i)nodes.push_back(model.roots+i);
+    std::vector<CachedNode>cachedNodes;
+    for(size_t i=0;i<nodes.size();++i){
+      CachedNode n = {};
+      n.modelMatrix = nodes[i]->modelMatrix;
+      n.mesh        = nodes[i]->mesh;
+      n.nofChildren = nodes[i]->nofChildren;
+      n.firstChild  = nodes.size();
+      for(size_t c=0;c<nodes[i]->nofChildren;++c)nodes.push_back(nodes[i]->children+c);
+      cachedNodes.push_back(n);
+    }
+    header.nofRoots    = model.nofRoots;
+    header.nofNodes    = cachedNodes.size();
+    header.nodesOffset = writer.write(cachedNodes.data(),sizeof(CachedNode)*cachedNodes.size());
+
+    header.nofMeshes    = model.nofMeshes;
+    header.meshesOffset = writer.write(model.meshes,sizeof(Mesh)*model.nofMeshes);
+
+    std::vector<CachedBuffer>cachedBuffers(model.nofBuffers);
+    for(size_t i=0;i<model.nofBuffers;++i){
+      cachedBuffers[i].size   = model.buffers[i].size;
+      cachedBuffers[i].offset = writer.write(model.buffers[i].data,model.buffers[i].size);
+    }
+
+    std::vector<CachedTexture>cachedTextures(model.nofTextures);
+    for(size_t i=0;i<model.nofTextures;++i){
+      auto&t = cachedTextures[i];
+      t.texture          = model.textures[i];
+      t.texture.img.data = nullptr;
+      t.size             = model.textures[i].img.data ? (uint64_t)t.texture.img.pitch*t.texture.height : 0;
+      t.offset           = writer.write(model.textures[i].img.data,t.size);
+    }
+
+    header.nofBuffers     = cachedBuffers.size();
+    header.buffersOffset  = writer.write(cachedBuffers.data(),sizeof(CachedBuffer)*cachedBuffers.size());
+    header.nofTextures    = cachedTextures.size();
+    header.texturesOffset = writer.write(cachedTextures.data(),sizeof(CachedTexture)*cachedTextures.size());
+    writer.pad();
+
+    std::memcpy(header.magic,cacheMagic,sizeof(cacheMagic));
+    header.version       = cacheVersion;
+    header.sizeofMesh    = sizeof(Mesh);
+    header.sizeofTexture = sizeof(Texture);
+    header.fileSize      = writer.position;
+    writer.file.seekp(0);
+    writer.file.write((char const*)&header,sizeof(header));
+    if(!writer.file){
+      std::cerr << "model cache: cannot write " << cacheFile << std::endl;
+      return false;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(tmpFile,cacheFile,error);
+  if(error){
+    std::cerr << "model cache: cannot write " << cacheFile << ": " << error.message() << std::endl;
+    std::filesystem::remove(tmpFile,error);
+    return false;
+  }
+  return true;
+}
+
+MappedModelCache::~MappedModelCache(){
+  close();
+}
+
+bool MappedModelCache::open(std::string const&cacheFile,std::string const&modelFile){
+  close();
+
+#if defined(_WIN32)
+  auto const file = CreateFileA(cacheFile.c_str(),GENERIC_READ,FILE_SHARE_READ,nullptr,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,nullptr);
+  if(file == INVALID_HANDLE_VALUE)return false;
+  LARGE_INTEGER fileSize;
+  GetFileSizeEx(file,&fileSize);
+  handle = CreateFileMappingA(file,nullptr,PAGE_READONLY,0,0,nullptr);
+  CloseHandle(file);
+  if(!handle)return false;
+  data = (uint8_t const*)MapViewOfFile(handle,FILE_MAP_READ,0,0,0);
+  size = (uint64_t)fileSize.QuadPart;
+  if(!data){
+    close();
+    return false;
+  }
+#else
+  auto const file = ::open(cacheFile.c_str(),O_RDONLY);
+  if(file < 0)return false;
+  struct stat fileStat;
+  if(fstat(file,&fileStat) != 0 || fileStat.st_size <= 0){
+    ::close(file);
+    return false;
+  }
+  auto const mapping = mmap(nullptr,(size_t)fileStat.st_size,PROT_READ,MAP_PRIVATE,file,0);
+  ::close(file);
+  if(mapping == MAP_FAILED)return false;
+  data = (uint8_t const*)mapping;
+  size = (uint64_t)fileStat.st_size;
+#endif
+
+  auto const stale = [&](){
+    close();
+    return false;
+  };
+
+  if(size < sizeof(CacheHeader))return stale();
+  auto const&header = *(CacheHeader const*)data;
+  if(std::memcmp(header.magic,cacheMagic,sizeof(cacheMagic)) != 0)return stale();
+  if(header.version != cacheVersion || header.sizeofMesh != sizeof(Mesh) || header.sizeofTexture != sizeof(Texture))return stale();
+  if(header.fileSize != size)return stale();
+  if(header.nofRoots > header.nofNodes)return stale();
+  if(!isArrayInFile(header.sourcesOffset ,header.nofSources ,sizeof(CachedSource ),size))return stale();
+  if(!isArrayInFile(header.nodesOffset   ,header.nofNodes   ,sizeof(CachedNode   ),size))return stale();
+  if(!isArrayInFile(header.meshesOffset  ,header.nofMeshes  ,sizeof(Mesh         ),size))return stale();
+  if(!isArrayInFile(header.buffersOffset ,header.nofBuffers ,sizeof(CachedBuffer ),size))return stale();
+  if(!isArrayInFile(header.texturesOffset,header.nofTextures,sizeof(CachedTexture),size))return stale();
+
+  auto const*nodes = (CachedNode const*)(data + header.nodesOffset);
+  for(uint64_t i=0;i<header.nofNodes;++i)
+    if(nodes[i].firstChild > header.nofNodes || nodes[i].nofChildren > header.nofNodes - nodes[i].firstChild)return stale();
+  auto const*buffers = (CachedBuffer const*)(data + header.buffersOffset);
+  for(uint64_t i=0;i<header.nofBuffers;++i)
+    if(!isInFile(buffers[i].offset,buffers[i].size,size))return stale();
+  auto const*textures = (CachedTexture const*)(data + header.texturesOffset);
+  for(uint64_t i=0;i<header.nofTextures;++i){
+    if(!isInFile(textures[i].offset,textures[i].size,size))return stale();
+    if(textures[i].size && textures[i].size < (uint64_t)textures[i].texture.img.pitch*textures[i].texture.height)return stale();
+  }
+
+  //the model file is the first source, the cache is stale if any source changed,
+  //unchanged size and write time are trusted, files are hashed only if the write time differs
+  auto const modelDir = std::filesystem::path(modelFile).parent_path();
+  auto const*sources = (CachedSource const*)(data + header.sourcesOffset);
+  if(header.nofSources == 0)return stale();
+  for(uint64_t i=0;i<header.nofSources;++i){
+    if(!isInFile(sources[i].nameOffset,sources[i].nameLength,size))return stale();
+    auto const name = std::string((char const*)data + sources[i].nameOffset,sources[i].nameLength);
+    if(i == 0 && name != std::filesystem::path(modelFile).filename().generic_string())return stale();
+    auto const source = (modelDir / name).string();
+    uint64_t fileSize;
+    int64_t  writeTime;
+    if(!getFileStamp(source,fileSize,writeTime) || fileSize != sources[i].fileSize)return stale();
+    if(writeTime == sources[i].writeTime)continue;
+    uint64_t hash;
+    if(!hashFile(source,hash) || hash != sources[i].hash)return stale();
+  }
+
+  return true;
+}
+
+void MappedModelCache::close(){
+#if defined(_WIN32)
+  if(data  )UnmapViewOfFile(data);
+  if(handle)CloseHandle(handle);
+#else
+  if(data)munmap((void*)data,(size_t)size);
+#endif
+  data   = nullptr;
+  size   = 0      ;
+  handle = nullptr;
+}
+
+namespace{
+
+void createNode(Node*outNode,CachedNode const*nodes,uint64_t id){
+  auto const&node = nodes[id];
+  outNode->modelMatrix = node.modelMatrix;
+  outNode->mesh        = node.mesh;
+  outNode->nofChildren = node.nofChildren;
+  outNode->children    = new Node[outNode->nofChildren];
+  for(size_t i=0;i<outNode->nofChildren;++i)
+    createNode(outNode->children+i,nodes,node.firstChild+i);
+}
+
+}
+
+void MappedModelCache::createModelView(Model&res)const{
+  if(!data)return;
+  auto const&header = *(CacheHeader const*)data;
+
+  //node, mesh, buffer and texture descriptors are allocated as in ModelData (free(Model&) releases them),
+  //data of buffers and textures stay in the mapped file
+  auto const*nodes = (CachedNode const*)(data + header.nodesOffset);
+  res.nofRoots = header.nofRoots;
+  res.roots    = new Node[res.nofRoots];
+  for(size_t i=0;i<res.nofRoots;++i)
+    createNode(res.roots+i,nodes,i);
+
+  res.nofMeshes = header.nofMeshes;
+  res.meshes    = new Mesh[res.nofMeshes];
+  if(res.nofMeshes)std::memcpy((void*)res.meshes,data + header.meshesOffset,sizeof(Mesh)*res.nofMeshes);
+
+  auto const*buffers = (CachedBuffer const*)(data + header.buffersOffset);
+  res.nofBuffers = header.nofBuffers;
+  res.buffers    = new Buffer[res.nofBuffers];
+  for(size_t i=0;i<res.nofBuffers;++i){
+    res.buffers[i].data = data + buffers[i].offset;
+    res.buffers[i].size = buffers[i].size;
+  }
+
+  auto const*textures = (CachedTexture const*)(data + header.texturesOffset);
+  res.nofTextures = header.nofTextures;
+  res.textures    = new Texture[res.nofTextures];
+  for(size_t i=0;i<res.nofTextures;++i){
+    res.textures[i]          = textures[i].texture;
+    res.textures[i].img.data = textures[i].size ? (void*)(data + textures[i].offset) : nullptr;
+  }
+}
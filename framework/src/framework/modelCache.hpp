@@ -0,0 +1,87 @@
+/*!
+ * @file
+ * @brief This file contains binary cache of preprocessed models.
+ *
+ * The cache stores flattened node tree, meshes, buffers and decoded textures
+ * of a glTF model in one file. Every section is aligned, so the file is mapped
+ * into memory and buffers and textures of the model view point directly into
+ * the mapping (no parsing, no image decoding, no copies).
+ *
+ * Only level 0 of textures in the linear layout is stored. Mip chains (filtered
+ * reads) and the tiled layout are built from it in heap memory by ModelData,
+ * so they are copies of the mapped texels.
+ */
+
+#pragma once
+
+#include<cstdint>
+#include<string>
+#include<vector>
+
+#include<solutionInterface/modelFwd.hpp>
+
+/**
+ * @brief This function computes 64-bit hash of a file
+ *
+ * @param fileName file
+ * @param hash resulting hash
+ *
+ * @return false if the file cannot be read
+ */
+bool hashFile(std::string const&fileName,uint64_t&hash);
+
+/**
+ * @brief This function returns name of the cache file of a model
+ *
+ * @param modelFile glTF model file
+ *
+ * @return cache file (next to the model)
+ */
+std::string getModelCacheFile(std::string const&modelFile);
+
+/**
+ * @brief This function writes model view into a cache file
+ *
+ * @param cacheFile cache file
+ * @param model model view (all data are copied into the file)
+ * @param sources model file and files it references (the cache is valid while their contents do not change)
+ *
+ * @return false if the file cannot be written
+ */
+bool writeModelCache(std::string const&cacheFile,Model const&model,std::vector<std::string>const&sources);
+
+/**
+ * @brief This class maps a model cache file into memory
+ */
+class MappedModelCache{
+  public:
+    MappedModelCache(){}
+    ~MappedModelCache();
+    MappedModelCache(MappedModelCache const&) = delete;
+    MappedModelCache&operator=(MappedModelCache const&) = delete;
+    /**
+     * @brief This function maps the cache file and checks that it belongs to the model
+     *
+     * @param cacheFile cache file
+     * @param modelFile model file the cache was created from
+     *
+     * @return false if the cache does not exist, is corrupted or is stale (size of a source file changed,
+     * or its write time and hash changed)
+     */
+    bool open(std::string const&cacheFile,std::string const&modelFile);
+    /**
+     * @brief This function unmaps the file
+     */
+    void close();
+    /**
+     * @brief This function creates model view, buffers and textures (level 0, linear layout) point into the mapped file
+     *
+     * @param model model view (release it by free(model) before the cache is closed)
+     */
+    void createModelView(Model&model)const;
+    bool isOpen()const{return data != nullptr;}
+  private:
+    uint8_t const*data   = nullptr;///< mapped file
+    uint64_t      size   = 0      ;///< size of the mapped file
+    void*         handle = nullptr;///< handle of the mapping (windows only)
+};
@@ -18,6 +18,18 @@ void ProgramContext::free(){
 
 ProgramContext*ProgramContext::reg = nullptr;
 
+size_t MethodDatabase::getNofMethods()const{
+  return methodFactories.size();
+}
+
+std::string const&MethodDatabase::getMethodName(size_t id)const{
+  return methodNames.at(id);
+}
+
+std::shared_ptr<Method>MethodDatabase::createMethod(size_t id,GPUMemory&mem)const{
+  return methodFactories.at(id)(mem,methodConstructData.at(id).get());
+}
+
 
 std::string methodCounter(){
   static int methodCounter=0;
@@ -11,6 +11,10 @@ template<typename CLASS>
 void registerMethod(std::string const&name,std::shared_ptr<MethodConstructionData>const&mcd = nullptr);
 
 class MethodDatabase{
+  public:
+    size_t                  getNofMethods(                  )const;
+    std::string const&      getMethodName(size_t id         )const;
+    std::shared_ptr<Method> createMethod (size_t id,GPUMemory&mem)const;
   private:
     using MethodFactory = std::function<std::shared_ptr<Method>(GPUMemory&,MethodConstructionData const*)>;
     struct MethodMetadata{
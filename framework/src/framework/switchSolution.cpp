@@ -4,6 +4,7 @@
 #include<studentSolution/gpu.hpp>
 #include<studentSolution/prepareModel.hpp>
 #include<studentSolution/shaderFunctions.hpp>
+#include<studentSolution/vertexBatch.hpp>
 
 bool useTeacherSolution = false;
 
@@ -39,11 +40,38 @@ void prepareModel(GPUMemory&mem,CommandBuffer&cb,Model const&model){
   taskFunctions_impl.prepareModel(mem,cb,model);
 }
 
+void gpuRun(GPUMemory&mem,CommandStream const&cs){
+  student_GPU_run(mem,cs);
+}
+
+void prepareModel(GPUMemory&mem,CommandStream&cs,Model const&model){
+  student_prepareModel(mem,cs,model);
+}
+
 void drawModel_vertexShader(OutVertex&outVertex,InVertex const&inVertex,ShaderInterface const&si){
   if(!taskFunctions_impl.drawModel_vertexShader)return;
   taskFunctions_impl.drawModel_vertexShader(outVertex,inVertex,si);
 }
 
+void drawModel_vertexShaderBatch(OutVertex outVertices[],InVertexBatch const&inVertices,ShaderInterface const&si){
+  if(taskFunctions_impl.drawModel_vertexShader == student_drawModel_vertexShader){
+    student_drawModel_vertexShaderBatch(outVertices,inVertices,si);
+    return;
+  }
+
+  // teacher solution has no batch shader - run its vertex shader lane by lane
+  for(uint32_t i=0;i<inVertices.nofVertices;++i){
+    InVertex inVertex;
+    inVertex.gl_VertexID = inVertices.gl_VertexID[i];
+    for(uint32_t a=0;a<maxAttribs;++a)
+      inVertex.attributes[a] = inVertices.attributes[a][i];
+    drawModel_vertexShader(outVertices[i],inVertex,si);
+  }
+}
+
+// programs only store drawModel_vertexShader, the batched vertex stage finds the batch version through it
+static bool const drawModel_vertexShaderBatchRegistered = (registerBatchVertexShader(drawModel_vertexShader,drawModel_vertexShaderBatch),true);
+
 void drawModel_fragmentShader(OutFragment&outFragment,InFragment const&inFragment,ShaderInterface const&si){
   if(!taskFunctions_impl.drawModel_fragmentShader)return;
   taskFunctions_impl.drawModel_fragmentShader(outFragment,inFragment,si);
@@ -3,5 +3,11 @@
 #include<solutionInterface/gpu.hpp>
 #include<solutionInterface/modelFwd.hpp>
 
+class CommandStream;
+
 void switchToStudentSolution();
 void switchToTeacherSolution();
+
+// the teacher solution has no command streams, they are always recorded and executed by the student solution
+void gpuRun      (GPUMemory&mem,CommandStream const&cs);
+void prepareModel(GPUMemory&mem,CommandStream&cs,Model const&model);
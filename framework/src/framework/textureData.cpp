@@ -1,10 +1,27 @@
 #include<framework/textureData.hpp>
 
 #include<libs/stb_image/stb_image.h>
+#include<studentSolution/gpuSettings.hpp>
+#include<studentSolution/shaderFunctions.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
 
+namespace{
+
+uint32_t getLevelPitch(uint32_t width,uint32_t bytesPerPixel,ImageLayout layout){
+  return layout == ImageLayout::TILED ? getTiledPitch(width,bytesPerPixel) : width*bytesPerPixel;
+}
+
+size_t getLevelSize(Texture const&level,ImageLayout layout){
+  auto const rows = layout == ImageLayout::TILED ? (level.height+textureTileSize-1)/textureTileSize : level.height;
+  return (size_t)level.img.pitch*rows;
+}
+
+}
+
 TextureData::TextureData(
     uint32_t w,
     uint32_t h,
@@ -25,6 +42,174 @@ TextureData::TextureData(
   texture.img.pitch         = w*texture.img.bytesPerPixel;
 }
 
+TextureData::TextureData(TextureData&&other):
+  memBacking(std::move(other.memBacking)),
+  texture   (other.texture              ),
+  mipBacking(std::move(other.mipBacking)),
+  mipLevels (std::move(other.mipLevels )),
+  layout    (other.layout               ){
+  //the chain is registered by the data pointer, which does not change by moving the vectors
+  other.mipLevels.clear();
+}
+
+TextureData&TextureData::operator=(TextureData&&other){
+  if(this == &other)return *this;
+  releaseMipmaps();
+  memBacking = std::move(other.memBacking);
+  texture    = other.texture              ;
+  mipBacking = std::move(other.mipBacking);
+  mipLevels  = std::move(other.mipLevels );
+  layout     = other.layout               ;
+  other.mipLevels.clear();
+  return *this;
+}
+
+TextureData::~TextureData(){
+  releaseMipmaps();
+}
+
+void TextureData::generateMipmaps(){
+  releaseMipmaps();
+  if(!texture.img.data)return;
+  createMipmaps(texture,mipBacking,mipLevels,layout);
+  attach();
+}
+
+void TextureData::convertLayout(ImageLayout newLayout){
+  if(newLayout == layout || !texture.img.data)return;
+
+  auto levels = mipLevels.empty() ? std::vector<Texture>{texture} : mipLevels;
+  std::vector<uint8_t>storage;
+  ::convertLayout(levels,storage,layout,newLayout);
+
+  releaseMipmaps();
+  memBacking = std::move(storage);
+  texture    = levels[0];
+  mipLevels  = std::move(levels);
+  layout     = newLayout;
+  attach();
+}
+
+void TextureData::convertFormat(){
+  if(!texture.img.data)return;
+  if(getTexelFormat(texture.img) != TexelFormat::GENERIC){
+    attach();
+    return;
+  }
+
+  //missing channels are filled like the generic fetch does: (0,0,0,1)
+  auto const&img = texture.img;
+  Texture converted = texture;
+  converted.img.channels      = 4;
+  converted.img.bytesPerPixel = 4*(img.format == Image::F32 ? sizeof(float) : sizeof(uint8_t));
+  converted.img.pitch         = getLevelPitch(texture.width,converted.img.bytesPerPixel,layout);
+  for(uint32_t c=0;c<4;++c)converted.img.channelTypes[c] = (Image::Channel)c;
+
+  std::vector<uint8_t>storage(getLevelSize(converted,layout));
+  converted.img.data = storage.data();
+  for(uint32_t y=0;y<texture.height;++y)
+    for(uint32_t x=0;x<texture.width;++x){
+      auto const src = getTexel(img          ,x,y,layout);
+      auto const dst = getTexel(converted.img,x,y,layout);
+      for(uint32_t c=0;c<4;++c){
+        if(img.format == Image::F32)((float  *)dst)[c] = c < img.channels ? ((float   const*)src)[img.channelTypes[c]] : c == 3 ? 1.f : 0.f;
+        else                        ((uint8_t*)dst)[c] = c < img.channels ? ((uint8_t const*)src)[img.channelTypes[c]] : c == 3 ? 255 : 0;
+      }
+    }
+
+  auto const hadMipmaps = mipLevels.size() > 1;
+  releaseMipmaps();
+  memBacking = std::move(storage);
+  texture    = converted;
+  if(hadMipmaps)generateMipmaps();
+  else          attach();
+}
+
+void TextureData::attach(){
+  //a single level is registered too, so reads know the layout and the format
+  if(mipLevels.empty())mipLevels = {texture};
+  student_setTextureMipmaps(texture,mipLevels.data(),(uint32_t)mipLevels.size(),layout);
+}
+
+void TextureData::releaseMipmaps(){
+  if(mipLevels.empty())return;
+  student_removeTextureMipmaps(mipLevels[0]);
+  mipLevels .clear();
+  mipBacking.clear();
+}
+
+void createMipmaps(Texture const&texture,std::vector<uint8_t>&storage,std::vector<Texture>&levels,ImageLayout layout){
+  levels = {texture};
+  storage.clear();
+
+  auto const&img         = texture.img;
+  auto const formatSize  = img.format == Image::F32 ? sizeof(float) : sizeof(uint8_t);
+  auto const nofElements = img.bytesPerPixel / formatSize;
+
+  //sizes of all levels first, so the storage is allocated only once
+  size_t size = 0;
+  for(uint32_t w=texture.width,h=texture.height;w>1 || h>1;){
+    w = std::max(w/2,1u);
+    h = std::max(h/2,1u);
+    Texture level = texture;
+    level.width         = w;
+    level.height        = h;
+    level.img.pitch     = getLevelPitch(w,img.bytesPerPixel,layout);
+    level.img.data      = (void*)size;
+    levels.push_back(level);
+    size += getLevelSize(level,layout);
+  }
+  storage.resize(size);
+  for(size_t i=1;i<levels.size();++i)
+    levels[i].img.data = storage.data() + (size_t)levels[i].img.data;
+
+  //every texel is average of 2x2 texels of the previous level (the last row/column is repeated for odd sizes)
+  for(size_t i=1;i<levels.size();++i){
+    auto const&src = levels[i-1];
+    auto      &dst = levels[i  ];
+    for(uint32_t y=0;y<dst.height;++y)
+      for(uint32_t x=0;x<dst.width;++x){
+        uint32_t const x0 = std::min(2*x,src.width -1),x1 = std::min(2*x+1,src.width -1);
+        uint32_t const y0 = std::min(2*y,src.height-1),y1 = std::min(2*y+1,src.height-1);
+        void const*p[4] = {getTexel(src.img,x0,y0,layout),getTexel(src.img,x1,y0,layout),getTexel(src.img,x0,y1,layout),getTexel(src.img,x1,y1,layout)};
+        auto*out = (void*)getTexel(dst.img,x,y,layout);
+        for(size_t e=0;e<nofElements;++e){
+          if(img.format == Image::F32){
+            float sum = 0.f;
+            for(auto const&q:p)sum += ((float const*)q)[e];
+            ((float*)out)[e] = sum/4.f;
+          }else{
+            uint32_t sum = 2;
+            for(auto const&q:p)sum += ((uint8_t const*)q)[e];
+            ((uint8_t*)out)[e] = (uint8_t)(sum/4);
+          }
+        }
+      }
+  }
+}
+
+void convertLayout(std::vector<Texture>&levels,std::vector<uint8_t>&storage,ImageLayout oldLayout,ImageLayout newLayout){
+  auto converted = levels;
+  size_t size = 0;
+  for(auto&level:converted){
+    level.img.pitch = getLevelPitch(level.width,level.img.bytesPerPixel,newLayout);
+    level.img.data  = (void*)size;
+    size += getLevelSize(level,newLayout);
+  }
+
+  std::vector<uint8_t>newStorage(size);
+  for(size_t i=0;i<levels.size();++i){
+    auto&level = converted[i];
+    level.img.data = newStorage.data() + (size_t)level.img.data;
+    for(uint32_t y=0;y<level.height;++y)
+      for(uint32_t x=0;x<level.width;++x)
+        std::memcpy((void*)getTexel(level.img,x,y,newLayout),getTexel(levels[i].img,x,y,oldLayout),level.img.bytesPerPixel);
+  }
+
+  levels  = std::move(converted );
+  storage = std::move(newStorage);
+}
+
 TextureData loadTexture(std::string const&fileName){
   TextureData res;
 
@@ -51,5 +236,9 @@ TextureData loadTexture(std::string const&fileName){
   res.texture.img.pitch         = w*res.texture.img.bytesPerPixel;
 
   stbi_image_free(data);
+  res.convertFormat();
+  //nearest filtering never reads above level 0
+  if(getGPUSettings().textureFilter != TextureFilter::NEAREST)res.generateMipmaps();
+  res.convertLayout(getGPUSettings().textureLayout);
   return res;
 }
@@ -4,20 +4,76 @@
 #include<cstdint>
 #include<string>
 #include<solutionInterface/gpu.hpp>
+#include<studentSolution/shaderFunctions.hpp>
 
 class TextureData{
   public:
     std::vector<uint8_t>memBacking;
     Texture texture;
+    std::vector<uint8_t>mipBacking;///< pixels of levels 1.. of the mip chain
+    std::vector<Texture>mipLevels ;///< all levels of the mip chain (mipLevels[0] is texture), empty = no mipmaps
+    ImageLayout         layout = ImageLayout::LINEAR;///< memory layout of all levels
     TextureData(){}
     TextureData(
         uint32_t w,
         uint32_t h,
         uint32_t c,
         Image::Format f = Image::U8);
+    TextureData(TextureData&&other);
+    TextureData&operator=(TextureData&&other);
+    TextureData(TextureData const&) = delete;
+    TextureData&operator=(TextureData const&) = delete;
+    ~TextureData();
     Texture getTexture(){
       return texture;
     }
+    /**
+     * @brief This function (re)creates mip chain from the current content of the texture
+     * and attaches it to the texture, so mipmapped reads of the texture can use it
+     */
+    void generateMipmaps();
+    /**
+     * @brief This function converts texels of all levels to another memory layout
+     * and attaches the layout to the texture (getTexture() returns the converted texture)
+     *
+     * @param newLayout new memory layout
+     */
+    void convertLayout(ImageLayout newLayout);
+    /**
+     * @brief This function converts texels to the texel format with the fastest fetch
+     * (RGBA8 for U8 images, RGBA32F for F32 colors, DEPTH32F stays as it is)
+     * and attaches the format to the texture, so reads do not swizzle channels per texel
+     */
+    void convertFormat();
+    /**
+     * @brief This function detaches mip chain, layout and format from the texture and frees the chain
+     */
+    void releaseMipmaps();
+  private:
+    /**
+     * @brief This function attaches mip chain (or the texture alone), layout and format to the texture
+     */
+    void attach();
 };
 
 TextureData loadTexture(std::string const&fileName);
+
+/**
+ * @brief This function creates mip chain of a texture (2x2 box filter down to 1x1)
+ *
+ * @param texture level 0
+ * @param storage receives pixels of levels 1..
+ * @param levels receives all levels, levels[0] is the texture, the others point into storage
+ * @param layout memory layout of the texture and of the created levels
+ */
+void createMipmaps(Texture const&texture,std::vector<uint8_t>&storage,std::vector<Texture>&levels,ImageLayout layout = ImageLayout::LINEAR);
+
+/**
+ * @brief This function copies levels of a texture into another memory layout
+ *
+ * @param levels levels, their pitches and data pointers are replaced (they point into storage)
+ * @param storage receives texels of all levels
+ * @param oldLayout current memory layout of the levels
+ * @param newLayout new memory layout
+ */
+void convertLayout(std::vector<Texture>&levels,std::vector<uint8_t>&storage,ImageLayout oldLayout,ImageLayout newLayout);
@@ -675,20 +675,36 @@ struct CommandBuffer{
 };
 //! [CommandBuffer]
 
+/**
+ * @brief This function reserves next command of command buffer.
+ * The command buffer has fixed size, so no command is reserved when it is full.
+ *
+ * @param cb command buffer
+ *
+ * @return pointer to the reserved command or nullptr if the command buffer is full
+ */
+[[nodiscard]] inline Command*reserveCommand(CommandBuffer&cb){
+  if(cb.nofCommands >= CommandBuffer::maxCommands)return nullptr;
+  return &cb.commands[cb.nofCommands++];
+}
+
 /**
  * @brief This function can be used to insert clear color command to command buffer.
  *
  * @param cb    command buffer
  * @param value clear color value for cleaning
+ *
+ * @return true if the command was inserted, false if the command buffer is full
  */
-inline void pushClearColorCommand(
+[[nodiscard]] inline bool pushClearColorCommand(
     CommandBuffer      &cb                  ,
     glm::vec4     const&value = glm::vec4(0)){
-  auto&cmd=cb.commands[cb.nofCommands];
-  cmd.type = CommandType::CLEAR_COLOR;
-  auto&c = cmd.data.clearColorCommand;
+  auto*cmd=reserveCommand(cb);
+  if(!cmd)return false;
+  cmd->type = CommandType::CLEAR_COLOR;
+  auto&c = cmd->data.clearColorCommand;
   c.value        = value     ;
-  cb.nofCommands++;
+  return true;
 }
 
 /**
@@ -696,15 +712,18 @@ inline void pushClearColorCommand(
  *
  * @param cb    command buffer
  * @param value clear depth value for cleaning
+ *
+ * @return true if the command was inserted, false if the command buffer is full
  */
-inline void pushClearDepthCommand(
+[[nodiscard]] inline bool pushClearDepthCommand(
     CommandBuffer &cb           ,
     float          value = 2){
-  auto&cmd=cb.commands[cb.nofCommands];
-  cmd.type = CommandType::CLEAR_DEPTH;
-  auto&c = cmd.data.clearDepthCommand;
+  auto*cmd=reserveCommand(cb);
+  if(!cmd)return false;
+  cmd->type = CommandType::CLEAR_DEPTH;
+  auto&c = cmd->data.clearDepthCommand;
   c.value = value;
-  cb.nofCommands++;
+  return true;
 }
 
 /**
@@ -712,15 +731,18 @@ inline void pushClearDepthCommand(
  *
  * @param cb    command buffer
  * @param value clear stencil value for cleaning
+ *
+ * @return true if the command was inserted, false if the command buffer is full
  */
-inline void pushClearStencilCommand(
+[[nodiscard]] inline bool pushClearStencilCommand(
     CommandBuffer &cb        ,
     uint8_t        value = 0u){
-  auto&cmd=cb.commands[cb.nofCommands];
-  cmd.type = CommandType::CLEAR_STENCIL;
-  auto&c = cmd.data.clearStencilCommand;
+  auto*cmd=reserveCommand(cb);
+  if(!cmd)return false;
+  cmd->type = CommandType::CLEAR_STENCIL;
+  auto&c = cmd->data.clearStencilCommand;
   c.value = value;
-  cb.nofCommands++;
+  return true;
 }
 
 
@@ -729,15 +751,18 @@ inline void pushClearStencilCommand(
  *
  * @param cb command buffer
  * @param nofVertices number of vertices that should be rendered
+ *
+ * @return true if the command was inserted, false if the command buffer is full
  */
-inline void pushDrawCommand(
+[[nodiscard]] inline bool pushDrawCommand(
     CommandBuffer &cb                     ,
     uint32_t       nofVertices            ){
-  auto&cmd=cb.commands[cb.nofCommands];
-  cmd.type = CommandType::DRAW;
-  auto&c = cmd.data.drawCommand;
+  auto*cmd=reserveCommand(cb);
+  if(!cmd)return false;
+  cmd->type = CommandType::DRAW;
+  auto&c = cmd->data.drawCommand;
   c.nofVertices     = nofVertices    ;
-  cb.nofCommands++;
+  return true;
 }
 
 /**
@@ -745,13 +770,17 @@ inline void pushDrawCommand(
  *
  * @param cb command buffer
  * @param id id of framebuffer to bind
+ *
+ * @return true if the command was inserted, false if the command buffer is full
  */
-inline void pushBindFramebufferCommand(
+[[nodiscard]] inline bool pushBindFramebufferCommand(
     CommandBuffer&cb,
     uint32_t      id){
-  auto&cmd=cb.commands[cb.nofCommands++];
-  cmd.type = CommandType::BIND_FRAMEBUFFER;
-  cmd.data.bindFramebufferCommand.id = id;
+  auto*cmd=reserveCommand(cb);
+  if(!cmd)return false;
+  cmd->type = CommandType::BIND_FRAMEBUFFER;
+  cmd->data.bindFramebufferCommand.id = id;
+  return true;
 }
 
 /**
@@ -759,13 +788,17 @@ inline void pushBindFramebufferCommand(
  *
  * @param cb command buffer
  * @param id id of program
+ *
+ * @return true if the command was inserted, false if the command buffer is full
  */
-inline void pushBindProgramCommand(
+[[nodiscard]] inline bool pushBindProgramCommand(
     CommandBuffer&cb,
     uint32_t      id){
-  auto&cmd=cb.commands[cb.nofCommands++];
-  cmd.type = CommandType::BIND_PROGRAM;
-  cmd.data.bindProgramCommand.id = id;
+  auto*cmd=reserveCommand(cb);
+  if(!cmd)return false;
+  cmd->type = CommandType::BIND_PROGRAM;
+  cmd->data.bindProgramCommand.id = id;
+  return true;
 }
 
 /**
@@ -773,13 +806,17 @@ inline void pushBindProgramCommand(
  *
  * @param cb command buffer
  * @param id id of vertex array
+ *
+ * @return true if the command was inserted, false if the command buffer is full
  */
-inline void pushBindVertexArrayCommand(
+[[nodiscard]] inline bool pushBindVertexArrayCommand(
     CommandBuffer&cb,
     uint32_t      id){
-  auto&cmd=cb.commands[cb.nofCommands++];
-  cmd.type = CommandType::BIND_VERTEXARRAY;
-  cmd.data.bindVertexArrayCommand.id = id;
+  auto*cmd=reserveCommand(cb);
+  if(!cmd)return false;
+  cmd->type = CommandType::BIND_VERTEXARRAY;
+  cmd->data.bindVertexArrayCommand.id = id;
+  return true;
 }
 
 /**
@@ -787,13 +824,17 @@ inline void pushBindVertexArrayCommand(
  *
  * @param cb command buffer
  * @param id gl_DrawID
+ *
+ * @return true if the command was inserted, false if the command buffer is full
  */
-inline void pushSetDrawIdCommand(
+[[nodiscard]] inline bool pushSetDrawIdCommand(
     CommandBuffer&cb ,
     uint32_t      id){
-  auto&cmd=cb.commands[cb.nofCommands++];
-  cmd.type = CommandType::SET_DRAW_ID;
-  cmd.data.setDrawIdCommand.id = id;
+  auto*cmd=reserveCommand(cb);
+  if(!cmd)return false;
+  cmd->type = CommandType::SET_DRAW_ID;
+  cmd->data.setDrawIdCommand.id = id;
+  return true;
 }
 
 /**
@@ -801,13 +842,17 @@ inline void pushSetDrawIdCommand(
  *
  * @param cb  command buffer
  * @param sub pointer to sub command
+ *
+ * @return true if the command was inserted, false if the command buffer is full
  */
-inline void pushSubCommand(
+[[nodiscard]] inline bool pushSubCommand(
     CommandBuffer&cb ,
     CommandBuffer*sub){
-  auto&cmd=cb.commands[cb.nofCommands++];
-  cmd.type = CommandType::SUB_COMMAND;
-  cmd.data.subCommand.commandBuffer = sub;
+  auto*cmd=reserveCommand(cb);
+  if(!cmd)return false;
+  cmd->type = CommandType::SUB_COMMAND;
+  cmd->data.subCommand.commandBuffer = sub;
+  return true;
 }
 
 /**
@@ -815,13 +860,17 @@ inline void pushSubCommand(
  *
  * @param cb       command buffer
  * @param settings stencil settings
+ *
+ * @return true if the command was inserted, false if the command buffer is full
  */
-inline void pushSetStencilCommand(
+[[nodiscard]] inline bool pushSetStencilCommand(
     CommandBuffer        &cb      ,
     StencilSettings const&settings){
-  auto&cmd=cb.commands[cb.nofCommands++];
-  cmd.type = CommandType::SET_STENCIL_COMMAND;
-  cmd.data.setStencilCommand.settings = settings;
+  auto*cmd=reserveCommand(cb);
+  if(!cmd)return false;
+  cmd->type = CommandType::SET_STENCIL_COMMAND;
+  cmd->data.setStencilCommand.settings = settings;
+  return true;
 }
 
 /**
@@ -831,18 +880,22 @@ inline void pushSetStencilCommand(
  * @param blockColor   set blocking for color writes
  * @param blockDepth   set blocking for depth writes
  * @param blockStencil set blocking for stencil writes
+ *
+ * @return true if the command was inserted, false if the command buffer is full
  */
-inline void pushBlockWritesCommand(
+[[nodiscard]] inline bool pushBlockWritesCommand(
     CommandBuffer&      cb   ,
     bool blockColor   = false,
     bool blockDepth   = false,
     bool blockStencil = false){
-  auto&cmd=cb.commands[cb.nofCommands++];
-  cmd.type = CommandType::BLOCK_WRITES_COMMAND;
-  auto&d = cmd.data.blockWritesCommand;
+  auto*cmd=reserveCommand(cb);
+  if(!cmd)return false;
+  cmd->type = CommandType::BLOCK_WRITES_COMMAND;
+  auto&d = cmd->data.blockWritesCommand;
   d.blockWrites.color   = blockColor  ;
   d.blockWrites.depth   = blockDepth  ;
   d.blockWrites.stencil = blockStencil;
+  return true;
 }
 
 /**
@@ -850,14 +903,18 @@ inline void pushBlockWritesCommand(
  *
  * @param cb                  command buffer
  * @param enabled             is backface culling enabled?
+ *
+ * @return true if the command was inserted, false if the command buffer is full
  */
-inline void pushSetBackfaceCullingCommand(
+[[nodiscard]] inline bool pushSetBackfaceCullingCommand(
     CommandBuffer& cb                                 ,
     bool           enabled                     = false){
-  auto& cmd = cb.commands[cb.nofCommands++];
-  auto& d   = cmd.data.setBackfaceCullingCommand;
-  d.enabled = enabled                                  ;
-  cmd.type  = CommandType::SET_BACKFACE_CULLING_COMMAND;
+  auto*cmd=reserveCommand(cb);
+  if(!cmd)return false;
+  auto& d   = cmd->data.setBackfaceCullingCommand;
+  d   .enabled = enabled                                  ;
+  cmd->type    = CommandType::SET_BACKFACE_CULLING_COMMAND;
+  return true;
 }
 
 /**
@@ -865,14 +922,18 @@ inline void pushSetBackfaceCullingCommand(
  *
  * @param cb                          command buffer
  * @param frontFaceIsCounterClockWise is front face specified in counter clock wise order?
+ *
+ * @return true if the command was inserted, false if the command buffer is full
  */
-inline void pushSetFrontFaceCommand(
+[[nodiscard]] inline bool pushSetFrontFaceCommand(
     CommandBuffer& cb                                ,
     bool           frontFaceIsCounterClockWise = true){
-  auto& cmd = cb.commands[cb.nofCommands++];
-  auto& d   = cmd.data.setFrontFaceCommand;
-  d  .frontFaceIsCounterClockWise = frontFaceIsCounterClockWise        ;
-  cmd.type                        = CommandType::SET_FRONT_FACE_COMMAND;
+  auto*cmd=reserveCommand(cb);
+  if(!cmd)return false;
+  auto& d   = cmd->data.setFrontFaceCommand;
+  d   .frontFaceIsCounterClockWise = frontFaceIsCounterClockWise        ;
+  cmd->type                        = CommandType::SET_FRONT_FACE_COMMAND;
+  return true;
 }
 
 /**
@@ -881,13 +942,17 @@ inline void pushSetFrontFaceCommand(
  * @param cb   command buffer
  * @param fce  user command
  * @param data user data
+ *
+ * @return true if the command was inserted, false if the command buffer is full
  */
-inline void pushUserCommand(
+[[nodiscard]] inline bool pushUserCommand(
     CommandBuffer& cb            ,
     UserCommandFce fce  = nullptr,
     void*          data = nullptr){
-  auto&cmd=cb.commands[cb.nofCommands++];
-  cmd.type = CommandType::USER_COMMAND;
-  cmd.data.userCommand.callback = fce ;
-  cmd.data.userCommand.data     = data;
+  auto*cmd=reserveCommand(cb);
+  if(!cmd)return false;
+  cmd->type = CommandType::USER_COMMAND;
+  cmd->data.userCommand.callback = fce ;
+  cmd->data.userCommand.data     = data;
+  return true;
 }
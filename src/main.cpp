@@ -5,11 +5,17 @@
 #include<framework/application.hpp>
 #include<framework/arguments.hpp>
 #include<framework/systemSpecific.hpp>
+#include<framework/model.hpp>
 #include<tests/conformanceTests.hpp>
 #include<tests/performanceTest.hpp>
+#include<tests/benchmarkSuite.hpp>
+#include<tests/stageBenchmarks.hpp>
 #include<tests/takeScreenShot.hpp>
+#include<tests/headlessRender.hpp>
+#include<studentSolution/gpuSettings.hpp>
+#include<studentSolution/commandTrace.hpp>
 
-void mainBody(int argc,char*argv[]){
+int mainBody(int argc,char*argv[]){
   auto&args = ProgramContext::get().args = Arguments(argc,argv);
 
   extern TaskFunctions taskFunctions_teacher;
@@ -19,40 +25,99 @@ void mainBody(int argc,char*argv[]){
     *taskFunctions_teacher.lineToBreak = args.lineToBreak;
 
   if(args.stop)
-    return;
+    return EXIT_SUCCESS;
+
+  if(args.buildModelCache)
+    return buildModelCaches(args.modelFile) ? EXIT_SUCCESS : EXIT_FAILURE;
 
   if(args.runConformanceTests){
     runConformanceTests(args.modelFile,args.mseThreshold,args.selectedTest,args.upToTest);
-    return;
+    return EXIT_SUCCESS;
   }
 
+  //conformance tests record shader invocations, so they always use the default (serial) GPU settings
+  auto&gpuSettings = getGPUSettings();
+  gpuSettings.nofThreads         = args.threads;
+  gpuSettings.tileSize           = args.tileSize;
+  gpuSettings.tiledRasterization = args.tiled;
+  gpuSettings.simdRasterization  = !args.noSimd;
+  gpuSettings.hierarchicalRasterization = !args.noHierarchy;
+  gpuSettings.depthOnlyFragments        = !args.noDepthOnly;
+  gpuSettings.hierarchicalDepth         = args.hiZ;
+  gpuSettings.lazyAttributeInterpolation = !args.eagerInterpolation;
+  gpuSettings.quadShading               = args.quadShading;
+  gpuSettings.fixedPointRasterization   = args.fixedPoint;
+  gpuSettings.vertexCache               = args.vertexCache;
+  gpuSettings.batchedVertexStage        = args.batchedVertices;
+  gpuSettings.specializedFragmentOperations = !args.genericFragmentOps;
+  gpuSettings.deferredClears            = args.deferredClears;
+  gpuSettings.compiledCommandBuffers    = args.compiledCommands;
+  gpuSettings.pipelineTimings           = args.stats;
+  gpuSettings.textureFilter             = args.textureFilter == "trilinear" ? TextureFilter::TRILINEAR :
+                                          args.textureFilter == "bilinear"  ? TextureFilter::BILINEAR  : TextureFilter::NEAREST;
+  gpuSettings.textureLayout             = args.textureLayout == "tiled"     ? ImageLayout::TILED       : ImageLayout::LINEAR;
+
+  if(!args.traceFile.empty())
+    startCommandTrace(args.traceFile,args.traceFrames);
+
   if(args.runPerformanceTests){
     runPerformanceTest(args.perfTests);
-    return;
+    return EXIT_SUCCESS;
+  }
+
+  if(args.runStageBenchmarks)
+    return runStageBenchmarks(args.stageBenchmarks,args.benchSamples) ? EXIT_FAILURE : EXIT_SUCCESS;
+
+  if(args.runBenchmark){
+    BenchmarkOptions options;
+    options.sizes               = args.benchSizes    ;
+    options.warmupFrames        = args.benchWarmup   ;
+    options.frames              = args.benchFrames   ;
+    options.outputFile          = args.benchOutput   ;
+    options.baselineFile        = args.benchBaseline ;
+    options.regressionThreshold = args.benchThreshold;
+    options.filter              = args.benchFilter   ;
+    return runBenchmarkSuite(options) ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  if(args.headless){
+    HeadlessOptions options;
+    options.width      = static_cast<uint32_t>(args.windowSize[0]);
+    options.height     = static_cast<uint32_t>(args.windowSize[1]);
+    options.method     = args.method        ;
+    options.nofFrames  = args.headlessFrames;
+    options.output     = args.headlessOutput;
+    options.cameraPath = args.cameraPath    ;
+    return renderHeadless(options) ? EXIT_SUCCESS : EXIT_FAILURE;
   }
 
   if(args.takeScreenShot){
     takeScreenShot();
-    return;
+    return EXIT_SUCCESS;
   }
 
   auto app = Application(args.windowSize[0],args.windowSize[1]);
   app.setMethod(args.method);
   app.start();
+  return EXIT_SUCCESS;
 }
 
 int main(int argc,char*argv[]){
   //system specific initialization and deinitialization on object destructor
   auto system = System();
 
+  int result = EXIT_SUCCESS;
   try{
-    mainBody(argc,argv);
+    result = mainBody(argc,argv);
   }catch(std::exception&e){
     std::cerr << e.what() << std::endl;
   }
 
+  //writes the trace if it has fewer frames than requested
+  finishCommandTrace();
+
   Catch::cleanUp();
   ProgramContext::free();
-  return EXIT_SUCCESS;
+  return result;
 }
 
@@ -0,0 +1,333 @@
+/*!
+ * @file commandPlan.cpp
+ * @brief This file contains compiler of command buffer trees into flat execution plans.
+ *
+ * @author Jan kalina, xkalinj00@stud.fit.vutbr.cz
+ */
+
+#include <studentSolution/commandPlan.hpp>
+#include <studentSolution/gpuStatistics.hpp>
+#include <cstring>        // std::memcpy
+#include <unordered_map>  // std::unordered_map
+#include <unordered_set>  // std::unordered_set
+
+//! Maximal number of cached plans (the cache is emptied when it is full)
+constexpr size_t maxNofCachedPlans = 64;
+
+//! Parts of the GPU state tracked by the compiler
+enum PlanState {
+    PLAN_STATE_FRAMEBUFFER = 0,
+    PLAN_STATE_PROGRAM,
+    PLAN_STATE_VERTEX_ARRAY,
+    PLAN_STATE_BLOCK_WRITES,
+    PLAN_STATE_BACKFACE_CULLING,
+    PLAN_STATE_FRONT_FACE,
+    PLAN_STATE_STENCIL,
+    PLAN_STATE_DRAW_ID,
+    NOF_PLAN_STATES
+};
+
+/**
+ * @brief Working state of one compilation.
+ *
+ * @details The GPU state at the start of the run is not known (memory keeps
+ *          it between runs), so a state is known only after the plan sets it.
+ *          The only exception is `gl_DrawID`, which every run starts at 0.
+ */
+struct PlanCompiler {
+    CommandPlan &plan;                                ///< plan being built
+    std::unordered_set<const CommandBuffer*> sources; ///< buffers already fingerprinted
+    bool     isKnown[NOF_PLAN_STATES] = {};           ///< value of the state is known
+    Command  knownValue[NOF_PLAN_STATES];             ///< last command setting the state
+    int64_t  iUnusedSet[NOF_PLAN_STATES];             ///< plan index of a set nothing has read yet (-1 = none)
+    std::vector<CommandPosition> position;            ///< position in the source tree (root buffer first)
+    bool     hasClearRun = false;                     ///< clears are being collected
+    FoldedClear clearRun;                             ///< collected clears
+
+    explicit PlanCompiler(CommandPlan &plan) : plan(plan) {
+        for(auto &iSet : iUnusedSet) {
+            iSet = -1;
+        } // for(iSet)
+    }
+};
+
+static uint64_t hashCommands(const CommandBuffer &commandBuffer) {
+    // FNV-1a over 64-bit words, the bytes of unused union members are hashed
+    // as well - they do not change unless the buffer is written
+    const uint8_t *pBytes = reinterpret_cast<const uint8_t*>(commandBuffer.commands);
+    const size_t nofBytes = commandBuffer.nofCommands * sizeof(Command);
+
+    uint64_t hash = 1469598103934665603ull;
+    size_t iByte = 0;
+    for(; iByte + sizeof(uint64_t) <= nofBytes; iByte += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, pBytes + iByte, sizeof(word));
+        hash = (hash ^ word) * 1099511628211ull;
+    } // for(iByte)
+    for(; iByte < nofBytes; iByte++) {
+        hash = (hash ^ pBytes[iByte]) * 1099511628211ull;
+    } // for(iByte)
+
+    return hash;
+} // hashCommands()
+
+static bool isSameStencilOps(const StencilOps &a, const StencilOps &b) {
+    return a.sfail == b.sfail && a.dpfail == b.dpfail && a.dppass == b.dppass;
+} // isSameStencilOps()
+
+static bool isSameStateValue(const PlanState state, const CommandData &a, const CommandData &b) {
+    switch(state) {
+        case PLAN_STATE_FRAMEBUFFER:
+            return a.bindFramebufferCommand.id == b.bindFramebufferCommand.id;
+        case PLAN_STATE_PROGRAM:
+            return a.bindProgramCommand.id == b.bindProgramCommand.id;
+        case PLAN_STATE_VERTEX_ARRAY:
+            return a.bindVertexArrayCommand.id == b.bindVertexArrayCommand.id;
+        case PLAN_STATE_BLOCK_WRITES:
+            return a.blockWritesCommand.blockWrites.color == b.blockWritesCommand.blockWrites.color &&
+                   a.blockWritesCommand.blockWrites.depth == b.blockWritesCommand.blockWrites.depth &&
+                   a.blockWritesCommand.blockWrites.stencil == b.blockWritesCommand.blockWrites.stencil;
+        case PLAN_STATE_BACKFACE_CULLING:
+            return a.setBackfaceCullingCommand.enabled == b.setBackfaceCullingCommand.enabled;
+        case PLAN_STATE_FRONT_FACE:
+            return a.setFrontFaceCommand.frontFaceIsCounterClockWise == b.setFrontFaceCommand.frontFaceIsCounterClockWise;
+        case PLAN_STATE_STENCIL: {
+            const StencilSettings &sa = a.setStencilCommand.settings;
+            const StencilSettings &sb = b.setStencilCommand.settings;
+            return sa.enabled == sb.enabled && sa.func == sb.func && sa.refValue == sb.refValue &&
+                   isSameStencilOps(sa.frontOps, sb.frontOps) && isSameStencilOps(sa.backOps, sb.backOps);
+        }
+        case PLAN_STATE_DRAW_ID:
+            return a.setDrawIdCommand.id == b.setDrawIdCommand.id;
+        default:
+            return false;
+    } // switch(state)
+} // isSameStateValue()
+
+static bool getSetCommandState(const CommandType type, PlanState &state) {
+    switch(type) {
+        case CommandType::BIND_FRAMEBUFFER:             state = PLAN_STATE_FRAMEBUFFER;      return true;
+        case CommandType::BIND_PROGRAM:                 state = PLAN_STATE_PROGRAM;          return true;
+        case CommandType::BIND_VERTEXARRAY:             state = PLAN_STATE_VERTEX_ARRAY;     return true;
+        case CommandType::BLOCK_WRITES_COMMAND:         state = PLAN_STATE_BLOCK_WRITES;     return true;
+        case CommandType::SET_BACKFACE_CULLING_COMMAND: state = PLAN_STATE_BACKFACE_CULLING; return true;
+        case CommandType::SET_FRONT_FACE_COMMAND:       state = PLAN_STATE_FRONT_FACE;       return true;
+        case CommandType::SET_STENCIL_COMMAND:          state = PLAN_STATE_STENCIL;          return true;
+        case CommandType::SET_DRAW_ID:                  state = PLAN_STATE_DRAW_ID;          return true;
+        default:                                                                             return false;
+    } // switch(type)
+} // getSetCommandState()
+
+static void endClearRun(PlanCompiler &compiler) {
+    if(!compiler.hasClearRun) {
+        return;
+    }
+    compiler.hasClearRun = false;
+
+    const FoldedClear &run = compiler.clearRun;
+    const int nofCleared = static_cast<int>(run.clearColor) + static_cast<int>(run.clearDepth) + static_cast<int>(run.clearStencil);
+
+    PlanCommand planCommand;
+    if(nofCleared > 1) {
+        planCommand.iFoldedClear = static_cast<int32_t>(compiler.plan.foldedClears.size());
+        compiler.plan.foldedClears.push_back(run);
+    }
+    else if(run.clearColor) {
+        planCommand.command.type = CommandType::CLEAR_COLOR;
+        planCommand.command.data.clearColorCommand.value = run.color;
+    }
+    else if(run.clearDepth) {
+        planCommand.command.type = CommandType::CLEAR_DEPTH;
+        planCommand.command.data.clearDepthCommand.value = run.depth;
+    }
+    else {
+        planCommand.command.type = CommandType::CLEAR_STENCIL;
+        planCommand.command.data.clearStencilCommand.value = run.stencil;
+    }
+    compiler.plan.commands.push_back(planCommand);
+} // endClearRun()
+
+static void emitCommand(PlanCompiler &compiler, const Command &command) {
+    endClearRun(compiler);
+
+    PlanCommand planCommand;
+    planCommand.command = command;
+    compiler.plan.commands.push_back(planCommand);
+} // emitCommand()
+
+static void compileSetCommand(PlanCompiler &compiler, const PlanState state, const Command &command) {
+    // Setting the value the state already has has no effect
+    if(compiler.isKnown[state] && isSameStateValue(state, compiler.knownValue[state].data, command.data)) {
+        return;
+    }
+
+    // Previous value was overwritten before anything read it
+    if(compiler.iUnusedSet[state] >= 0) {
+        compiler.plan.commands[static_cast<size_t>(compiler.iUnusedSet[state])].command.type = CommandType::EMPTY;
+    }
+
+    emitCommand(compiler, command);
+    compiler.isKnown[state] = true;
+    compiler.knownValue[state] = command;
+    compiler.iUnusedSet[state] = static_cast<int64_t>(compiler.plan.commands.size() - 1);
+} // compileSetCommand()
+
+static void compileClearCommand(PlanCompiler &compiler, const Command &command) {
+    // Clear reads the bound framebuffer
+    compiler.iUnusedSet[PLAN_STATE_FRAMEBUFFER] = -1;
+
+    if(!compiler.hasClearRun) {
+        compiler.hasClearRun = true;
+        compiler.clearRun = FoldedClear{};
+    }
+
+    // Clears of different buffers are independent, the last clear of a buffer wins
+    FoldedClear &run = compiler.clearRun;
+    switch(command.type) {
+        case CommandType::CLEAR_COLOR:
+            run.clearColor = true;
+            run.color = command.data.clearColorCommand.value;
+            break;
+        case CommandType::CLEAR_DEPTH:
+            run.clearDepth = true;
+            run.depth = command.data.clearDepthCommand.value;
+            break;
+        default:
+            run.clearStencil = true;
+            run.stencil = command.data.clearStencilCommand.value;
+            break;
+    } // switch(type)
+} // compileClearCommand()
+
+static void compileCommandBuffer(PlanCompiler &compiler, const CommandBuffer &commandBuffer) {
+    // Every buffer of the tree is fingerprinted once, even if it is replayed many times
+    if(compiler.sources.insert(&commandBuffer).second) {
+        compiler.plan.sources.push_back(CommandBufferFingerprint{&commandBuffer, commandBuffer.nofCommands, hashCommands(commandBuffer)});
+    }
+
+    compiler.position.push_back(CommandPosition{&commandBuffer, 0});
+    for(uint32_t iCommand = 0; iCommand < commandBuffer.nofCommands; iCommand++) {
+        const Command &command = commandBuffer.commands[iCommand];
+        compiler.plan.nofSourceCommands++;
+        compiler.position.back().iCommand = iCommand;
+
+        PlanState state;
+        if(getSetCommandState(command.type, state)) {
+            compileSetCommand(compiler, state, command);
+            continue;
+        }
+
+        switch(command.type) {
+            case CommandType::CLEAR_COLOR:
+            case CommandType::CLEAR_DEPTH:
+            case CommandType::CLEAR_STENCIL:
+                compileClearCommand(compiler, command);
+                break;
+
+            case CommandType::SUB_COMMAND:
+                // Sub-command buffer is inlined
+                if(command.data.subCommand.commandBuffer) {
+                    compileCommandBuffer(compiler, *command.data.subCommand.commandBuffer);
+                }
+                break;
+
+            case CommandType::DRAW:
+                emitCommand(compiler, command);
+
+                // Draw reads all the state and increments the draw ID
+                for(auto &iSet : compiler.iUnusedSet) {
+                    iSet = -1;
+                } // for(iSet)
+                compiler.knownValue[PLAN_STATE_DRAW_ID].data.setDrawIdCommand.id++;
+                break;
+
+            case CommandType::USER_COMMAND:
+                emitCommand(compiler, command);
+
+                // Interpretation continues from here if the callback rewrites the tree
+                compiler.plan.commands.back().iResumePoint = static_cast<int32_t>(compiler.plan.resumePoints.size());
+                compiler.plan.resumePoints.push_back(compiler.position);
+
+                // User callback may read and modify anything in the memory
+                for(int iState = 0; iState < NOF_PLAN_STATES; iState++) {
+                    compiler.iUnusedSet[iState] = -1;
+                    compiler.isKnown[iState] = false;
+                } // for(iState)
+                break;
+
+            case CommandType::EMPTY:
+            default:
+                break;
+        } // switch(type)
+    } // for(iCommand)
+    compiler.position.pop_back();
+} // compileCommandBuffer()
+
+void compileCommandPlan(const CommandBuffer &commandBuffer, CommandPlan &plan) {
+    plan = CommandPlan{};
+    PlanCompiler compiler(plan);
+
+    // Every run starts with gl_DrawID = 0
+    compiler.isKnown[PLAN_STATE_DRAW_ID] = true;
+    compiler.knownValue[PLAN_STATE_DRAW_ID].type = CommandType::SET_DRAW_ID;
+    compiler.knownValue[PLAN_STATE_DRAW_ID].data.setDrawIdCommand.id = 0;
+
+    compileCommandBuffer(compiler, commandBuffer);
+    endClearRun(compiler);
+
+    // Remove overwritten state changes
+    size_t nofKept = 0;
+    for(const PlanCommand &planCommand : plan.commands) {
+        if(planCommand.iFoldedClear >= 0 || planCommand.command.type != CommandType::EMPTY) {
+            plan.commands[nofKept++] = planCommand;
+        }
+    } // for(planCommand)
+    plan.commands.resize(nofKept);
+} // compileCommandPlan()
+
+/******************************************************************************/
+/*                                PLAN CACHE                                  */
+/******************************************************************************/
+
+static std::unordered_map<const CommandBuffer*, CommandPlan> &getCommandPlanCache() {
+    static std::unordered_map<const CommandBuffer*, CommandPlan> cache;
+    return cache;
+} // getCommandPlanCache()
+
+bool isCommandPlanUpToDate(const CommandPlan &plan) {
+    for(const CommandBufferFingerprint &source : plan.sources) {
+        if(source.pCommandBuffer->nofCommands != source.nofCommands || hashCommands(*source.pCommandBuffer) != source.hash) {
+            return false;
+        }
+    } // for(source)
+    return true;
+} // isCommandPlanUpToDate()
+
+const CommandPlan &getCommandPlan(const CommandBuffer &commandBuffer) {
+    auto &cache = getCommandPlanCache();
+    CommandStatistics &statistics = getCommandStatistics();
+
+    const auto it = cache.find(&commandBuffer);
+    if(it != cache.end() && isCommandPlanUpToDate(it->second)) {
+        statistics.planCacheHits++;
+        return it->second;
+    }
+
+    if(it == cache.end() && cache.size() >= maxNofCachedPlans) {
+        cache.clear();
+    }
+
+    CommandPlan &plan = cache[&commandBuffer];
+    compileCommandPlan(commandBuffer, plan);
+
+    statistics.planCompilations++;
+    statistics.removedCommands += plan.nofSourceCommands - plan.commands.size();
+    statistics.foldedClears += plan.foldedClears.size();
+    return plan;
+} // getCommandPlan()
+
+void clearCommandPlanCache() {
+    getCommandPlanCache().clear();
+} // clearCommandPlanCache()
+
+/*** end of file commandPlan.cpp ***/
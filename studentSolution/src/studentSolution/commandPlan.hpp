@@ -0,0 +1,109 @@
+/*!
+ * @file commandPlan.hpp
+ * @brief This file contains compiler of command buffer trees into flat execution plans.
+ *
+ * @author Jan kalina, xkalinj00@stud.fit.vutbr.cz
+ */
+#pragma once
+
+#include <solutionInterface/gpu.hpp>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Consecutive clears of different buffers merged into one pass.
+ *
+ * @details Only the last clear of each buffer in the run is kept, clears of
+ *          different buffers do not depend on each other.
+ */
+struct FoldedClear {
+    bool      clearColor = false;    ///< color buffer is cleared
+    bool      clearDepth = false;    ///< depth buffer is cleared
+    bool      clearStencil = false;  ///< stencil buffer is cleared
+    glm::vec4 color = glm::vec4(0.f);///< clear color
+    float     depth = 0.f;           ///< clear depth
+    uint8_t   stencil = 0;           ///< clear stencil value
+};
+
+/**
+ * @brief Position of a command in a source command buffer.
+ */
+struct CommandPosition {
+    const CommandBuffer *pCommandBuffer = nullptr;  ///< source buffer
+    uint32_t iCommand = 0;                          ///< index of the command in the buffer
+};
+
+/**
+ * @brief One step of the execution plan.
+ */
+struct PlanCommand {
+    Command command;               ///< command executed by `handleCommand()` (if not a folded clear)
+    int32_t iFoldedClear = -1;     ///< index into `CommandPlan::foldedClears` or -1
+    int32_t iResumePoint = -1;     ///< index into `CommandPlan::resumePoints` (user commands) or -1
+};
+
+/**
+ * @brief Content of one source command buffer at the time of compilation.
+ */
+struct CommandBufferFingerprint {
+    const CommandBuffer *pCommandBuffer = nullptr;  ///< source buffer
+    uint32_t nofCommands = 0;                       ///< number of its commands
+    uint64_t hash = 0;                              ///< hash of its commands
+};
+
+/**
+ * @brief Flat execution plan of a command buffer tree.
+ *
+ * @details Sub-command buffers are inlined, state changes without effect are
+ *          dropped and runs of clears are folded. Executing the plan leaves the
+ *          GPU memory in the same state as executing the source tree.
+ *
+ *          A user command may rewrite any buffer of the tree while the plan
+ *          runs. The rest of the plan is executed only if the sources are still
+ *          unchanged after the callback returns, otherwise the source buffers are
+ *          interpreted from the position of the user command (`resumePoints`).
+ */
+struct CommandPlan {
+    std::vector<PlanCommand> commands;              ///< flat list of steps
+    std::vector<FoldedClear> foldedClears;          ///< merged clears
+    std::vector<std::vector<CommandPosition>> resumePoints; ///< source positions of user commands (root buffer first)
+    std::vector<CommandBufferFingerprint> sources;  ///< all buffers of the tree (each once)
+    uint32_t nofSourceCommands = 0;                 ///< commands executed by the source tree
+};
+
+/**
+ * @brief Compiles a command buffer tree into a flat execution plan.
+ *
+ * @param commandBuffer Root command buffer.
+ * @param plan Output plan (previous content is replaced).
+ */
+void compileCommandPlan(const CommandBuffer &commandBuffer, CommandPlan &plan);
+
+/**
+ * @brief Checks that no source buffer of the plan has been modified since its compilation.
+ *
+ * @param plan Compiled plan.
+ *
+ * @return `true` if all source buffers contain the compiled commands.
+ */
+bool isCommandPlanUpToDate(const CommandPlan &plan);
+
+/**
+ * @brief Returns the cached plan of the command buffer tree.
+ *
+ * @details The plan is compiled again whenever any buffer of the tree has
+ *          been modified since the last compilation (checked by hashing the
+ *          commands of all source buffers).
+ *
+ * @param commandBuffer Root command buffer.
+ *
+ * @return `const CommandPlan&` Up-to-date plan (valid until the next call).
+ */
+const CommandPlan &getCommandPlan(const CommandBuffer &commandBuffer);
+
+/**
+ * @brief Removes all cached plans.
+ */
+void clearCommandPlanCache();
+
+/*** end of file commandPlan.hpp ***/
@@ -0,0 +1,171 @@
+/*!
+ * @file commandStream.cpp
+ * @brief This file contains growable command stream stored in an arena.
+ *
+ * @author Jan kalina, xkalinj00@stud.fit.vutbr.cz
+ */
+
+#include <studentSolution/commandStream.hpp>
+#include <cstring>  // std::memcpy
+
+CommandStream::CommandStream(const size_t maxNofBytes) : maxNofBytes(maxNofBytes) {
+} // CommandStream()
+
+bool CommandStream::pushRecord(const uint16_t type, const void *pPayload, const size_t payloadSize) {
+    // Records are padded, so the next header (and payload) stays aligned
+    const size_t recordSize = (sizeof(CommandRecordHeader) + payloadSize + commandRecordAlignment - 1) /
+                              commandRecordAlignment * commandRecordAlignment;
+    if(maxNofBytes && nofBytes + recordSize > maxNofBytes) {
+        return false;
+    }
+
+    // Start a new chunk if the record does not fit into the current one
+    if(nofUsedChunks == 0 || chunks[nofUsedChunks - 1].nofBytes + recordSize > chunkSize) {
+        if(nofUsedChunks == chunks.size()) {
+            chunks.push_back(Chunk{std::unique_ptr<uint8_t[]>(new uint8_t[chunkSize]), 0});
+        }
+        chunks[nofUsedChunks++].nofBytes = 0;
+    }
+
+    Chunk &chunk = chunks[nofUsedChunks - 1];
+    uint8_t *pRecord = chunk.data.get() + chunk.nofBytes;
+
+    CommandRecordHeader header;
+    header.type = type;
+    header.nofBytes = static_cast<uint16_t>(recordSize);
+    std::memcpy(pRecord, &header, sizeof(header));
+    std::memcpy(pRecord + sizeof(header), pPayload, payloadSize);
+
+    chunk.nofBytes += recordSize;
+    nofBytes += recordSize;
+    nofCommands++;
+    return true;
+} // pushRecord()
+
+bool CommandStream::pushSubStream(const CommandStream *pSubStream) {
+    return pushRecord(subStreamRecordType, &pSubStream, sizeof(pSubStream));
+} // pushSubStream()
+
+void CommandStream::reset() {
+    // Chunks stay allocated, recording the same frame again does not allocate
+    nofUsedChunks = 0;
+    nofBytes = 0;
+    nofCommands = 0;
+} // reset()
+
+uint32_t CommandStream::getNofCommands() const {
+    return nofCommands;
+} // getNofCommands()
+
+size_t CommandStream::getNofBytes() const {
+    return nofBytes;
+} // getNofBytes()
+
+size_t CommandStream::getNofAllocatedBytes() const {
+    return chunks.size() * chunkSize;
+} // getNofAllocatedBytes()
+
+const CommandStream::Chunk *CommandStream::getChunks() const {
+    return chunks.data();
+} // getChunks()
+
+size_t CommandStream::getNofUsedChunks() const {
+    return nofUsedChunks;
+} // getNofUsedChunks()
+
+/******************************************************************************/
+/*                              PUSH HELPERS                                  */
+/******************************************************************************/
+
+bool pushClearColorCommand(CommandStream &cs, const glm::vec4 &value) {
+    ClearColorCommand command;
+    command.value = value;
+    return cs.push(CommandType::CLEAR_COLOR, command);
+} // pushClearColorCommand()
+
+bool pushClearDepthCommand(CommandStream &cs, const float value) {
+    ClearDepthCommand command;
+    command.value = value;
+    return cs.push(CommandType::CLEAR_DEPTH, command);
+} // pushClearDepthCommand()
+
+bool pushClearStencilCommand(CommandStream &cs, const uint8_t value) {
+    ClearStencilCommand command;
+    command.value = value;
+    return cs.push(CommandType::CLEAR_STENCIL, command);
+} // pushClearStencilCommand()
+
+bool pushDrawCommand(CommandStream &cs, const uint32_t nofVertices) {
+    DrawCommand command;
+    command.nofVertices = nofVertices;
+    return cs.push(CommandType::DRAW, command);
+} // pushDrawCommand()
+
+bool pushBindFramebufferCommand(CommandStream &cs, const uint32_t id) {
+    BindFramebufferCommand command;
+    command.id = id;
+    return cs.push(CommandType::BIND_FRAMEBUFFER, command);
+} // pushBindFramebufferCommand()
+
+bool pushBindProgramCommand(CommandStream &cs, const uint32_t id) {
+    BindProgramCommand command;
+    command.id = id;
+    return cs.push(CommandType::BIND_PROGRAM, command);
+} // pushBindProgramCommand()
+
+bool pushBindVertexArrayCommand(CommandStream &cs, const uint32_t id) {
+    BindVertexArrayCommand command;
+    command.id = id;
+    return cs.push(CommandType::BIND_VERTEXARRAY, command);
+} // pushBindVertexArrayCommand()
+
+bool pushSetDrawIdCommand(CommandStream &cs, const uint32_t id) {
+    SetDrawIdCommand command;
+    command.id = id;
+    return cs.push(CommandType::SET_DRAW_ID, command);
+} // pushSetDrawIdCommand()
+
+bool pushSubCommand(CommandStream &cs, CommandBuffer *sub) {
+    SubCommand command;
+    command.commandBuffer = sub;
+    return cs.push(CommandType::SUB_COMMAND, command);
+} // pushSubCommand()
+
+bool pushSubCommand(CommandStream &cs, const CommandStream *sub) {
+    return cs.pushSubStream(sub);
+} // pushSubCommand()
+
+bool pushSetStencilCommand(CommandStream &cs, const StencilSettings &settings) {
+    SetStencilCommand command;
+    command.settings = settings;
+    return cs.push(CommandType::SET_STENCIL_COMMAND, command);
+} // pushSetStencilCommand()
+
+bool pushBlockWritesCommand(CommandStream &cs, const bool blockColor, const bool blockDepth, const bool blockStencil) {
+    BlockWritesCommand command;
+    command.blockWrites.color = blockColor;
+    command.blockWrites.depth = blockDepth;
+    command.blockWrites.stencil = blockStencil;
+    return cs.push(CommandType::BLOCK_WRITES_COMMAND, command);
+} // pushBlockWritesCommand()
+
+bool pushSetBackfaceCullingCommand(CommandStream &cs, const bool enabled) {
+    SetBackfaceCullingCommand command;
+    command.enabled = enabled;
+    return cs.push(CommandType::SET_BACKFACE_CULLING_COMMAND, command);
+} // pushSetBackfaceCullingCommand()
+
+bool pushSetFrontFaceCommand(CommandStream &cs, const bool frontFaceIsCounterClockWise) {
+    SetFrontFaceCommand command;
+    command.frontFaceIsCounterClockWise = frontFaceIsCounterClockWise;
+    return cs.push(CommandType::SET_FRONT_FACE_COMMAND, command);
+} // pushSetFrontFaceCommand()
+
+bool pushUserCommand(CommandStream &cs, const UserCommandFce fce, void *data) {
+    UserCommand command;
+    command.callback = fce;
+    command.data = data;
+    return cs.push(CommandType::USER_COMMAND, command);
+} // pushUserCommand()
+
+/*** end of file commandStream.cpp ***/
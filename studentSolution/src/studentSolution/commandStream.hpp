@@ -0,0 +1,141 @@
+/*!
+ * @file commandStream.hpp
+ * @brief This file contains growable command stream stored in an arena.
+ *
+ * @author Jan kalina, xkalinj00@stud.fit.vutbr.cz
+ */
+#pragma once
+
+#include <solutionInterface/gpu.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+//! Record type of a sub-stream (outside of the `CommandType` range)
+constexpr uint16_t subStreamRecordType = 0x100;
+
+//! Alignment of every record and of its payload
+constexpr uint32_t commandRecordAlignment = 8;
+
+/**
+ * @brief Header of one packed command record.
+ *
+ * @details The payload (only the data of the given command type, not the
+ *          whole `CommandData` union) follows right after the header.
+ */
+struct alignas(commandRecordAlignment) CommandRecordHeader {
+    uint16_t type = 0;      ///< `CommandType` or `subStreamRecordType`
+    uint16_t nofBytes = 0;  ///< size of the whole record including the header
+};
+
+/**
+ * @brief Growable replacement of `CommandBuffer`.
+ *
+ * @details Commands are stored as variable-size records in fixed-size arena
+ *          chunks. New chunks are allocated when the stream grows, so records
+ *          never move and a record never crosses a chunk boundary. Executing
+ *          the stream does not modify it, so the same stream can be replayed
+ *          every frame. `reset()` keeps the chunks for the next recording.
+ */
+class CommandStream {
+    public:
+        //! Size of one arena chunk in bytes
+        static constexpr size_t chunkSize = 64 * 1024;
+
+        //! One arena chunk
+        struct Chunk {
+            std::unique_ptr<uint8_t[]> data;  ///< chunkSize bytes
+            size_t nofBytes = 0;              ///< number of used bytes
+        };
+
+        /**
+         * @brief Creates an empty stream.
+         *
+         * @param maxNofBytes Capacity limit of the stream (0 = no limit).
+         */
+        explicit CommandStream(size_t maxNofBytes = 0);
+
+        /**
+         * @brief Appends one command record.
+         *
+         * @param type Command type.
+         * @param payload Data of the command type (e.g. `DrawCommand`).
+         *
+         * @return `bool` False if the capacity limit would be exceeded.
+         */
+        template<typename Payload>
+        [[nodiscard]] bool push(CommandType type, const Payload &payload) {
+            return pushRecord(static_cast<uint16_t>(type), &payload, sizeof(Payload));
+        }
+
+        /**
+         * @brief Appends execution of another stream (like `SUB_COMMAND`).
+         *
+         * @param pSubStream Stream to be executed, `nullptr` is ignored by the GPU.
+         *
+         * @return `bool` False if the capacity limit would be exceeded.
+         */
+        [[nodiscard]] bool pushSubStream(const CommandStream *pSubStream);
+
+        /**
+         * @brief Removes all commands, allocated chunks are kept for reuse.
+         */
+        void reset();
+
+        /**
+         * @brief Returns number of recorded commands.
+         */
+        uint32_t getNofCommands() const;
+
+        /**
+         * @brief Returns number of bytes used by the recorded commands.
+         */
+        size_t getNofBytes() const;
+
+        /**
+         * @brief Returns number of bytes allocated by the arena.
+         */
+        size_t getNofAllocatedBytes() const;
+
+        /**
+         * @brief Returns the used chunks (in recording order).
+         */
+        const Chunk *getChunks() const;
+
+        /**
+         * @brief Returns number of used chunks.
+         */
+        size_t getNofUsedChunks() const;
+
+    private:
+        bool pushRecord(uint16_t type, const void *pPayload, size_t payloadSize);
+
+        std::vector<Chunk> chunks;     ///< allocated chunks (used ones first)
+        size_t nofUsedChunks = 0;      ///< number of chunks containing records
+        size_t nofBytes = 0;           ///< bytes of all records
+        size_t maxNofBytes = 0;        ///< capacity limit (0 = no limit)
+        uint32_t nofCommands = 0;      ///< number of records
+};
+
+/*
+ * Same helpers as for `CommandBuffer` - they return false when the capacity
+ * limit of the stream is reached (a stream without a limit only grows).
+ */
+[[nodiscard]] bool pushClearColorCommand(CommandStream &cs, const glm::vec4 &value = glm::vec4(0));
+[[nodiscard]] bool pushClearDepthCommand(CommandStream &cs, float value = 2);
+[[nodiscard]] bool pushClearStencilCommand(CommandStream &cs, uint8_t value = 0u);
+[[nodiscard]] bool pushDrawCommand(CommandStream &cs, uint32_t nofVertices);
+[[nodiscard]] bool pushBindFramebufferCommand(CommandStream &cs, uint32_t id);
+[[nodiscard]] bool pushBindProgramCommand(CommandStream &cs, uint32_t id);
+[[nodiscard]] bool pushBindVertexArrayCommand(CommandStream &cs, uint32_t id);
+[[nodiscard]] bool pushSetDrawIdCommand(CommandStream &cs, uint32_t id);
+[[nodiscard]] bool pushSubCommand(CommandStream &cs, CommandBuffer *sub);
+[[nodiscard]] bool pushSubCommand(CommandStream &cs, const CommandStream *sub);
+[[nodiscard]] bool pushSetStencilCommand(CommandStream &cs, const StencilSettings &settings);
+[[nodiscard]] bool pushBlockWritesCommand(CommandStream &cs, bool blockColor = false, bool blockDepth = false, bool blockStencil = false);
+[[nodiscard]] bool pushSetBackfaceCullingCommand(CommandStream &cs, bool enabled = false);
+[[nodiscard]] bool pushSetFrontFaceCommand(CommandStream &cs, bool frontFaceIsCounterClockWise = true);
+[[nodiscard]] bool pushUserCommand(CommandStream &cs, UserCommandFce fce = nullptr, void *data = nullptr);
+
+/*** end of file commandStream.hpp ***/
@@ -0,0 +1,154 @@
+/*!
+ * @file commandTrace.cpp
+ * @brief This file contains recorder of the command execution timeline
+ *        (Chrome trace event format, viewable in chrome://tracing or Perfetto).
+ *
+ * @author Jan kalina, xkalinj00@stud.fit.vutbr.cz
+ */
+
+#include <studentSolution/commandTrace.hpp>
+#include <algorithm>  // std::max
+#include <atomic>
+#include <chrono>     // std::chrono::steady_clock
+#include <fstream>
+#include <iomanip>    // std::setprecision
+#include <iostream>   // std::cerr
+#include <mutex>
+
+/**
+ * @brief State of the recorded trace.
+ *
+ * @details Spans are added from all rasterization threads, but only a few
+ *          of them per command or tile, so one mutex is enough.
+ */
+struct CommandTrace {
+    std::atomic<bool>       isActive{false};  ///< recording is running
+    std::mutex              mutex;            ///< guards the members below
+    std::string             fileName;         ///< output file
+    uint32_t                maxNofFrames = 0; ///< frames to record (0 = until finished)
+    uint32_t                nofFrames = 0;    ///< frames recorded so far
+    std::vector<TraceSpan>  spans;            ///< recorded spans
+    std::chrono::steady_clock::time_point startTime;///< origin of the span times
+};
+
+static CommandTrace commandTrace;
+
+void startCommandTrace(const std::string &fileName, const uint32_t maxNofFrames) {
+    std::lock_guard<std::mutex> lock(commandTrace.mutex);
+    commandTrace.fileName = fileName;
+    commandTrace.maxNofFrames = maxNofFrames;
+    commandTrace.nofFrames = 0;
+    commandTrace.spans.clear();
+    commandTrace.startTime = std::chrono::steady_clock::now();
+    commandTrace.isActive = true;
+} // startCommandTrace()
+
+// Writes one span as a JSON event, times are in microseconds
+static void writeTraceSpan(std::ostream &stream, const TraceSpan &span) {
+    stream << "{\"name\":\"" << span.name << "\",\"cat\":\"" << span.category << "\",\"ph\":\"X\",\"pid\":1"
+           << ",\"tid\":" << span.track
+           << ",\"ts\":" << static_cast<double>(span.startTime) / 1000.0
+           << ",\"dur\":" << static_cast<double>(span.duration) / 1000.0;
+
+    if(span.argumentNames[0]) {
+        stream << ",\"args\":{\"" << span.argumentNames[0] << "\":" << span.argumentValues[0];
+        if(span.argumentNames[1]) {
+            stream << ",\"" << span.argumentNames[1] << "\":" << span.argumentValues[1];
+        }
+        stream << "}";
+    }
+    stream << "}";
+} // writeTraceSpan()
+
+bool finishCommandTrace() {
+    std::lock_guard<std::mutex> lock(commandTrace.mutex);
+    if(!commandTrace.isActive) {
+        return true;
+    }
+    commandTrace.isActive = false;
+
+    std::ofstream file(commandTrace.fileName);
+    if(!file) {
+        std::cerr << "command trace: cannot write " << commandTrace.fileName << std::endl;
+        return false;
+    }
+
+    // Every track gets a name, the track of the calling thread first
+    uint32_t nofTracks = 1;
+    for(const TraceSpan &span : commandTrace.spans) {
+        nofTracks = std::max(nofTracks, span.track + 1);
+    } // for(span)
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for(uint32_t iTrack = 0; iTrack < nofTracks; iTrack++) {
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << iTrack
+             << ",\"args\":{\"name\":\"" << (iTrack ? "worker " : "gpu ") << iTrack << "\"}},\n";
+    } // for(iTrack)
+    for(size_t iSpan = 0; iSpan < commandTrace.spans.size(); iSpan++) {
+        writeTraceSpan(file, commandTrace.spans[iSpan]);
+        file << (iSpan + 1 < commandTrace.spans.size() ? ",\n" : "\n");
+    } // for(iSpan)
+    file << "]}\n";
+
+    commandTrace.spans.clear();
+    commandTrace.spans.shrink_to_fit();
+    return static_cast<bool>(file);
+} // finishCommandTrace()
+
+bool isCommandTraceActive() {
+    return commandTrace.isActive.load(std::memory_order_relaxed);
+} // isCommandTraceActive()
+
+uint64_t readTraceClock() {
+    const auto elapsed = std::chrono::steady_clock::now() - commandTrace.startTime;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+} // readTraceClock()
+
+void addTraceSpan(const TraceSpan &span) {
+    std::lock_guard<std::mutex> lock(commandTrace.mutex);
+    if(commandTrace.isActive) {
+        commandTrace.spans.push_back(span);
+    }
+} // addTraceSpan()
+
+void endTraceFrame() {
+    bool isLastFrame;
+    {
+        std::lock_guard<std::mutex> lock(commandTrace.mutex);
+        commandTrace.nofFrames++;
+        isLastFrame = commandTrace.maxNofFrames && commandTrace.nofFrames >= commandTrace.maxNofFrames;
+    }
+
+    if(isLastFrame) {
+        finishCommandTrace();
+    }
+} // endTraceFrame()
+
+std::vector<TraceSpan> getTraceSpans() {
+    std::lock_guard<std::mutex> lock(commandTrace.mutex);
+    return commandTrace.spans;
+} // getTraceSpans()
+
+const char *getCommandTypeName(const CommandType type) {
+    switch(type) {
+        case CommandType::BIND_FRAMEBUFFER:             return "BIND_FRAMEBUFFER";
+        case CommandType::BIND_PROGRAM:                 return "BIND_PROGRAM";
+        case CommandType::BIND_VERTEXARRAY:             return "BIND_VERTEXARRAY";
+        case CommandType::BLOCK_WRITES_COMMAND:         return "BLOCK_WRITES";
+        case CommandType::SET_BACKFACE_CULLING_COMMAND: return "SET_BACKFACE_CULLING";
+        case CommandType::SET_FRONT_FACE_COMMAND:       return "SET_FRONT_FACE";
+        case CommandType::SET_STENCIL_COMMAND:          return "SET_STENCIL";
+        case CommandType::SET_DRAW_ID:                  return "SET_DRAW_ID";
+        case CommandType::USER_COMMAND:                 return "USER_COMMAND";
+        case CommandType::CLEAR_COLOR:                  return "CLEAR_COLOR";
+        case CommandType::CLEAR_DEPTH:                  return "CLEAR_DEPTH";
+        case CommandType::CLEAR_STENCIL:                return "CLEAR_STENCIL";
+        case CommandType::DRAW:                         return "DRAW";
+        case CommandType::SUB_COMMAND:                  return "SUB_COMMAND";
+        case CommandType::EMPTY:
+        default:                                        return "EMPTY";
+    } // switch(type)
+} // getCommandTypeName()
+
+/*** end of file commandTrace.cpp ***/
@@ -0,0 +1,91 @@
+/*!
+ * @file commandTrace.hpp
+ * @brief This file contains recorder of the command execution timeline
+ *        (Chrome trace event format, viewable in chrome://tracing or Perfetto).
+ *
+ * @author Jan kalina, xkalinj00@stud.fit.vutbr.cz
+ */
+#pragma once
+
+#include <solutionInterface/gpu.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One span of the timeline (complete event of the trace format).
+ *
+ * @details Spans of one track are nested by their times, so a span of a
+ *          sub-command encloses spans of its commands.
+ */
+struct TraceSpan {
+    const char *name = "";                          ///< name of the span (static string)
+    const char *category = "";                      ///< category of the span (static string)
+    uint64_t    startTime = 0;                      ///< start [ns since the start of the trace]
+    uint64_t    duration = 0;                       ///< duration [ns]
+    uint32_t    track = 0;                          ///< worker index (0 = thread calling `student_GPU_run()`)
+    const char *argumentNames[2] = {nullptr, nullptr};///< names of integer arguments (nullptr = unused)
+    int64_t     argumentValues[2] = {0, 0};         ///< values of integer arguments
+};
+
+/**
+ * @brief Starts recording of the timeline.
+ *
+ * @details The file is written by `finishCommandTrace()` or automatically
+ *          after `maxNofFrames` calls of `student_GPU_run()`.
+ *
+ * @param fileName Output JSON file.
+ * @param maxNofFrames Number of recorded frames (0 = until finished).
+ */
+void startCommandTrace(const std::string &fileName, uint32_t maxNofFrames);
+
+/**
+ * @brief Writes the recorded timeline (if recording) and stops recording.
+ *
+ * @return `bool` False if the file could not be written.
+ */
+bool finishCommandTrace();
+
+/**
+ * @brief Checks whether the timeline is being recorded.
+ *
+ * @return `bool` True between start and finish of the trace.
+ */
+bool isCommandTraceActive();
+
+/**
+ * @brief Reads the clock of the trace.
+ *
+ * @return `uint64_t` Nanoseconds since the start of the trace.
+ */
+uint64_t readTraceClock();
+
+/**
+ * @brief Adds a finished span (thread-safe).
+ *
+ * @param span The span.
+ */
+void addTraceSpan(const TraceSpan &span);
+
+/**
+ * @brief Marks the end of a frame, the trace is written after the last recorded frame.
+ */
+void endTraceFrame();
+
+/**
+ * @brief Returns copy of the spans recorded so far.
+ *
+ * @return `std::vector<TraceSpan>` Recorded spans (in order of their end).
+ */
+std::vector<TraceSpan> getTraceSpans();
+
+/**
+ * @brief Returns name of the command type used in the timeline.
+ *
+ * @param type The type of the command.
+ *
+ * @return `const char*` Name of the type (e.g. "DRAW").
+ */
+const char *getCommandTypeName(CommandType type);
+
+/*** end of file commandTrace.hpp ***/
@@ -0,0 +1,43 @@
+/*!
+ * @file fragmentShaderTraits.cpp
+ * @brief This file contains properties of fragment shaders the pipeline can rely on.
+ *
+ * @author Jan kalina, xkalinj00@stud.fit.vutbr.cz
+ */
+
+#include <studentSolution/fragmentShaderTraits.hpp>
+#include <mutex>          // std::mutex, std::lock_guard
+#include <unordered_set>  // std::unordered_set
+
+//! Fragment shaders declared color-only
+struct FragmentShaderTraitsRegistry {
+    std::mutex mutex;
+    std::unordered_set<FragmentShader> colorOnlyShaders;
+};
+
+static FragmentShaderTraitsRegistry &getFragmentShaderTraitsRegistry() {
+    // Function-local static, so shaders can be declared during static initialization
+    static FragmentShaderTraitsRegistry registry;
+    return registry;
+} // getFragmentShaderTraitsRegistry()
+
+void declareColorOnlyFragmentShader(const FragmentShader fragmentShader, const bool isColorOnly) {
+    FragmentShaderTraitsRegistry &registry = getFragmentShaderTraitsRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    if(isColorOnly) {
+        registry.colorOnlyShaders.insert(fragmentShader);
+    }
+    else {
+        registry.colorOnlyShaders.erase(fragmentShader);
+    }
+} // declareColorOnlyFragmentShader()
+
+bool isColorOnlyFragmentShader(const FragmentShader fragmentShader) {
+    FragmentShaderTraitsRegistry &registry = getFragmentShaderTraitsRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    return registry.colorOnlyShaders.count(fragmentShader) != 0;
+} // isColorOnlyFragmentShader()
+
+/*** end of file fragmentShaderTraits.cpp ***/
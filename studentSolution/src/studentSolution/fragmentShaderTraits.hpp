@@ -0,0 +1,36 @@
+/*!
+ * @file fragmentShaderTraits.hpp
+ * @brief This file contains properties of fragment shaders the pipeline can rely on.
+ *
+ * @author Jan kalina, xkalinj00@stud.fit.vutbr.cz
+ */
+#pragma once
+
+#include <solutionInterface/gpu.hpp>
+
+/**
+ * @brief Declares that a fragment shader only computes `gl_FragColor`.
+ *
+ * @details Such shader never sets `discard` and has no side effects (it
+ *          writes no memory and does not ask for attribute derivatives).
+ *          Draws that write no color (no color buffer or blocked color
+ *          writes) then use the depth-only path, which neither interpolates
+ *          the attributes nor calls the shader. `Program` only holds the
+ *          function pointer, so the declaration is found by it. Passing
+ *          `false` removes the declaration again.
+ *
+ * @param fragmentShader Fragment shader stored in `Program`.
+ * @param isColorOnly Whether the shader only computes `gl_FragColor`.
+ */
+void declareColorOnlyFragmentShader(FragmentShader fragmentShader, bool isColorOnly = true);
+
+/**
+ * @brief Checks whether a fragment shader was declared color-only.
+ *
+ * @param fragmentShader Fragment shader stored in `Program`.
+ *
+ * @return `bool` True if `declareColorOnlyFragmentShader()` declared it.
+ */
+bool isColorOnlyFragmentShader(FragmentShader fragmentShader);
+
+/*** end of file fragmentShaderTraits.hpp ***/
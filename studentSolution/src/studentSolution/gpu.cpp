@@ -7,7 +7,17 @@
  */
 
 #include <studentSolution/gpu.hpp>
+#include <studentSolution/gpuSettings.hpp>
+#include <studentSolution/gpuStatistics.hpp>
+#include <studentSolution/commandTrace.hpp>
+#include <studentSolution/shaderFunctions.hpp>
+#include <studentSolution/threadPool.hpp>
+#include <studentSolution/simd.hpp>
 #include <algorithm>  // std::min, std::max, std::fabs
+#include <chrono>     // std::chrono::steady_clock
+#include <cmath>      // std::llround
+#include <cstring>    // std::memcpy
+#include <limits>     // std::numeric_limits
 
 /*
  * When implementing this part of the project, I maximally based my code on the
@@ -40,6 +50,8 @@
 #define XKALINJ00_GPU_SOLUTION
 
 void executeCommandBuffer(GPUMemory &memory, const CommandBuffer &commandBuffer);
+void executeCommandStream(GPUMemory &memory, const CommandStream &commandStream);
+void executeCommandPlan(GPUMemory &memory, const CommandPlan &plan);
 void handleCommand(GPUMemory &memory, CommandType type, const CommandData &data);
 void handleBindFramebufferCommand(GPUMemory &memory, const CommandData &commandData);
 void handleBindProgramCommand(GPUMemory &memory, const CommandData &commandData);
@@ -53,19 +65,71 @@ void handleClearColorCommand(const GPUMemory &memory, const ClearColorCommand &c
 void handleClearDepthCommand(const GPUMemory &memory, const ClearDepthCommand &clearDepthCommand);
 void handleClearStencilCommand(const GPUMemory &memory, const ClearStencilCommand &clearStencilCommand);
 void handleUserCommand(const UserCommand &userCommand);
+bool packClearColor(const Image &image, const glm::vec4 &color, ClearValue &clearValue);
+bool packClearValue(const Image &image, const void *pValue, uint32_t valueSize, ClearValue &clearValue);
+void fillPixels(uint8_t *pDestination, const ClearValue &clearValue, size_t nofPixels);
+void fillImageRegion(const Image &image, const ClearValue &clearValue, const ScreenRegion &region, uint32_t height, bool yReversed);
+void clearAttachment(const Framebuffer &frameBuffer, ClearAttachment attachment, const ClearValue &clearValue);
+bool doesCommandRequireClearResolve(CommandType type);
+bool hasPendingDeferredClears();
+void resolveDeferredClears(const ScreenRegion &region);
+void resolveDeferredClearsOfTriangle(const glm::vec3 vertices[3], const Framebuffer &frameBuffer);
+void resolveAllDeferredClears();
+void handleFoldedClear(GPUMemory &memory, const FoldedClear &foldedClear);
 void handleDrawCommand(GPUMemory &memory, const DrawCommand &drawCommand);
 void handleSubCommand(GPUMemory &memory, const CommandBuffer *pSubCommandBuffer);
 uint32_t getVertexIndex(const GPUMemory &memory, uint32_t vertexIndex);
 void vertexAssemblyUnit(const GPUMemory &memory, InVertex &inVertex);
+bool isVertexCacheUsable(const GPUMemory &memory);
+void beginVertexCacheDraw();
+bool fetchCachedVertex(uint32_t vertexID, OutVertex &outVertex);
+void storeCachedVertex(uint32_t vertexID, const OutVertex &outVertex);
+void setupVertexFetcher(const GPUMemory &memory, VertexFetcher &fetcher);
+uint32_t fetchVertexIndex(const VertexFetcher &fetcher, uint32_t vertexIndex);
+void runBatchedVertexStage(const Program &program, const ShaderInterface &shaderInterface, const VertexFetcher &fetcher, BatchVertexShader batchVertexShader,
+                           uint32_t firstVertex, uint32_t nofVertices, bool useVertexCache, OutVertex outVertices[], uint64_t &nofCacheHits, uint64_t &nofCacheMisses);
+void processTriangle(const GPUMemory &memory, const Program &program, const Framebuffer &frameBuffer, const ShaderInterface &shaderInterface,
+                     const FragmentBackEnd &fragmentBackEnd, const OutVertex outTriangle[3], bool useTileBinning, uint32_t binnedDrawIndex,
+                     const ScreenRegion &frameBufferRegion);
 glm::vec3 perspectiveDivision(const glm::vec4 &clipSpacePosition, float &oneOverW);
 glm::vec3 viewportTransformation(const glm::vec3 &normalizedDeviceCoordinates, uint32_t width, uint32_t height);
 bool backFaceCulling(const glm::vec3 triangleVertex[3], const BackfaceCulling &backfaceCulling);
 void rasterizeTriangleUsingPineda(const GPUMemory &memory, const Program &program, const Framebuffer &frameBuffer, const ShaderInterface &shaderInterface,
-                                  const OutVertex outTriangle[3], const glm::vec3 vertices[3], const float oneOverW[3]);
+                                  const FragmentBackEnd &fragmentBackEnd, const OutVertex outTriangle[3], const glm::vec3 vertices[3], const float oneOverW[3],
+                                  const ScreenRegion &region);
+void processFragment(const Program &program, const ShaderInterface &shaderInterface, const TriangleSetup &triangle, int x, int y, float edgeFunction12, float edgeFunction20, float edgeFunction01);
+void processQuad(const Program &program, const ShaderInterface &shaderInterface, const TriangleSetup &triangle, int quadX, int quadY, const float edgeFunctions[4][3], uint32_t coverageMask);
+float interpolateFragmentDepth(const TriangleSetup &triangle, float edgeFunction12, float edgeFunction20, float edgeFunction01);
+bool rasterizeTriangleFixedPoint(const GPUMemory &memory, const Program &program, const Framebuffer &frameBuffer, const ShaderInterface &shaderInterface,
+                                 const FragmentBackEnd &fragmentBackEnd, const OutVertex outTriangle[3], const glm::vec3 vertices[3], const float oneOverW[3], const ScreenRegion &region);
+EdgeBounds computeEdgeBounds(float firstPixelValue, float stepX, float stepY, int nofColumns, int nofRows);
+BlockClass classifyBlock(const EdgeBounds edges[3], int firstColumn, int lastColumn, int firstRow, int lastRow);
+DepthPlane computeDepthPlane(const glm::vec3 vertices[3], const EdgeBounds edgeBounds[3], float triangleArea,
+                             int minX, int minY, int nofColumns, int nofRows);
+bool computeTriangleBoundingBox(const glm::vec3 vertices[3], const Framebuffer &frameBuffer, ScreenRegion &boundingBox);
+ScreenRegion getFramebufferRegion(const Framebuffer &frameBuffer);
+bool doesCommandRequireTileFlush(CommandType type);
+uint32_t beginBinnedDraw(const GPUMemory &memory, const Program &program, const ShaderInterface &shaderInterface, const FragmentBackEnd &fragmentBackEnd);
+void binTriangle(uint32_t drawIndex, const OutVertex outTriangle[3], const glm::vec3 vertices[3], const float oneOverW[3]);
+void flushTileBins(const GPUMemory &memory);
+void bindHierarchicalDepth(const Framebuffer &frameBuffer);
+void invalidateHierarchicalDepth();
+void clearHierarchicalDepth(const Framebuffer &frameBuffer, float depth);
+float getTileMaxDepth(uint32_t tileX, uint32_t tileY);
+bool findOccludedTiles(const DepthPlane &plane, const ScreenRegion &region, OccludedTiles &occludedTiles);
+bool isBlockOccluded(const OccludedTiles &occludedTiles, int minX, int minY, int maxX, int maxY);
+void markDepthTilesWritten(const OccludedTiles &occludedTiles);
 void interpolateFragmentAttributes(const Program &program, float lambda0, float lambda1, float lambda2, InFragment &inFragment, const OutVertex outVertices[3]);
+void setupAttributePlanes(const Program &program, const OutVertex outVertices[3], const glm::vec3 vertices[3], const float oneOverW[3], int originX, int originY, AttributePlanes &planes);
+float interpolateAttributePlanes(const AttributePlanes &planes, const OutVertex outVertices[3], int x, int y, InFragment &inFragment);
 bool executeEarlyPerFragmentOperations(const GPUMemory &memory, const Framebuffer &frameBuffer, const InFragment &inFragment, bool isFacingFront);
 void executeLatePerFragmentOperations(const GPUMemory &memory, const Framebuffer &frameBuffer, const InFragment &inFragment, const OutFragment &outFragment, bool isFacingFront);
 void executeStencilOperation(uint8_t &stencilValue, StencilOp stencilOperation, uint32_t stencilValueReference);
+bool evaluateStencilFunction(uint8_t stencilValue, StencilFunc stencilFunction, uint32_t stencilValueReference);
+void setupFragmentBackEnd(const GPUMemory &memory, const Framebuffer &frameBuffer, FragmentBackEnd &backEnd);
+void shadeFragmentGeneric(const FragmentBackEnd &backEnd, const Program &program, const ShaderInterface &shaderInterface, const InFragment &inFragment, bool isFacingFront);
+PixelRows getPixelRows(const Image &image, uint32_t height, bool yReversed);
+uint8_t *getPixel(const PixelRows &rows, int x, int y);
 uint32_t clippingSutherlandHodgman(const Program &program, const OutVertex inputTriangle[3], OutVertex outputTriangles[2][3]);
 bool isVertexInsideClipPlane(const OutVertex &vertex);
 OutVertex calculateClipPlaneIntersection(const Program &program, const OutVertex &startVertex, const OutVertex &endVertex);
@@ -73,6 +137,10 @@ OutVertex interpolateVertex(const Program &program, const OutVertex &startVertex
 uint8_t *getPixelMaybeReversed(const Image &image, uint32_t x, uint32_t y, uint32_t height, bool yReversed);
 uint8_t castNormalizedFloatToUnsignedInt8(float value);
 float castUnsignedInt8ToNormalizedFloat(uint8_t value);
+uint64_t readPipelineClock();
+void addCommandTime(CommandType type, uint64_t startTime);
+void traceCommand(CommandType type, const CommandData &data, uint32_t drawID, uint64_t startTime);
+void traceFrame(uint64_t startTime);
 
 #endif // XKALINJ00_GPU_SOLUTION
 
@@ -82,15 +150,54 @@ float castUnsignedInt8ToNormalizedFloat(uint8_t value);
 /*                                                                            */
 /******************************************************************************/
 
+/*
+ * Pipeline statistics: the hot paths increment plain counters of their thread
+ * (no atomics per fragment), which are added to the global statistics at the
+ * end of every rasterized tile and every student_GPU_run().
+ */
+
+//! Pipeline counters of the calling thread
+static thread_local PipelineCounters pipelineCounters;
+
 //! [student_GPU_run]
 void student_GPU_run(GPUMemory &mem, const CommandBuffer &cb) {
+    const uint64_t frameStartTime = readPipelineClock();
+    const bool isTraced = isCommandTraceActive();
+    const uint64_t traceStartTime = isTraced ? readTraceClock() : 0;
+
     // === TEST 12 ===
     // Initialize the draw ID to 0 before processing commands from main-cb and sub-cbs
     mem.gl_DrawID = 0;
 
+    // Depth buffer could have been written by anyone since the last frame
+    invalidateHierarchicalDepth();
+
     // Main loop is separated into its own function, so the draw ID is correctly
     // incremented when recursively calling main loop for sub-commands
-    executeCommandBuffer(mem, cb);
+    if(getGPUSettings().compiledCommandBuffers) {
+        // Flat plan with inlined sub-commands, compiled once and reused while cb is unchanged
+        executeCommandPlan(mem, getCommandPlan(cb));
+    }
+    else {
+        executeCommandBuffer(mem, cb);
+    }
+
+    // Rasterize triangles still waiting in tile bins (tile-binned back-end only)
+    flushTileBins(mem);
+
+    // Write clears of tiles no triangle has touched (deferred clears only)
+    resolveAllDeferredClears();
+
+    PipelineStatistics &statistics = getPipelineStatistics();
+    addPipelineCounters(pipelineCounters);
+    statistics.frames++;
+    if(frameStartTime) {
+        statistics.frameTime += readPipelineClock() - frameStartTime;
+    }
+
+    if(isTraced) {
+        traceFrame(traceStartTime);
+    }
 } // student_GPU_run()
 //! [student_GPU_run]
 
@@ -101,7 +208,138 @@ inline void executeCommandBuffer(GPUMemory &memory, const CommandBuffer &command
     } // for(iCommand)
 } // executeCommandBuffer()
 
+//! [student_GPU_run_stream]
+void student_GPU_run(GPUMemory &mem, const CommandStream &cs) {
+    const uint64_t frameStartTime = readPipelineClock();
+    const bool isTraced = isCommandTraceActive();
+    const uint64_t traceStartTime = isTraced ? readTraceClock() : 0;
+
+    // Same frame boundaries as for the fixed-size command buffer
+    mem.gl_DrawID = 0;
+    invalidateHierarchicalDepth();
+
+    executeCommandStream(mem, cs);
+
+    flushTileBins(mem);
+    resolveAllDeferredClears();
+
+    PipelineStatistics &statistics = getPipelineStatistics();
+    addPipelineCounters(pipelineCounters);
+    statistics.frames++;
+    if(frameStartTime) {
+        statistics.frameTime += readPipelineClock() - frameStartTime;
+    }
+
+    if(isTraced) {
+        traceFrame(traceStartTime);
+    }
+} // student_GPU_run()
+//! [student_GPU_run_stream]
+
+inline void executeCommandStream(GPUMemory &memory, const CommandStream &commandStream) {
+    const CommandStream::Chunk *pChunks = commandStream.getChunks();
+
+    for(size_t iChunk = 0; iChunk < commandStream.getNofUsedChunks(); iChunk++) {
+        const uint8_t *pRecord = pChunks[iChunk].data.get();
+        const uint8_t *pChunkEnd = pRecord + pChunks[iChunk].nofBytes;
+
+        while(pRecord < pChunkEnd) {
+            CommandRecordHeader header;
+            std::memcpy(&header, pRecord, sizeof(header));
+            const uint8_t *pPayload = pRecord + sizeof(header);
+
+            if(header.type == subStreamRecordType) {
+                // Sub-stream is executed like a sub-command buffer
+                const CommandStream *pSubStream;
+                std::memcpy(&pSubStream, pPayload, sizeof(pSubStream));
+                if(pSubStream) {
+                    const bool isTraced = isCommandTraceActive();
+                    const uint64_t traceStartTime = isTraced ? readTraceClock() : 0;
+
+                    executeCommandStream(memory, *pSubStream);
+
+                    if(isTraced) {
+                        TraceSpan span;
+                        span.name = "SUB_STREAM";
+                        span.category = "sub";
+                        span.startTime = traceStartTime;
+                        span.duration = readTraceClock() - traceStartTime;
+                        span.argumentNames[0] = "nofCommands";
+                        span.argumentValues[0] = pSubStream->getNofCommands();
+                        addTraceSpan(span);
+                    }
+                }
+            }
+            else {
+                // Only the payload of the command type is stored, the rest of the union is unused
+                CommandData data;
+                std::memcpy(static_cast<void*>(&data), pPayload,
+                            std::min<size_t>(header.nofBytes - sizeof(header), sizeof(CommandData)));
+                handleCommand(memory, static_cast<CommandType>(header.type), data);
+            }
+
+            pRecord += header.nofBytes;
+        } // while(records)
+    } // for(iChunk)
+} // executeCommandStream()
+
+inline void executeCommandPlan(GPUMemory &memory, const CommandPlan &plan) {
+    for(const PlanCommand &planCommand : plan.commands) {
+        if(planCommand.iFoldedClear >= 0) {
+            const uint64_t startTime = readPipelineClock();
+            const bool isTraced = isCommandTraceActive();
+            const uint64_t traceStartTime = isTraced ? readTraceClock() : 0;
+
+            handleFoldedClear(memory, plan.foldedClears[static_cast<size_t>(planCommand.iFoldedClear)]);
+
+            addCommandTime(CommandType::CLEAR_COLOR, startTime);
+            if(isTraced) {
+                TraceSpan span;
+                span.name = "FOLDED_CLEAR";
+                span.category = "clear";
+                span.startTime = traceStartTime;
+                span.duration = readTraceClock() - traceStartTime;
+                addTraceSpan(span);
+            }
+        }
+        else {
+            handleCommand(memory, planCommand.command.type, planCommand.command.data);
+
+            // User callback rewrote the tree - the rest of the plan is stale, the
+            // source buffers are interpreted from the user command on (innermost first)
+            if(planCommand.iResumePoint >= 0 && !isCommandPlanUpToDate(plan)) {
+                const auto &positions = plan.resumePoints[static_cast<size_t>(planCommand.iResumePoint)];
+                for(auto it = positions.rbegin(); it != positions.rend(); ++it) {
+                    const CommandBuffer &commandBuffer = *it->pCommandBuffer;
+                    for(uint32_t iCommand = it->iCommand + 1; iCommand < commandBuffer.nofCommands; iCommand++) {
+                        handleCommand(memory, commandBuffer.commands[iCommand].type, commandBuffer.commands[iCommand].data);
+                    } // for(iCommand)
+                } // for(it)
+                return;
+            }
+        }
+    } // for(planCommand)
+} // executeCommandPlan()
+
 inline void handleCommand(GPUMemory &memory, const CommandType type, const CommandData &data) {
+    // Binned triangles have to be rasterized before anything they depend on changes
+    if(doesCommandRequireTileFlush(type)) {
+        flushTileBins(memory);
+    }
+
+    // Deferred clears have to be written before the framebuffer is switched or read
+    if(doesCommandRequireClearResolve(type)) {
+        resolveAllDeferredClears();
+    }
+
+    // Clears and draws are timed (when pipeline timings are enabled)
+    const uint64_t startTime = readPipelineClock();
+
+    // Every command is a span of the timeline (when tracing)
+    const bool isTraced = isCommandTraceActive();
+    const uint64_t traceStartTime = isTraced ? readTraceClock() : 0;
+    const uint32_t traceDrawID = memory.gl_DrawID;
+
     switch(type) {
         /**********************************************************************/
         /*                       03.1 BINDING commands                        */
@@ -189,6 +427,11 @@ inline void handleCommand(GPUMemory &memory, const CommandType type, const Comma
         default:
             break;
     } // switch(type)
+
+    addCommandTime(type, startTime);
+    if(isTraced) {
+        traceCommand(type, data, traceDrawID, traceStartTime);
+    }
 } // handleCommand()
 
 
@@ -245,6 +488,16 @@ inline void handleClearColorCommand(const GPUMemory &memory, const ClearColorCom
 
     // Does framebuffer contain color buffer?
     if(framebuffer.color.data) {
+        // Fast path - the clear value is packed into one pixel and whole rows are filled
+        ClearValue clearValue;
+        if(packClearColor(framebuffer.color, clearColorCommand.value, clearValue)) {
+            clearAttachment(framebuffer, CLEAR_ATTACHMENT_COLOR, clearValue);
+            return;
+        }
+
+        // Pending deferred clears would overwrite this clear later
+        resolveAllDeferredClears();
+
         // Clear the color buffer for each pixel
         for(uint32_t y = 0; y < framebuffer.height; y++) {
             for(uint32_t x = 0; x < framebuffer.width; x++) {
@@ -294,6 +547,19 @@ inline void handleClearDepthCommand(const GPUMemory &memory, const ClearDepthCom
 
     // Does framebuffer contain depth buffer?
     if(framebuffer.depth.data) {
+        // Every tile of the hierarchical depth buffer gets the cleared depth
+        clearHierarchicalDepth(framebuffer, clearDepthCommand.value);
+
+        // Fast path - whole rows are filled with the packed value
+        ClearValue clearValue;
+        if(packClearValue(framebuffer.depth, &clearDepthCommand.value, sizeof(float), clearValue)) {
+            clearAttachment(framebuffer, CLEAR_ATTACHMENT_DEPTH, clearValue);
+            return;
+        }
+
+        // Pending deferred clears would overwrite this clear later
+        resolveAllDeferredClears();
+
         // Clear the depth buffer for each pixel
         for(uint32_t y = 0; y < framebuffer.height; y++) {
             for(uint32_t x = 0; x < framebuffer.width; x++) {
@@ -313,6 +579,16 @@ inline void handleClearStencilCommand(const GPUMemory &memory, const ClearStenci
 
     // Does framebuffer contain stencil buffer?
     if(framebuffer.stencil.data) {
+        // Fast path - whole rows are filled with the packed value
+        ClearValue clearValue;
+        if(packClearValue(framebuffer.stencil, &clearStencilCommand.value, sizeof(uint8_t), clearValue)) {
+            clearAttachment(framebuffer, CLEAR_ATTACHMENT_STENCIL, clearValue);
+            return;
+        }
+
+        // Pending deferred clears would overwrite this clear later
+        resolveAllDeferredClears();
+
         // Clear the stencil buffer for each pixel
         for(uint32_t y = 0; y < framebuffer.height; y++) {
             for(uint32_t x = 0; x < framebuffer.width; x++) {
@@ -325,11 +601,289 @@ inline void handleClearStencilCommand(const GPUMemory &memory, const ClearStenci
     } // if(framebuffer.stencil.data)
 } // handleClearStencilCommand()
 
+/*
+ * Fast clears: the clear value is converted into the bytes of one pixel only
+ * once and the image is then filled row by row (or all at once when rows are
+ * not padded) with memset/memcpy. Layouts where the channels do not fill the
+ * whole pixel keep the original per-pixel loops above.
+ *
+ * Deferred clears (opt-in): a clear only records the packed value and marks
+ * every screen tile as pending. The pixels are written when a triangle first
+ * touches the tile (by the thread rasterizing the tile in the tile-binned
+ * back-end) or when the framebuffer is switched, read by a user command or
+ * the command buffer ends. Tiles are the same as in the tile-binned back-end.
+ */
+
+//! Pending clears of the active framebuffer
+static DeferredClears deferredClears;
+
+inline const Image &getClearAttachmentImage(const Framebuffer &frameBuffer, const ClearAttachment attachment) {
+    switch(attachment) {
+        case CLEAR_ATTACHMENT_DEPTH:   return frameBuffer.depth;
+        case CLEAR_ATTACHMENT_STENCIL: return frameBuffer.stencil;
+        case CLEAR_ATTACHMENT_COLOR:
+        default:
+            return frameBuffer.color;
+    } // switch(attachment)
+} // getClearAttachmentImage()
+
+inline bool packClearColor(const Image &image, const glm::vec4 &color, ClearValue &clearValue) {
+    const uint32_t channelSize = image.format == Image::F32 ? sizeof(float) : sizeof(uint8_t);
+
+    // Bytes not covered by channels must stay untouched, so they cannot be part of the pattern
+    if(image.bytesPerPixel != image.channels * channelSize || image.bytesPerPixel > sizeof(clearValue.pixel)) {
+        return false;
+    }
+
+    clearValue.bytesPerPixel = image.bytesPerPixel;
+    for(uint32_t iChannel = 0; iChannel < image.channels; iChannel++) {
+        // Same channel selection and conversion as in handleClearColorCommand()
+        float selectedChannel{0.f};
+        switch(image.channelTypes[iChannel]) {
+            case Image::RED:   selectedChannel = color.r; break;
+            case Image::GREEN: selectedChannel = color.g; break;
+            case Image::BLUE:  selectedChannel = color.b; break;
+            case Image::ALPHA: selectedChannel = color.a; break;
+            default:           selectedChannel = 0.f;     break;
+        } // switch(channel)
+
+        if(image.format == Image::F32) {
+            std::memcpy(clearValue.pixel + iChannel * sizeof(float), &selectedChannel, sizeof(float));
+        }
+        else {
+            clearValue.pixel[iChannel] = castNormalizedFloatToUnsignedInt8(selectedChannel);
+        }
+    } // for(iChannel)
+
+    return true;
+} // packClearColor()
+
+inline bool packClearValue(const Image &image, const void *pValue, const uint32_t valueSize, ClearValue &clearValue) {
+    if(image.bytesPerPixel != valueSize || valueSize > sizeof(clearValue.pixel)) {
+        return false;
+    }
+
+    clearValue.bytesPerPixel = valueSize;
+    std::memcpy(clearValue.pixel, pValue, valueSize);
+    return true;
+} // packClearValue()
+
+inline void fillPixels(uint8_t *pDestination, const ClearValue &clearValue, const size_t nofPixels) {
+    const size_t nofBytes = nofPixels * clearValue.bytesPerPixel;
+    if(nofBytes == 0) {
+        return;
+    }
+
+    // Pattern of identical bytes (black, white, depth 0, any stencil value) is a plain memset
+    const uint8_t *pPixel = clearValue.pixel;
+    if(std::all_of(pPixel, pPixel + clearValue.bytesPerPixel, [pPixel](const uint8_t byte) { return byte == pPixel[0]; })) {
+        std::memset(pDestination, pPixel[0], nofBytes);
+        return;
+    }
+
+    // Otherwise the already filled part is copied over and over (doubling its size)
+    std::memcpy(pDestination, pPixel, clearValue.bytesPerPixel);
+    size_t nofFilledBytes = clearValue.bytesPerPixel;
+    while(nofFilledBytes < nofBytes) {
+        const size_t nofCopiedBytes = std::min(nofFilledBytes, nofBytes - nofFilledBytes);
+        std::memcpy(pDestination + nofFilledBytes, pDestination, nofCopiedBytes);
+        nofFilledBytes += nofCopiedBytes;
+    } // while(not filled)
+} // fillPixels()
+
+inline void fillImageRegion(const Image &image, const ClearValue &clearValue, const ScreenRegion &region,
+                            const uint32_t height, const bool yReversed) {
+    const uint32_t nofPixels = static_cast<uint32_t>(region.maxX - region.minX + 1);
+    const uint32_t nofRows = static_cast<uint32_t>(region.maxY - region.minY + 1);
+
+    // Whole rows without padding - the region is one continuous block of memory
+    // (row order does not matter, so y-reversal can be ignored)
+    const bool isContinuous = region.minX == 0 && nofPixels * image.bytesPerPixel == image.pitch;
+    if(isContinuous && region.minY == 0 && static_cast<uint32_t>(region.maxY) == height - 1) {
+        fillPixels(static_cast<uint8_t*>(image.data), clearValue, static_cast<size_t>(nofPixels) * nofRows);
+        return;
+    }
+
+    for(int y = region.minY; y <= region.maxY; y++) {
+        uint8_t *pRow = getPixelMaybeReversed(image, static_cast<uint32_t>(region.minX), static_cast<uint32_t>(y), height, yReversed);
+        fillPixels(pRow, clearValue, nofPixels);
+    } // for(y)
+} // fillImageRegion()
+
+inline void clearAttachment(const Framebuffer &frameBuffer, const ClearAttachment attachment, const ClearValue &clearValue) {
+    if(frameBuffer.width == 0 || frameBuffer.height == 0) {
+        return;
+    }
+
+    if(!getGPUSettings().deferredClears) {
+        fillImageRegion(getClearAttachmentImage(frameBuffer, attachment), clearValue, getFramebufferRegion(frameBuffer),
+                        frameBuffer.height, frameBuffer.yReversed);
+        return;
+    }
+
+    // Pending clears belong to one framebuffer (and one tile grid)
+    const bool isFrameBufferChanged = &frameBuffer != deferredClears.pFrameBuffer ||
+                                      frameBuffer.width != deferredClears.width ||
+                                      frameBuffer.height != deferredClears.height ||
+                                      std::max(1u, getGPUSettings().tileSize) != deferredClears.tileSize;
+    if(isFrameBufferChanged) {
+        resolveAllDeferredClears();
+        deferredClears.pFrameBuffer = &frameBuffer;
+        deferredClears.width = frameBuffer.width;
+        deferredClears.height = frameBuffer.height;
+        deferredClears.tileSize = std::max(1u, getGPUSettings().tileSize);
+        deferredClears.nofTilesX = (deferredClears.width + deferredClears.tileSize - 1) / deferredClears.tileSize;
+        deferredClears.nofTilesY = (deferredClears.height + deferredClears.tileSize - 1) / deferredClears.tileSize;
+        deferredClears.pendingTiles.assign(deferredClears.nofTilesX * deferredClears.nofTilesY, 0);
+    }
+
+    // Newer clear replaces the older one in all tiles
+    deferredClears.values[attachment] = clearValue;
+    for(auto &pendingAttachments : deferredClears.pendingTiles) {
+        pendingAttachments |= static_cast<uint8_t>(1u << attachment);
+    } // for(pendingAttachments)
+    deferredClears.hasPending = true;
+} // clearAttachment()
+
+inline bool doesCommandRequireClearResolve(const CommandType type) {
+    // Draws resolve the tiles they touch, clears just replace pending values
+    return type == CommandType::BIND_FRAMEBUFFER || type == CommandType::USER_COMMAND;
+} // doesCommandRequireClearResolve()
+
+inline bool hasPendingDeferredClears() {
+    return deferredClears.hasPending;
+} // hasPendingDeferredClears()
+
+inline void resolveDeferredClears(const ScreenRegion &region) {
+    if(!deferredClears.hasPending) {
+        return;
+    }
+
+    const Framebuffer &frameBuffer = *deferredClears.pFrameBuffer;
+    const uint32_t tileSize = deferredClears.tileSize;
+    const uint32_t minTileX = static_cast<uint32_t>(region.minX) / tileSize;
+    const uint32_t maxTileX = static_cast<uint32_t>(region.maxX) / tileSize;
+    const uint32_t minTileY = static_cast<uint32_t>(region.minY) / tileSize;
+    const uint32_t maxTileY = static_cast<uint32_t>(region.maxY) / tileSize;
+
+    for(uint32_t tileY = minTileY; tileY <= maxTileY; tileY++) {
+        for(uint32_t tileX = minTileX; tileX <= maxTileX; tileX++) {
+            uint8_t &pendingAttachments = deferredClears.pendingTiles[tileY * deferredClears.nofTilesX + tileX];
+            if(!pendingAttachments) {
+                continue;
+            }
+
+            const int tileMinX = static_cast<int>(tileX * tileSize);
+            const int tileMinY = static_cast<int>(tileY * tileSize);
+            const ScreenRegion tileRegion{tileMinX, tileMinY,
+                                          std::min(tileMinX + static_cast<int>(tileSize), static_cast<int>(frameBuffer.width)) - 1,
+                                          std::min(tileMinY + static_cast<int>(tileSize), static_cast<int>(frameBuffer.height)) - 1};
+
+            for(uint32_t iAttachment = 0; iAttachment < nofClearAttachments; iAttachment++) {
+                if(pendingAttachments & (1u << iAttachment)) {
+                    const Image &image = getClearAttachmentImage(frameBuffer, static_cast<ClearAttachment>(iAttachment));
+                    fillImageRegion(image, deferredClears.values[iAttachment], tileRegion, frameBuffer.height, frameBuffer.yReversed);
+                }
+            } // for(iAttachment)
+            pendingAttachments = 0;
+        } // for(tileX)
+    } // for(tileY)
+} // resolveDeferredClears()
+
+inline void resolveDeferredClearsOfTriangle(const glm::vec3 vertices[3], const Framebuffer &frameBuffer) {
+    ScreenRegion boundingBox;
+    if(!computeTriangleBoundingBox(vertices, frameBuffer, boundingBox)) {
+        return;
+    }
+
+    // One pixel more on each side covers the snapped vertices of the fixed-point rasterizer
+    boundingBox.minX = std::max(boundingBox.minX - 1, 0);
+    boundingBox.minY = std::max(boundingBox.minY - 1, 0);
+    boundingBox.maxX = std::min(boundingBox.maxX + 1, static_cast<int>(frameBuffer.width) - 1);
+    boundingBox.maxY = std::min(boundingBox.maxY + 1, static_cast<int>(frameBuffer.height) - 1);
+    resolveDeferredClears(boundingBox);
+} // resolveDeferredClearsOfTriangle()
+
+inline void resolveAllDeferredClears() {
+    if(!deferredClears.hasPending) {
+        return;
+    }
+
+    // Tiles are independent, so the remaining clears are written in parallel
+    const uint32_t nofTiles = deferredClears.nofTilesX * deferredClears.nofTilesY;
+    getThreadPool(getEffectiveNofThreads()).parallelFor(nofTiles, [](const uint32_t iTile, uint32_t) {
+        const int tileX = static_cast<int>((iTile % deferredClears.nofTilesX) * deferredClears.tileSize);
+        const int tileY = static_cast<int>((iTile / deferredClears.nofTilesX) * deferredClears.tileSize);
+        resolveDeferredClears(ScreenRegion{tileX, tileY, tileX, tileY});
+    }); // parallelFor(iTile)
+
+    deferredClears.hasPending = false;
+} // resolveAllDeferredClears()
+
+inline void handleFoldedClear(GPUMemory &memory, const FoldedClear &foldedClear) {
+    // Clears write memory, so binned triangles have to be rasterized first
+    flushTileBins(memory);
+
+    const Framebuffer &framebuffer = memory.framebuffers[memory.activatedFramebuffer];
+
+    // Pack all cleared buffers, buffers without data are skipped like in the clear handlers
+    const bool isCleared[nofClearAttachments] = {
+        foldedClear.clearColor && framebuffer.color.data,
+        foldedClear.clearDepth && framebuffer.depth.data,
+        foldedClear.clearStencil && framebuffer.stencil.data
+    };
+    ClearValue clearValues[nofClearAttachments];
+    const bool isPacked = (!isCleared[CLEAR_ATTACHMENT_COLOR] || packClearColor(framebuffer.color, foldedClear.color, clearValues[CLEAR_ATTACHMENT_COLOR])) &&
+                          (!isCleared[CLEAR_ATTACHMENT_DEPTH] || packClearValue(framebuffer.depth, &foldedClear.depth, sizeof(float), clearValues[CLEAR_ATTACHMENT_DEPTH])) &&
+                          (!isCleared[CLEAR_ATTACHMENT_STENCIL] || packClearValue(framebuffer.stencil, &foldedClear.stencil, sizeof(uint8_t), clearValues[CLEAR_ATTACHMENT_STENCIL]));
+
+    // Padded layouts (or deferred clears) are handled by the clear handlers one by one
+    if(!isPacked || getGPUSettings().deferredClears) {
+        if(foldedClear.clearColor) {
+            ClearColorCommand command;
+            command.value = foldedClear.color;
+            handleClearColorCommand(memory, command);
+        }
+        if(foldedClear.clearDepth) {
+            ClearDepthCommand command;
+            command.value = foldedClear.depth;
+            handleClearDepthCommand(memory, command);
+        }
+        if(foldedClear.clearStencil) {
+            ClearStencilCommand command;
+            command.value = foldedClear.stencil;
+            handleClearStencilCommand(memory, command);
+        }
+        return;
+    }
+
+    if(isCleared[CLEAR_ATTACHMENT_DEPTH]) {
+        clearHierarchicalDepth(framebuffer, foldedClear.depth);
+    }
+
+    // One pass over the framebuffer - a band of rows of every buffer at a time
+    constexpr int bandHeight = 16;
+    for(int minY = 0; minY < static_cast<int>(framebuffer.height); minY += bandHeight) {
+        const ScreenRegion band{0, minY, static_cast<int>(framebuffer.width) - 1,
+                                std::min(minY + bandHeight, static_cast<int>(framebuffer.height)) - 1};
+
+        for(uint32_t iAttachment = 0; iAttachment < nofClearAttachments; iAttachment++) {
+            if(isCleared[iAttachment]) {
+                const Image &image = getClearAttachmentImage(framebuffer, static_cast<ClearAttachment>(iAttachment));
+                fillImageRegion(image, clearValues[iAttachment], band, framebuffer.height, framebuffer.yReversed);
+            }
+        } // for(iAttachment)
+    } // for(minY)
+} // handleFoldedClear()
+
 // === TEST 11 ===
 inline void handleUserCommand(const UserCommand &userCommand) {
     // If user collback is NULL we ignore it as described in test 11
     if(userCommand.callback) {
         userCommand.callback(userCommand.data);
+
+        // The callback may write the depth buffer directly
+        invalidateHierarchicalDepth();
     }
 } // handleUserCommand()
 
@@ -355,63 +909,105 @@ inline void handleDrawCommand(GPUMemory &memory, const DrawCommand &drawCommand)
     // Get the currently activated framebuffer from memory
     const auto &frameBuffer = memory.framebuffers[memory.activatedFramebuffer];
 
-    // We process each triangle - triangle has 3 vertices, thus we increment by 3
-    for(uint32_t iTriangleStart = 0; iTriangleStart < drawCommand.nofVertices; iTriangleStart += 3) {
-        OutVertex outTriangle[3];
+    // Triangles are either rasterized immediately over the whole framebuffer
+    // or they are binned into screen tiles and rasterized later in parallel
+    const bool useTileBinning = isTileBinningEnabled();
+    const ScreenRegion frameBufferRegion = getFramebufferRegion(frameBuffer);
+    // Per-fragment operations are selected once, the GPU state cannot change during the draw
+    FragmentBackEnd fragmentBackEnd;
+    setupFragmentBackEnd(memory, frameBuffer, fragmentBackEnd);
 
-        // === TEST 14, 18, 19-21 ===
-        // Vertex Processor & Vertex Assembly Unit ('07 Vektorová čast GPU: část vertexů')
-        for(int iVertex = 0; iVertex < 3; iVertex++) {
-            InVertex inVertex;
+    const uint32_t binnedDrawIndex = useTileBinning ? beginBinnedDraw(memory, program, shaderInterface, fragmentBackEnd) : 0;
 
-            // === TEST 18 ===
-            // getVertexIndex() function supports both indexed and non-indexed drawing
-            inVertex.gl_VertexID = getVertexIndex(memory, iTriangleStart + iVertex);
+    // Outputs of the vertex shader can be reused only within one draw (uniforms may change)
+    const bool useVertexCache = getGPUSettings().vertexCache && isVertexCacheUsable(memory);
+    if(useVertexCache) {
+        beginVertexCacheDraw();
+    }
+    VertexStatistics &vertexStatistics = getVertexStatistics();
+    uint64_t nofCacheHits = 0;
+    uint64_t nofCacheMisses = 0;
+    uint64_t vertexTime = 0;
+
+    // Batched vertex stage - vertices of up to `vertexBatchSize` triangles are
+    // fetched and shaded together before their triangles are assembled
+    if(getGPUSettings().batchedVertexStage) {
+        VertexFetcher fetcher;
+        setupVertexFetcher(memory, fetcher);
+        const BatchVertexShader batchVertexShader = findBatchVertexShader(program.vertexShader);
+
+        constexpr uint32_t maxNofBatchVertices = 3 * vertexBatchSize;
+        OutVertex outVertices[maxNofBatchVertices];
+
+        for(uint32_t iBatchStart = 0; iBatchStart < drawCommand.nofVertices; iBatchStart += maxNofBatchVertices) {
+            // Last (incomplete) triangle is assembled the same way as in the per-vertex path
+            const uint32_t nofTriangles = std::min(vertexBatchSize, (drawCommand.nofVertices - iBatchStart + 2) / 3);
+
+            const uint64_t vertexStartTime = readPipelineClock();
+            runBatchedVertexStage(program, shaderInterface, fetcher, batchVertexShader, iBatchStart, 3 * nofTriangles,
+                                  useVertexCache, outVertices, nofCacheHits, nofCacheMisses);
+            if(vertexStartTime) {
+                vertexTime += readPipelineClock() - vertexStartTime;
+            }
 
-            // === TEST 19-21 ===
-            // Assemble vertex from buffers using Vertex Assembly unit
-            vertexAssemblyUnit(memory, inVertex);
+            for(uint32_t iTriangle = 0; iTriangle < nofTriangles; iTriangle++) {
+                processTriangle(memory, program, frameBuffer, shaderInterface, fragmentBackEnd, &outVertices[3 * iTriangle],
+                                useTileBinning, binnedDrawIndex, frameBufferRegion);
+            } // for(iTriangle)
+        } // for(iBatchStart)
+    } // if(batchedVertexStage)
+    else {
+        // We process each triangle - triangle has 3 vertices, thus we increment by 3
+        for(uint32_t iTriangleStart = 0; iTriangleStart < drawCommand.nofVertices; iTriangleStart += 3) {
+            OutVertex outTriangle[3];
+            const uint64_t vertexStartTime = readPipelineClock();
 
-            // === TEST 14 ===
-            // Run vertex shader for each vertex
-            program.vertexShader(outTriangle[iVertex], inVertex, shaderInterface);
-        } // for(iVertex)
+            // === TEST 14, 18, 19-21 ===
+            // Vertex Processor & Vertex Assembly Unit ('07 Vektorová čast GPU: část vertexů')
+            for(int iVertex = 0; iVertex < 3; iVertex++) {
+                InVertex inVertex;
 
-        // === TEST 38-41 ===
-        // Apply triangle clipping using Sutherland-Hodgman algorithm
-        OutVertex clippedTriangles[2][3];
-        const uint32_t clippedTrinaglesCount = clippingSutherlandHodgman(program, outTriangle, clippedTriangles);
+                // === TEST 18 ===
+                // getVertexIndex() function supports both indexed and non-indexed drawing
+                inVertex.gl_VertexID = getVertexIndex(memory, iTriangleStart + iVertex);
 
-        for(uint32_t iClippedTriangle = 0; iClippedTriangle < clippedTrinaglesCount; iClippedTriangle++) {
-            glm::vec3 screenSpaceVertices[3];
-            float oneOverW[3];
+                // Post-transform cache - vertex already shaded in this draw
+                if(useVertexCache) {
+                    if(fetchCachedVertex(inVertex.gl_VertexID, outTriangle[iVertex])) {
+                        nofCacheHits++;
+                        continue;
+                    }
+                    nofCacheMisses++;
+                }
 
-            // === TEST 25 ===
-            // Apply viewport transform to each vertex of the clipped triangle
-            for(int iVertex = 0; iVertex < 3; iVertex++) {
-                // Perform perspective division to convert from clip space to normalized device coordinates (NDC)
-                const glm::vec3 normalizedDeviceCoordinates = perspectiveDivision(clippedTriangles[iClippedTriangle][iVertex].gl_Position, oneOverW[iVertex]);
+                // === TEST 19-21 ===
+                // Assemble vertex from buffers using Vertex Assembly unit
+                vertexAssemblyUnit(memory, inVertex);
 
-                // Transform NDC coordinates (range [-1,1]) to screen space coordinates (range [0,width/height])
-                screenSpaceVertices[iVertex] = viewportTransformation(normalizedDeviceCoordinates, frameBuffer.width, frameBuffer.height);
+                // === TEST 14 ===
+                // Run vertex shader for each vertex
+                program.vertexShader(outTriangle[iVertex], inVertex, shaderInterface);
+                pipelineCounters.verticesShaded++;
+
+                if(useVertexCache) {
+                    storeCachedVertex(inVertex.gl_VertexID, outTriangle[iVertex]);
+                }
             } // for(iVertex)
 
-            // === TEST 26 ===
-            if(backFaceCulling(screenSpaceVertices, memory.backfaceCulling)) {
-                continue;
+            if(vertexStartTime) {
+                vertexTime += readPipelineClock() - vertexStartTime;
             }
 
-            // === TEST 22-24, 27-37 ===
-            // All these steps are handled by the rasterizeTriangleUsingPineda function
-            rasterizeTriangleUsingPineda(memory,                              // GPU state
-                                         program,                             // active program
-                                         frameBuffer,                         // active framebuffer
-                                         shaderInterface,                     // constants for fragment shader
-                                         clippedTriangles[iClippedTriangle],  // vertex shader outputs
-                                         screenSpaceVertices,                 // vertices in screen-space
-                                         oneOverW);                           // 1/w for perspective correction
-        } // for(iClippedTriangle)
-    } // for(iTriangle)
+            processTriangle(memory, program, frameBuffer, shaderInterface, fragmentBackEnd, outTriangle,
+                            useTileBinning, binnedDrawIndex, frameBufferRegion);
+        } // for(iTriangle)
+    } // else(per-vertex stage)
+
+    vertexStatistics.cacheHits += nofCacheHits;
+    vertexStatistics.cacheMisses += nofCacheMisses;
+    if(vertexTime) {
+        getPipelineStatistics().vertexTime += vertexTime;
+    }
 
     // === TEST 12 ===
     memory.gl_DrawID++;  // increment the draw ID for each draw command
@@ -537,6 +1133,228 @@ inline void vertexAssemblyUnit(const GPUMemory &memory, InVertex &inVertex) {
     } // for(iAttribute)
 } // assembleVertex()
 
+/*
+ * Post-transform vertex cache: vertex shader outputs are stored in a dense
+ * array indexed by gl_VertexID. Entries are tagged with a stamp of the draw
+ * that wrote them, so invalidating the whole cache for a new draw is just an
+ * increment of the stamp.
+ */
+
+//! Shaded vertices of the current draw
+static VertexCache vertexCache;
+
+inline bool isVertexCacheUsable(const GPUMemory &memory) {
+    // Without indexing every gl_VertexID appears only once, so there is nothing to reuse
+    const VertexArray &vertexArray = memory.vertexArrays[memory.activatedVertexArray];
+    return vertexArray.indexBufferID >= 0 && memory.buffers[vertexArray.indexBufferID].data;
+} // isVertexCacheUsable()
+
+inline void beginVertexCacheDraw() {
+    vertexCache.stamp++;
+
+    // Stamp overflow - stale entries could look valid again, so we clear them
+    if(vertexCache.stamp == 0) {
+        std::fill(vertexCache.stamps.begin(), vertexCache.stamps.end(), 0u);
+        vertexCache.stamp = 1;
+    }
+} // beginVertexCacheDraw()
+
+inline bool fetchCachedVertex(const uint32_t vertexID, OutVertex &outVertex) {
+    if(vertexID >= vertexCache.stamps.size() || vertexCache.stamps[vertexID] != vertexCache.stamp) {
+        return false;
+    }
+
+    outVertex = vertexCache.vertices[vertexID];
+    return true;
+} // fetchCachedVertex()
+
+inline void storeCachedVertex(const uint32_t vertexID, const OutVertex &outVertex) {
+    // Huge indices are not cached at all, so the cache stays reasonably small
+    if(vertexID >= VertexCache::maxNofVertices) {
+        return;
+    }
+
+    if(vertexID >= vertexCache.stamps.size()) {
+        vertexCache.stamps.resize(vertexID + 1, 0u);
+        vertexCache.vertices.resize(vertexID + 1);
+    }
+
+    vertexCache.stamps[vertexID] = vertexCache.stamp;
+    vertexCache.vertices[vertexID] = outVertex;
+} // storeCachedVertex()
+
+/*
+ * Batched vertex stage: the vertex array is decoded once per draw into a list
+ * of active attributes with a copy routine specialized for each type. Vertices
+ * are then fetched into a structure of arrays and shaded `vertexBatchSize` at
+ * a time, either by a registered batch shader or lane by lane.
+ */
+
+template<typename T>
+inline void fetchAttributeOfType(const uint8_t *pAttribute, Attrib &attribute) {
+    // Only sizeof(T) bytes are written, the rest keeps the default value (as in vertexAssemblyUnit)
+    std::memcpy(static_cast<void*>(&attribute), pAttribute, sizeof(T));
+} // fetchAttributeOfType()
+
+inline AttributeFetch getAttributeFetch(const AttribType attributeType) {
+    switch(attributeType) {
+        case AttribType::FLOAT: return fetchAttributeOfType<float>;
+        case AttribType::VEC2:  return fetchAttributeOfType<glm::vec2>;
+        case AttribType::VEC3:  return fetchAttributeOfType<glm::vec3>;
+        case AttribType::VEC4:  return fetchAttributeOfType<glm::vec4>;
+        case AttribType::UINT:  return fetchAttributeOfType<uint32_t>;
+        case AttribType::UVEC2: return fetchAttributeOfType<glm::uvec2>;
+        case AttribType::UVEC3: return fetchAttributeOfType<glm::uvec3>;
+        case AttribType::UVEC4: return fetchAttributeOfType<glm::uvec4>;
+        case AttribType::EMPTY:
+        default:
+            return nullptr;
+    } // switch(attributeType)
+} // getAttributeFetch()
+
+inline void setupVertexFetcher(const GPUMemory &memory, VertexFetcher &fetcher) {
+    const VertexArray &vertexArray = memory.vertexArrays[memory.activatedVertexArray];
+
+    // Index buffer (same conditions as in getVertexIndex())
+    fetcher.pIndices = nullptr;
+    if(vertexArray.indexBufferID >= 0 && memory.buffers[vertexArray.indexBufferID].data) {
+        fetcher.pIndices = static_cast<const uint8_t*>(memory.buffers[vertexArray.indexBufferID].data) + vertexArray.indexOffset;
+        fetcher.indexType = vertexArray.indexType;
+    }
+
+    // Active attributes (same conditions as in vertexAssemblyUnit())
+    fetcher.nofAttributes = 0;
+    for(uint32_t iAttribute = 0; iAttribute < maxAttribs; iAttribute++) {
+        const VertexAttrib &attribute = vertexArray.vertexAttrib[iAttribute];
+        const AttributeFetch fetchAttribute = getAttributeFetch(attribute.type);
+        if(!fetchAttribute || attribute.bufferID < 0) {
+            continue;
+        }
+
+        const uint32_t iActive = fetcher.nofAttributes++;
+        fetcher.attributeIndex[iActive] = iAttribute;
+        fetcher.pAttributes[iActive] = static_cast<const uint8_t*>(memory.buffers[attribute.bufferID].data) + attribute.offset;
+        fetcher.attributeStride[iActive] = attribute.stride;
+        fetcher.fetchAttribute[iActive] = fetchAttribute;
+    } // for(iAttribute)
+} // setupVertexFetcher()
+
+inline uint32_t fetchVertexIndex(const VertexFetcher &fetcher, const uint32_t vertexIndex) {
+    if(!fetcher.pIndices) {
+        return vertexIndex;
+    }
+
+    switch(fetcher.indexType) {
+        case IndexType::U8:
+            return fetcher.pIndices[vertexIndex];
+        case IndexType::U16:
+            return reinterpret_cast<const uint16_t*>(fetcher.pIndices)[vertexIndex];
+        case IndexType::U32:
+            return reinterpret_cast<const uint32_t*>(fetcher.pIndices)[vertexIndex];
+        default:
+            return vertexIndex;
+    } // switch(fetcher.indexType)
+} // fetchVertexIndex()
+
+inline void runBatchedVertexStage(const Program &program, const ShaderInterface &shaderInterface,
+                                  const VertexFetcher &fetcher, const BatchVertexShader batchVertexShader,
+                                  const uint32_t firstVertex, const uint32_t nofVertices, const bool useVertexCache,
+                                  OutVertex outVertices[], uint64_t &nofCacheHits, uint64_t &nofCacheMisses) {
+    // Vertices which really have to be shaded - index into outVertices of their first occurrence
+    uint32_t shadedVertex[3 * vertexBatchSize];
+    uint32_t nofShadedVertices = 0;
+
+    // Occurrences of an already scheduled vertex - copied after shading
+    uint32_t duplicateVertex[3 * vertexBatchSize];
+    uint32_t duplicateOf[3 * vertexBatchSize];
+    uint32_t nofDuplicates = 0;
+
+    uint32_t vertexIDs[3 * vertexBatchSize];
+    for(uint32_t iVertex = 0; iVertex < nofVertices; iVertex++) {
+        vertexIDs[iVertex] = fetchVertexIndex(fetcher, firstVertex + iVertex);
+
+        if(useVertexCache) {
+            if(fetchCachedVertex(vertexIDs[iVertex], outVertices[iVertex])) {
+                nofCacheHits++;
+                continue;
+            }
+
+            // Vertex missed the cache, but it may be scheduled earlier in this batch
+            // (vertices too large for the cache are shaded every time, as in the per-vertex path)
+            uint32_t iShaded = vertexIDs[iVertex] < VertexCache::maxNofVertices ? 0 : nofShadedVertices;
+            while(iShaded < nofShadedVertices && vertexIDs[shadedVertex[iShaded]] != vertexIDs[iVertex]) {
+                iShaded++;
+            } // while(not found)
+
+            if(iShaded < nofShadedVertices) {
+                duplicateVertex[nofDuplicates] = iVertex;
+                duplicateOf[nofDuplicates] = shadedVertex[iShaded];
+                nofDuplicates++;
+                nofCacheHits++;
+                continue;
+            }
+            nofCacheMisses++;
+        }
+
+        shadedVertex[nofShadedVertices++] = iVertex;
+    } // for(iVertex)
+
+    // Fetch & shade the scheduled vertices in batches of vertexBatchSize
+    for(uint32_t iBatchStart = 0; iBatchStart < nofShadedVertices; iBatchStart += vertexBatchSize) {
+        const uint32_t nofLanes = std::min(vertexBatchSize, nofShadedVertices - iBatchStart);
+
+        if(batchVertexShader) {
+            InVertexBatch inVertices;
+            inVertices.nofVertices = nofLanes;
+            for(uint32_t iLane = 0; iLane < nofLanes; iLane++) {
+                inVertices.gl_VertexID[iLane] = vertexIDs[shadedVertex[iBatchStart + iLane]];
+            } // for(iLane)
+
+            // Attribute after attribute, so each fetch routine runs over the whole batch
+            for(uint32_t iActive = 0; iActive < fetcher.nofAttributes; iActive++) {
+                Attrib *attributes = inVertices.attributes[fetcher.attributeIndex[iActive]];
+                for(uint32_t iLane = 0; iLane < nofLanes; iLane++) {
+                    const uint8_t *pAttribute = fetcher.pAttributes[iActive] + fetcher.attributeStride[iActive] * inVertices.gl_VertexID[iLane];
+                    fetcher.fetchAttribute[iActive](pAttribute, attributes[iLane]);
+                } // for(iLane)
+            } // for(iActive)
+
+            OutVertex shadedVertices[vertexBatchSize];
+            batchVertexShader(shadedVertices, inVertices, shaderInterface);
+            pipelineCounters.verticesShaded += nofLanes;
+            for(uint32_t iLane = 0; iLane < nofLanes; iLane++) {
+                outVertices[shadedVertex[iBatchStart + iLane]] = shadedVertices[iLane];
+            } // for(iLane)
+        }
+        else {
+            // No batch shader - the per-vertex shader is run for each lane
+            for(uint32_t iLane = 0; iLane < nofLanes; iLane++) {
+                const uint32_t iVertex = shadedVertex[iBatchStart + iLane];
+
+                InVertex inVertex;
+                inVertex.gl_VertexID = vertexIDs[iVertex];
+                for(uint32_t iActive = 0; iActive < fetcher.nofAttributes; iActive++) {
+                    const uint8_t *pAttribute = fetcher.pAttributes[iActive] + fetcher.attributeStride[iActive] * inVertex.gl_VertexID;
+                    fetcher.fetchAttribute[iActive](pAttribute, inVertex.attributes[fetcher.attributeIndex[iActive]]);
+                } // for(iActive)
+
+                program.vertexShader(outVertices[iVertex], inVertex, shaderInterface);
+                pipelineCounters.verticesShaded++;
+            } // for(iLane)
+        }
+    } // for(iBatchStart)
+
+    if(useVertexCache) {
+        for(uint32_t iShaded = 0; iShaded < nofShadedVertices; iShaded++) {
+            storeCachedVertex(vertexIDs[shadedVertex[iShaded]], outVertices[shadedVertex[iShaded]]);
+        } // for(iShaded)
+    }
+
+    for(uint32_t iDuplicate = 0; iDuplicate < nofDuplicates; iDuplicate++) {
+        outVertices[duplicateVertex[iDuplicate]] = outVertices[duplicateOf[iDuplicate]];
+    } // for(iDuplicate)
+} // runBatchedVertexStage()
+
 
 /******************************************************************************/
 /*                                                                            */
@@ -546,6 +1364,71 @@ inline void vertexAssemblyUnit(const GPUMemory &memory, InVertex &inVertex) {
 /*                                                                            */
 /******************************************************************************/
 
+// === TEST 25-41 ===
+inline void processTriangle(const GPUMemory &memory, const Program &program, const Framebuffer &frameBuffer,
+                            const ShaderInterface &shaderInterface, const FragmentBackEnd &fragmentBackEnd,
+                            const OutVertex outTriangle[3], const bool useTileBinning, const uint32_t binnedDrawIndex,
+                            const ScreenRegion &frameBufferRegion) {
+    pipelineCounters.trianglesIn++;
+
+    // === TEST 38-41 ===
+    // Apply triangle clipping using Sutherland-Hodgman algorithm
+    OutVertex clippedTriangles[2][3];
+    const uint32_t clippedTrinaglesCount = clippingSutherlandHodgman(program, outTriangle, clippedTriangles);
+
+    for(uint32_t iClippedTriangle = 0; iClippedTriangle < clippedTrinaglesCount; iClippedTriangle++) {
+        glm::vec3 screenSpaceVertices[3];
+        float oneOverW[3];
+
+        // === TEST 25 ===
+        // Apply viewport transform to each vertex of the clipped triangle
+        for(int iVertex = 0; iVertex < 3; iVertex++) {
+            // Perform perspective division to convert from clip space to normalized device coordinates (NDC)
+            const glm::vec3 normalizedDeviceCoordinates = perspectiveDivision(clippedTriangles[iClippedTriangle][iVertex].gl_Position, oneOverW[iVertex]);
+
+            // Transform NDC coordinates (range [-1,1]) to screen space coordinates (range [0,width/height])
+            screenSpaceVertices[iVertex] = viewportTransformation(normalizedDeviceCoordinates, frameBuffer.width, frameBuffer.height);
+        } // for(iVertex)
+
+        // === TEST 26 ===
+        if(backFaceCulling(screenSpaceVertices, memory.backfaceCulling)) {
+            pipelineCounters.trianglesCulled++;
+            continue;
+        }
+
+        // Zero-area triangles are only counted, the rasterizer rejects them
+        // (the same signed double-area as in the rasterizer)
+        const float signedDoubleArea = (screenSpaceVertices[1].x - screenSpaceVertices[0].x) * (screenSpaceVertices[2].y - screenSpaceVertices[0].y) -
+                                       (screenSpaceVertices[1].y - screenSpaceVertices[0].y) * (screenSpaceVertices[2].x - screenSpaceVertices[0].x);
+        if(signedDoubleArea == 0.f) {
+            pipelineCounters.trianglesDegenerate++;
+        }
+
+        // Sort-middle back-end: the triangle is only stored into tile bins here
+        if(useTileBinning) {
+            binTriangle(binnedDrawIndex, clippedTriangles[iClippedTriangle], screenSpaceVertices, oneOverW);
+            continue;
+        }
+
+        // Tiles of the triangle must be cleared before their pixels are read
+        if(hasPendingDeferredClears()) {
+            resolveDeferredClearsOfTriangle(screenSpaceVertices, frameBuffer);
+        }
+
+        // === TEST 22-24, 27-37 ===
+        // All these steps are handled by the rasterizeTriangleUsingPineda function
+        rasterizeTriangleUsingPineda(memory,                              // GPU state
+                                     program,                             // active program
+                                     frameBuffer,                         // active framebuffer
+                                     shaderInterface,                     // constants for fragment shader
+                                     fragmentBackEnd,                     // per-fragment operations of the draw
+                                     clippedTriangles[iClippedTriangle],  // vertex shader outputs
+                                     screenSpaceVertices,                 // vertices in screen-space
+                                     oneOverW,                            // 1/w for perspective correction
+                                     frameBufferRegion);                  // rasterize the whole framebuffer
+    } // for(iClippedTriangle)
+} // processTriangle()
+
 // === TEST 25 ===
 inline glm::vec3 perspectiveDivision(const glm::vec4 &clipSpacePosition, float &oneOverW) {
     // Calculate inverse of w-component (1/w) for perspective division
@@ -614,9 +1497,17 @@ inline void rasterizeTriangleUsingPineda(const GPUMemory &memory,
     /**********************************/ const Program &program,
     /*                    C           */ const Framebuffer &frameBuffer,
     /*   v(CA) = -v(AC)  / \  v(BC)   */ const ShaderInterface &shaderInterface,
-    /*                  /   \         */ const OutVertex outTriangle[3],
-    /*                 A-----B        */ const glm::vec3 vertices[3],
-    /*                  v(AB)         */ const float oneOverW[3]) {
+    /*                  /   \         */ const FragmentBackEnd &fragmentBackEnd,
+    /*                 A-----B        */ const OutVertex outTriangle[3],
+    /*                  v(AB)         */ const glm::vec3 vertices[3],
+    /*                                */ const float oneOverW[3],
+    /**********************************/ const ScreenRegion &region) {
+    // Fixed-point mode handles everything except triangles out of its guard band
+    if(getGPUSettings().fixedPointRasterization &&
+       rasterizeTriangleFixedPoint(memory, program, frameBuffer, shaderInterface, fragmentBackEnd, outTriangle, vertices, oneOverW, region)) {
+        return;
+    }
+
     /**************************************************************************/
     /*                Calculate vectors/edges of the triangle                 */
     /**************************************************************************/
@@ -688,24 +1579,24 @@ inline void rasterizeTriangleUsingPineda(const GPUMemory &memory,
     /*                 Calculate bounding box of the triangle                 */
     /**************************************************************************/
 
-    // Find the min/max coordinates among the triangle vertices
-    const float minVertexX = std::min({vertices[0].x, vertices[1].x, vertices[2].x});
-    const float maxVertexX = std::max({vertices[0].x, vertices[1].x, vertices[2].x});
-    const float minVertexY = std::min({vertices[0].y, vertices[1].y, vertices[2].y});
-    const float maxVertexY = std::max({vertices[0].y, vertices[1].y, vertices[2].y});
-
-    // Round the minimum coordinate down and maximum coordinate up
-    const int minVertexFlooredX = static_cast<int>(std::floor(minVertexX));
-    const int maxVertexCeiledX = static_cast<int>(std::ceil(maxVertexX));
-    const int minVertexFlooredY = static_cast<int>(std::floor(minVertexY));
-    const int maxVertexCeiledY = static_cast<int>(std::ceil(maxVertexY));
-
-    // Clamp the coordinates to the framebuffer boundaries
-    //                         | vertices extreme | MINimal pixel coord. | MAXimal pixel coordinate               |
-    const int minX = glm::clamp(minVertexFlooredX,  0,                     static_cast<int>(frameBuffer.width - 1));
-    const int maxX = glm::clamp(maxVertexCeiledX,   0,                     static_cast<int>(frameBuffer.width - 1));
-    const int minY = glm::clamp(minVertexFlooredY,  0,                     static_cast<int>(frameBuffer.height - 1));
-    const int maxY = glm::clamp(maxVertexCeiledY,   0,                     static_cast<int>(frameBuffer.height - 1));
+    // Bounding box clamped to the framebuffer boundaries
+    ScreenRegion boundingBox;
+    computeTriangleBoundingBox(vertices, frameBuffer, boundingBox);
+    const int minX = boundingBox.minX;
+    const int maxX = boundingBox.maxX;
+    const int minY = boundingBox.minY;
+    const int maxY = boundingBox.maxY;
+
+    // Part of the bounding box that lies inside of the rasterized region
+    // Note: The serial rasterizer passes the whole framebuffer, so the region
+    //       equals to the bounding box there.
+    const int regionMinX = std::max(minX, region.minX);
+    const int regionMaxX = std::min(maxX, region.maxX);
+    const int regionMinY = std::max(minY, region.minY);
+    const int regionMaxY = std::min(maxY, region.maxY);
+    if(regionMinX > regionMaxX || regionMinY > regionMaxY) {
+        return;
+    }
 
 
     /**************************************************************************/
@@ -734,76 +1625,287 @@ inline void rasterizeTriangleUsingPineda(const GPUMemory &memory,
     /*   Rasterization loop using Pineda's edge functions and Scanline fill   */
     /**************************************************************************/
 
-    // === TEST 22-24 ==
-    // Rasterization loop over the bounding box of the triangle using Pineda's edge functions
-    for(int y = minY; y <= maxY; y++) {
-        // Initialize edge function values at the start of this scanline
-        float edgeFunction12 = edge12RowStart;
-        float edgeFunction20 = edge20RowStart;
-        float edgeFunction01 = edge01RowStart;
+    // Constants shared by all fragments of the triangle
+    TriangleSetup triangleSetup;
+    triangleSetup.outTriangle = outTriangle;
+    triangleSetup.vertices = vertices;
+    triangleSetup.oneOverW = oneOverW;
+    triangleSetup.triangleArea = triangleArea;
+
+    // Barycentric coordinates are the edge functions divided by the area, so
+    // their per-pixel steps are the edge steps divided by the area
+    triangleSetup.barycentricStepX = glm::vec3(edgeStep12X, edgeStep20X, edgeStep01X) / triangleArea;
+    triangleSetup.barycentricStepY = glm::vec3(edgeStep12Y, edgeStep20Y, edgeStep01Y) / triangleArea;
+
+    // Determine front/back face for culling and stencil operations
+    triangleSetup.isFacingFront = ((signedDoubleArea > 0) == memory.backfaceCulling.frontFaceIsCounterClockWise);
+    triangleSetup.pFragmentBackEnd = &fragmentBackEnd;
+    if(!fragmentBackEnd.shadeDepth) {
+        setupAttributePlanes(program, outTriangle, vertices, oneOverW, minX, minY, triangleSetup.attributePlanes);
+    }
 
-        for(int x = minX; x <= maxX; x++) {
-            // Determine if pixel is inside triangle using edge functions
-            // Includes top-left rule to avoid double-drawing shared edges
-            const bool isInsideEdge12 = (edgeFunction12 > 0 || (edgeFunction12 == 0 && edge12TopLeft));
-            const bool isInsideEdge20 = (edgeFunction20 > 0 || (edgeFunction20 == 0 && edge20TopLeft));
-            const bool isInsideEdge01 = (edgeFunction01 > 0 || (edgeFunction01 == 0 && edge01TopLeft));
+    // Conservative bounds of the edge functions used for hierarchical traversal
+    // (column/row indices used for classification are relative to minX/minY)
+    const bool useHierarchy = getGPUSettings().hierarchicalRasterization;
+    const EdgeBounds edgeBounds[3] = {
+        computeEdgeBounds(edge12RowStart, edgeStep12X, edgeStep12Y, maxX - minX + 1, maxY - minY + 1),
+        computeEdgeBounds(edge20RowStart, edgeStep20X, edgeStep20Y, maxX - minX + 1, maxY - minY + 1),
+        computeEdgeBounds(edge01RowStart, edgeStep01X, edgeStep01Y, maxX - minX + 1, maxY - minY + 1)};
+
+    // Whole region (a tile of the binned rasterizer) can be rejected at once
+    if(useHierarchy && classifyBlock(edgeBounds, regionMinX - minX, regionMaxX - minX,
+                                     regionMinY - minY, regionMaxY - minY) == BlockClass::OUTSIDE) {
+        pipelineCounters.regionsOutside++;
+        return;
+    }
 
-            // Point is inside the triangle if all edge functions have the same sign
-            if(isInsideEdge12 && isInsideEdge20 && isInsideEdge01) {
-                // Calculate barycentric coordinates for interpolation
-                const float lambda0 = edgeFunction12 / triangleArea;
-                const float lambda1 = edgeFunction20 / triangleArea;
-                const float lambda2 = edgeFunction01 / triangleArea;
-
-                // === TEST 27 ===
-                // Calculating 2D Barycentric coordinates for depth interpolation
-                // fragment.gl_FragCoord.z = vertex[0].gl_Position.z * λ0_2D + vertex[1].gl_Position.z * λ1_2D + vertex[2].gl_Position.z * λ2_2D
-                const float depth = vertices[0].z * lambda0 + vertices[1].z * lambda1 + vertices[2].z * lambda2;
-
-                // Perspective correction for attribute interpolation
-                const float perspectiveLambda0 = lambda0 * oneOverW[0];
-                const float perspectiveLambda1 = lambda1 * oneOverW[1];
-                const float perspectiveLambda2 = lambda2 * oneOverW[2];
-
-                // Sum of perspective-corrected weights for normalization
-                // s  = (λ0_2D / h0) + (λ1_2D / h1) + (λ2_2D / h2);
-                const float sumWeight = perspectiveLambda0 + perspectiveLambda1 + perspectiveLambda2;
-                const float oneOverSumWeight = 1.0f / sumWeight;
-
-                // Normalized perspective-corrected weights
-                const float l0 = perspectiveLambda0 * oneOverSumWeight;  // λ0 = (λ0_2D / h0) / s;
-                const float l1 = perspectiveLambda1 * oneOverSumWeight;  // λ1 = (λ1_2D / h1) / s;
-                const float l2 = perspectiveLambda2 * oneOverSumWeight;  // λ2 = (λ2_2D / h2) / s;
-
-                // Set up fragment data structure (as described in '09 Rasterizace: InFragment')
-                InFragment inFragment;
-                inFragment.gl_FragCoord = glm::vec4(x + 0.5f, y + 0.5f, depth, oneOverSumWeight);
-
-                // === TEST 28-29 ===
-                // Interpolation of attributes for the fragment shader
-                interpolateFragmentAttributes(program, l0, l1, l2, inFragment, outTriangle);
-
-                // Determine front/back face for culling and stencil operations
-                const bool isFacingFront = ((signedDoubleArea > 0) == memory.backfaceCulling.frontFaceIsCounterClockWise);
-
-                // === TEST 30-33 ===
-                // If EPFO returned false, we skip the fragment shader execution
-                if(!executeEarlyPerFragmentOperations(memory, frameBuffer, inFragment, isFacingFront)) {
-                    edgeFunction12 += edgeStep12X;
-                    edgeFunction20 += edgeStep20X;
-                    edgeFunction01 += edgeStep01X;
+    // Hi-Z tiles where the whole triangle lies behind the depth buffer are
+    // skipped, the region is rejected at once if all of them are
+    OccludedTiles occludedTiles;
+    if(fragmentBackEnd.useHierarchicalDepth) {
+        const DepthPlane depthPlane = computeDepthPlane(vertices, edgeBounds, triangleArea, minX, minY, maxX - minX + 1, maxY - minY + 1);
+        const bool isRegionOccluded = findOccludedTiles(depthPlane, ScreenRegion{regionMinX, regionMinY, regionMaxX, regionMaxY}, occludedTiles);
+        pipelineCounters.depthTilesOccluded += occludedTiles.nofOccluded;
+        if(isRegionOccluded) {
+            pipelineCounters.regionsOccluded++;
+            return;
+        }
+    }
+    const bool hasOccludedTiles = occludedTiles.nofOccluded > 0;
+    const bool marksDepthTiles = fragmentBackEnd.useHierarchicalDepth && fragmentBackEnd.hasDepthWrites;
+
+    // Skip scanlines above the region
+    // Note: The edge functions are stepped exactly like in the full bounding
+    //       box traversal, so every pixel gets bit-identical (float) values no
+    //       matter in which tile it is rasterized.
+    for(int y = minY; y < regionMinY; y++) {
+        edge12RowStart += edgeStep12Y;
+        edge20RowStart += edgeStep20Y;
+        edge01RowStart += edgeStep01Y;
+    } // for(y)
+
+    if(getGPUSettings().quadShading) {
+        /**********************************************************************/
+        /*     Pairs of scanlines handed over in screen-aligned 2x2 quads     */
+        /**********************************************************************/
+
+        // Every scanline steps its edge functions by the very same float
+        // additions as the scalar loop below, two of them just run side by side
+        for(int quadY = regionMinY & ~1; quadY <= regionMaxY; quadY += quadSize) {
+            float edgeFunctions[quadSize][3];
+            bool hasRow[quadSize];
+            for(int iRow = 0; iRow < quadSize; iRow++) {
+                const int y = quadY + iRow;
+                hasRow[iRow] = y >= regionMinY && y <= regionMaxY;
+                if(!hasRow[iRow]) {
                     continue;
                 }
 
-                // === TEST 22 ===
-                // Call the fragment shader
-                OutFragment outFragment;
-                program.fragmentShader(outFragment, inFragment, shaderInterface);
+                edgeFunctions[iRow][0] = edge12RowStart;
+                edgeFunctions[iRow][1] = edge20RowStart;
+                edgeFunctions[iRow][2] = edge01RowStart;
+                edge12RowStart += edgeStep12Y;
+                edge20RowStart += edgeStep20Y;
+                edge01RowStart += edgeStep01Y;
+
+                // Skip pixels left of the region
+                for(int x = minX; x < regionMinX; x++) {
+                    edgeFunctions[iRow][0] += edgeStep12X;
+                    edgeFunctions[iRow][1] += edgeStep20X;
+                    edgeFunctions[iRow][2] += edgeStep01X;
+                } // for(x)
+            } // for(iRow)
+
+            float quadEdges[quadSize * quadSize][3];
+            uint32_t coverageMask = 0;
+            for(int x = regionMinX; x <= regionMaxX; x++) {
+                const int iColumn = x & 1;
+                for(int iRow = 0; iRow < quadSize; iRow++) {
+                    if(!hasRow[iRow]) {
+                        continue;
+                    }
 
-                // === TEST 22-24 ===
-                // Apply LPFO and write the color to the framebuffer
-                executeLatePerFragmentOperations(memory, frameBuffer, inFragment, outFragment, isFacingFront);
+                    float *edges = edgeFunctions[iRow];
+                    const bool isInsideEdge12 = (edges[0] > 0 || (edges[0] == 0 && edge12TopLeft));
+                    const bool isInsideEdge20 = (edges[1] > 0 || (edges[1] == 0 && edge20TopLeft));
+                    const bool isInsideEdge01 = (edges[2] > 0 || (edges[2] == 0 && edge01TopLeft));
+                    if(isInsideEdge12 && isInsideEdge20 && isInsideEdge01 &&
+                       !(hasOccludedTiles && isBlockOccluded(occludedTiles, x, quadY + iRow, x, quadY + iRow))) {
+                        const int iLane = iRow * quadSize + iColumn;
+                        coverageMask |= 1u << iLane;
+                        std::copy(edges, edges + 3, quadEdges[iLane]);
+                    }
+
+                    edges[0] += edgeStep12X;
+                    edges[1] += edgeStep20X;
+                    edges[2] += edgeStep01X;
+                } // for(iRow)
+
+                // Quad is complete in its right column or at the end of the region
+                if(iColumn == 1 || x == regionMaxX) {
+                    if(coverageMask) {
+                        processQuad(program, shaderInterface, triangleSetup, x & ~1, quadY, quadEdges, coverageMask);
+                    }
+                    coverageMask = 0;
+                }
+            } // for(x)
+        } // for(quadY)
+
+        if(marksDepthTiles) {
+            markDepthTilesWritten(occludedTiles);
+        }
+        return;
+    }
+
+    if(getGPUSettings().simdRasterization) {
+        /**********************************************************************/
+        /*        SIMD traversal of square blocks (simdWidth x simdWidth)     */
+        /**********************************************************************/
+
+        // Each SIMD lane holds one scanline of the block. The lanes step in X
+        // by the very same float additions as the scalar loop below, thus the
+        // coverage (including the top-left rule) is identical.
+        const SimdFloat edgeStep12XLanes = simdBroadcast(edgeStep12X);
+        const SimdFloat edgeStep20XLanes = simdBroadcast(edgeStep20X);
+        const SimdFloat edgeStep01XLanes = simdBroadcast(edgeStep01X);
+
+        // Block counters are accumulated locally and published once per triangle
+        uint64_t nofBlocksOutside = 0;
+        uint64_t nofBlocksInside = 0;
+        uint64_t nofBlocksPartial = 0;
+
+        for(int blockY = regionMinY; blockY <= regionMaxY; blockY += simdWidth) {
+            const uint32_t nofBlockRows = static_cast<uint32_t>(std::min<int>(simdWidth, regionMaxY - blockY + 1));
+
+            // Gather the row starts of all scanlines of the block row
+            alignas(32) float rowStarts[3][simdWidth] = {};
+            for(uint32_t iRow = 0; iRow < nofBlockRows; iRow++) {
+                rowStarts[0][iRow] = edge12RowStart;
+                rowStarts[1][iRow] = edge20RowStart;
+                rowStarts[2][iRow] = edge01RowStart;
+                edge12RowStart += edgeStep12Y;
+                edge20RowStart += edgeStep20Y;
+                edge01RowStart += edgeStep01Y;
+            } // for(iRow)
+            SimdFloat edgeFunction12 = simdLoad(rowStarts[0]);
+            SimdFloat edgeFunction20 = simdLoad(rowStarts[1]);
+            SimdFloat edgeFunction01 = simdLoad(rowStarts[2]);
+
+            // Lanes of missing scanlines (bottom of the region) are masked out
+            const uint32_t rowMask = (1u << nofBlockRows) - 1u;
+
+            // Skip pixels left of the region
+            for(int x = minX; x < regionMinX; x++) {
+                edgeFunction12 = simdAdd(edgeFunction12, edgeStep12XLanes);
+                edgeFunction20 = simdAdd(edgeFunction20, edgeStep20XLanes);
+                edgeFunction01 = simdAdd(edgeFunction01, edgeStep01XLanes);
+            } // for(x)
+
+            for(int blockX = regionMinX; blockX <= regionMaxX; blockX += simdWidth) {
+                const uint32_t nofBlockColumns = static_cast<uint32_t>(std::min<int>(simdWidth, regionMaxX - blockX + 1));
+
+                // Block behind the depth buffer - no pixel can pass the depth test
+                if(hasOccludedTiles && isBlockOccluded(occludedTiles, blockX, blockY, blockX + static_cast<int>(nofBlockColumns) - 1,
+                                                       blockY + static_cast<int>(nofBlockRows) - 1)) {
+                    for(uint32_t iColumn = 0; iColumn < nofBlockColumns; iColumn++) {
+                        edgeFunction12 = simdAdd(edgeFunction12, edgeStep12XLanes);
+                        edgeFunction20 = simdAdd(edgeFunction20, edgeStep20XLanes);
+                        edgeFunction01 = simdAdd(edgeFunction01, edgeStep01XLanes);
+                    } // for(iColumn)
+                    continue;
+                }
+
+                // Classify the block against all three edges
+                const BlockClass blockClass = !useHierarchy
+                    ? BlockClass::PARTIAL
+                    : classifyBlock(edgeBounds, blockX - minX, blockX - minX + static_cast<int>(nofBlockColumns) - 1,
+                                    blockY - minY, blockY - minY + static_cast<int>(nofBlockRows) - 1);
+
+                // Block fully outside - only step the edge functions over it
+                if(blockClass == BlockClass::OUTSIDE) {
+                    nofBlocksOutside++;
+                    for(uint32_t iColumn = 0; iColumn < nofBlockColumns; iColumn++) {
+                        edgeFunction12 = simdAdd(edgeFunction12, edgeStep12XLanes);
+                        edgeFunction20 = simdAdd(edgeFunction20, edgeStep20XLanes);
+                        edgeFunction01 = simdAdd(edgeFunction01, edgeStep01XLanes);
+                    } // for(iColumn)
+                    continue;
+                }
+                (blockClass == BlockClass::INSIDE ? nofBlocksInside : nofBlocksPartial)++;
+
+                // Evaluate edge functions of the whole block and build its coverage mask
+                // Note: Bit (iColumn * simdWidth + iRow) represents one pixel.
+                alignas(32) float blockEdges[3][simdWidth][simdWidth];
+                uint64_t coverageMask = 0;
+                for(uint32_t iColumn = 0; iColumn < nofBlockColumns; iColumn++) {
+                    // Block fully inside covers all its pixels without any edge tests
+                    const uint32_t columnMask = blockClass == BlockClass::INSIDE
+                        ? rowMask
+                        : simdEdgeInsideMask(edgeFunction12, edge12TopLeft) &
+                          simdEdgeInsideMask(edgeFunction20, edge20TopLeft) &
+                          simdEdgeInsideMask(edgeFunction01, edge01TopLeft) & rowMask;
+                    coverageMask |= static_cast<uint64_t>(columnMask) << (iColumn * simdWidth);
+
+                    simdStore(blockEdges[0][iColumn], edgeFunction12);
+                    simdStore(blockEdges[1][iColumn], edgeFunction20);
+                    simdStore(blockEdges[2][iColumn], edgeFunction01);
+
+                    edgeFunction12 = simdAdd(edgeFunction12, edgeStep12XLanes);
+                    edgeFunction20 = simdAdd(edgeFunction20, edgeStep20XLanes);
+                    edgeFunction01 = simdAdd(edgeFunction01, edgeStep01XLanes);
+                } // for(iColumn)
+
+                // Blocks completely outside of the triangle generate no work at all
+                while(coverageMask) {
+                    const uint32_t iPixel = static_cast<uint32_t>(__builtin_ctzll(coverageMask));
+                    coverageMask &= coverageMask - 1;
+
+                    const uint32_t iColumn = iPixel / simdWidth;
+                    const uint32_t iRow = iPixel % simdWidth;
+                    processFragment(program, shaderInterface, triangleSetup,
+                                    blockX + static_cast<int>(iColumn), blockY + static_cast<int>(iRow),
+                                    blockEdges[0][iColumn][iRow], blockEdges[1][iColumn][iRow], blockEdges[2][iColumn][iRow]);
+                } // while(coverageMask)
+            } // for(blockX)
+        } // for(blockY)
+
+        pipelineCounters.blocksOutside += nofBlocksOutside;
+        pipelineCounters.blocksInside += nofBlocksInside;
+        pipelineCounters.blocksPartial += nofBlocksPartial;
+        if(marksDepthTiles) {
+            markDepthTilesWritten(occludedTiles);
+        }
+        return;
+    }
+
+    // === TEST 22-24 ==
+    // Rasterization loop over the bounding box of the triangle using Pineda's edge functions
+    for(int y = regionMinY; y <= regionMaxY; y++) {
+        // Initialize edge function values at the start of this scanline
+        float edgeFunction12 = edge12RowStart;
+        float edgeFunction20 = edge20RowStart;
+        float edgeFunction01 = edge01RowStart;
+
+        // Skip pixels left of the region (again by stepping for exact values)
+        for(int x = minX; x < regionMinX; x++) {
+            edgeFunction12 += edgeStep12X;
+            edgeFunction20 += edgeStep20X;
+            edgeFunction01 += edgeStep01X;
+        } // for(x)
+
+        for(int x = regionMinX; x <= regionMaxX; x++) {
+            // Determine if pixel is inside triangle using edge functions
+            // Includes top-left rule to avoid double-drawing shared edges
+            const bool isInsideEdge12 = (edgeFunction12 > 0 || (edgeFunction12 == 0 && edge12TopLeft));
+            const bool isInsideEdge20 = (edgeFunction20 > 0 || (edgeFunction20 == 0 && edge20TopLeft));
+            const bool isInsideEdge01 = (edgeFunction01 > 0 || (edgeFunction01 == 0 && edge01TopLeft));
+
+            // Point is inside the triangle if all edge functions have the same sign
+            // (pixels of occluded Hi-Z tiles would fail the depth test)
+            if(isInsideEdge12 && isInsideEdge20 && isInsideEdge01 &&
+               !(hasOccludedTiles && isBlockOccluded(occludedTiles, x, y, x, y))) {
+                processFragment(program, shaderInterface, triangleSetup,
+                                x, y, edgeFunction12, edgeFunction20, edgeFunction01);
             } // if(shouldDraw)
 
             // Increment edge function values for the next pixel in this scanline
@@ -817,8 +1919,466 @@ inline void rasterizeTriangleUsingPineda(const GPUMemory &memory,
         edge20RowStart += edgeStep20Y;
         edge01RowStart += edgeStep01Y;
     } // for(y)
+
+    if(marksDepthTiles) {
+        markDepthTilesWritten(occludedTiles);
+    }
 } // rasterizeTriangleUsingPineda()
 
+inline bool rasterizeTriangleFixedPoint(const GPUMemory &memory, const Program &program,
+                                        const Framebuffer &frameBuffer, const ShaderInterface &shaderInterface,
+                                        const FragmentBackEnd &fragmentBackEnd, const OutVertex outTriangle[3],
+                                        const glm::vec3 vertices[3], const float oneOverW[3], const ScreenRegion &region) {
+    // 8 fractional bits => 1/256 pixel grid
+    constexpr int64_t subPixelBits = 8;
+    constexpr int64_t subPixelOne = int64_t(1) << subPixelBits;
+    constexpr int64_t subPixelHalf = subPixelOne / 2;
+
+    // Coordinates up to 2^21 pixels keep all products of the edge functions
+    // inside of 64-bit integers (2^29 * 2^30 * 3 < 2^63), vertices beyond this
+    // guard band are left for the float rasterizer
+    constexpr float guardBand = static_cast<float>(1 << 21);
+    for(int iVertex = 0; iVertex < 3; iVertex++) {
+        if(!(std::fabs(vertices[iVertex].x) < guardBand && std::fabs(vertices[iVertex].y) < guardBand)) {
+            return false;
+        }
+    } // for(iVertex)
+
+
+    /**************************************************************************/
+    /*              Snap vertices to the sub-pixel grid (x256)                */
+    /**************************************************************************/
+    int64_t snappedX[3];
+    int64_t snappedY[3];
+    for(int iVertex = 0; iVertex < 3; iVertex++) {
+        snappedX[iVertex] = std::llround(static_cast<double>(vertices[iVertex].x) * subPixelOne);
+        snappedY[iVertex] = std::llround(static_cast<double>(vertices[iVertex].y) * subPixelOne);
+    } // for(iVertex)
+
+    // Signed double-area of the snapped triangle (exact)
+    const int64_t signedDoubleArea = (snappedX[1] - snappedX[0]) * (snappedY[2] - snappedY[0]) -
+                                     (snappedY[1] - snappedY[0]) * (snappedX[2] - snappedX[0]);
+    if(signedDoubleArea == 0) {
+        return true;  // degenerated triangle generates no fragments
+    }
+    const int64_t orientation = signedDoubleArea > 0 ? 1 : -1;
+
+
+    /**************************************************************************/
+    /*        Integer edge equations (same orientation as float version)      */
+    /**************************************************************************/
+    // Edge iEdge goes from vertex edgeStart[iEdge] to edgeEnd[iEdge] and its value
+    // is the (scaled) barycentric coordinate of the opposite vertex: 12, 20, 01
+    constexpr int edgeStart[3] = {1, 2, 0};
+    constexpr int edgeEnd[3] = {2, 0, 1};
+    int64_t edgeA[3], edgeB[3], edgeC[3];
+    bool edgeTopLeft[3];
+    for(int iEdge = 0; iEdge < 3; iEdge++) {
+        const int start = edgeStart[iEdge];
+        const int end = edgeEnd[iEdge];
+        edgeA[iEdge] = -(snappedY[end] - snappedY[start]) * orientation;
+        edgeB[iEdge] = (snappedX[end] - snappedX[start]) * orientation;
+        edgeC[iEdge] = -(edgeA[iEdge] * snappedX[start] + edgeB[iEdge] * snappedY[start]);
+
+        // The very same 'top-left' rule as in the float rasterizer
+        edgeTopLeft[iEdge] = (edgeB[iEdge] > 0) || (edgeB[iEdge] == 0 && edgeA[iEdge] > 0);
+    } // for(iEdge)
+
+    // Edge value in a pixel center, evaluated directly - thus independent of
+    // the traversal order
+    auto evaluateEdge = [&](const int iEdge, const int x, const int y) {
+        return edgeA[iEdge] * (x * subPixelOne + subPixelHalf) + edgeB[iEdge] * (y * subPixelOne + subPixelHalf) + edgeC[iEdge];
+    };
+
+
+    /**************************************************************************/
+    /*                  Bounding box limited to the region                    */
+    /**************************************************************************/
+    // Note: Snapped vertices never leave the pixel range of the float bounding box
+    ScreenRegion boundingBox;
+    computeTriangleBoundingBox(vertices, frameBuffer, boundingBox);
+    const int minX = std::max(boundingBox.minX, region.minX);
+    const int maxX = std::min(boundingBox.maxX, region.maxX);
+    const int minY = std::max(boundingBox.minY, region.minY);
+    const int maxY = std::min(boundingBox.maxY, region.maxY);
+
+    TriangleSetup triangleSetup;
+    triangleSetup.outTriangle = outTriangle;
+    triangleSetup.vertices = vertices;
+    triangleSetup.oneOverW = oneOverW;
+    triangleSetup.triangleArea = static_cast<float>(signedDoubleArea * orientation);
+    triangleSetup.barycentricStepX = glm::vec3(static_cast<float>(edgeA[0] * subPixelOne), static_cast<float>(edgeA[1] * subPixelOne),
+                                               static_cast<float>(edgeA[2] * subPixelOne)) / triangleSetup.triangleArea;
+    triangleSetup.barycentricStepY = glm::vec3(static_cast<float>(edgeB[0] * subPixelOne), static_cast<float>(edgeB[1] * subPixelOne),
+                                               static_cast<float>(edgeB[2] * subPixelOne)) / triangleSetup.triangleArea;
+    triangleSetup.isFacingFront = ((signedDoubleArea > 0) == memory.backfaceCulling.frontFaceIsCounterClockWise);
+    triangleSetup.pFragmentBackEnd = &fragmentBackEnd;
+    if(!fragmentBackEnd.shadeDepth) {
+        // Planes are relative to the whole bounding box, thus independent of the region
+        setupAttributePlanes(program, outTriangle, vertices, oneOverW, boundingBox.minX, boundingBox.minY,
+                             triangleSetup.attributePlanes);
+    }
+
+
+    /**************************************************************************/
+    /*              Hi-Z tiles behind the depth buffer are skipped            */
+    /**************************************************************************/
+    OccludedTiles occludedTiles;
+    if(fragmentBackEnd.useHierarchicalDepth && minX <= maxX && minY <= maxY) {
+        // Depth is the exact plane of the integer edge functions, the
+        // barycentric coordinates are exact up to the float conversions and
+        // they sum up to one, so 16 ulps of the depth cover the interpolation
+        const double area = static_cast<double>(signedDoubleArea * orientation);
+        DepthPlane depthPlane{0., 0., 0., 0., minX, minY};
+        double maxAbsDepth = 0.;
+        double magnitude = 0.;
+        for(int iEdge = 0; iEdge < 3; iEdge++) {
+            const double depth = vertices[iEdge].z;
+            const double originValue = static_cast<double>(evaluateEdge(iEdge, minX, minY));
+            const double stepX = static_cast<double>(edgeA[iEdge] * subPixelOne);
+            const double stepY = static_cast<double>(edgeB[iEdge] * subPixelOne);
+            depthPlane.a += depth * stepX;
+            depthPlane.b += depth * stepY;
+            depthPlane.c += depth * originValue;
+            maxAbsDepth = std::max(maxAbsDepth, std::fabs(depth));
+            magnitude += std::fabs(depth) * (std::fabs(originValue) + std::fabs(stepX) * (maxX - minX + 1) + std::fabs(stepY) * (maxY - minY + 1));
+        } // for(iEdge)
+        depthPlane.a /= area;
+        depthPlane.b /= area;
+        depthPlane.c /= area;
+        depthPlane.margin = 0x1p-20 * maxAbsDepth + 0x1p-40 * magnitude / area;
+
+        const bool isRegionOccluded = findOccludedTiles(depthPlane, ScreenRegion{minX, minY, maxX, maxY}, occludedTiles);
+        pipelineCounters.depthTilesOccluded += occludedTiles.nofOccluded;
+        if(isRegionOccluded) {
+            pipelineCounters.regionsOccluded++;
+            return true;
+        }
+    }
+    const bool hasOccludedTiles = occludedTiles.nofOccluded > 0;
+
+
+    /**************************************************************************/
+    /*       Traversal of 8x8 blocks with exact (integer) classification      */
+    /**************************************************************************/
+    constexpr int blockSize = 8;
+    const bool useHierarchy = getGPUSettings().hierarchicalRasterization;
+    uint64_t nofBlocksOutside = 0;
+    uint64_t nofBlocksInside = 0;
+    uint64_t nofBlocksPartial = 0;
+
+    // Quads are aligned to even pixels, so are the blocks (pixels outside of
+    // the region are never covered)
+    const bool useQuads = getGPUSettings().quadShading;
+    const int firstBlockX = useQuads ? minX & ~1 : minX;
+    const int firstBlockY = useQuads ? minY & ~1 : minY;
+
+    for(int blockY = firstBlockY; blockY <= maxY; blockY += blockSize) {
+        const int blockMaxY = std::min(blockY + blockSize - 1, maxY);
+
+        for(int blockX = firstBlockX; blockX <= maxX; blockX += blockSize) {
+            const int blockMaxX = std::min(blockX + blockSize - 1, maxX);
+
+            // Block behind the depth buffer - no pixel can pass the depth test
+            if(hasOccludedTiles && isBlockOccluded(occludedTiles, std::max(blockX, minX), std::max(blockY, minY), blockMaxX, blockMaxY)) {
+                continue;
+            }
+
+            // Edge functions are linear, so the corners give exact extremes
+            BlockClass blockClass = BlockClass::PARTIAL;
+            if(useHierarchy) {
+                blockClass = BlockClass::INSIDE;
+                for(int iEdge = 0; iEdge < 3 && blockClass != BlockClass::OUTSIDE; iEdge++) {
+                    const int64_t corners[4] = {evaluateEdge(iEdge, blockX, blockY), evaluateEdge(iEdge, blockMaxX, blockY),
+                                                evaluateEdge(iEdge, blockX, blockMaxY), evaluateEdge(iEdge, blockMaxX, blockMaxY)};
+                    const int64_t minValue = std::min({corners[0], corners[1], corners[2], corners[3]});
+                    const int64_t maxValue = std::max({corners[0], corners[1], corners[2], corners[3]});
+                    if(maxValue < 0) {
+                        blockClass = BlockClass::OUTSIDE;
+                    } else if(minValue <= 0) {
+                        blockClass = BlockClass::PARTIAL;
+                    }
+                } // for(iEdge)
+            }
+
+            if(blockClass == BlockClass::OUTSIDE) {
+                nofBlocksOutside++;
+                continue;
+            }
+            (blockClass == BlockClass::INSIDE ? nofBlocksInside : nofBlocksPartial)++;
+
+            if(useQuads) {
+                for(int quadY = blockY; quadY <= blockMaxY; quadY += quadSize) {
+                    for(int quadX = blockX; quadX <= blockMaxX; quadX += quadSize) {
+                        float quadEdges[quadSize * quadSize][3];
+                        uint32_t coverageMask = 0;
+                        for(int iLane = 0; iLane < quadSize * quadSize; iLane++) {
+                            const int x = quadX + iLane % quadSize;
+                            const int y = quadY + iLane / quadSize;
+                            if(x < minX || x > maxX || y < minY || y > maxY) {
+                                continue;
+                            }
+
+                            const int64_t edgeFunction[3] = {evaluateEdge(0, x, y), evaluateEdge(1, x, y), evaluateEdge(2, x, y)};
+                            bool isInside = blockClass == BlockClass::INSIDE;
+                            if(!isInside) {
+                                isInside = true;
+                                for(int iEdge = 0; iEdge < 3; iEdge++) {
+                                    isInside &= edgeFunction[iEdge] > 0 || (edgeFunction[iEdge] == 0 && edgeTopLeft[iEdge]);
+                                } // for(iEdge)
+                            }
+
+                            if(isInside) {
+                                coverageMask |= 1u << iLane;
+                                for(int iEdge = 0; iEdge < 3; iEdge++) {
+                                    quadEdges[iLane][iEdge] = static_cast<float>(edgeFunction[iEdge]);
+                                } // for(iEdge)
+                            }
+                        } // for(iLane)
+
+                        if(coverageMask) {
+                            processQuad(program, shaderInterface, triangleSetup, quadX, quadY, quadEdges, coverageMask);
+                        }
+                    } // for(quadX)
+                } // for(quadY)
+                continue;
+            }
+
+            for(int y = blockY; y <= blockMaxY; y++) {
+                // Integer stepping is exact, so it equals the direct evaluation
+                int64_t edgeFunction[3] = {evaluateEdge(0, blockX, y), evaluateEdge(1, blockX, y), evaluateEdge(2, blockX, y)};
+
+                for(int x = blockX; x <= blockMaxX; x++) {
+                    bool isInside = blockClass == BlockClass::INSIDE;
+                    if(!isInside) {
+                        isInside = true;
+                        for(int iEdge = 0; iEdge < 3; iEdge++) {
+                            isInside &= edgeFunction[iEdge] > 0 || (edgeFunction[iEdge] == 0 && edgeTopLeft[iEdge]);
+                        } // for(iEdge)
+                    }
+
+                    if(isInside) {
+                        processFragment(program, shaderInterface, triangleSetup, x, y,
+                                        static_cast<float>(edgeFunction[0]),
+                                        static_cast<float>(edgeFunction[1]),
+                                        static_cast<float>(edgeFunction[2]));
+                    }
+
+                    for(int iEdge = 0; iEdge < 3; iEdge++) {
+                        edgeFunction[iEdge] += edgeA[iEdge] * subPixelOne;
+                    } // for(iEdge)
+                } // for(x)
+            } // for(y)
+        } // for(blockX)
+    } // for(blockY)
+
+    pipelineCounters.blocksOutside += nofBlocksOutside;
+    pipelineCounters.blocksInside += nofBlocksInside;
+    pipelineCounters.blocksPartial += nofBlocksPartial;
+    if(fragmentBackEnd.useHierarchicalDepth && fragmentBackEnd.hasDepthWrites) {
+        markDepthTilesWritten(occludedTiles);
+    }
+    return true;
+} // rasterizeTriangleFixedPoint()
+
+inline EdgeBounds computeEdgeBounds(const float firstPixelValue, const float stepX, const float stepY,
+                                    const int nofColumns, const int nofRows) {
+    EdgeBounds bounds;
+    bounds.firstPixelValue = firstPixelValue;
+    bounds.stepX = stepX;
+    bounds.stepY = stepY;
+
+    // Every partial sum of the incremental evaluation is bounded by M and each
+    // float addition rounds by at most 2^-24 * M. We use 2^-23 to stay safe.
+    const double maxMagnitude = std::fabs(static_cast<double>(firstPixelValue)) +
+                                std::fabs(static_cast<double>(stepX)) * nofColumns +
+                                std::fabs(static_cast<double>(stepY)) * nofRows;
+    bounds.errorPerStep = maxMagnitude * 0x1p-23;
+    return bounds;
+} // computeEdgeBounds()
+
+inline BlockClass classifyBlock(const EdgeBounds edges[3], const int firstColumn, const int lastColumn,
+                                const int firstRow, const int lastRow) {
+    // Accumulated error grows with the number of additions, the farthest pixel is the worst one
+    const double nofSteps = static_cast<double>(lastColumn + lastRow + 1);
+
+    bool isInside = true;
+    for(int iEdge = 0; iEdge < 3; iEdge++) {
+        const EdgeBounds &edge = edges[iEdge];
+
+        // Edge function is linear, thus its extremes lie in the block corners
+        const double columnA = edge.stepX * static_cast<double>(firstColumn);
+        const double columnB = edge.stepX * static_cast<double>(lastColumn);
+        const double rowA = edge.stepY * static_cast<double>(firstRow);
+        const double rowB = edge.stepY * static_cast<double>(lastRow);
+        const double minValue = edge.firstPixelValue + std::min(columnA, columnB) + std::min(rowA, rowB);
+        const double maxValue = edge.firstPixelValue + std::max(columnA, columnB) + std::max(rowA, rowB);
+        const double margin = edge.errorPerStep * nofSteps;
+
+        // Note: NaN values fail both comparisons and end up as PARTIAL
+        if(maxValue < -margin) {
+            return BlockClass::OUTSIDE;
+        }
+        if(!(minValue > margin)) {
+            isInside = false;
+        }
+    } // for(iEdge)
+
+    return isInside ? BlockClass::INSIDE : BlockClass::PARTIAL;
+} // classifyBlock()
+
+inline DepthPlane computeDepthPlane(const glm::vec3 vertices[3], const EdgeBounds edgeBounds[3], const float triangleArea,
+                                    const int minX, const int minY, const int nofColumns, const int nofRows) {
+    DepthPlane plane{0., 0., 0., 0., minX, minY};
+    const double nofSteps = static_cast<double>(nofColumns + nofRows + 1);
+    double maxAbsDepth = 0.;
+    double edgeError = 0.;
+    double lambdaSum = 0.;
+    for(int iEdge = 0; iEdge < 3; iEdge++) {
+        // Edge function iEdge is the barycentric coordinate of vertex iEdge (times the area)
+        const EdgeBounds &edge = edgeBounds[iEdge];
+        const double depth = vertices[iEdge].z;
+        plane.a += depth * edge.stepX;
+        plane.b += depth * edge.stepY;
+        plane.c += depth * edge.firstPixelValue;
+
+        // Error and magnitude of the edge function anywhere in the bounding box
+        const double error = edge.errorPerStep * nofSteps;
+        const double magnitude = edge.errorPerStep * 0x1p23;
+        edgeError += std::fabs(depth) * error;
+        lambdaSum += magnitude + error;
+        maxAbsDepth = std::max(maxAbsDepth, std::fabs(depth));
+    } // for(iEdge)
+    plane.a /= triangleArea;
+    plane.b /= triangleArea;
+    plane.c /= triangleArea;
+
+    // Edge functions of covered pixels are not negative, so the rounding of
+    // the division and of the interpolation (8 ulps) is relative to their sum,
+    // the plane itself is evaluated in doubles
+    plane.margin = (edgeError + (0x1p-21 + 0x1p-40) * maxAbsDepth * lambdaSum) / triangleArea;
+    return plane;
+} // computeDepthPlane()
+
+//! Fragment whose shader is running on the calling thread (for attribute derivatives)
+static thread_local ShadedFragment shadedFragment;
+
+// === TEST 22, 27-37 ===
+inline void processFragment(const Program &program, const ShaderInterface &shaderInterface, const TriangleSetup &triangle,
+                            const int x, const int y, const float edgeFunction12,
+                            const float edgeFunction20, const float edgeFunction01) {
+    // === TEST 27 ===
+    const float depth = interpolateFragmentDepth(triangle, edgeFunction12, edgeFunction20, edgeFunction01);
+
+    // Depth-only draws need nothing more than the depth (no attributes, no shader)
+    const FragmentBackEnd &backEnd = *triangle.pFragmentBackEnd;
+    if(backEnd.shadeDepth) {
+        pipelineCounters.fragmentsGenerated++;
+        backEnd.shadeDepth(backEnd, x, y, depth, triangle.isFacingFront);
+        return;
+    }
+
+    // Stencil and depth tests need nothing but the depth, fragments that fail
+    // them never get their attributes interpolated
+    pipelineCounters.fragmentsGenerated++;
+    if(backEnd.testFragment && !backEnd.testFragment(backEnd, x, y, depth, triangle.isFacingFront)) {
+        return;
+    }
+
+    // Set up fragment data structure (as described in '09 Rasterizace: InFragment')
+    InFragment inFragment;
+
+    // === TEST 28-29 ===
+    // Interpolation of attributes for the fragment shader (perspective-correct planes of the triangle)
+    pipelineCounters.fragmentsInterpolated++;
+    const float w = interpolateAttributePlanes(triangle.attributePlanes, triangle.outTriangle, x, y, inFragment);
+    inFragment.gl_FragCoord = glm::vec4(x + 0.5f, y + 0.5f, depth, w);
+
+    // === TEST 22-24, 30-37 ===
+    // EPFO (unless tested above), fragment shader and LPFO are done by the back-end selected for the draw
+    shadedFragment.pProgram = &program;
+    shadedFragment.pTriangle = &triangle;
+    shadedFragment.pInFragment = &inFragment;
+    backEnd.shadeFragment(backEnd, program, shaderInterface, inFragment, triangle.isFacingFront);
+    shadedFragment.pTriangle = nullptr;
+} // processFragment()
+
+// === TEST 27 ===
+inline float interpolateFragmentDepth(const TriangleSetup &triangle, const float edgeFunction12,
+                                      const float edgeFunction20, const float edgeFunction01) {
+    // Calculate barycentric coordinates for interpolation
+    const float lambda0 = edgeFunction12 / triangle.triangleArea;
+    const float lambda1 = edgeFunction20 / triangle.triangleArea;
+    const float lambda2 = edgeFunction01 / triangle.triangleArea;
+
+    // Calculating 2D Barycentric coordinates for depth interpolation
+    // fragment.gl_FragCoord.z = vertex[0].gl_Position.z * λ0_2D + vertex[1].gl_Position.z * λ1_2D + vertex[2].gl_Position.z * λ2_2D
+    const glm::vec3 *vertices = triangle.vertices;
+    return vertices[0].z * lambda0 + vertices[1].z * lambda1 + vertices[2].z * lambda2;
+} // interpolateFragmentDepth()
+
+inline void processQuad(const Program &program, const ShaderInterface &shaderInterface, const TriangleSetup &triangle,
+                        const int quadX, const int quadY, const float edgeFunctions[4][3], const uint32_t coverageMask) {
+    // Depth-only draws have no attributes to differentiate, the lanes are independent
+    const FragmentBackEnd &backEnd = *triangle.pFragmentBackEnd;
+    if(backEnd.shadeDepth) {
+        for(uint32_t iLane = 0; iLane < quadSize * quadSize; iLane++) {
+            if(coverageMask & (1u << iLane)) {
+                processFragment(program, shaderInterface, triangle, quadX + static_cast<int>(iLane % quadSize),
+                                quadY + static_cast<int>(iLane / quadSize),
+                                edgeFunctions[iLane][0], edgeFunctions[iLane][1], edgeFunctions[iLane][2]);
+            }
+        } // for(iLane)
+        return;
+    }
+
+    // Early tests of the covered lanes (the same as in processFragment())
+    float depths[quadSize * quadSize] = {};
+    uint32_t shadedMask = 0;
+    for(uint32_t iLane = 0; iLane < quadSize * quadSize; iLane++) {
+        if(!(coverageMask & (1u << iLane))) {
+            continue;
+        }
+
+        const int x = quadX + static_cast<int>(iLane % quadSize);
+        const int y = quadY + static_cast<int>(iLane / quadSize);
+        depths[iLane] = interpolateFragmentDepth(triangle, edgeFunctions[iLane][0], edgeFunctions[iLane][1], edgeFunctions[iLane][2]);
+        pipelineCounters.fragmentsGenerated++;
+        if(!backEnd.testFragment || backEnd.testFragment(backEnd, x, y, depths[iLane], triangle.isFacingFront)) {
+            shadedMask |= 1u << iLane;
+        }
+    } // for(iLane)
+    if(!shadedMask) {
+        return;
+    }
+
+    // === TEST 28-29 ===
+    // All four lanes are interpolated, helper lanes (not covered or killed by
+    // the tests) only complete the differences of the quad
+    InFragment quad[quadSize * quadSize];
+    for(uint32_t iLane = 0; iLane < quadSize * quadSize; iLane++) {
+        const int x = quadX + static_cast<int>(iLane % quadSize);
+        const int y = quadY + static_cast<int>(iLane / quadSize);
+        const float w = interpolateAttributePlanes(triangle.attributePlanes, triangle.outTriangle, x, y, quad[iLane]);
+        quad[iLane].gl_FragCoord = glm::vec4(x + 0.5f, y + 0.5f, depths[iLane], w);
+    } // for(iLane)
+    pipelineCounters.fragmentsInterpolated += quadSize * quadSize;
+
+    // === TEST 22-24, 30-37 ===
+    shadedFragment.pProgram = &program;
+    shadedFragment.pTriangle = &triangle;
+    shadedFragment.pQuad = quad;
+    for(uint32_t iLane = 0; iLane < quadSize * quadSize; iLane++) {
+        if(shadedMask & (1u << iLane)) {
+            shadedFragment.pInFragment = &quad[iLane];
+            shadedFragment.iQuadLane = iLane;
+            backEnd.shadeFragment(backEnd, program, shaderInterface, quad[iLane], triangle.isFacingFront);
+        }
+    } // for(iLane)
+    shadedFragment.pTriangle = nullptr;
+    shadedFragment.pQuad = nullptr;
+} // processQuad()
+
 // === TEST 28-29 ===
 inline void interpolateFragmentAttributes(const Program &program, const float lambda0,
                                           const float lambda1, const float lambda2,
@@ -881,6 +2441,446 @@ inline void interpolateFragmentAttributes(const Program &program, const float la
     } // for(iAttribute)
 } // interpolateFragmentAttributes()
 
+inline void setupAttributePlanes(const Program &program, const OutVertex outVertices[3], const glm::vec3 vertices[3],
+                                 const float oneOverW[3], const int originX, const int originY, AttributePlanes &planes) {
+    // Plane q(x, y) = a * x + b * y + c through the values q0, q1, q2 in the
+    // three vertices, relative to the center of the origin pixel
+    // Note: Double precision keeps the coefficients exact up to the final
+    //       rounding even for long thin triangles.
+    const double x0 = vertices[0].x;
+    const double y0 = vertices[0].y;
+    const double x10 = vertices[1].x - x0;
+    const double y10 = vertices[1].y - y0;
+    const double x20 = vertices[2].x - x0;
+    const double y20 = vertices[2].y - y0;
+    const double doubleArea = x10 * y20 - x20 * y10;
+    const double originOffsetX = originX + 0.5 - x0;
+    const double originOffsetY = originY + 0.5 - y0;
+    auto setupPlane = [&](const double q0, const double q1, const double q2, float &a, float &b, float &c) {
+        const double planeA = ((q1 - q0) * y20 - (q2 - q0) * y10) / doubleArea;
+        const double planeB = ((q2 - q0) * x10 - (q1 - q0) * x20) / doubleArea;
+        a = static_cast<float>(planeA);
+        b = static_cast<float>(planeB);
+        c = static_cast<float>(q0 + planeA * originOffsetX + planeB * originOffsetY);
+    };
+
+    planes.originX = originX;
+    planes.originY = originY;
+    setupPlane(oneOverW[0], oneOverW[1], oneOverW[2], planes.oneOverWStepX, planes.oneOverWStepY, planes.oneOverWOrigin);
+
+    planes.nofComponents = 0;
+    planes.nofFlatAttributes = 0;
+    for(uint32_t iAttribute = 0; iAttribute < maxAttribs; iAttribute++) {
+        const AttribType type = program.vs2fs[iAttribute];
+        if(type == AttribType::EMPTY) {
+            continue;
+        }
+
+        // For 'unsigned integer' attributes, we use flat shading
+        if(static_cast<uint8_t>(type) > static_cast<uint8_t>(AttribType::VEC4)) {
+            planes.flatAttributes[planes.nofFlatAttributes++] = static_cast<uint8_t>(iAttribute);
+            continue;
+        }
+
+        // 'float' to 'vec4' - the type value is the number of components
+        // Note: Attributes divided by w are linear in screen space.
+        for(uint32_t iComponent = 0; iComponent < static_cast<uint32_t>(type); iComponent++) {
+            const uint32_t iPlane = planes.nofComponents++;
+            planes.components[iPlane] = static_cast<uint8_t>(iAttribute * 4 + iComponent);
+            setupPlane(static_cast<double>(outVertices[0].attributes[iAttribute].v4[iComponent]) * oneOverW[0],
+                       static_cast<double>(outVertices[1].attributes[iAttribute].v4[iComponent]) * oneOverW[1],
+                       static_cast<double>(outVertices[2].attributes[iAttribute].v4[iComponent]) * oneOverW[2],
+                       planes.stepX[iPlane], planes.stepY[iPlane], planes.origin[iPlane]);
+        } // for(iComponent)
+    } // for(iAttribute)
+} // setupAttributePlanes()
+
+// === TEST 28-29 ===
+inline float interpolateAttributePlanes(const AttributePlanes &planes, const OutVertex outVertices[3],
+                                        const int x, const int y, InFragment &inFragment) {
+    const float offsetX = static_cast<float>(x - planes.originX);
+    const float offsetY = static_cast<float>(y - planes.originY);
+
+    // Perspective correction: a = (a/w) / (1/w), both are planes in screen space
+    const float w = 1.0f / (planes.oneOverWOrigin + planes.oneOverWStepX * offsetX + planes.oneOverWStepY * offsetY);
+
+    float *pComponents = &inFragment.attributes[0].v4.x;
+    for(uint32_t iPlane = 0; iPlane < planes.nofComponents; iPlane++) {
+        pComponents[planes.components[iPlane]] = (planes.origin[iPlane] + planes.stepX[iPlane] * offsetX + planes.stepY[iPlane] * offsetY) * w;
+    } // for(iPlane)
+
+    for(uint32_t iFlat = 0; iFlat < planes.nofFlatAttributes; iFlat++) {
+        const uint8_t iAttribute = planes.flatAttributes[iFlat];
+        inFragment.attributes[iAttribute] = outVertices[0].attributes[iAttribute];
+    } // for(iFlat)
+    return w;
+} // interpolateAttributePlanes()
+
+inline bool computeTriangleBoundingBox(const glm::vec3 vertices[3], const Framebuffer &frameBuffer,
+                                       ScreenRegion &boundingBox) {
+    // Find the min/max coordinates among the triangle vertices
+    const float minVertexX = std::min({vertices[0].x, vertices[1].x, vertices[2].x});
+    const float maxVertexX = std::max({vertices[0].x, vertices[1].x, vertices[2].x});
+    const float minVertexY = std::min({vertices[0].y, vertices[1].y, vertices[2].y});
+    const float maxVertexY = std::max({vertices[0].y, vertices[1].y, vertices[2].y});
+
+    // Round the minimum coordinate down and maximum coordinate up
+    const int minVertexFlooredX = static_cast<int>(std::floor(minVertexX));
+    const int maxVertexCeiledX = static_cast<int>(std::ceil(maxVertexX));
+    const int minVertexFlooredY = static_cast<int>(std::floor(minVertexY));
+    const int maxVertexCeiledY = static_cast<int>(std::ceil(maxVertexY));
+
+    // Clamp the coordinates to the framebuffer boundaries
+    //                                  | vertices extreme | MINimal pixel coord. | MAXimal pixel coordinate               |
+    boundingBox.minX = glm::clamp(minVertexFlooredX,  0,                     static_cast<int>(frameBuffer.width - 1));
+    boundingBox.maxX = glm::clamp(maxVertexCeiledX,   0,                     static_cast<int>(frameBuffer.width - 1));
+    boundingBox.minY = glm::clamp(minVertexFlooredY,  0,                     static_cast<int>(frameBuffer.height - 1));
+    boundingBox.maxY = glm::clamp(maxVertexCeiledY,   0,                     static_cast<int>(frameBuffer.height - 1));
+
+    // Bounding box is empty if the triangle lies completely out of the framebuffer
+    return maxVertexCeiledX >= 0 && maxVertexCeiledY >= 0 &&
+           minVertexFlooredX <= static_cast<int>(frameBuffer.width - 1) &&
+           minVertexFlooredY <= static_cast<int>(frameBuffer.height - 1);
+} // computeTriangleBoundingBox()
+
+
+/******************************************************************************/
+/*                                                                            */
+/*              TILE-BINNED (SORT-MIDDLE) MULTITHREADED BACK-END              */
+/*                                                                            */
+/******************************************************************************/
+
+/*
+ * The vector part of the pipeline (vertex shader, clipping, culling) is still
+ * executed serially in command order. Instead of rasterizing each triangle
+ * right away, the triangle is stored and its index is appended to the bin of
+ * every screen tile its bounding box touches. When something the rasterizer
+ * depends on is about to change (framebuffer binding, stencil settings,
+ * clears, user commands, ...) or the command buffer ends, all tiles are
+ * rasterized in parallel. Each tile is owned by exactly one thread and
+ * processes its triangles in submission order, so blending, depth and stencil
+ * give exactly the same result as the serial rasterizer.
+ */
+
+//! Triangles (and their draws) waiting for rasterization
+static TileBins tileBins;
+
+inline ScreenRegion getFramebufferRegion(const Framebuffer &frameBuffer) {
+    return ScreenRegion{0, 0, static_cast<int>(frameBuffer.width) - 1, static_cast<int>(frameBuffer.height) - 1};
+} // getFramebufferRegion()
+
+inline bool doesCommandRequireTileFlush(const CommandType type) {
+    switch(type) {
+        // These commands only affect the vector part of the pipeline (or the
+        // needed state is captured together with the binned draw)
+        case CommandType::BIND_PROGRAM:
+        case CommandType::BIND_VERTEXARRAY:
+        case CommandType::SET_BACKFACE_CULLING_COMMAND:
+        case CommandType::SET_DRAW_ID:
+        case CommandType::DRAW:
+        case CommandType::SUB_COMMAND:
+        case CommandType::EMPTY:
+            return false;
+
+        // Framebuffer, stencil/write settings and front face are read by the
+        // per-fragment operations, clears and user callbacks touch memory
+        default:
+            return true;
+    } // switch(type)
+} // doesCommandRequireTileFlush()
+
+inline uint32_t beginBinnedDraw(const GPUMemory &memory, const Program &program,
+                                const ShaderInterface &shaderInterface, const FragmentBackEnd &fragmentBackEnd) {
+    const Framebuffer *pFrameBuffer = &memory.framebuffers[memory.activatedFramebuffer];
+
+    // Tile grid is bound to a framebuffer, so we have to rasterize the old
+    // triangles first if the framebuffer (or its size) has changed meanwhile
+    const bool isFrameBufferChanged = pFrameBuffer != tileBins.pFrameBuffer ||
+                                      pFrameBuffer->width != tileBins.width ||
+                                      pFrameBuffer->height != tileBins.height;
+    if(isFrameBufferChanged) {
+        flushTileBins(memory);
+    }
+
+    // Set up the tile grid when the bins are empty
+    if(tileBins.draws.empty()) {
+        tileBins.pFrameBuffer = pFrameBuffer;
+        tileBins.width = pFrameBuffer->width;
+        tileBins.height = pFrameBuffer->height;
+        tileBins.tileSize = std::max(1u, getGPUSettings().tileSize);
+        tileBins.nofTilesX = (tileBins.width + tileBins.tileSize - 1) / tileBins.tileSize;
+        tileBins.nofTilesY = (tileBins.height + tileBins.tileSize - 1) / tileBins.tileSize;
+        tileBins.tiles.resize(tileBins.nofTilesX * tileBins.nofTilesY);
+    }
+
+    tileBins.draws.push_back(BinnedDraw{&program, shaderInterface, fragmentBackEnd});
+    return static_cast<uint32_t>(tileBins.draws.size() - 1);
+} // beginBinnedDraw()
+
+inline void binTriangle(const uint32_t drawIndex, const OutVertex outTriangle[3],
+                        const glm::vec3 vertices[3], const float oneOverW[3]) {
+    ScreenRegion boundingBox;
+    if(!computeTriangleBoundingBox(vertices, *tileBins.pFrameBuffer, boundingBox)) {
+        return;
+    }
+
+    // Store the triangle only once, bins contain just its index
+    BinnedTriangle triangle;
+    triangle.drawIndex = drawIndex;
+    for(int iVertex = 0; iVertex < 3; iVertex++) {
+        triangle.outTriangle[iVertex] = outTriangle[iVertex];
+        triangle.vertices[iVertex] = vertices[iVertex];
+        triangle.oneOverW[iVertex] = oneOverW[iVertex];
+    } // for(iVertex)
+    const uint32_t triangleIndex = static_cast<uint32_t>(tileBins.triangles.size());
+    tileBins.triangles.push_back(triangle);
+
+    // Append the triangle to every tile overlapped by its bounding box
+    const uint32_t minTileX = static_cast<uint32_t>(boundingBox.minX) / tileBins.tileSize;
+    const uint32_t maxTileX = static_cast<uint32_t>(boundingBox.maxX) / tileBins.tileSize;
+    const uint32_t minTileY = static_cast<uint32_t>(boundingBox.minY) / tileBins.tileSize;
+    const uint32_t maxTileY = static_cast<uint32_t>(boundingBox.maxY) / tileBins.tileSize;
+    for(uint32_t tileY = minTileY; tileY <= maxTileY; tileY++) {
+        for(uint32_t tileX = minTileX; tileX <= maxTileX; tileX++) {
+            tileBins.tiles[tileY * tileBins.nofTilesX + tileX].push_back(triangleIndex);
+        } // for(tileX)
+    } // for(tileY)
+} // binTriangle()
+
+inline void flushTileBins(const GPUMemory &memory) {
+    if(tileBins.draws.empty()) {
+        return;
+    }
+
+    if(!tileBins.triangles.empty()) {
+        ThreadPool &threadPool = getThreadPool(getEffectiveNofThreads());
+        const uint64_t startTime = readPipelineClock();
+        const bool isTraced = isCommandTraceActive();
+        const uint64_t traceStartTime = isTraced ? readTraceClock() : 0;
+
+        // Each tile is rasterized by a single thread, so no pixel is shared
+        threadPool.parallelFor(static_cast<uint32_t>(tileBins.tiles.size()), [&](const uint32_t iTile, const uint32_t iWorker) {
+            const std::vector<uint32_t> &tile = tileBins.tiles[iTile];
+            if(tile.empty()) {
+                return;
+            }
+            const uint64_t tileTraceStartTime = isTraced ? readTraceClock() : 0;
+
+            const int tileX = static_cast<int>((iTile % tileBins.nofTilesX) * tileBins.tileSize);
+            const int tileY = static_cast<int>((iTile / tileBins.nofTilesX) * tileBins.tileSize);
+            const ScreenRegion tileRegion{tileX, tileY,
+                                          std::min(tileX + static_cast<int>(tileBins.tileSize), static_cast<int>(tileBins.width)) - 1,
+                                          std::min(tileY + static_cast<int>(tileBins.tileSize), static_cast<int>(tileBins.height)) - 1};
+
+            // Deferred clear of the tile is written by the thread owning the tile
+            resolveDeferredClears(tileRegion);
+
+            for(const uint32_t triangleIndex : tile) {
+                const BinnedTriangle &triangle = tileBins.triangles[triangleIndex];
+                const BinnedDraw &draw = tileBins.draws[triangle.drawIndex];
+                rasterizeTriangleUsingPineda(memory, *draw.pProgram, *tileBins.pFrameBuffer, draw.shaderInterface, draw.fragmentBackEnd,
+                                             triangle.outTriangle, triangle.vertices, triangle.oneOverW, tileRegion);
+            } // for(triangleIndex)
+
+            // Counters of worker threads would otherwise never be added
+            addPipelineCounters(pipelineCounters);
+
+            // Tiles are shown on the track of the worker which rasterized them
+            if(isTraced) {
+                TraceSpan span;
+                span.name = "TILE";
+                span.category = "raster";
+                span.startTime = tileTraceStartTime;
+                span.duration = readTraceClock() - tileTraceStartTime;
+                span.track = iWorker;
+                span.argumentNames[0] = "tile";
+                span.argumentValues[0] = iTile;
+                span.argumentNames[1] = "nofTriangles";
+                span.argumentValues[1] = static_cast<int64_t>(tile.size());
+                addTraceSpan(span);
+            }
+        }); // parallelFor(iTile)
+
+        if(startTime) {
+            getPipelineStatistics().tileRasterizationTime += readPipelineClock() - startTime;
+        }
+        if(isTraced) {
+            TraceSpan span;
+            span.name = "FLUSH_TILE_BINS";
+            span.category = "raster";
+            span.startTime = traceStartTime;
+            span.duration = readTraceClock() - traceStartTime;
+            span.argumentNames[0] = "nofTriangles";
+            span.argumentValues[0] = static_cast<int64_t>(tileBins.triangles.size());
+            addTraceSpan(span);
+        }
+    }
+
+    // Keep the allocated memory for the next batch
+    for(auto &tile : tileBins.tiles) {
+        tile.clear();
+    } // for(tile)
+    tileBins.triangles.clear();
+    tileBins.draws.clear();
+} // flushTileBins()
+
+
+/******************************************************************************/
+/*                                                                            */
+/*                    HIERARCHICAL DEPTH BUFFER (Hi-Z)                        */
+/*                                                                            */
+/******************************************************************************/
+
+/*
+ * The depth test passes only if the stored depth is greater than the depth of
+ * the fragment. If the nearest depth a triangle can have in a tile is not
+ * less than the farthest stored depth of the tile, every fragment of the
+ * triangle in the tile fails, so the tile is skipped before any edge test,
+ * interpolation or shader. The farthest depth of each 8x8 tile is kept
+ * conservative (it may be greater than the real one, never less).
+ */
+
+//! Farthest depth of the tiles of the bound depth buffer
+static HierarchicalDepth hierarchicalDepth;
+
+inline void bindHierarchicalDepth(const Framebuffer &frameBuffer) {
+    const PixelRows depth = getPixelRows(frameBuffer.depth, frameBuffer.height, frameBuffer.yReversed);
+    const bool isDepthBufferChanged = frameBuffer.depth.data != hierarchicalDepth.pDepthData ||
+                                      frameBuffer.width != hierarchicalDepth.width ||
+                                      frameBuffer.height != hierarchicalDepth.height ||
+                                      depth.pRow0 != hierarchicalDepth.depth.pRow0 ||
+                                      depth.rowStep != hierarchicalDepth.depth.rowStep ||
+                                      depth.bytesPerPixel != hierarchicalDepth.depth.bytesPerPixel;
+    if(!isDepthBufferChanged) {
+        return;
+    }
+
+    hierarchicalDepth.pDepthData = frameBuffer.depth.data;
+    hierarchicalDepth.width = frameBuffer.width;
+    hierarchicalDepth.height = frameBuffer.height;
+    hierarchicalDepth.nofTilesX = (frameBuffer.width + depthTileSize - 1) / depthTileSize;
+    hierarchicalDepth.nofTilesY = (frameBuffer.height + depthTileSize - 1) / depthTileSize;
+    hierarchicalDepth.depth = depth;
+    hierarchicalDepth.maxDepth.resize(hierarchicalDepth.nofTilesX * hierarchicalDepth.nofTilesY);
+    hierarchicalDepth.isStale.resize(hierarchicalDepth.maxDepth.size());
+    invalidateHierarchicalDepth();
+} // bindHierarchicalDepth()
+
+inline void invalidateHierarchicalDepth() {
+    // Infinity is an upper bound of anything the depth buffer may contain now
+    std::fill(hierarchicalDepth.maxDepth.begin(), hierarchicalDepth.maxDepth.end(), std::numeric_limits<float>::infinity());
+    std::fill(hierarchicalDepth.isStale.begin(), hierarchicalDepth.isStale.end(), 1);
+} // invalidateHierarchicalDepth()
+
+inline void clearHierarchicalDepth(const Framebuffer &frameBuffer, const float depth) {
+    if(frameBuffer.depth.data != hierarchicalDepth.pDepthData || frameBuffer.width != hierarchicalDepth.width ||
+       frameBuffer.height != hierarchicalDepth.height) {
+        return;  // other depth buffers are invalidated when they are bound
+    }
+
+    // Exact maximum even for pending deferred clears (the pixels are cleared before they are read)
+    std::fill(hierarchicalDepth.maxDepth.begin(), hierarchicalDepth.maxDepth.end(), depth);
+    std::fill(hierarchicalDepth.isStale.begin(), hierarchicalDepth.isStale.end(), 0);
+} // clearHierarchicalDepth()
+
+inline float getTileMaxDepth(const uint32_t tileX, const uint32_t tileY) {
+    const uint32_t iTile = tileY * hierarchicalDepth.nofTilesX + tileX;
+    if(!hierarchicalDepth.isStale[iTile]) {
+        return hierarchicalDepth.maxDepth[iTile];
+    }
+
+    const int minX = static_cast<int>(tileX * depthTileSize);
+    const int minY = static_cast<int>(tileY * depthTileSize);
+    const int maxX = std::min(minX + static_cast<int>(depthTileSize), static_cast<int>(hierarchicalDepth.width)) - 1;
+    const int maxY = std::min(minY + static_cast<int>(depthTileSize), static_cast<int>(hierarchicalDepth.height)) - 1;
+
+    // Pixels are read, so their pending clear has to be written first
+    if(hasPendingDeferredClears()) {
+        resolveDeferredClears(ScreenRegion{minX, minY, maxX, maxY});
+    }
+
+    // NaN pixels are skipped, they fail the depth test anyway
+    float maxDepth = -std::numeric_limits<float>::infinity();
+    for(int y = minY; y <= maxY; y++) {
+        for(int x = minX; x <= maxX; x++) {
+            const float depth = *reinterpret_cast<const float*>(getPixel(hierarchicalDepth.depth, x, y));
+            if(depth > maxDepth) {
+                maxDepth = depth;
+            }
+        } // for(x)
+    } // for(y)
+
+    hierarchicalDepth.maxDepth[iTile] = maxDepth;
+    hierarchicalDepth.isStale[iTile] = 0;
+    return maxDepth;
+} // getTileMaxDepth()
+
+inline bool findOccludedTiles(const DepthPlane &plane, const ScreenRegion &region, OccludedTiles &occludedTiles) {
+    // Flags of the last triangle of the thread are not needed anymore
+    static thread_local std::vector<uint8_t> isOccluded;
+
+    const int tileSize = static_cast<int>(depthTileSize);
+    occludedTiles.minTileX = region.minX / tileSize;
+    occludedTiles.minTileY = region.minY / tileSize;
+    occludedTiles.nofTilesX = region.maxX / tileSize - occludedTiles.minTileX + 1;
+    occludedTiles.nofTilesY = region.maxY / tileSize - occludedTiles.minTileY + 1;
+    isOccluded.assign(static_cast<size_t>(occludedTiles.nofTilesX * occludedTiles.nofTilesY), 0);
+    occludedTiles.pIsOccluded = isOccluded.data();
+    occludedTiles.nofOccluded = 0;
+
+    for(int iTileY = 0; iTileY < occludedTiles.nofTilesY; iTileY++) {
+        const int tileY = occludedTiles.minTileY + iTileY;
+        const double rowA = plane.b * (std::max(tileY * tileSize, region.minY) - plane.originY);
+        const double rowB = plane.b * (std::min(tileY * tileSize + tileSize - 1, region.maxY) - plane.originY);
+
+        for(int iTileX = 0; iTileX < occludedTiles.nofTilesX; iTileX++) {
+            const int tileX = occludedTiles.minTileX + iTileX;
+            const double columnA = plane.a * (std::max(tileX * tileSize, region.minX) - plane.originX);
+            const double columnB = plane.a * (std::min(tileX * tileSize + tileSize - 1, region.maxX) - plane.originX);
+
+            // Depth is linear, thus its minimum over the pixels of the tile lies in a corner
+            const double nearestDepth = plane.c + std::min(columnA, columnB) + std::min(rowA, rowB) - plane.margin;
+
+            // Stale maximum is still an upper bound, it is recomputed only if it is not enough
+            // Note: NaN values fail the comparisons, such tiles are never occluded
+            const uint32_t iTile = static_cast<uint32_t>(tileY) * hierarchicalDepth.nofTilesX + static_cast<uint32_t>(tileX);
+            const bool isBehind = nearestDepth >= hierarchicalDepth.maxDepth[iTile] ||
+                                  (hierarchicalDepth.isStale[iTile] && nearestDepth >= getTileMaxDepth(static_cast<uint32_t>(tileX), static_cast<uint32_t>(tileY)));
+            if(isBehind) {
+                isOccluded[static_cast<size_t>(iTileY * occludedTiles.nofTilesX + iTileX)] = 1;
+                occludedTiles.nofOccluded++;
+            }
+        } // for(iTileX)
+    } // for(iTileY)
+
+    return occludedTiles.nofOccluded == isOccluded.size();
+} // findOccludedTiles()
+
+inline bool isBlockOccluded(const OccludedTiles &occludedTiles, const int minX, const int minY, const int maxX, const int maxY) {
+    const int tileSize = static_cast<int>(depthTileSize);
+    for(int tileY = minY / tileSize; tileY <= maxY / tileSize; tileY++) {
+        for(int tileX = minX / tileSize; tileX <= maxX / tileSize; tileX++) {
+            const int iTile = (tileY - occludedTiles.minTileY) * occludedTiles.nofTilesX + (tileX - occludedTiles.minTileX);
+            if(!occludedTiles.pIsOccluded[iTile]) {
+                return false;
+            }
+        } // for(tileX)
+    } // for(tileY)
+    return true;
+} // isBlockOccluded()
+
+inline void markDepthTilesWritten(const OccludedTiles &occludedTiles) {
+    for(int iTileY = 0; iTileY < occludedTiles.nofTilesY; iTileY++) {
+        for(int iTileX = 0; iTileX < occludedTiles.nofTilesX; iTileX++) {
+            if(!occludedTiles.pIsOccluded[iTileY * occludedTiles.nofTilesX + iTileX]) {
+                const uint32_t tileX = static_cast<uint32_t>(occludedTiles.minTileX + iTileX);
+                const uint32_t tileY = static_cast<uint32_t>(occludedTiles.minTileY + iTileY);
+                hierarchicalDepth.isStale[tileY * hierarchicalDepth.nofTilesX + tileX] = 1;
+            }
+        } // for(iTileX)
+    } // for(iTileY)
+} // markDepthTilesWritten()
+
 
 /******************************************************************************/
 /*                                                                            */
@@ -905,36 +2905,8 @@ inline bool executeEarlyPerFragmentOperations(const GPUMemory &memory, const Fra
                                                        static_cast<uint32_t>(inFragment.gl_FragCoord.y), frameBuffer.height,
                                                        frameBuffer.yReversed);
 
-        // Read the current stencil value
-        bool pass{false};
-
         // Stencil Test
-        switch(memory.stencilSettings.func) {
-            case StencilFunc::NEVER:
-                pass = false; // sfail
-                break;
-            case StencilFunc::LESS:
-                pass = *pStencilPixel < memory.stencilSettings.refValue;
-                break;
-            case StencilFunc::LEQUAL:
-                pass = *pStencilPixel <= memory.stencilSettings.refValue;
-                break;
-            case StencilFunc::GREATER:
-                pass = *pStencilPixel > memory.stencilSettings.refValue;
-                break;
-            case StencilFunc::GEQUAL:
-                pass = *pStencilPixel >= memory.stencilSettings.refValue;
-                break;
-            case StencilFunc::EQUAL:
-                pass = *pStencilPixel == memory.stencilSettings.refValue;
-                break;
-            case StencilFunc::NOTEQUAL:
-                pass = *pStencilPixel != memory.stencilSettings.refValue;
-                break;
-            case StencilFunc::ALWAYS:
-                pass = true; // spass
-                break;
-        } // switch(stencil_function)
+        const bool pass = evaluateStencilFunction(*pStencilPixel, memory.stencilSettings.func, memory.stencilSettings.refValue);
 
         // Handle stencil test failure (sfail case)
         if(!pass) {
@@ -944,6 +2916,7 @@ inline bool executeEarlyPerFragmentOperations(const GPUMemory &memory, const Fra
                 executeStencilOperation(*pStencilPixel, sfail, memory.stencilSettings.refValue); // sfail
             }
 
+            pipelineCounters.fragmentsStencilFailed++;
             return false; // fragment processing is stopped
         }
     } // if(stencilTest)
@@ -978,6 +2951,7 @@ inline bool executeEarlyPerFragmentOperations(const GPUMemory &memory, const Fra
                 executeStencilOperation(*pStencilPixel, dpfail, memory.stencilSettings.refValue); // dpfail
             }
 
+            pipelineCounters.fragmentsDepthFailed++;
             return false; // fragment processing is stopped
         }
     } // if(depthTest)
@@ -991,8 +2965,10 @@ inline void executeLatePerFragmentOperations(const GPUMemory &memory, const Fram
     // === TEST 34 ===
     // Discarding
     if(outFragment.discard) {
+        pipelineCounters.fragmentsDiscarded++;
         return;
     }
+    pipelineCounters.pixelsWritten++;
 
     // === TEST 35 ===
     // Stencil writes
@@ -1150,6 +3126,367 @@ inline void executeStencilOperation(uint8_t &stencilValue, const StencilOp stenc
     } // switch(stencilOperation)
 } // executeStencilOperation()
 
+inline bool evaluateStencilFunction(const uint8_t stencilValue, const StencilFunc stencilFunction,
+                                    const uint32_t stencilValueReference) {
+    switch(stencilFunction) {
+        case StencilFunc::NEVER:
+            return false; // sfail
+        case StencilFunc::LESS:
+            return stencilValue < stencilValueReference;
+        case StencilFunc::LEQUAL:
+            return stencilValue <= stencilValueReference;
+        case StencilFunc::GREATER:
+            return stencilValue > stencilValueReference;
+        case StencilFunc::GEQUAL:
+            return stencilValue >= stencilValueReference;
+        case StencilFunc::EQUAL:
+            return stencilValue == stencilValueReference;
+        case StencilFunc::NOTEQUAL:
+            return stencilValue != stencilValueReference;
+        case StencilFunc::ALWAYS:
+            return true; // spass
+    } // switch(stencilFunction)
+
+    return false;
+} // evaluateStencilFunction()
+
+
+/******************************************************************************/
+/*                                                                            */
+/*        PER FRAGMENT BACK-ENDS specialized for the state of the draw        */
+/*                                                                            */
+/******************************************************************************/
+
+/*
+ * The functions above decide everything for each fragment again: is there
+ * a stencil/depth/color buffer, are the writes blocked, which stencil function
+ * and operation to use, what is the layout of the color buffer... None of it
+ * can change during a draw, so setupFragmentBackEnd() resolves it once and
+ * picks a routine compiled for exactly that combination. The stencil function
+ * and operations become tables indexed by the old stencil value. Results are
+ * bit-identical to the generic functions (same float operations in the same
+ * order), the generic back-end is kept for unusual color buffer layouts.
+ */
+
+inline PixelRows getPixelRows(const Image &image, const uint32_t height, const bool yReversed) {
+    PixelRows rows;
+    rows.bytesPerPixel = image.bytesPerPixel;
+    rows.rowStep = yReversed ? -static_cast<int64_t>(image.pitch) : static_cast<int64_t>(image.pitch);
+    rows.pRow0 = static_cast<uint8_t*>(image.data);
+    if(yReversed && height > 0) {
+        rows.pRow0 += static_cast<int64_t>(height - 1) * image.pitch;  // same as getPixelMaybeReversed()
+    }
+    return rows;
+} // getPixelRows()
+
+inline uint8_t *getPixel(const PixelRows &rows, const int x, const int y) {
+    return rows.pRow0 + static_cast<int64_t>(y) * rows.rowStep + static_cast<uint64_t>(x) * rows.bytesPerPixel;
+} // getPixel()
+
+inline uint8_t *getPixel(const PixelRows &rows, const InFragment &inFragment) {
+    return getPixel(rows, static_cast<int>(inFragment.gl_FragCoord.x), static_cast<int>(inFragment.gl_FragCoord.y));
+} // getPixel()
+
+// Alpha blending of executeLatePerFragmentOperations() for the RGBA8 and RGB8 layouts
+template<ColorMode colorMode>
+inline void blendFragmentColor(uint8_t *pColorPixel, const glm::vec4 &fragmentColor) {
+    const float alpha = glm::clamp(fragmentColor.a, 0.f, 1.f);
+
+    pColorPixel[0] = castNormalizedFloatToUnsignedInt8(castUnsignedInt8ToNormalizedFloat(pColorPixel[0]) * (1.f - alpha) + fragmentColor.r * alpha);
+    pColorPixel[1] = castNormalizedFloatToUnsignedInt8(castUnsignedInt8ToNormalizedFloat(pColorPixel[1]) * (1.f - alpha) + fragmentColor.g * alpha);
+    pColorPixel[2] = castNormalizedFloatToUnsignedInt8(castUnsignedInt8ToNormalizedFloat(pColorPixel[2]) * (1.f - alpha) + fragmentColor.b * alpha);
+    if constexpr(colorMode == ColorMode::RGBA8) {
+        pColorPixel[3] = castNormalizedFloatToUnsignedInt8(castUnsignedInt8ToNormalizedFloat(pColorPixel[3]) * (1.f - alpha) + alpha);
+    }
+} // blendFragmentColor()
+
+// Stencil and depth tests of shadeFragmentSpecialized() (and the stencil
+// operations and depth writes done by them), they need only the depth
+template<StencilMode stencilMode, DepthMode depthMode>
+inline bool testFragmentSpecialized(const FragmentBackEnd &backEnd, const int x, const int y, const float depth,
+                                    const bool isFacingFront) {
+    constexpr bool hasStencilWrites = stencilMode == StencilMode::TEST_WRITE;
+    const auto &stencilOps = backEnd.stencilOps[isFacingFront];
+
+    // === TEST 30-31 ===
+    uint8_t *pStencilPixel = nullptr;
+    if constexpr(stencilMode != StencilMode::NONE) {
+        pStencilPixel = getPixel(backEnd.stencil, x, y);
+        if(!backEnd.stencilPass[*pStencilPixel]) {
+            if constexpr(hasStencilWrites) {
+                *pStencilPixel = stencilOps[STENCIL_SFAIL][*pStencilPixel];
+            }
+            pipelineCounters.fragmentsStencilFailed++;
+            return false;
+        }
+    }
+
+    // === TEST 32-33 ===
+    if constexpr(depthMode != DepthMode::NONE) {
+        float *pDepthPixel = reinterpret_cast<float*>(getPixel(backEnd.depth, x, y));
+        if(!(*pDepthPixel > depth)) {
+            if constexpr(hasStencilWrites) {
+                *pStencilPixel = stencilOps[STENCIL_DPFAIL][*pStencilPixel];
+            }
+            pipelineCounters.fragmentsDepthFailed++;
+            return false;
+        }
+        if constexpr(depthMode == DepthMode::TEST_WRITE) {
+            *pDepthPixel = depth;
+        }
+    }
+    return true;
+} // testFragmentSpecialized()
+
+// With isTested, testFragmentSpecialized() has already been run for the fragment
+template<StencilMode stencilMode, DepthMode depthMode, ColorMode colorMode, bool isTested>
+inline void shadeFragmentSpecialized(const FragmentBackEnd &backEnd, const Program &program,
+                                     const ShaderInterface &shaderInterface, const InFragment &inFragment,
+                                     const bool isFacingFront) {
+    constexpr bool hasStencilWrites = stencilMode == StencilMode::TEST_WRITE;
+    const auto &stencilOps = backEnd.stencilOps[isFacingFront];
+
+    // === TEST 30-33 ===
+    if constexpr(!isTested) {
+        if(!testFragmentSpecialized<stencilMode, depthMode>(backEnd, static_cast<int>(inFragment.gl_FragCoord.x),
+                                                             static_cast<int>(inFragment.gl_FragCoord.y),
+                                                             inFragment.gl_FragCoord.z, isFacingFront)) {
+            return;
+        }
+    }
+
+    // === TEST 22 ===
+    OutFragment outFragment;
+    program.fragmentShader(outFragment, inFragment, shaderInterface);
+
+    // === TEST 34 ===
+    if(outFragment.discard) {
+        pipelineCounters.fragmentsDiscarded++;
+        return;
+    }
+    pipelineCounters.pixelsWritten++;
+
+    // === TEST 35-37 ===
+    if constexpr(hasStencilWrites) {
+        uint8_t *pStencilPixel = getPixel(backEnd.stencil, inFragment);
+        *pStencilPixel = stencilOps[STENCIL_DPPASS][*pStencilPixel];
+    }
+    if constexpr(depthMode == DepthMode::TEST_WRITE) {
+        *reinterpret_cast<float*>(getPixel(backEnd.depth, inFragment)) = inFragment.gl_FragCoord.z;
+    }
+    if constexpr(colorMode != ColorMode::NONE) {
+        blendFragmentColor<colorMode>(getPixel(backEnd.color, inFragment), outFragment.gl_FragColor);
+    }
+} // shadeFragmentSpecialized()
+
+// Per-fragment operations of shadeFragmentSpecialized() without the shader (it
+// cannot discard and its color is not written), the depth test passes exactly
+// when the full path would write the pixel
+template<StencilMode stencilMode, DepthMode depthMode>
+inline void shadeDepthSpecialized(const FragmentBackEnd &backEnd, const int x, const int y, const float depth,
+                                  const bool isFacingFront) {
+    if(!testFragmentSpecialized<stencilMode, depthMode>(backEnd, x, y, depth, isFacingFront)) {
+        return;
+    }
+    pipelineCounters.pixelsWritten++;
+
+    if constexpr(stencilMode == StencilMode::TEST_WRITE) {
+        uint8_t *pStencilPixel = getPixel(backEnd.stencil, x, y);
+        *pStencilPixel = backEnd.stencilOps[isFacingFront][STENCIL_DPPASS][*pStencilPixel];
+    }
+} // shadeDepthSpecialized()
+
+inline void shadeFragmentGeneric(const FragmentBackEnd &backEnd, const Program &program,
+                                 const ShaderInterface &shaderInterface, const InFragment &inFragment,
+                                 const bool isFacingFront) {
+    // === TEST 30-33 ===
+    // If EPFO returned false, we skip the fragment shader execution
+    if(!executeEarlyPerFragmentOperations(*backEnd.pMemory, *backEnd.pFrameBuffer, inFragment, isFacingFront)) {
+        return;
+    }
+
+    // === TEST 22 ===
+    // Call the fragment shader
+    OutFragment outFragment;
+    program.fragmentShader(outFragment, inFragment, shaderInterface);
+
+    // === TEST 22-24 ===
+    // Apply LPFO and write the color to the framebuffer
+    executeLatePerFragmentOperations(*backEnd.pMemory, *backEnd.pFrameBuffer, inFragment, outFragment, isFacingFront);
+} // shadeFragmentGeneric()
+
+// Turns the run-time modes into template arguments (one switch per mode)
+template<StencilMode stencilMode, DepthMode depthMode, bool isTested>
+inline ShadeFragment selectShadeFragmentByColor(const ColorMode colorMode) {
+    switch(colorMode) {
+        case ColorMode::RGBA8: return shadeFragmentSpecialized<stencilMode, depthMode, ColorMode::RGBA8, isTested>;
+        case ColorMode::RGB8:  return shadeFragmentSpecialized<stencilMode, depthMode, ColorMode::RGB8, isTested>;
+        case ColorMode::NONE:
+        default:
+            return shadeFragmentSpecialized<stencilMode, depthMode, ColorMode::NONE, isTested>;
+    } // switch(colorMode)
+} // selectShadeFragmentByColor()
+
+template<StencilMode stencilMode, bool isTested>
+inline ShadeFragment selectShadeFragmentByDepth(const DepthMode depthMode, const ColorMode colorMode) {
+    switch(depthMode) {
+        case DepthMode::TEST:       return selectShadeFragmentByColor<stencilMode, DepthMode::TEST, isTested>(colorMode);
+        case DepthMode::TEST_WRITE: return selectShadeFragmentByColor<stencilMode, DepthMode::TEST_WRITE, isTested>(colorMode);
+        case DepthMode::NONE:
+        default:
+            return selectShadeFragmentByColor<stencilMode, DepthMode::NONE, isTested>(colorMode);
+    } // switch(depthMode)
+} // selectShadeFragmentByDepth()
+
+template<StencilMode stencilMode>
+inline ShadeDepth selectShadeDepthByDepth(const DepthMode depthMode) {
+    switch(depthMode) {
+        case DepthMode::TEST:       return shadeDepthSpecialized<stencilMode, DepthMode::TEST>;
+        case DepthMode::TEST_WRITE: return shadeDepthSpecialized<stencilMode, DepthMode::TEST_WRITE>;
+        case DepthMode::NONE:
+        default:
+            return shadeDepthSpecialized<stencilMode, DepthMode::NONE>;
+    } // switch(depthMode)
+} // selectShadeDepthByDepth()
+
+inline ShadeDepth selectShadeDepth(const StencilMode stencilMode, const DepthMode depthMode) {
+    switch(stencilMode) {
+        case StencilMode::TEST:       return selectShadeDepthByDepth<StencilMode::TEST>(depthMode);
+        case StencilMode::TEST_WRITE: return selectShadeDepthByDepth<StencilMode::TEST_WRITE>(depthMode);
+        case StencilMode::NONE:
+        default:
+            return selectShadeDepthByDepth<StencilMode::NONE>(depthMode);
+    } // switch(stencilMode)
+} // selectShadeDepth()
+
+template<bool isTested>
+inline ShadeFragment selectShadeFragment(const StencilMode stencilMode, const DepthMode depthMode, const ColorMode colorMode) {
+    switch(stencilMode) {
+        case StencilMode::TEST:       return selectShadeFragmentByDepth<StencilMode::TEST, isTested>(depthMode, colorMode);
+        case StencilMode::TEST_WRITE: return selectShadeFragmentByDepth<StencilMode::TEST_WRITE, isTested>(depthMode, colorMode);
+        case StencilMode::NONE:
+        default:
+            return selectShadeFragmentByDepth<StencilMode::NONE, isTested>(depthMode, colorMode);
+    } // switch(stencilMode)
+} // selectShadeFragment()
+
+template<StencilMode stencilMode>
+inline TestFragment selectTestFragmentByDepth(const DepthMode depthMode) {
+    switch(depthMode) {
+        case DepthMode::TEST:       return testFragmentSpecialized<stencilMode, DepthMode::TEST>;
+        case DepthMode::TEST_WRITE: return testFragmentSpecialized<stencilMode, DepthMode::TEST_WRITE>;
+        case DepthMode::NONE:
+        default:
+            return testFragmentSpecialized<stencilMode, DepthMode::NONE>;
+    } // switch(depthMode)
+} // selectTestFragmentByDepth()
+
+inline TestFragment selectTestFragment(const StencilMode stencilMode, const DepthMode depthMode) {
+    switch(stencilMode) {
+        case StencilMode::TEST:       return selectTestFragmentByDepth<StencilMode::TEST>(depthMode);
+        case StencilMode::TEST_WRITE: return selectTestFragmentByDepth<StencilMode::TEST_WRITE>(depthMode);
+        case StencilMode::NONE:
+        default:
+            return selectTestFragmentByDepth<StencilMode::NONE>(depthMode);
+    } // switch(stencilMode)
+} // selectTestFragment()
+
+// Checks the channel layout the specialized blending expects (bytes R, G, B[, A])
+inline bool hasColorLayout(const Image &color, const uint32_t nofChannels) {
+    if(color.format != Image::U8 || color.channels != nofChannels || color.bytesPerPixel != nofChannels) {
+        return false;
+    }
+    for(uint32_t iChannel = 0; iChannel < nofChannels; iChannel++) {
+        if(color.channelTypes[iChannel] != static_cast<Image::Channel>(iChannel)) {
+            return false;
+        }
+    } // for(iChannel)
+    return true;
+} // hasColorLayout()
+
+inline void setupFragmentBackEnd(const GPUMemory &memory, const Framebuffer &frameBuffer, FragmentBackEnd &backEnd) {
+    backEnd.pMemory = &memory;
+    backEnd.pFrameBuffer = &frameBuffer;
+    backEnd.shadeFragment = shadeFragmentGeneric;
+
+    // Same conditions as in executeEarlyPerFragmentOperations() and executeLatePerFragmentOperations()
+    const bool hasStencilTest = memory.stencilSettings.enabled && frameBuffer.stencil.data;
+    const bool hasColorWrites = !memory.blockWrites.color && frameBuffer.color.data;
+
+    const StencilMode stencilMode = !hasStencilTest ? StencilMode::NONE
+                                  : memory.blockWrites.stencil ? StencilMode::TEST : StencilMode::TEST_WRITE;
+    const DepthMode depthMode = !frameBuffer.depth.data ? DepthMode::NONE
+                              : memory.blockWrites.depth ? DepthMode::TEST : DepthMode::TEST_WRITE;
+
+    ColorMode colorMode = ColorMode::NONE;
+    if(hasColorWrites) {
+        if(hasColorLayout(frameBuffer.color, 4)) {
+            colorMode = ColorMode::RGBA8;
+        }
+        else if(hasColorLayout(frameBuffer.color, 3)) {
+            colorMode = ColorMode::RGB8;
+        }
+        else {
+            return;  // unusual layout - generic back-end
+        }
+    }
+
+    if(!getGPUSettings().specializedFragmentOperations) {
+        return;
+    }
+
+    backEnd.color = getPixelRows(frameBuffer.color, frameBuffer.height, frameBuffer.yReversed);
+    backEnd.depth = getPixelRows(frameBuffer.depth, frameBuffer.height, frameBuffer.yReversed);
+    backEnd.stencil = getPixelRows(frameBuffer.stencil, frameBuffer.height, frameBuffer.yReversed);
+
+    // Stencil function and operations evaluated for every possible stencil value
+    if(stencilMode != StencilMode::NONE) {
+        const StencilSettings &stencilSettings = memory.stencilSettings;
+        for(uint32_t value = 0; value < 256; value++) {
+            const uint8_t stencilValue = static_cast<uint8_t>(value);
+            backEnd.stencilPass[value] = evaluateStencilFunction(stencilValue, stencilSettings.func, stencilSettings.refValue);
+
+            for(int isFacingFront = 0; isFacingFront < 2; isFacingFront++) {
+                const auto &[sfail, dpfail, dppass] = isFacingFront ? stencilSettings.frontOps : stencilSettings.backOps;
+                const StencilOp operations[3] = {sfail, dpfail, dppass};
+                for(int iOperation = 0; iOperation < 3; iOperation++) {
+                    uint8_t newValue = stencilValue;
+                    executeStencilOperation(newValue, operations[iOperation], stencilSettings.refValue);
+                    backEnd.stencilOps[isFacingFront][iOperation][value] = newValue;
+                } // for(iOperation)
+            } // for(isFacingFront)
+        } // for(value)
+    }
+
+    // Without any test there is nothing to run before the interpolation
+    if(getGPUSettings().lazyAttributeInterpolation && (stencilMode != StencilMode::NONE || depthMode != DepthMode::NONE)) {
+        backEnd.testFragment = selectTestFragment(stencilMode, depthMode);
+        backEnd.shadeFragment = selectShadeFragment<true>(stencilMode, depthMode, colorMode);
+    }
+    else {
+        backEnd.shadeFragment = selectShadeFragment<false>(stencilMode, depthMode, colorMode);
+    }
+
+    // Fragments skipped by the hierarchical depth buffer would only fail the
+    // depth test, which changes nothing but stencil (dpfail). Hi-Z tiles must
+    // not be shared by the threads of the tile-binned back-end.
+    if(getGPUSettings().hierarchicalDepth && depthMode != DepthMode::NONE) {
+        const bool hasAlignedTiles = !isTileBinningEnabled() || std::max(1u, getGPUSettings().tileSize) % depthTileSize == 0;
+        if(hasAlignedTiles && stencilMode != StencilMode::TEST_WRITE) {
+            bindHierarchicalDepth(frameBuffer);
+            backEnd.useHierarchicalDepth = true;
+            backEnd.hasDepthWrites = depthMode == DepthMode::TEST_WRITE;
+        }
+    }
+
+    // Without color writes the only outputs of a color-only shader are lost,
+    // thus only the depth (and stencil) of the fragment matters
+    const FragmentShader fragmentShader = memory.programs[memory.activatedProgram].fragmentShader;
+    if(getGPUSettings().depthOnlyFragments && colorMode == ColorMode::NONE && isColorOnlyFragmentShader(fragmentShader)) {
+        backEnd.shadeDepth = selectShadeDepth(stencilMode, depthMode);
+    }
+} // setupFragmentBackEnd()
+
 
 /********************************************************************************/
 /*                                                                              */
@@ -1179,6 +3516,7 @@ inline uint32_t clippingSutherlandHodgman(const Program &program, const OutVerte
     // Initialize buffer for storing the clipped polygon (may have up to 4 vertices)
     OutVertex clippedTriangle[4];
     uint32_t clippedVertexCount{0};
+    bool isClipped{false};
 
     // Process each edge of the input triangle using Sutherland-Hodgman algorithm
     for(uint32_t iVertex = 0; iVertex < vertexCount; iVertex++) {
@@ -1188,6 +3526,7 @@ inline uint32_t clippingSutherlandHodgman(const Program &program, const OutVerte
         // Determine if vertices are inside or outside the clipping plane
         const bool isPreviousInside = isVertexInsideClipPlane(previousVertex);
         const bool isCurrentInside = isVertexInsideClipPlane(currentVertex);
+        isClipped |= !isCurrentInside;
 
         // Clip the triangle as shown in the picture '14 Ořez: Teorie ořezu'
         // Both vertices inside - keep the current vertex
@@ -1214,8 +3553,13 @@ inline uint32_t clippingSutherlandHodgman(const Program &program, const OutVerte
         }
     } // for(iVertex)
 
+    if(isClipped) {
+        pipelineCounters.trianglesClipped++;
+    }
+
     // Handle results based on number of vertices in the clipped polygon
     if(clippedVertexCount < vertexCount) {
+        pipelineCounters.trianglesClippedAway++;
         return 0;  // triangle completely clipped away
     }
 
@@ -1324,6 +3668,130 @@ inline OutVertex interpolateVertex(const Program &program, const OutVertex &star
 } // interpolateVertex()
 
 
+/******************************************************************************/
+/*                                                                            */
+/*              ATTRIBUTE DERIVATIVES (used by mipmapped textures)            */
+/*                                                                            */
+/******************************************************************************/
+
+bool student_getAttributeDerivatives(const uint32_t attribute, glm::vec4 &dFdx, glm::vec4 &dFdy) {
+    const TriangleSetup *pTriangle = shadedFragment.pTriangle;
+    if(!pTriangle || attribute >= maxAttribs) {
+        return false;
+    }
+
+    const InFragment &inFragment = *shadedFragment.pInFragment;
+    const OutVertex *outVertices = pTriangle->outTriangle;
+
+    // Attribute of the fragment as vec4 (components of smaller types are zero)
+    auto getValue = [&](const Attrib &value, const AttribType type) {
+        switch(type) {
+            case AttribType::FLOAT: return glm::vec4(value.v1, 0.f, 0.f, 0.f);
+            case AttribType::VEC2:  return glm::vec4(value.v2, 0.f, 0.f);
+            case AttribType::VEC3:  return glm::vec4(value.v3, 0.f);
+            default:                return value.v4;
+        } // switch(type)
+    };
+    const AttribType type = shadedFragment.pProgram->vs2fs[attribute];
+    if(type == AttribType::EMPTY || static_cast<uint8_t>(type) > static_cast<uint8_t>(AttribType::VEC4)) {
+        return false;
+    }
+
+    // Quad shading - differences of the row and the column of the fragment in its quad
+    if(const InFragment *pQuad = shadedFragment.pQuad) {
+        const uint32_t iRow = shadedFragment.iQuadLane / quadSize;
+        const uint32_t iColumn = shadedFragment.iQuadLane % quadSize;
+        dFdx = getValue(pQuad[iRow * quadSize + 1].attributes[attribute], type) - getValue(pQuad[iRow * quadSize].attributes[attribute], type);
+        dFdy = getValue(pQuad[quadSize + iColumn].attributes[attribute], type) - getValue(pQuad[iColumn].attributes[attribute], type);
+        return true;
+    }
+
+    // a = sum(λi/wi * ai) / sum(λi/wi), thus
+    // da/dx = sum(dλi/dx / wi * (ai - a)) / sum(λi/wi), where 1 / sum(λi/wi) is gl_FragCoord.w
+    const glm::vec4 value = getValue(inFragment.attributes[attribute], type);
+    dFdx = glm::vec4(0.f);
+    dFdy = glm::vec4(0.f);
+    for(int iVertex = 0; iVertex < 3; iVertex++) {
+        const glm::vec4 difference = getValue(outVertices[iVertex].attributes[attribute], type) - value;
+        dFdx += difference * (pTriangle->barycentricStepX[iVertex] * pTriangle->oneOverW[iVertex]);
+        dFdy += difference * (pTriangle->barycentricStepY[iVertex] * pTriangle->oneOverW[iVertex]);
+    } // for(iVertex)
+    dFdx *= inFragment.gl_FragCoord.w;
+    dFdy *= inFragment.gl_FragCoord.w;
+    return true;
+} // student_getAttributeDerivatives()
+
+
+/******************************************************************************/
+/*                                                                            */
+/*                 STAGE ENTRY POINTS (used by microbenchmarks)               */
+/*                                                                            */
+/******************************************************************************/
+
+uint32_t runClippingStage(const Program &program, const OutVertex inputTriangle[3], OutVertex outputTriangles[2][3]) {
+    return clippingSutherlandHodgman(program, inputTriangle, outputTriangles);
+} // runClippingStage()
+
+void runRasterizationStage(const GPUMemory &memory, const OutVertex outTriangle[3]) {
+    const Program &program = memory.programs[memory.activatedProgram];
+    const Framebuffer &frameBuffer = memory.framebuffers[memory.activatedFramebuffer];
+
+    // Same setup as in handleDrawCommand() and processTriangle()
+    ShaderInterface shaderInterface;
+    shaderInterface.gl_DrawID = memory.gl_DrawID;
+    shaderInterface.uniforms = memory.uniforms;
+    shaderInterface.textures = memory.textures;
+
+    FragmentBackEnd fragmentBackEnd;
+    setupFragmentBackEnd(memory, frameBuffer, fragmentBackEnd);
+
+    glm::vec3 screenSpaceVertices[3];
+    float oneOverW[3];
+    for(int iVertex = 0; iVertex < 3; iVertex++) {
+        const glm::vec3 normalizedDeviceCoordinates = perspectiveDivision(outTriangle[iVertex].gl_Position, oneOverW[iVertex]);
+        screenSpaceVertices[iVertex] = viewportTransformation(normalizedDeviceCoordinates, frameBuffer.width, frameBuffer.height);
+    } // for(iVertex)
+
+    rasterizeTriangleUsingPineda(memory, program, frameBuffer, shaderInterface, fragmentBackEnd, outTriangle,
+                                 screenSpaceVertices, oneOverW, getFramebufferRegion(frameBuffer));
+} // runRasterizationStage()
+
+void runVertexAssemblyStage(const GPUMemory &memory, InVertex &inVertex) {
+    vertexAssemblyUnit(memory, inVertex);
+} // runVertexAssemblyStage()
+
+void runAttributeInterpolationStage(const Program &program, const float lambda0, const float lambda1, const float lambda2,
+                                    InFragment &inFragment, const OutVertex outVertices[3]) {
+    interpolateFragmentAttributes(program, lambda0, lambda1, lambda2, inFragment, outVertices);
+} // runAttributeInterpolationStage()
+
+void runAttributeSetupStage(const Program &program, const OutVertex outVertices[3], const glm::vec3 vertices[3],
+                            const float oneOverW[3], const int originX, const int originY, AttributePlanes &planes) {
+    setupAttributePlanes(program, outVertices, vertices, oneOverW, originX, originY, planes);
+} // runAttributeSetupStage()
+
+float runAttributePlaneStage(const AttributePlanes &planes, const OutVertex outVertices[3], const int x, const int y,
+                             InFragment &inFragment) {
+    return interpolateAttributePlanes(planes, outVertices, x, y, inFragment);
+} // runAttributePlaneStage()
+
+void runStencilOperationStage(uint8_t &stencilValue, const StencilOp stencilOperation, const uint32_t stencilValueReference) {
+    executeStencilOperation(stencilValue, stencilOperation, stencilValueReference);
+} // runStencilOperationStage()
+
+void runClearColorStage(const GPUMemory &memory, const ClearColorCommand &clearColorCommand) {
+    handleClearColorCommand(memory, clearColorCommand);
+} // runClearColorStage()
+
+void runClearDepthStage(const GPUMemory &memory, const ClearDepthCommand &clearDepthCommand) {
+    handleClearDepthCommand(memory, clearDepthCommand);
+} // runClearDepthStage()
+
+void runClearStencilStage(const GPUMemory &memory, const ClearStencilCommand &clearStencilCommand) {
+    handleClearStencilCommand(memory, clearStencilCommand);
+} // runClearStencilStage()
+
+
 /******************************************************************************/
 /*                                                                            */
 /*                          GENERAL HELPER FUNCTIONS                          */
@@ -1351,4 +3819,89 @@ inline float castUnsignedInt8ToNormalizedFloat(const uint8_t value) {
     return static_cast<float>(value) / 255.0f;
 } // castUnsignedInt8ToNormalizedFloat()
 
+inline uint64_t readPipelineClock() {
+    if(!getGPUSettings().pipelineTimings) {
+        return 0;
+    }
+
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+} // readPipelineClock()
+
+inline void addCommandTime(const CommandType type, const uint64_t startTime) {
+    // Timings are disabled (or the command was not timed)
+    if(!startTime) {
+        return;
+    }
+
+    PipelineStatistics &statistics = getPipelineStatistics();
+    switch(type) {
+        case CommandType::CLEAR_COLOR:
+        case CommandType::CLEAR_DEPTH:
+        case CommandType::CLEAR_STENCIL:
+            statistics.clearTime += readPipelineClock() - startTime;
+            break;
+        case CommandType::DRAW:
+            statistics.drawTime += readPipelineClock() - startTime;
+            break;
+        default:
+            break;
+    } // switch(type)
+} // addCommandTime()
+
+inline void traceCommand(const CommandType type, const CommandData &data, const uint32_t drawID, const uint64_t startTime) {
+    TraceSpan span;
+    span.name = getCommandTypeName(type);
+    span.startTime = startTime;
+    span.duration = readTraceClock() - startTime;
+
+    // Category and arguments shown by the trace viewer
+    switch(type) {
+        case CommandType::CLEAR_COLOR:
+        case CommandType::CLEAR_DEPTH:
+        case CommandType::CLEAR_STENCIL:
+            span.category = "clear";
+            break;
+        case CommandType::DRAW:
+            span.category = "draw";
+            span.argumentNames[0] = "drawID";
+            span.argumentValues[0] = drawID;
+            span.argumentNames[1] = "nofVertices";
+            span.argumentValues[1] = data.drawCommand.nofVertices;
+            break;
+        case CommandType::SUB_COMMAND:
+            span.category = "sub";
+            if(data.subCommand.commandBuffer) {
+                span.argumentNames[0] = "nofCommands";
+                span.argumentValues[0] = data.subCommand.commandBuffer->nofCommands;
+            }
+            break;
+        case CommandType::USER_COMMAND:
+            span.category = "user";
+            break;
+        case CommandType::SET_DRAW_ID:
+            span.category = "state";
+            span.argumentNames[0] = "drawID";
+            span.argumentValues[0] = data.setDrawIdCommand.id;
+            break;
+        default:
+            span.category = "state";
+            break;
+    } // switch(type)
+
+    addTraceSpan(span);
+} // traceCommand()
+
+inline void traceFrame(const uint64_t startTime) {
+    TraceSpan span;
+    span.name = "student_GPU_run";
+    span.category = "frame";
+    span.startTime = startTime;
+    span.duration = readTraceClock() - startTime;
+    addTraceSpan(span);
+
+    // The trace is written after its last frame
+    endTraceFrame();
+} // traceFrame()
+
 /*** end of file gpu.cpp ***/
@@ -8,6 +8,11 @@
 #pragma once
 
 #include <solutionInterface/gpu.hpp>
+#include <studentSolution/commandPlan.hpp>
+#include <studentSolution/commandStream.hpp>
+#include <studentSolution/fragmentShaderTraits.hpp>
+#include <studentSolution/vertexBatch.hpp>
+#include <vector>
 
 /*
  * DISCLAIMER: This header file prototype documentation was co-created with the
@@ -49,6 +54,42 @@ void student_GPU_run(GPUMemory &mem, const CommandBuffer &cb);
  */
 void executeCommandBuffer(GPUMemory &memory, const CommandBuffer &commandBuffer);
 
+/**
+ * @brief Entry point for execution of a growable command stream.
+ *
+ * @details Behaves exactly like `student_GPU_run()` with a `CommandBuffer`
+ *          containing the same commands, but the stream is not limited to
+ *          `CommandBuffer::maxCommands` commands.
+ *
+ * @param mem Reference to GPU memory containing all resources.
+ * @param cs Command stream containing the commands to be executed.
+ */
+void student_GPU_run(GPUMemory &mem, const CommandStream &cs);
+
+/**
+ * @brief Processes all records of a command stream sequentially.
+ *
+ * @details Payload of each record is copied into `CommandData` and passed to
+ *          `handleCommand()`, sub-stream records are executed recursively
+ *          (just like sub-command buffers).
+ *
+ * @param memory Reference to GPU memory where operations will be performed.
+ * @param commandStream The stream containing commands to be processed.
+ */
+void executeCommandStream(GPUMemory &memory, const CommandStream &commandStream);
+
+/**
+ * @brief Executes a compiled plan of a command buffer tree.
+ *
+ * @details Used instead of `executeCommandBuffer()` when compiled command
+ *          buffers are enabled in `GPUSettings`. Leaves the GPU memory in
+ *          the same state as executing the source tree.
+ *
+ * @param memory Reference to GPU memory where operations will be performed.
+ * @param plan Plan returned by `getCommandPlan()`.
+ */
+void executeCommandPlan(GPUMemory &memory, const CommandPlan &plan);
+
 /**
  * @brief Processes a single GPU command.
  *
@@ -230,6 +271,114 @@ uint32_t getVertexIndex(const GPUMemory &memory, uint32_t vertexIndex);
  */
 void vertexAssemblyUnit(const GPUMemory &memory, InVertex &inVertex);
 
+/**
+ * @brief Post-transform vertex cache (vertex shader outputs of one draw).
+ */
+struct VertexCache {
+    static constexpr uint32_t maxNofVertices = 1u << 20;  ///< larger gl_VertexIDs are not cached
+    std::vector<OutVertex> vertices;                      ///< shaded vertices indexed by gl_VertexID
+    std::vector<uint32_t> stamps;                         ///< draw stamp of each entry (valid = current stamp)
+    uint32_t stamp = 0;                                   ///< stamp of the current draw
+};
+
+/**
+ * @brief Checks whether the post-transform cache can help the current draw.
+ *
+ * @param memory GPU memory with the active vertex array.
+ *
+ * @return `bool` True for indexed draws (only they can reuse vertices).
+ */
+bool isVertexCacheUsable(const GPUMemory &memory);
+
+/**
+ * @brief Invalidates all cached vertices before a new draw.
+ */
+void beginVertexCacheDraw();
+
+/**
+ * @brief Looks up a shaded vertex of the current draw.
+ *
+ * @param vertexID The gl_VertexID of the vertex.
+ * @param outVertex Output vertex filled on hit.
+ *
+ * @return `bool` True on cache hit.
+ */
+bool fetchCachedVertex(uint32_t vertexID, OutVertex &outVertex);
+
+/**
+ * @brief Stores a shaded vertex of the current draw.
+ *
+ * @param vertexID The gl_VertexID of the vertex.
+ * @param outVertex Output of the vertex shader.
+ */
+void storeCachedVertex(uint32_t vertexID, const OutVertex &outVertex);
+
+/**
+ * @brief Routine copying one attribute of one vertex from a buffer.
+ */
+using AttributeFetch = void(*)(const uint8_t *pAttribute, Attrib &attribute);
+
+/**
+ * @brief Vertex array decoded once per draw for the batched vertex stage.
+ *
+ * @details Only active attributes are stored, each with its own fetch
+ *          routine specialized for the attribute type, so no per-vertex
+ *          switching over `AttribType` is needed.
+ */
+struct VertexFetcher {
+    const uint8_t *pIndices = nullptr;            ///< index buffer data (nullptr = non-indexed draw)
+    IndexType      indexType = IndexType::U32;    ///< type of indices
+    uint32_t       nofAttributes = 0;             ///< number of active attributes
+    uint32_t       attributeIndex[maxAttribs];    ///< attribute slot of each active attribute
+    const uint8_t *pAttributes[maxAttribs];       ///< buffer data + offset of each active attribute
+    uint64_t       attributeStride[maxAttribs];   ///< stride of each active attribute
+    AttributeFetch fetchAttribute[maxAttribs];    ///< specialized copy routine of each active attribute
+};
+
+/**
+ * @brief Decodes the active vertex array into a vertex fetcher.
+ *
+ * @param memory GPU memory with the active vertex array and buffers.
+ * @param fetcher Fetcher to be filled.
+ */
+void setupVertexFetcher(const GPUMemory &memory, VertexFetcher &fetcher);
+
+/**
+ * @brief Same as `getVertexIndex()`, but uses the decoded vertex array.
+ *
+ * @param fetcher Decoded vertex array.
+ * @param vertexIndex Sequence number of the vertex in the drawing command.
+ *
+ * @return `uint32_t` The vertex index value (`gl_VertexID`).
+ */
+uint32_t fetchVertexIndex(const VertexFetcher &fetcher, uint32_t vertexIndex);
+
+/**
+ * @brief Batched vertex stage - shades `nofVertices` consecutive vertices of
+ *        a draw.
+ *
+ * @details Vertices are fetched and shaded in batches of `vertexBatchSize`.
+ *          The batch shader registered for `program.vertexShader` is used if
+ *          there is one, otherwise the per-vertex shader is run for each lane.
+ *          With the vertex cache enabled, every unique vertex is shaded only
+ *          once (also within a batch).
+ *
+ * @param program Active program.
+ * @param shaderInterface Constants of the draw.
+ * @param fetcher Decoded vertex array.
+ * @param batchVertexShader Batch version of the vertex shader or `nullptr`.
+ * @param firstVertex Sequence number of the first vertex in the draw.
+ * @param nofVertices Number of vertices to shade.
+ * @param useVertexCache Whether the post-transform cache is used.
+ * @param outVertices Output vertices (`nofVertices` entries).
+ * @param nofCacheHits Incremented by number of cache hits.
+ * @param nofCacheMisses Incremented by number of cache misses.
+ */
+void runBatchedVertexStage(const Program &program, const ShaderInterface &shaderInterface,
+                           const VertexFetcher &fetcher, BatchVertexShader batchVertexShader,
+                           uint32_t firstVertex, uint32_t nofVertices, bool useVertexCache,
+                           OutVertex outVertices[], uint64_t &nofCacheHits, uint64_t &nofCacheMisses);
+
 
 /******************************************************************************/
 /*                                                                            */
@@ -239,6 +388,31 @@ void vertexAssemblyUnit(const GPUMemory &memory, InVertex &inVertex);
 /*                                                                            */
 /******************************************************************************/
 
+struct ScreenRegion;
+struct FragmentBackEnd;
+
+/**
+ * @brief Processes one assembled triangle of a draw.
+ *
+ * @details Clips the triangle, transforms the clipped triangles to screen
+ *          space, culls back faces and either rasterizes them immediately or
+ *          stores them into the tile bins.
+ *
+ * @param memory GPU memory containing all resources.
+ * @param program Active shader program.
+ * @param frameBuffer Target framebuffer.
+ * @param shaderInterface Constants for the fragment shader.
+ * @param fragmentBackEnd Per-fragment operations selected for the draw.
+ * @param outTriangle Array of three output vertices from the vertex shader.
+ * @param useTileBinning Whether triangles are binned instead of rasterized.
+ * @param binnedDrawIndex Index of the draw returned by `beginBinnedDraw()`.
+ * @param frameBufferRegion Region of the whole framebuffer.
+ */
+void processTriangle(const GPUMemory &memory, const Program &program, const Framebuffer &frameBuffer,
+                     const ShaderInterface &shaderInterface, const FragmentBackEnd &fragmentBackEnd,
+                     const OutVertex outTriangle[3], bool useTileBinning, uint32_t binnedDrawIndex,
+                     const ScreenRegion &frameBufferRegion);
+
 /**
  * @brief Performs perspective division on clip-space coordinates.
  *
@@ -300,28 +474,355 @@ bool backFaceCulling(const glm::vec3 triangleVertex[3], const BackfaceCulling &b
 /*                                                                            */
 /******************************************************************************/
 
+/**
+ * @brief Rectangular region of the screen (inclusive pixel coordinates).
+ */
+struct ScreenRegion {
+    int minX;  ///< left-most pixel column
+    int minY;  ///< bottom-most pixel row
+    int maxX;  ///< right-most pixel column
+    int maxY;  ///< top-most pixel row
+};
+
+//! Stencil part of a specialized per-fragment back-end
+enum class StencilMode {
+    NONE,        ///< no stencil test
+    TEST,        ///< stencil test without writes
+    TEST_WRITE,  ///< stencil test and stencil operations
+};
+
+//! Depth part of a specialized per-fragment back-end
+enum class DepthMode {
+    NONE,        ///< no depth buffer
+    TEST,        ///< depth test without writes
+    TEST_WRITE,  ///< depth test and depth writes
+};
+
+//! Color part of a specialized per-fragment back-end
+enum class ColorMode {
+    NONE,   ///< no color writes
+    RGBA8,  ///< blending into 8-bit RGBA pixels
+    RGB8,   ///< blending into 8-bit RGB pixels
+};
+
+/**
+ * @brief Rows of a framebuffer image with the y-reversal already applied.
+ */
+struct PixelRows {
+    uint8_t *pRow0 = nullptr;    ///< first byte of row y = 0
+    int64_t  rowStep = 0;        ///< bytes between rows y and y + 1 (negative if reversed)
+    uint32_t bytesPerPixel = 0;  ///< size of a pixel in bytes
+};
+
+/**
+ * @brief Runs the early per-fragment operations, the fragment shader and the
+ *        late per-fragment operations for one fragment.
+ */
+using ShadeFragment = void(*)(const FragmentBackEnd &backEnd, const Program &program, const ShaderInterface &shaderInterface,
+                              const InFragment &inFragment, bool isFacingFront);
+
+/**
+ * @brief Runs the per-fragment operations of a fragment whose shader can be
+ *        skipped (depth-only draws), the depth comes straight from the
+ *        edge functions.
+ */
+using ShadeDepth = void(*)(const FragmentBackEnd &backEnd, int x, int y, float depth, bool isFacingFront);
+
+/**
+ * @brief Runs the stencil and depth tests of a fragment before its attributes
+ *        are interpolated (including the stencil operations and depth writes
+ *        the tests do).
+ *
+ * @return `bool` True if the fragment survived and has to be shaded.
+ */
+using TestFragment = bool(*)(const FragmentBackEnd &backEnd, int x, int y, float depth, bool isFacingFront);
+
+//! Indices of stencil operations in `FragmentBackEnd::stencilOps`
+enum StencilOpIndex {
+    STENCIL_SFAIL = 0,
+    STENCIL_DPFAIL = 1,
+    STENCIL_DPPASS = 2,
+};
+
+/**
+ * @brief Per-fragment operations selected once per draw from the GPU state.
+ *
+ * @details The stencil function and operations are evaluated into lookup
+ *          tables indexed by the current stencil value, so the specialized
+ *          back-ends do not branch on the stencil state at all.
+ */
+struct FragmentBackEnd {
+    ShadeFragment      shadeFragment = nullptr;  ///< selected (specialized or generic) routine
+    ShadeDepth         shadeDepth = nullptr;     ///< depth-only routine, `nullptr` if the shader has to run
+    TestFragment       testFragment = nullptr;   ///< early tests run before interpolation, `nullptr` if `shadeFragment` runs them
+    const GPUMemory   *pMemory = nullptr;        ///< GPU state (used by the generic back-end)
+    const Framebuffer *pFrameBuffer = nullptr;   ///< framebuffer (used by the generic back-end)
+    PixelRows          color;                    ///< color buffer rows
+    PixelRows          depth;                    ///< depth buffer rows
+    PixelRows          stencil;                  ///< stencil buffer rows
+    bool               stencilPass[256];         ///< result of the stencil function for each stencil value
+    uint8_t            stencilOps[2][3][256];    ///< [isFacingFront][StencilOpIndex][old value] = new value
+    bool               useHierarchicalDepth = false;///< tiles behind the Hi-Z buffer are skipped (no stencil writes)
+    bool               hasDepthWrites = false;   ///< the draw writes depth (Hi-Z tiles it touches become stale)
+};
+
+/**
+ * @brief Interpolated attributes of a triangle as screen-space plane equations.
+ *
+ * @details Attributes divided by w (and 1/w itself) are linear in screen
+ *          space, so every float component is `a/w = c + a * dx + b * dy`,
+ *          where dx, dy are offsets of the pixel from the origin pixel. The
+ *          coefficients are computed once per triangle, a fragment then costs
+ *          two multiply-adds per component and a single reciprocal of 1/w.
+ *          Only the components the program passes to the fragment shader are
+ *          stored. Integer attributes are flat (taken from vertex 0).
+ */
+struct AttributePlanes {
+    int      originX = 0;                        ///< pixel column the planes are relative to
+    int      originY = 0;                        ///< pixel row the planes are relative to
+    float    oneOverWOrigin = 0.f;               ///< 1/w in the center of the origin pixel
+    float    oneOverWStepX = 0.f;                ///< change of 1/w per pixel in x
+    float    oneOverWStepY = 0.f;                ///< change of 1/w per pixel in y
+    uint32_t nofComponents = 0;                  ///< number of interpolated float components
+    uint8_t  components[maxAttribs * 4];         ///< index of the component in `InFragment::attributes` (4 floats per attribute)
+    float    origin[maxAttribs * 4];             ///< component divided by w in the center of the origin pixel
+    float    stepX[maxAttribs * 4];              ///< change of the component divided by w per pixel in x
+    float    stepY[maxAttribs * 4];              ///< change of the component divided by w per pixel in y
+    uint32_t nofFlatAttributes = 0;              ///< number of integer attributes
+    uint8_t  flatAttributes[maxAttribs];         ///< indices of the integer attributes
+};
+
+/**
+ * @brief Per-triangle constants shared by all fragments of the triangle.
+ */
+struct TriangleSetup {
+    const OutVertex *outTriangle;  ///< three vertex shader outputs
+    const glm::vec3 *vertices;     ///< three screen-space vertices
+    const float     *oneOverW;     ///< three 1/w values for perspective correction
+    float            triangleArea; ///< absolute value of the double area of the triangle
+    glm::vec3        barycentricStepX;///< change of the three 2D barycentric coordinates per pixel in x
+    glm::vec3        barycentricStepY;///< change of the three 2D barycentric coordinates per pixel in y
+    bool             isFacingFront;///< is the triangle front facing?
+    const FragmentBackEnd *pFragmentBackEnd;///< per-fragment operations of the draw
+    AttributePlanes  attributePlanes;///< interpolated attributes (not set up for depth-only draws)
+};
+
+/**
+ * @brief Fragment whose shader is being executed.
+ *
+ * @details Lets `student_getAttributeDerivatives()` reach the triangle of the
+ *          fragment without changing the shader interface. With quad shading
+ *          it also reaches the other three fragments of the 2x2 quad.
+ */
+struct ShadedFragment {
+    const Program       *pProgram = nullptr;   ///< program of the draw
+    const TriangleSetup *pTriangle = nullptr;  ///< triangle of the fragment (nullptr outside of the rasterizer)
+    const InFragment    *pInFragment = nullptr;///< interpolated attributes of the fragment
+    const InFragment    *pQuad = nullptr;      ///< four fragments of the quad (nullptr if the fragment is shaded alone)
+    uint32_t             iQuadLane = 0;        ///< lane of the fragment in the quad (`iRow * 2 + iColumn`)
+};
+
+//! Width and height of a quad of fragments shaded together (quad shading)
+constexpr int quadSize = 2;
+
 /**
  * @brief Rasterizes a triangle using the Pineda algorithm.
  *
  * @details Converts a triangle into fragments (potential pixels) using edge functions.
  *          For each pixel within the triangle's bounding box, determines if it's inside
  *          the triangle, interpolates vertex attributes, and invokes the fragment shader.
+ *          When SIMD rasterization is enabled, the edge functions are evaluated
+ *          for square blocks of pixels at once (one SIMD lane per scanline) and
+ *          only pixels set in the resulting coverage mask are processed.
+ *          With hierarchical rasterization, the region and every block are
+ *          first classified as outside/inside/partial, so outside blocks are
+ *          skipped and inside blocks need no per-pixel edge tests.
+ *          With quad shading, scanlines are traversed in pairs and pixels
+ *          are handed over in screen-aligned 2x2 quads (`processQuad()`),
+ *          the edge functions are stepped exactly like in the scalar loop.
  *
  * @param memory GPU memory containing all resources.
  * @param program Active shader program with vertex and fragment shaders.
  * @param frameBuffer Target framebuffer for rendering output.
  * @param shaderInterface Interface for passing uniform data to shaders.
+ * @param fragmentBackEnd Per-fragment operations selected for the draw.
  * @param outTriangle Array of three output vertices from the vertex shader.
  * @param vertices Array of three screen-space vertex positions after viewport transform.
  * @param oneOverW Array of 1/w values for perspective-correct interpolation.
+ * @param region Screen region (e.g. a tile) pixels are generated in. Edge
+ *               functions are stepped from the corner of the whole bounding
+ *               box, so the result does not depend on the region split.
  */
 void rasterizeTriangleUsingPineda(const GPUMemory &memory,
                                   const Program &program,
                                   const Framebuffer &frameBuffer,
                                   const ShaderInterface &shaderInterface,
+                                  const FragmentBackEnd &fragmentBackEnd,
                                   const OutVertex outTriangle[3],
                                   const glm::vec3 vertices[3],
-                                  const float oneOverW[3]);
+                                  const float oneOverW[3],
+                                  const ScreenRegion &region);
+
+/**
+ * @brief Processes a single covered pixel of a triangle.
+ *
+ * @details Calculates barycentric coordinates from the edge function values,
+ *          interpolates depth and attributes and hands the fragment over to
+ *          the per-fragment back-end of the draw (early per-fragment
+ *          operations, fragment shader, late per-fragment operations).
+ *          Back-ends with a separate test stage get the fragment right after
+ *          its depth is known, attributes are interpolated only for the
+ *          fragments that survive the stencil and depth tests.
+ *
+ * @param program Active shader program.
+ * @param shaderInterface Interface for passing uniform data to shaders.
+ * @param triangle Per-triangle constants.
+ * @param x Pixel column.
+ * @param y Pixel row.
+ * @param edgeFunction12 Value of the edge function opposite to vertex 0.
+ * @param edgeFunction20 Value of the edge function opposite to vertex 1.
+ * @param edgeFunction01 Value of the edge function opposite to vertex 2.
+ */
+void processFragment(const Program &program,
+                     const ShaderInterface &shaderInterface,
+                     const TriangleSetup &triangle,
+                     int x, int y,
+                     float edgeFunction12, float edgeFunction20, float edgeFunction01);
+
+/**
+ * @brief Processes a 2x2 quad of pixels of a triangle (quad shading).
+ *
+ * @details Covered fragments get their depth and run the early tests one
+ *          by one like in `processFragment()`. If any of them survives,
+ *          attributes are interpolated for all four lanes - lanes that are
+ *          not covered or failed the tests are helper lanes, which are never
+ *          shaded and only make the differences of the quad complete. The
+ *          surviving fragments are then shaded in lane order and
+ *          `student_getAttributeDerivatives()` returns the differences of
+ *          their row and column of the quad.
+ *
+ * @param program Active shader program.
+ * @param shaderInterface Interface for passing uniform data to shaders.
+ * @param triangle Per-triangle constants.
+ * @param quadX Pixel column of the left lanes (even).
+ * @param quadY Pixel row of the bottom lanes (even).
+ * @param edgeFunctions Values of the edge functions 12, 20, 01 of the covered lanes.
+ * @param coverageMask Covered lanes, bit `iRow * 2 + iColumn`.
+ */
+void processQuad(const Program &program,
+                 const ShaderInterface &shaderInterface,
+                 const TriangleSetup &triangle,
+                 int quadX, int quadY,
+                 const float edgeFunctions[4][3], uint32_t coverageMask);
+
+/**
+ * @brief Rasterizes a triangle with vertices snapped to 1/256 pixel grid
+ *        and integer edge functions.
+ *
+ * @details Snapped vertices and 64-bit edge functions make the coverage
+ *          exact: every pixel gets the same value regardless of traversal
+ *          order or tiling, and shared edges are drawn exactly once thanks
+ *          to the same top-left rule as in the float rasterizer. Pixels are
+ *          traversed in 8x8 blocks classified exactly by their corners
+ *          (aligned to even pixels and split into 2x2 quads with quad shading).
+ *
+ * @param memory GPU memory containing all resources.
+ * @param program Active shader program.
+ * @param frameBuffer Target framebuffer.
+ * @param shaderInterface Interface for passing uniform data to shaders.
+ * @param fragmentBackEnd Per-fragment operations selected for the draw.
+ * @param outTriangle Array of three output vertices from the vertex shader.
+ * @param vertices Array of three screen-space vertex positions.
+ * @param oneOverW Array of 1/w values for perspective-correct interpolation.
+ * @param region Screen region pixels are generated in.
+ *
+ * @return `bool` False if a vertex lies out of the guard band where 64-bit
+ *         integers suffice (the caller then uses the float rasterizer).
+ */
+bool rasterizeTriangleFixedPoint(const GPUMemory &memory,
+                                 const Program &program,
+                                 const Framebuffer &frameBuffer,
+                                 const ShaderInterface &shaderInterface,
+                                 const FragmentBackEnd &fragmentBackEnd,
+                                 const OutVertex outTriangle[3],
+                                 const glm::vec3 vertices[3],
+                                 const float oneOverW[3],
+                                 const ScreenRegion &region);
+
+/**
+ * @brief Classification of a screen block against the triangle edges.
+ */
+enum class BlockClass {
+    OUTSIDE,  ///< no pixel of the block can be covered
+    INSIDE,   ///< all pixels of the block are covered
+    PARTIAL,  ///< pixels have to be tested one by one
+};
+
+/**
+ * @brief Data needed to bound values of one incrementally evaluated edge function.
+ */
+struct EdgeBounds {
+    double firstPixelValue;  ///< value in the first pixel of the bounding box
+    double stepX;            ///< increment per pixel column
+    double stepY;            ///< increment per pixel row
+    double errorPerStep;     ///< upper bound of the rounding error of one float addition
+};
+
+/**
+ * @brief Prepares bounds of an edge function for block classification.
+ *
+ * @param firstPixelValue Edge function value in the first pixel of the bounding box.
+ * @param stepX Increment per pixel column.
+ * @param stepY Increment per pixel row.
+ * @param nofColumns Width of the bounding box.
+ * @param nofRows Height of the bounding box.
+ *
+ * @return `EdgeBounds` Bounds used by `classifyBlock()`.
+ */
+EdgeBounds computeEdgeBounds(float firstPixelValue, float stepX, float stepY, int nofColumns, int nofRows);
+
+/**
+ * @brief Conservatively classifies a block of pixels against three edges.
+ *
+ * @details The rasterizer evaluates edge functions by adding float steps, so
+ *          the classification accounts for the worst accumulated rounding
+ *          error. A block is INSIDE/OUTSIDE only if the incremental (exact
+ *          pixel by pixel) evaluation would give the same answer for every
+ *          pixel, thus the coverage does not change at all.
+ *
+ * @param edges Bounds of the three edge functions.
+ * @param firstColumn First column of the block (relative to the bounding box).
+ * @param lastColumn Last column of the block (relative to the bounding box).
+ * @param firstRow First row of the block (relative to the bounding box).
+ * @param lastRow Last row of the block (relative to the bounding box).
+ *
+ * @return `BlockClass` Class of the block.
+ */
+BlockClass classifyBlock(const EdgeBounds edges[3], int firstColumn, int lastColumn, int firstRow, int lastRow);
+
+struct DepthPlane;
+
+/**
+ * @brief Computes conservative depth of a triangle rasterized by the float
+ *        rasterizer (for the hierarchical depth buffer).
+ *
+ * @details Barycentric coordinates of the rasterizer are the incrementally
+ *          evaluated edge functions divided by the area, so the depth is
+ *          a plane up to the accumulated error of the edge functions (see
+ *          `computeEdgeBounds()`) and the rounding of the interpolation.
+ *
+ * @param vertices Array of three screen-space vertex positions.
+ * @param edgeBounds Bounds of the edge functions 12, 20 and 01.
+ * @param triangleArea Absolute value of the double area of the triangle.
+ * @param minX First column of the bounding box (origin of the plane).
+ * @param minY First row of the bounding box (origin of the plane).
+ * @param nofColumns Width of the bounding box.
+ * @param nofRows Height of the bounding box.
+ *
+ * @return `DepthPlane` Plane and error margin of the depth.
+ */
+DepthPlane computeDepthPlane(const glm::vec3 vertices[3], const EdgeBounds edgeBounds[3], float triangleArea,
+                             int minX, int minY, int nofColumns, int nofRows);
 
 /**
  * @brief Interpolates vertex attributes for a fragment using barycentric coordinates.
@@ -344,6 +845,430 @@ void interpolateFragmentAttributes(const Program &program,
                                    InFragment &inFragment,
                                    const OutVertex outVertices[3]);
 
+/**
+ * @brief Sets up the attribute plane equations of a triangle.
+ *
+ * @param program The shader program containing `vs2fs` configuration.
+ * @param outVertices Array of three output vertices containing attribute values.
+ * @param vertices Array of three screen-space vertex positions.
+ * @param oneOverW Array of 1/w values of the vertices.
+ * @param originX Pixel column the planes are relative to (left of the bounding box).
+ * @param originY Pixel row the planes are relative to (bottom of the bounding box).
+ * @param planes Output plane equations.
+ */
+void setupAttributePlanes(const Program &program, const OutVertex outVertices[3], const glm::vec3 vertices[3],
+                          const float oneOverW[3], int originX, int originY, AttributePlanes &planes);
+
+/**
+ * @brief Interpolates vertex attributes for a fragment from the plane
+ *        equations of its triangle.
+ *
+ * @details Gives the same attributes as `interpolateFragmentAttributes()`
+ *          with perspective-corrected barycentric coordinates up to rounding,
+ *          but touches only the components the program uses.
+ *
+ * @param planes Plane equations of the triangle.
+ * @param outVertices Array of three output vertices (source of flat attributes).
+ * @param x Pixel column.
+ * @param y Pixel row.
+ * @param inFragment Reference to the fragment where interpolated attributes will be stored.
+ *
+ * @return `float` Interpolated w of the fragment (`gl_FragCoord.w`).
+ */
+float interpolateAttributePlanes(const AttributePlanes &planes, const OutVertex outVertices[3],
+                                 int x, int y, InFragment &inFragment);
+
+/**
+ * @brief Calculates the bounding box of a screen-space triangle clamped to
+ *        the framebuffer.
+ *
+ * @param vertices Array of three screen-space vertex positions.
+ * @param frameBuffer Framebuffer the bounding box is clamped to.
+ * @param boundingBox Output bounding box.
+ *
+ * @return `bool` False if the triangle lies completely out of the framebuffer.
+ */
+bool computeTriangleBoundingBox(const glm::vec3 vertices[3], const Framebuffer &frameBuffer, ScreenRegion &boundingBox);
+
+
+/******************************************************************************/
+/*                                                                            */
+/*              TILE-BINNED (SORT-MIDDLE) MULTITHREADED BACK-END              */
+/*                                                                            */
+/******************************************************************************/
+
+/**
+ * @brief Triangle that passed the vector part of the pipeline and waits in
+ *        tile bins for rasterization.
+ */
+struct BinnedTriangle {
+    OutVertex outTriangle[3];  ///< vertex shader outputs (after clipping)
+    glm::vec3 vertices[3];     ///< screen-space vertices
+    float     oneOverW[3];     ///< 1/w for perspective correction
+    uint32_t  drawIndex;       ///< index of the draw the triangle belongs to
+};
+
+/**
+ * @brief State of a draw command captured for its binned triangles.
+ */
+struct BinnedDraw {
+    const Program  *pProgram;        ///< program active during the draw
+    ShaderInterface shaderInterface; ///< constants for the fragment shader
+    FragmentBackEnd fragmentBackEnd; ///< per-fragment operations selected for the draw
+};
+
+/**
+ * @brief Triangles binned into screen tiles (sort-middle architecture).
+ */
+struct TileBins {
+    const Framebuffer *pFrameBuffer = nullptr;  ///< framebuffer the tile grid belongs to
+    uint32_t width = 0;                         ///< width of the framebuffer
+    uint32_t height = 0;                        ///< height of the framebuffer
+    uint32_t tileSize = 0;                      ///< size of a square tile in pixels
+    uint32_t nofTilesX = 0;                     ///< number of tile columns
+    uint32_t nofTilesY = 0;                     ///< number of tile rows
+    std::vector<BinnedDraw> draws;              ///< binned draws in command order
+    std::vector<BinnedTriangle> triangles;      ///< binned triangles in command order
+    std::vector<std::vector<uint32_t>> tiles;   ///< indices of triangles overlapping each tile
+};
+
+/**
+ * @brief Returns region covering the whole framebuffer.
+ *
+ * @param frameBuffer The framebuffer.
+ *
+ * @return `ScreenRegion` Region of all pixels of the framebuffer.
+ */
+ScreenRegion getFramebufferRegion(const Framebuffer &frameBuffer);
+
+/**
+ * @brief Checks whether binned triangles must be rasterized before executing
+ *        command of given type.
+ *
+ * @details Commands changing state read by the per-fragment operations
+ *          (framebuffer, stencil, blocked writes, front face), clears and
+ *          user commands (which may touch any memory) require a flush.
+ *
+ * @param type The type of the command.
+ *
+ * @return `bool` True if the tile bins must be flushed first.
+ */
+bool doesCommandRequireTileFlush(CommandType type);
+
+/**
+ * @brief Starts a new draw in the tile-binned back-end.
+ *
+ * @details Captures the program, the shader interface and the per-fragment
+ *          back-end of the draw and
+ *          (re)initializes the tile grid for the active framebuffer.
+ *
+ * @param memory GPU memory containing the active framebuffer.
+ * @param program Active shader program.
+ * @param shaderInterface Constants for the fragment shader.
+ * @param fragmentBackEnd Per-fragment operations selected for the draw.
+ *
+ * @return `uint32_t` Index of the draw used by `binTriangle()`.
+ */
+uint32_t beginBinnedDraw(const GPUMemory &memory, const Program &program, const ShaderInterface &shaderInterface,
+                         const FragmentBackEnd &fragmentBackEnd);
+
+/**
+ * @brief Stores a triangle and appends it to the bins of all tiles its
+ *        bounding box overlaps.
+ *
+ * @param drawIndex Index of the draw returned by `beginBinnedDraw()`.
+ * @param outTriangle Array of three output vertices from the vertex shader.
+ * @param vertices Array of three screen-space vertex positions.
+ * @param oneOverW Array of 1/w values for perspective-correct interpolation.
+ */
+void binTriangle(uint32_t drawIndex, const OutVertex outTriangle[3], const glm::vec3 vertices[3], const float oneOverW[3]);
+
+/**
+ * @brief Rasterizes all binned triangles in parallel (one tile per job)
+ *        and empties the bins.
+ *
+ * @param memory GPU memory used by the per-fragment operations.
+ */
+void flushTileBins(const GPUMemory &memory);
+
+
+/******************************************************************************/
+/*                                                                            */
+/*                    HIERARCHICAL DEPTH BUFFER (Hi-Z)                        */
+/*                                                                            */
+/******************************************************************************/
+
+//! Width and height of a tile of the hierarchical depth buffer in pixels
+constexpr uint32_t depthTileSize = 8;
+
+/**
+ * @brief Coarse (per-tile) farthest depth of the depth buffer of the active
+ *        framebuffer.
+ *
+ * @details The Framebuffer struct has no room for it, so it is kept next to
+ *          the depth buffer and bound to its data pointer. Depth writes only
+ *          lower the depth (the test is "less"), so the stored maximum stays
+ *          an upper bound after draws, tiles written by a draw are just marked
+ *          stale and recomputed from the depth buffer when they are queried.
+ *          Clears set the maximum directly, anything else that may write the
+ *          depth buffer (user commands, code outside of `student_GPU_run()`)
+ *          makes all tiles stale.
+ */
+struct HierarchicalDepth {
+    const void *pDepthData = nullptr;  ///< depth buffer the tiles belong to
+    uint32_t width = 0;                ///< width of the framebuffer
+    uint32_t height = 0;               ///< height of the framebuffer
+    uint32_t nofTilesX = 0;            ///< number of tile columns
+    uint32_t nofTilesY = 0;            ///< number of tile rows
+    PixelRows depth;                   ///< rows of the depth buffer
+    std::vector<float> maxDepth;       ///< farthest depth of each tile (NaN pixels are ignored, they fail every test)
+    std::vector<uint8_t> isStale;      ///< the tile was written since its maximum was computed
+};
+
+/**
+ * @brief Conservative depth of one triangle, a plane in pixel coordinates.
+ *
+ * @details Depth the rasterizer computes for any covered pixel (x, y) is at
+ *          least `a * (x - originX) + b * (y - originY) + c - margin`, the margin bounds all rounding
+ *          errors of the edge functions and of the interpolation.
+ */
+struct DepthPlane {
+    double a;       ///< change of depth per pixel column
+    double b;       ///< change of depth per pixel row
+    double c;       ///< depth in the origin pixel
+    double margin;  ///< upper bound of the rounding error of the rasterized depth
+    int originX;    ///< column of the origin pixel (small distances keep the plane exact)
+    int originY;    ///< row of the origin pixel
+};
+
+/**
+ * @brief Hi-Z tiles of one rasterized triangle (within its region) that lie
+ *        completely behind the depth buffer.
+ */
+struct OccludedTiles {
+    int minTileX = 0;              ///< first tile column of the region
+    int minTileY = 0;              ///< first tile row of the region
+    int nofTilesX = 0;             ///< number of tile columns of the region
+    int nofTilesY = 0;             ///< number of tile rows of the region
+    const uint8_t *pIsOccluded = nullptr;///< flag of every tile of the region (row by row)
+    uint32_t nofOccluded = 0;      ///< number of occluded tiles
+};
+
+/**
+ * @brief Binds the hierarchical depth buffer to the depth buffer of a framebuffer.
+ *
+ * @details Nothing changes while the same depth buffer stays bound, otherwise
+ *          all tiles are stale.
+ *
+ * @param frameBuffer Framebuffer with a depth buffer.
+ */
+void bindHierarchicalDepth(const Framebuffer &frameBuffer);
+
+/**
+ * @brief Marks all tiles stale, their maxima are recomputed on the next query.
+ */
+void invalidateHierarchicalDepth();
+
+/**
+ * @brief Sets the maxima of all tiles after a depth clear.
+ *
+ * @param frameBuffer The cleared framebuffer (ignored if it is not bound).
+ * @param depth The clear value.
+ */
+void clearHierarchicalDepth(const Framebuffer &frameBuffer, float depth);
+
+/**
+ * @brief Returns the farthest depth of a tile, stale tiles are recomputed.
+ *
+ * @details Called from the thread rasterizing the tile only (tiles of the
+ *          binned back-end are aligned to the Hi-Z tiles).
+ *
+ * @param tileX Tile column.
+ * @param tileY Tile row.
+ *
+ * @return `float` Maximum of the depth buffer over the tile.
+ */
+float getTileMaxDepth(uint32_t tileX, uint32_t tileY);
+
+/**
+ * @brief Finds Hi-Z tiles of a region where every pixel of a triangle would
+ *        fail the depth test.
+ *
+ * @param plane Conservative depth of the triangle.
+ * @param region Part of the bounding box of the triangle that is rasterized.
+ * @param occludedTiles Output flags (valid until the next call on the thread).
+ *
+ * @return `bool` True if all tiles of the region are occluded.
+ */
+bool findOccludedTiles(const DepthPlane &plane, const ScreenRegion &region, OccludedTiles &occludedTiles);
+
+/**
+ * @brief Checks whether all Hi-Z tiles overlapping a block are occluded.
+ *
+ * @param occludedTiles Occluded tiles of the triangle.
+ * @param minX First column of the block.
+ * @param minY First row of the block.
+ * @param maxX Last column of the block.
+ * @param maxY Last row of the block.
+ *
+ * @return `bool` True if no pixel of the block can pass the depth test.
+ */
+bool isBlockOccluded(const OccludedTiles &occludedTiles, int minX, int minY, int maxX, int maxY);
+
+/**
+ * @brief Marks tiles a triangle may have written as stale.
+ *
+ * @param occludedTiles Occluded tiles of the triangle (they are not written).
+ */
+void markDepthTilesWritten(const OccludedTiles &occludedTiles);
+
+
+
+/******************************************************************************/
+/*                                                                            */
+/*                         FAST and DEFERRED CLEARS                           */
+/*                                                                            */
+/******************************************************************************/
+
+//! Framebuffer attachments handled by the fast clears
+enum ClearAttachment {
+    CLEAR_ATTACHMENT_COLOR = 0,
+    CLEAR_ATTACHMENT_DEPTH = 1,
+    CLEAR_ATTACHMENT_STENCIL = 2,
+};
+
+//! Number of framebuffer attachments handled by the fast clears
+constexpr uint32_t nofClearAttachments = 3;
+
+/**
+ * @brief Clear value converted into the bytes of one pixel.
+ */
+struct ClearValue {
+    uint8_t  pixel[16];          ///< bytes of one pixel (up to 4 float channels)
+    uint32_t bytesPerPixel = 0;  ///< number of valid bytes in `pixel`
+};
+
+/**
+ * @brief Clears of the active framebuffer which are not written yet.
+ */
+struct DeferredClears {
+    const Framebuffer *pFrameBuffer = nullptr;  ///< framebuffer the pending clears belong to
+    uint32_t width = 0;                         ///< width of the framebuffer
+    uint32_t height = 0;                        ///< height of the framebuffer
+    uint32_t tileSize = 0;                      ///< size of a square tile in pixels
+    uint32_t nofTilesX = 0;                     ///< number of tile columns
+    uint32_t nofTilesY = 0;                     ///< number of tile rows
+    ClearValue values[nofClearAttachments];     ///< latest clear value of each attachment
+    std::vector<uint8_t> pendingTiles;          ///< bit mask of attachments each tile still has to clear
+    bool hasPending = false;                    ///< is there any pending tile?
+};
+
+/**
+ * @brief Packs the clear color into the bytes of one pixel.
+ *
+ * @param image The color buffer.
+ * @param color The clear color.
+ * @param clearValue Packed value.
+ *
+ * @return `bool` False if channels do not fill the whole pixel (the slow
+ *         per-pixel clear has to be used).
+ */
+bool packClearColor(const Image &image, const glm::vec4 &color, ClearValue &clearValue);
+
+/**
+ * @brief Packs a single-channel clear value (depth, stencil).
+ *
+ * @param image The cleared image.
+ * @param pValue Pointer to the value.
+ * @param valueSize Size of the value in bytes.
+ * @param clearValue Packed value.
+ *
+ * @return `bool` False if the value does not fill the whole pixel.
+ */
+bool packClearValue(const Image &image, const void *pValue, uint32_t valueSize, ClearValue &clearValue);
+
+/**
+ * @brief Fills continuous memory with copies of a packed pixel.
+ *
+ * @param pDestination First byte to be written.
+ * @param clearValue The packed pixel.
+ * @param nofPixels Number of pixels to write.
+ */
+void fillPixels(uint8_t *pDestination, const ClearValue &clearValue, size_t nofPixels);
+
+/**
+ * @brief Fills a rectangular region of an image with a packed pixel.
+ *
+ * @param image The image.
+ * @param clearValue The packed pixel.
+ * @param region Region in framebuffer coordinates.
+ * @param height Height of the framebuffer.
+ * @param yReversed Whether the framebuffer rows are stored bottom-up.
+ */
+void fillImageRegion(const Image &image, const ClearValue &clearValue, const ScreenRegion &region,
+                     uint32_t height, bool yReversed);
+
+/**
+ * @brief Clears the whole attachment immediately or records a deferred clear.
+ *
+ * @param frameBuffer The active framebuffer.
+ * @param attachment The cleared attachment.
+ * @param clearValue The packed clear value.
+ */
+void clearAttachment(const Framebuffer &frameBuffer, ClearAttachment attachment, const ClearValue &clearValue);
+
+/**
+ * @brief Checks whether pending clears must be written before executing
+ *        command of given type (framebuffer switch, user command).
+ *
+ * @param type The type of the command.
+ *
+ * @return `bool` True if all deferred clears must be resolved first.
+ */
+bool doesCommandRequireClearResolve(CommandType type);
+
+/**
+ * @brief Checks whether any deferred clear is waiting to be written.
+ *
+ * @return `bool` True if some tile still has to be cleared.
+ */
+bool hasPendingDeferredClears();
+
+/**
+ * @brief Writes pending clears of all tiles overlapping the region.
+ *
+ * @details Called from the thread rasterizing a tile with the tile region,
+ *          so every tile is resolved by exactly one thread.
+ *
+ * @param region Region in framebuffer coordinates.
+ */
+void resolveDeferredClears(const ScreenRegion &region);
+
+/**
+ * @brief Writes pending clears of all tiles a triangle may touch.
+ *
+ * @param vertices Array of three screen-space vertex positions.
+ * @param frameBuffer The active framebuffer.
+ */
+void resolveDeferredClearsOfTriangle(const glm::vec3 vertices[3], const Framebuffer &frameBuffer);
+
+/**
+ * @brief Writes all pending clears (in parallel over tiles).
+ */
+void resolveAllDeferredClears();
+
+/**
+ * @brief Clears several buffers of the active framebuffer in one pass.
+ *
+ * @details Bands of rows of all cleared buffers are written one after
+ *          another. Falls back to the separate clear handlers when any of the
+ *          buffers cannot use the fast path.
+ *
+ * @param memory Reference to GPU memory with the active framebuffer.
+ * @param foldedClear Clears merged by the command buffer compiler.
+ */
+void handleFoldedClear(GPUMemory &memory, const FoldedClear &foldedClear);
+
 
 /******************************************************************************/
 /*                                                                            */
@@ -414,6 +1339,36 @@ void executeLatePerFragmentOperations(const GPUMemory &memory, const Framebuffer
  */
 void executeStencilOperation(uint8_t &stencilValue, StencilOp stencilOperation, uint32_t stencilValueReference);
 
+/**
+ * @brief Evaluates the stencil function.
+ *
+ * @param stencilValue Current value in the stencil buffer.
+ * @param stencilFunction The comparison function.
+ * @param stencilValueReference Reference value of the comparison.
+ *
+ * @return `bool` True if the stencil test passes.
+ */
+bool evaluateStencilFunction(uint8_t stencilValue, StencilFunc stencilFunction, uint32_t stencilValueReference);
+
+/**
+ * @brief Selects the per-fragment back-end for the next draw.
+ *
+ * @details Everything that cannot change during a draw (enabled tests,
+ *          blocked writes, attached buffers, stencil function and operations,
+ *          color buffer layout) is resolved here. Unusual color layouts (or
+ *          disabled specialization) use the generic back-end built on
+ *          `executeEarlyPerFragmentOperations()` and
+ *          `executeLatePerFragmentOperations()`.
+ *          Draws that write no color with a color-only fragment shader
+ *          (see `declareColorOnlyFragmentShader()`) also get a depth-only
+ *          routine, which skips the attribute interpolation and the shader.
+ *
+ * @param memory GPU memory with the current state.
+ * @param frameBuffer The active framebuffer.
+ * @param backEnd Back-end to be filled.
+ */
+void setupFragmentBackEnd(const GPUMemory &memory, const Framebuffer &frameBuffer, FragmentBackEnd &backEnd);
+
 
 /********************************************************************************/
 /*                                                                              */
@@ -495,6 +1450,126 @@ OutVertex interpolateVertex(const Program &program, const OutVertex &startVertex
                             const OutVertex &endVertex, float t);
 
 
+/******************************************************************************/
+/*                                                                            */
+/*                 STAGE ENTRY POINTS (used by microbenchmarks)               */
+/*                                                                            */
+/******************************************************************************/
+
+/*
+ * Functions of the pipeline stages are `inline` and visible only in gpu.cpp.
+ * These entry points call them one by one, so each stage can be measured
+ * in isolation (`--stage-benchmarks`) without running whole scenes.
+ */
+
+/**
+ * @brief Runs `clippingSutherlandHodgman()` on one triangle.
+ *
+ * @param program Program containing attribute type information.
+ * @param inputTriangle Triangle in clip space.
+ * @param outputTriangles Storage for up to two resulting triangles.
+ *
+ * @return `uint32_t` Number of resulting triangles (0-2).
+ */
+uint32_t runClippingStage(const Program &program, const OutVertex inputTriangle[3], OutVertex outputTriangles[2][3]);
+
+/**
+ * @brief Rasterizes one triangle with `rasterizeTriangleUsingPineda()` into
+ *        the activated framebuffer of the active program.
+ *
+ * @details The triangle must lie in front of the near plane, it is
+ *          perspective-divided and transformed to the viewport, but neither
+ *          clipped nor culled. Per-fragment operations are set up from the
+ *          current GPU state as in a draw command.
+ *
+ * @param memory GPU memory with the active program and framebuffer.
+ * @param outTriangle Vertex shader outputs of the triangle.
+ */
+void runRasterizationStage(const GPUMemory &memory, const OutVertex outTriangle[3]);
+
+/**
+ * @brief Runs `vertexAssemblyUnit()` for one vertex of the activated vertex array.
+ *
+ * @param memory GPU memory with the vertex array and its buffers.
+ * @param inVertex Vertex with `gl_VertexID` set, receives the attributes.
+ */
+void runVertexAssemblyStage(const GPUMemory &memory, InVertex &inVertex);
+
+/**
+ * @brief Runs `interpolateFragmentAttributes()` for one fragment.
+ *
+ * @param program Program containing attribute type information.
+ * @param lambda0 Perspective-correct barycentric coordinate of the first vertex.
+ * @param lambda1 Perspective-correct barycentric coordinate of the second vertex.
+ * @param lambda2 Perspective-correct barycentric coordinate of the third vertex.
+ * @param inFragment Fragment receiving the interpolated attributes.
+ * @param outVertices Vertices of the triangle.
+ */
+void runAttributeInterpolationStage(const Program &program, float lambda0, float lambda1, float lambda2,
+                                    InFragment &inFragment, const OutVertex outVertices[3]);
+
+/**
+ * @brief Runs `setupAttributePlanes()` for one triangle.
+ *
+ * @param program Program containing attribute type information.
+ * @param outVertices Vertices of the triangle.
+ * @param vertices Screen-space positions of the vertices.
+ * @param oneOverW 1/w values of the vertices.
+ * @param originX Pixel column the planes are relative to.
+ * @param originY Pixel row the planes are relative to.
+ * @param planes Output plane equations.
+ */
+void runAttributeSetupStage(const Program &program, const OutVertex outVertices[3], const glm::vec3 vertices[3],
+                            const float oneOverW[3], int originX, int originY, AttributePlanes &planes);
+
+/**
+ * @brief Runs `interpolateAttributePlanes()` for one fragment.
+ *
+ * @param planes Plane equations of the triangle.
+ * @param outVertices Vertices of the triangle.
+ * @param x Pixel column.
+ * @param y Pixel row.
+ * @param inFragment Fragment receiving the interpolated attributes.
+ *
+ * @return `float` Interpolated w of the fragment.
+ */
+float runAttributePlaneStage(const AttributePlanes &planes, const OutVertex outVertices[3], int x, int y,
+                             InFragment &inFragment);
+
+/**
+ * @brief Runs `executeStencilOperation()` on one stencil value.
+ *
+ * @param stencilValue The stencil value to be modified.
+ * @param stencilOperation The operation.
+ * @param stencilValueReference Reference value of the stencil test.
+ */
+void runStencilOperationStage(uint8_t &stencilValue, StencilOp stencilOperation, uint32_t stencilValueReference);
+
+/**
+ * @brief Runs `handleClearColorCommand()` on the activated framebuffer.
+ *
+ * @param memory GPU memory containing the framebuffer.
+ * @param clearColorCommand Command data containing the clear color value.
+ */
+void runClearColorStage(const GPUMemory &memory, const ClearColorCommand &clearColorCommand);
+
+/**
+ * @brief Runs `handleClearDepthCommand()` on the activated framebuffer.
+ *
+ * @param memory GPU memory containing the framebuffer.
+ * @param clearDepthCommand Command data containing the clear depth value.
+ */
+void runClearDepthStage(const GPUMemory &memory, const ClearDepthCommand &clearDepthCommand);
+
+/**
+ * @brief Runs `handleClearStencilCommand()` on the activated framebuffer.
+ *
+ * @param memory GPU memory containing the framebuffer.
+ * @param clearStencilCommand Command data containing the clear stencil value.
+ */
+void runClearStencilStage(const GPUMemory &memory, const ClearStencilCommand &clearStencilCommand);
+
+
 /******************************************************************************/
 /*                                                                            */
 /*                          GENERAL HELPER FUNCTIONS                          */
@@ -538,4 +1613,36 @@ uint8_t castNormalizedFloatToUnsignedInt8(float value);
  */
 float castUnsignedInt8ToNormalizedFloat(uint8_t value);
 
+/**
+ * @brief Reads the clock used for the pipeline stage times.
+ *
+ * @return `uint64_t` Time in nanoseconds, or 0 if pipeline timings are disabled.
+ */
+uint64_t readPipelineClock();
+
+/**
+ * @brief Adds time of a finished command to its pipeline stage.
+ *
+ * @param type The type of the command (only clears and draws are timed).
+ * @param startTime Value of `readPipelineClock()` before the command.
+ */
+void addCommandTime(CommandType type, uint64_t startTime);
+
+/**
+ * @brief Adds a span of a finished command to the timeline.
+ *
+ * @param type The type of the command.
+ * @param data The data of the command (arguments of the span).
+ * @param drawID Draw ID before the command was executed.
+ * @param startTime Value of `readTraceClock()` before the command.
+ */
+void traceCommand(CommandType type, const CommandData &data, uint32_t drawID, uint64_t startTime);
+
+/**
+ * @brief Adds a span of a finished `student_GPU_run()` to the timeline.
+ *
+ * @param startTime Value of `readTraceClock()` at the start of the frame.
+ */
+void traceFrame(uint64_t startTime);
+
 /*** end of file gpu.hpp ***/
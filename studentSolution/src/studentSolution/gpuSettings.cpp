@@ -0,0 +1,32 @@
+/*!
+ * @file gpuSettings.cpp
+ * @brief This file contains run-time settings of the GPU implementation.
+ *
+ * @author Jan kalina, xkalinj00@stud.fit.vutbr.cz
+ */
+
+#include <studentSolution/gpuSettings.hpp>
+#include <algorithm>  // std::max
+#include <thread>     // std::thread::hardware_concurrency
+
+GPUSettings &getGPUSettings() {
+    static GPUSettings settings;
+    return settings;
+} // getGPUSettings()
+
+uint32_t getEffectiveNofThreads() {
+    const uint32_t nofThreads = getGPUSettings().nofThreads;
+
+    // Zero means "use whatever the machine offers"
+    if(nofThreads == 0) {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    return nofThreads;
+} // getEffectiveNofThreads()
+
+bool isTileBinningEnabled() {
+    return getGPUSettings().tiledRasterization || getEffectiveNofThreads() > 1;
+} // isTileBinningEnabled()
+
+/*** end of file gpuSettings.cpp ***/
@@ -0,0 +1,67 @@
+/*!
+ * @file gpuSettings.hpp
+ * @brief This file contains run-time settings of the GPU implementation.
+ *
+ * @author Jan kalina, xkalinj00@stud.fit.vutbr.cz
+ */
+#pragma once
+
+#include <cstdint>
+
+#include <studentSolution/shaderFunctions.hpp>
+
+/**
+ * @brief Run-time settings of the student GPU.
+ *
+ * @details Default values keep the single-threaded pipeline, so the
+ *          conformance tests (which record every shader invocation) always
+ *          see the same behaviour as the teacher solution. Back-ends that
+ *          change the order or number of shader invocations are opt-in and
+ *          are usually enabled from command line.
+ */
+struct GPUSettings {
+    uint32_t nofThreads = 1;           ///< number of rasterization threads (0 = all hardware threads, 1 = serial)
+    uint32_t tileSize = 64;            ///< size of the square screen tile (in pixels) used for triangle binning, multiples of 8 keep Hi-Z and quads inside tiles
+    bool     tiledRasterization = false;///< force tile binning even when rasterizing on one thread
+    bool     simdRasterization = true;  ///< evaluate edge functions for blocks of pixels using SIMD
+    bool     hierarchicalRasterization = true;///< classify tiles/blocks as outside/inside/partial before per-pixel tests
+    bool     fixedPointRasterization = false;///< snap vertices to 1/256 pixel and use integer edge functions
+    bool     vertexCache = false;             ///< shade each unique vertex of an indexed draw only once
+    bool     batchedVertexStage = false;      ///< fetch and shade vertices in batches of `vertexBatchSize`
+    bool     specializedFragmentOperations = true;///< per-fragment operations compiled for the state of each draw
+    bool     depthOnlyFragments = true;       ///< skip interpolation and color-only shaders of draws that write no color
+    bool     lazyAttributeInterpolation = true;///< run stencil and depth tests before attributes are interpolated (specialized back-ends)
+    bool     hierarchicalDepth = false;       ///< skip tiles behind the per-tile max depth (Hi-Z)
+    bool     quadShading = false;             ///< rasterize and shade 2x2 pixel quads, derivatives are differences of the quad
+    bool     deferredClears = false;          ///< write clears per screen tile on first touch instead of immediately
+    bool     compiledCommandBuffers = false;  ///< execute command buffer trees as cached flat plans
+    bool     pipelineTimings = false;         ///< measure time spent in the pipeline stages (see `PipelineStatistics`)
+    TextureFilter textureFilter = TextureFilter::NEAREST;///< filtering of model textures (mipmapped unless `NEAREST`)
+    ImageLayout   textureLayout = ImageLayout::LINEAR;   ///< memory layout loaded textures are converted to (framebuffers stay linear)
+};
+
+/**
+ * @brief Returns the global GPU settings used by `student_GPU_run()`.
+ *
+ * @return `GPUSettings&` Reference to the (modifiable) settings.
+ */
+GPUSettings &getGPUSettings();
+
+/**
+ * @brief Returns the number of threads the rasterizer will really use.
+ *
+ * @details Resolves the `0 = all hardware threads` setting.
+ *
+ * @return `uint32_t` Number of threads (always at least 1).
+ */
+uint32_t getEffectiveNofThreads();
+
+/**
+ * @brief Checks whether triangles are binned into screen tiles before
+ *        rasterization (sort-middle back-end).
+ *
+ * @return `bool` True if the tile-binned back-end is used.
+ */
+bool isTileBinningEnabled();
+
+/*** end of file gpuSettings.hpp ***/
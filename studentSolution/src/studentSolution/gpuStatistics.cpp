@@ -0,0 +1,179 @@
+/*!
+ * @file gpuStatistics.cpp
+ * @brief This file contains statistics counters of the GPU implementation.
+ *
+ * @author Jan kalina, xkalinj00@stud.fit.vutbr.cz
+ */
+
+#include <studentSolution/gpuStatistics.hpp>
+#include <ostream>
+
+RasterStatistics &getRasterStatistics() {
+    static RasterStatistics statistics;
+    return statistics;
+} // getRasterStatistics()
+
+void resetRasterStatistics() {
+    RasterStatistics &statistics = getRasterStatistics();
+    statistics.regionsOutside = 0;
+    statistics.blocksOutside = 0;
+    statistics.blocksInside = 0;
+    statistics.blocksPartial = 0;
+    statistics.regionsOccluded = 0;
+    statistics.depthTilesOccluded = 0;
+} // resetRasterStatistics()
+
+void printRasterStatistics(std::ostream &stream) {
+    const RasterStatistics &statistics = getRasterStatistics();
+    const uint64_t nofBlocks = statistics.blocksOutside + statistics.blocksInside + statistics.blocksPartial;
+
+    // Share of the block class in percents (guarded against empty frames)
+    auto percents = [nofBlocks](const uint64_t count) {
+        return nofBlocks ? 100.0 * static_cast<double>(count) / static_cast<double>(nofBlocks) : 0.0;
+    };
+
+    stream << "Rasterized tiles rejected as a whole: " << statistics.regionsOutside << "\n";
+    stream << "Blocks fully outside: " << statistics.blocksOutside << " (" << percents(statistics.blocksOutside) << " %)\n";
+    stream << "Blocks fully inside:  " << statistics.blocksInside << " (" << percents(statistics.blocksInside) << " %)\n";
+    stream << "Blocks partial:       " << statistics.blocksPartial << " (" << percents(statistics.blocksPartial) << " %)\n";
+    stream << "Rasterized tiles behind the depth buffer: " << statistics.regionsOccluded << "\n";
+    stream << "Hi-Z tiles behind the depth buffer:       " << statistics.depthTilesOccluded << "\n";
+} // printRasterStatistics()
+
+VertexStatistics &getVertexStatistics() {
+    static VertexStatistics statistics;
+    return statistics;
+} // getVertexStatistics()
+
+void resetVertexStatistics() {
+    VertexStatistics &statistics = getVertexStatistics();
+    statistics.cacheHits = 0;
+    statistics.cacheMisses = 0;
+} // resetVertexStatistics()
+
+void printVertexStatistics(std::ostream &stream) {
+    const VertexStatistics &statistics = getVertexStatistics();
+    const uint64_t nofVertices = statistics.cacheHits + statistics.cacheMisses;
+    const double hitRate = nofVertices ? 100.0 * static_cast<double>(statistics.cacheHits) / static_cast<double>(nofVertices) : 0.0;
+
+    stream << "Vertex cache hits:   " << statistics.cacheHits << " (" << hitRate << " %)\n";
+    stream << "Vertex cache misses: " << statistics.cacheMisses << "\n";
+} // printVertexStatistics()
+
+CommandStatistics &getCommandStatistics() {
+    static CommandStatistics statistics;
+    return statistics;
+} // getCommandStatistics()
+
+void resetCommandStatistics() {
+    CommandStatistics &statistics = getCommandStatistics();
+    statistics.planCompilations = 0;
+    statistics.planCacheHits = 0;
+    statistics.removedCommands = 0;
+    statistics.foldedClears = 0;
+} // resetCommandStatistics()
+
+void printCommandStatistics(std::ostream &stream) {
+    const CommandStatistics &statistics = getCommandStatistics();
+
+    stream << "Command plans compiled: " << statistics.planCompilations << "\n";
+    stream << "Command plans reused:   " << statistics.planCacheHits << "\n";
+    stream << "Commands removed:       " << statistics.removedCommands << "\n";
+    stream << "Clear runs folded:      " << statistics.foldedClears << "\n";
+} // printCommandStatistics()
+
+PipelineStatistics &getPipelineStatistics() {
+    static PipelineStatistics statistics;
+    return statistics;
+} // getPipelineStatistics()
+
+void addPipelineCounters(PipelineCounters &counters) {
+    PipelineStatistics &statistics = getPipelineStatistics();
+    statistics.verticesShaded += counters.verticesShaded;
+    statistics.trianglesIn += counters.trianglesIn;
+    statistics.trianglesClipped += counters.trianglesClipped;
+    statistics.trianglesClippedAway += counters.trianglesClippedAway;
+    statistics.trianglesCulled += counters.trianglesCulled;
+    statistics.trianglesDegenerate += counters.trianglesDegenerate;
+    statistics.fragmentsGenerated += counters.fragmentsGenerated;
+    statistics.fragmentsStencilFailed += counters.fragmentsStencilFailed;
+    statistics.fragmentsDepthFailed += counters.fragmentsDepthFailed;
+    statistics.fragmentsInterpolated += counters.fragmentsInterpolated;
+    statistics.fragmentsDiscarded += counters.fragmentsDiscarded;
+    statistics.pixelsWritten += counters.pixelsWritten;
+
+    // Most tiles have no triangles, their raster counters are not touched
+    const uint64_t nofRasterEvents = counters.regionsOutside + counters.blocksOutside + counters.blocksInside +
+                                     counters.blocksPartial + counters.regionsOccluded + counters.depthTilesOccluded;
+    if(nofRasterEvents) {
+        RasterStatistics &rasterStatistics = getRasterStatistics();
+        rasterStatistics.regionsOutside += counters.regionsOutside;
+        rasterStatistics.blocksOutside += counters.blocksOutside;
+        rasterStatistics.blocksInside += counters.blocksInside;
+        rasterStatistics.blocksPartial += counters.blocksPartial;
+        rasterStatistics.regionsOccluded += counters.regionsOccluded;
+        rasterStatistics.depthTilesOccluded += counters.depthTilesOccluded;
+    }
+    counters = PipelineCounters();
+} // addPipelineCounters()
+
+void resetPipelineStatistics() {
+    PipelineStatistics &statistics = getPipelineStatistics();
+    statistics.frames = 0;
+    statistics.verticesShaded = 0;
+    statistics.trianglesIn = 0;
+    statistics.trianglesClipped = 0;
+    statistics.trianglesClippedAway = 0;
+    statistics.trianglesCulled = 0;
+    statistics.trianglesDegenerate = 0;
+    statistics.fragmentsGenerated = 0;
+    statistics.fragmentsStencilFailed = 0;
+    statistics.fragmentsDepthFailed = 0;
+    statistics.fragmentsInterpolated = 0;
+    statistics.fragmentsDiscarded = 0;
+    statistics.pixelsWritten = 0;
+    statistics.frameTime = 0;
+    statistics.clearTime = 0;
+    statistics.drawTime = 0;
+    statistics.vertexTime = 0;
+    statistics.tileRasterizationTime = 0;
+} // resetPipelineStatistics()
+
+void printPipelineStatistics(std::ostream &stream) {
+    const PipelineStatistics &statistics = getPipelineStatistics();
+
+    // Values are printed per frame (guarded against no frames)
+    const double nofFrames = statistics.frames ? static_cast<double>(statistics.frames) : 1.0;
+    auto perFrame = [nofFrames](const uint64_t count) {
+        return static_cast<double>(count) / nofFrames;
+    };
+    auto milliseconds = [nofFrames](const uint64_t nanoseconds) {
+        return static_cast<double>(nanoseconds) / nofFrames / 1e6;
+    };
+
+    stream << "Pipeline statistics per frame (" << statistics.frames << " frames):\n";
+    stream << "  Vertices shaded:          " << perFrame(statistics.verticesShaded) << "\n";
+    stream << "  Triangles in:             " << perFrame(statistics.trianglesIn) << "\n";
+    stream << "  Triangles clipped:        " << perFrame(statistics.trianglesClipped) << "\n";
+    stream << "  Triangles clipped away:   " << perFrame(statistics.trianglesClippedAway) << "\n";
+    stream << "  Triangles culled:         " << perFrame(statistics.trianglesCulled) << "\n";
+    stream << "  Triangles degenerate:     " << perFrame(statistics.trianglesDegenerate) << "\n";
+    stream << "  Fragments generated:      " << perFrame(statistics.fragmentsGenerated) << "\n";
+    stream << "  Fragments stencil failed: " << perFrame(statistics.fragmentsStencilFailed) << "\n";
+    stream << "  Fragments depth failed:   " << perFrame(statistics.fragmentsDepthFailed) << "\n";
+    stream << "  Fragments interpolated:   " << perFrame(statistics.fragmentsInterpolated) << "\n";
+    stream << "  Fragments discarded:      " << perFrame(statistics.fragmentsDiscarded) << "\n";
+    stream << "  Pixels written:           " << perFrame(statistics.pixelsWritten) << "\n";
+
+    // Times are zero unless they were measured
+    if(statistics.frameTime) {
+        stream << "Pipeline times per frame [ms]:\n";
+        stream << "  Frame:                    " << milliseconds(statistics.frameTime) << "\n";
+        stream << "  Clears:                   " << milliseconds(statistics.clearTime) << "\n";
+        stream << "  Draws:                    " << milliseconds(statistics.drawTime) << "\n";
+        stream << "    Vertex stage:           " << milliseconds(statistics.vertexTime) << "\n";
+        stream << "  Tile rasterization:       " << milliseconds(statistics.tileRasterizationTime) << "\n";
+    }
+} // printPipelineStatistics()
+
+/*** end of file gpuStatistics.cpp ***/
@@ -0,0 +1,192 @@
+/*!
+ * @file gpuStatistics.hpp
+ * @brief This file contains statistics counters of the GPU implementation.
+ *
+ * @author Jan kalina, xkalinj00@stud.fit.vutbr.cz
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+
+/**
+ * @brief Counters of the hierarchical (block based) rasterization.
+ *
+ * @details Blocks are the square SIMD blocks of the rasterizer. Rasterization
+ *          threads count into their `PipelineCounters`, which are added here
+ *          by `addPipelineCounters()`, so they are complete after each
+ *          `student_GPU_run()`.
+ */
+struct RasterStatistics {
+    std::atomic<uint64_t> regionsOutside{0}; ///< (triangle, tile) pairs rejected as a whole
+    std::atomic<uint64_t> blocksOutside{0};  ///< blocks skipped without any edge tests
+    std::atomic<uint64_t> blocksInside{0};   ///< blocks shaded without per-pixel edge tests
+    std::atomic<uint64_t> blocksPartial{0};  ///< blocks that needed per-pixel edge tests
+    std::atomic<uint64_t> regionsOccluded{0};///< (triangle, tile) pairs rejected by the hierarchical depth buffer
+    std::atomic<uint64_t> depthTilesOccluded{0};///< Hi-Z tiles of triangles skipped by the hierarchical depth buffer
+};
+
+/**
+ * @brief Counters of the post-transform vertex cache.
+ */
+struct VertexStatistics {
+    std::atomic<uint64_t> cacheHits{0};   ///< vertices reused from the cache
+    std::atomic<uint64_t> cacheMisses{0}; ///< vertices processed by the vertex shader
+};
+
+/**
+ * @brief Counters of the command buffer compiler.
+ */
+struct CommandStatistics {
+    std::atomic<uint64_t> planCompilations{0}; ///< plans compiled (cache misses)
+    std::atomic<uint64_t> planCacheHits{0};    ///< plans reused without compilation
+    std::atomic<uint64_t> removedCommands{0};  ///< source commands not present in compiled plans
+    std::atomic<uint64_t> foldedClears{0};     ///< runs of clears merged into one pass
+};
+
+/**
+ * @brief Pipeline counters of one thread.
+ *
+ * @details Plain (non-atomic) counters incremented on the hot paths, they are
+ *          added to `PipelineStatistics` (block counters to `RasterStatistics`)
+ *          by `addPipelineCounters()` at the end of each rasterized tile and
+ *          each `student_GPU_run()`.
+ */
+struct PipelineCounters {
+    uint64_t verticesShaded = 0;        ///< vertex shader invocations
+    uint64_t trianglesIn = 0;           ///< triangles assembled from vertices
+    uint64_t trianglesClipped = 0;      ///< triangles cut by the near plane (including the removed ones)
+    uint64_t trianglesClippedAway = 0;  ///< triangles completely removed by clipping
+    uint64_t trianglesCulled = 0;       ///< (clipped) triangles rejected by `backFaceCulling()`
+    uint64_t trianglesDegenerate = 0;   ///< (clipped) triangles with zero screen-space area
+    uint64_t fragmentsGenerated = 0;    ///< fragments produced by the rasterizer
+    uint64_t fragmentsStencilFailed = 0;///< fragments killed by the stencil test (before the fragment shader)
+    uint64_t fragmentsDepthFailed = 0;  ///< fragments killed by the depth test (before the fragment shader)
+    uint64_t fragmentsInterpolated = 0; ///< fragments whose attributes were interpolated
+    uint64_t fragmentsDiscarded = 0;    ///< fragments discarded by the fragment shader
+    uint64_t pixelsWritten = 0;         ///< fragments which passed all tests and were written
+    uint64_t regionsOutside = 0;        ///< see `RasterStatistics`
+    uint64_t blocksOutside = 0;         ///< see `RasterStatistics`
+    uint64_t blocksInside = 0;          ///< see `RasterStatistics`
+    uint64_t blocksPartial = 0;         ///< see `RasterStatistics`
+    uint64_t regionsOccluded = 0;       ///< see `RasterStatistics`
+    uint64_t depthTilesOccluded = 0;    ///< see `RasterStatistics`
+};
+
+/**
+ * @brief Per-stage counters and times of the whole pipeline.
+ *
+ * @details Counters are summed over all `student_GPU_run()` calls since the
+ *          last reset, so they are complete between frames (e.g. a method can
+ *          reset them before and print them after its frame). Times are in
+ *          nanoseconds and are measured only if `GPUSettings::pipelineTimings`
+ *          is set. Draw time includes the vertex time and the rasterization
+ *          done during draws (serial back-end), binned tiles are rasterized
+ *          in the tile rasterization time.
+ */
+struct PipelineStatistics {
+    std::atomic<uint64_t> frames{0};                 ///< calls of `student_GPU_run()`
+    std::atomic<uint64_t> verticesShaded{0};         ///< see `PipelineCounters`
+    std::atomic<uint64_t> trianglesIn{0};            ///< see `PipelineCounters`
+    std::atomic<uint64_t> trianglesClipped{0};       ///< see `PipelineCounters`
+    std::atomic<uint64_t> trianglesClippedAway{0};   ///< see `PipelineCounters`
+    std::atomic<uint64_t> trianglesCulled{0};        ///< see `PipelineCounters`
+    std::atomic<uint64_t> trianglesDegenerate{0};    ///< see `PipelineCounters`
+    std::atomic<uint64_t> fragmentsGenerated{0};     ///< see `PipelineCounters`
+    std::atomic<uint64_t> fragmentsStencilFailed{0}; ///< see `PipelineCounters`
+    std::atomic<uint64_t> fragmentsDepthFailed{0};   ///< see `PipelineCounters`
+    std::atomic<uint64_t> fragmentsInterpolated{0};  ///< see `PipelineCounters`
+    std::atomic<uint64_t> fragmentsDiscarded{0};     ///< see `PipelineCounters`
+    std::atomic<uint64_t> pixelsWritten{0};          ///< see `PipelineCounters`
+    std::atomic<uint64_t> frameTime{0};              ///< whole `student_GPU_run()` [ns]
+    std::atomic<uint64_t> clearTime{0};              ///< clear commands [ns]
+    std::atomic<uint64_t> drawTime{0};               ///< draw commands [ns]
+    std::atomic<uint64_t> vertexTime{0};             ///< vertex fetch and vertex shader [ns]
+    std::atomic<uint64_t> tileRasterizationTime{0};  ///< rasterization of binned tiles [ns]
+};
+
+/**
+ * @brief Returns the global rasterization statistics.
+ *
+ * @return `RasterStatistics&` Reference to the counters.
+ */
+RasterStatistics &getRasterStatistics();
+
+/**
+ * @brief Sets all rasterization counters to zero.
+ */
+void resetRasterStatistics();
+
+/**
+ * @brief Prints the rasterization counters in human readable form.
+ *
+ * @param stream Output stream.
+ */
+void printRasterStatistics(std::ostream &stream);
+
+/**
+ * @brief Returns the global vertex statistics.
+ *
+ * @return `VertexStatistics&` Reference to the counters.
+ */
+VertexStatistics &getVertexStatistics();
+
+/**
+ * @brief Sets all vertex counters to zero.
+ */
+void resetVertexStatistics();
+
+/**
+ * @brief Prints the vertex counters in human readable form.
+ *
+ * @param stream Output stream.
+ */
+void printVertexStatistics(std::ostream &stream);
+
+/**
+ * @brief Returns the global command compiler statistics.
+ *
+ * @return `CommandStatistics&` Reference to the counters.
+ */
+CommandStatistics &getCommandStatistics();
+
+/**
+ * @brief Sets all command compiler counters to zero.
+ */
+void resetCommandStatistics();
+
+/**
+ * @brief Prints the command compiler counters in human readable form.
+ *
+ * @param stream Output stream.
+ */
+void printCommandStatistics(std::ostream &stream);
+
+/**
+ * @brief Returns the global pipeline statistics.
+ *
+ * @return `PipelineStatistics&` Reference to the counters.
+ */
+PipelineStatistics &getPipelineStatistics();
+
+/**
+ * @brief Adds counters of one thread to the global pipeline statistics.
+ *
+ * @param counters Counters of the thread (set to zero afterwards).
+ */
+void addPipelineCounters(PipelineCounters &counters);
+
+/**
+ * @brief Sets all pipeline counters and times to zero.
+ */
+void resetPipelineStatistics();
+
+/**
+ * @brief Prints the pipeline counters (and times, if measured) in human readable form.
+ *
+ * @param stream Output stream.
+ */
+void printPipelineStatistics(std::ostream &stream);
+
+/*** end of file gpuStatistics.hpp ***/
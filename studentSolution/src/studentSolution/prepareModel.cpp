@@ -8,8 +8,10 @@
 
 #include <studentSolution/prepareModel.hpp>
 #include <studentSolution/gpu.hpp>
+#include <studentSolution/gpuSettings.hpp>
 #include <studentSolution/shaderFunctions.hpp>
 #include <solutionInterface/uniformLocations.hpp>
+#include <iostream>  // std::cerr
 
 /*
  * When implementing this part of the project, I maximally based my code on the
@@ -30,7 +32,11 @@
 #ifndef XKALINJ00_PREPARE_MODEL_SOLUTION
 #define XKALINJ00_PREPARE_MODEL_SOLUTION
 
-void prepareNode(GPUMemory &memory, CommandBuffer &commandBuffer, const Model &model,
+template<typename Commands>
+void recordModel(GPUMemory &mem, Commands &commands, const Model &model);
+
+template<typename Commands>
+bool prepareNode(GPUMemory &memory, Commands &commands, const Model &model,
                  const Node &node, const glm::mat4 &parentMatrix, uint32_t &drawCounter,
                  uint32_t &vertexArrayCounter);
 
@@ -45,14 +51,27 @@ void prepareNode(GPUMemory &memory, CommandBuffer &commandBuffer, const Model &m
 
 //! [drawModel]
 void student_prepareModel(GPUMemory &mem, CommandBuffer &commandBuffer, const Model &model) {
+    recordModel(mem, commandBuffer, model);
+} // student_prepareModel()
+
+void student_prepareModel(GPUMemory &mem, CommandStream &commandStream, const Model &model) {
+    recordModel(mem, commandStream, model);
+} // student_prepareModel()
+
+template<typename Commands>
+inline void recordModel(GPUMemory &mem, Commands &commands, const Model &model) {
     // Copy buffers: mem.buffers  = ...;
     for(size_t iBuffer = 0; iBuffer < model.nofBuffers; iBuffer++) {
         mem.buffers[iBuffer] = model.buffers[iBuffer];
     }
 
     // Copy textures: mem.textures = ...;
+    // Filtering of the model textures is attached to them, so the fragment
+    // shader reads it from the textures it gets (not from the GPU settings)
+    const TextureFilter textureFilter = getGPUSettings().textureFilter;
     for(size_t iTexture = 0; iTexture < model.nofTextures; iTexture++) {
         mem.textures[iTexture] = model.textures[iTexture];
+        student_setTextureFilter(mem.textures[iTexture], textureFilter);
     }
 
     uint32_t vertexArrayCounter{0};  // index into 'vertexArrays'
@@ -61,15 +80,20 @@ void student_prepareModel(GPUMemory &mem, CommandBuffer &commandBuffer, const Mo
     // Recursively prepare nodes using pre-order traversal
     constexpr auto identityMatrix = glm::mat4(1.f);
     for(size_t iRoot = 0; iRoot < model.nofRoots; iRoot++) {
-        prepareNode(mem, commandBuffer, model, model.roots[iRoot],
-                    identityMatrix, drawCounter, vertexArrayCounter);
+        if(!prepareNode(mem, commands, model, model.roots[iRoot],
+                        identityMatrix, drawCounter, vertexArrayCounter)) {
+            // Skipped draws would silently disappear from the image
+            std::cerr << "prepareModel: the model does not fit, only " << drawCounter << " draws were recorded" << std::endl;
+            return;
+        }
     }
-} // student_prepareModel()
+} // recordModel()
 //! [drawModel]
 
-inline void prepareNode(GPUMemory &memory, CommandBuffer &commandBuffer, const Model &model,
-                        const Node &node, const glm::mat4 &parentMatrix, uint32_t &drawCounter,
-                        uint32_t &vertexArrayCounter) {
+template<typename Commands>
+bool prepareNode(GPUMemory &memory, Commands &commands, const Model &model,
+                 const Node &node, const glm::mat4 &parentMatrix, uint32_t &drawCounter,
+                 uint32_t &vertexArrayCounter) {
     // Calculate the model matrix by combining parent and local transformations
     const glm::mat4 modelMatrix = parentMatrix * node.modelMatrix;
 
@@ -78,6 +102,11 @@ inline void prepareNode(GPUMemory &memory, CommandBuffer &commandBuffer, const M
         // Get mesh data from the model
         const Mesh &mesh = model.meshes[node.mesh];
 
+        // Vertex array and uniforms of the draw have to fit into the memory
+        if(vertexArrayCounter >= memory.maxVertexArrays || getUniformLocation(drawCounter, DOUBLE_SIDED) >= memory.maxUniforms) {
+            return false;
+        }
+
         // Create and initialize vertex array
         VertexArray vertexArray{};
         vertexArray.indexBufferID = mesh.indexBufferID;
@@ -90,14 +119,14 @@ inline void prepareNode(GPUMemory &memory, CommandBuffer &commandBuffer, const M
         // Save the new vertex array in the GPU memory
         memory.vertexArrays[vertexArrayCounter] = vertexArray;
 
-        // Bind the vertex array for the current draw call
-        pushBindVertexArrayCommand(commandBuffer, vertexArrayCounter);
-
-        // Configure backface culling (disable for double-sided materials)
-        pushSetBackfaceCullingCommand(commandBuffer, !mesh.doubleSided);
-
-        // Create draw command with the number of indices to render
-        pushDrawCommand(commandBuffer, mesh.nofIndices);
+        // Bind the vertex array, configure backface culling (disable for
+        // double-sided materials) and draw the indices of the mesh
+        const bool isRecorded = pushBindVertexArrayCommand(commands, vertexArrayCounter) &&
+                                pushSetBackfaceCullingCommand(commands, !mesh.doubleSided) &&
+                                pushDrawCommand(commands, mesh.nofIndices);
+        if(!isRecorded) {
+            return false;
+        }
 
         // Write uniform data to memory
         memory.uniforms[getUniformLocation(drawCounter, MODEL_MATRIX)].m4 = modelMatrix;
@@ -113,11 +142,19 @@ inline void prepareNode(GPUMemory &memory, CommandBuffer &commandBuffer, const M
 
     // Recursively prepare nodes using pre-order traversal
     for(size_t iChild = 0; iChild < node.nofChildren; iChild++) {
-        prepareNode(memory, commandBuffer, model, node.children[iChild],
-                    modelMatrix, drawCounter, vertexArrayCounter);
+        if(!prepareNode(memory, commands, model, node.children[iChild],
+                        modelMatrix, drawCounter, vertexArrayCounter)) {
+            return false;
+        }
     } // for(iChild)
+    return true;
 } // prepareNode()
 
+template bool prepareNode(GPUMemory &memory, CommandBuffer &commands, const Model &model, const Node &node,
+                          const glm::mat4 &parentMatrix, uint32_t &drawCounter, uint32_t &vertexArrayCounter);
+template bool prepareNode(GPUMemory &memory, CommandStream &commands, const Model &model, const Node &node,
+                          const glm::mat4 &parentMatrix, uint32_t &drawCounter, uint32_t &vertexArrayCounter);
+
 
 /******************************************************************************/
 /*                                                                            */
@@ -158,6 +195,27 @@ void student_drawModel_vertexShader(OutVertex &outVertex, const InVertex &inVert
 } // student_drawModel_vertexShader()
 //! [drawModel_vs]
 
+void student_drawModel_vertexShaderBatch(OutVertex outVertices[], const InVertexBatch &inVertices, const ShaderInterface &si) {
+    // Uniforms are the same for the whole batch, so they are loaded only once
+    const glm::mat4 cameraProjectionViewMatrix = si.uniforms[getUniformLocation(si.gl_DrawID, PROJECTION_VIEW_MATRIX)].m4;
+    const glm::mat4 lightProjectionViewMatrix = si.uniforms[getUniformLocation(si.gl_DrawID, USE_SHADOW_MAP_MATRIX)].m4;
+    const glm::mat4 modelMatrix = si.uniforms[getUniformLocation(si.gl_DrawID, MODEL_MATRIX)].m4;
+    const glm::mat4 inverseTransposeModelMatrix = si.uniforms[getUniformLocation(si.gl_DrawID, INVERSE_TRANSPOSE_MODEL_MATRIX)].m4;
+
+    // Same computation as student_drawModel_vertexShader(), lane by lane
+    for(uint32_t iLane = 0; iLane < inVertices.nofVertices; iLane++) {
+        const glm::vec3 worldSpaceVertexPosition = glm::vec3(modelMatrix * glm::vec4(inVertices.attributes[0][iLane].v3, 1.f));
+        const glm::vec3 worldSpaceVertexNormal = glm::vec3(inverseTransposeModelMatrix * glm::vec4(inVertices.attributes[1][iLane].v3, 0.f));
+
+        OutVertex &outVertex = outVertices[iLane];
+        outVertex.attributes[0].v3 = worldSpaceVertexPosition;
+        outVertex.attributes[1].v3 = worldSpaceVertexNormal;
+        outVertex.attributes[2].v2 = inVertices.attributes[2][iLane].v2;
+        outVertex.attributes[3].v4 = lightProjectionViewMatrix * glm::vec4(worldSpaceVertexPosition, 1.f);
+        outVertex.gl_Position = cameraProjectionViewMatrix * glm::vec4(worldSpaceVertexPosition, 1.f);
+    } // for(iLane)
+} // student_drawModel_vertexShaderBatch()
+
 
 /******************************************************************************/
 /*                                                                            */
@@ -193,7 +251,16 @@ void student_drawModel_fragmentShader(OutFragment &outFragment, const InFragment
     // The diffuse color of the material is either stored in a uniform variable or in a texture
     // It depends on whether the texture number is negative or not
     if(textureId >= 0) {
-        diffuseColor = student_read_textureClamp(si.textures[textureId], texturingCoordinates);
+        // Filtered reads select the mip level from the screen-space derivatives of the coordinates
+        const TextureFilter textureFilter = student_getTextureFilter(si.textures[textureId]);
+        glm::vec4 texturingCoordinatesDx, texturingCoordinatesDy;
+        if(textureFilter != TextureFilter::NEAREST &&
+           student_getAttributeDerivatives(2, texturingCoordinatesDx, texturingCoordinatesDy)) {
+            diffuseColor = student_read_textureGrad(si.textures[textureId], texturingCoordinates, glm::vec2(texturingCoordinatesDx),
+                                                    glm::vec2(texturingCoordinatesDy), TextureSampler{textureFilter, TextureWrap::CLAMP});
+        } else {
+            diffuseColor = student_read_textureClamp(si.textures[textureId], texturingCoordinates);
+        }
     } // if(diffuse color is stored in a texture)
 
     // If the doubleSided flag is set (is > 0), it is a double-sided surface.
@@ -8,6 +8,8 @@
 #pragma once
 
 #include <solutionInterface/modelFwd.hpp>
+#include <studentSolution/commandStream.hpp>
+#include <studentSolution/vertexBatch.hpp>
 
 /*
  * DISCLAIMER: This header file prototype documentation was co-created with the
@@ -35,12 +37,29 @@
  *          buffer. Transformation matrices are calculated to properly position
  *          objects in the scene.
  *
+ *          If the commands do not fit into the fixed-size command buffer (or
+ *          the draws into the uniforms and vertex arrays of the memory), the
+ *          remaining nodes are skipped and the overflow is reported to
+ *          `std::cerr`.
+ *
  * @param mem GPU memory where resources and vertex arrays will be stored.
  * @param commandBuffer Buffer that will be filled with rendering commands.
  * @param model The 3D model containing hierarchical scene data with meshes and materials.
  */
 void student_prepareModel(GPUMemory &mem, CommandBuffer &commandBuffer, const Model &model);
 
+/**
+ * @brief Same as `student_prepareModel()`, but records into a growable stream.
+ *
+ * @details The stream has no command limit, so the number of draws is
+ *          limited only by the uniforms and vertex arrays of the memory.
+ *
+ * @param mem GPU memory where resources and vertex arrays will be stored.
+ * @param commandStream Stream that will be filled with rendering commands.
+ * @param model The 3D model containing hierarchical scene data with meshes and materials.
+ */
+void student_prepareModel(GPUMemory &mem, CommandStream &commandStream, const Model &model);
+
 /**
  * @brief Recursively processes nodes in the model hierarchy.
  *
@@ -53,15 +72,21 @@ void student_prepareModel(GPUMemory &mem, CommandBuffer &commandBuffer, const Mo
  *          For each node with a valid mesh, it creates the necessary rendering
  *          setup and then recursively processes all child nodes.
  *
+ * @tparam Commands `CommandBuffer` or `CommandStream`.
+ *
  * @param memory GPU memory where vertex arrays and uniforms will be stored.
- * @param commandBuffer Buffer where rendering commands will be stored.
+ * @param commands Buffer or stream where rendering commands will be stored.
  * @param model The 3D model containing meshes and materials.
  * @param node Current node being processed in the scene hierarchy.
  * @param parentMatrix Accumulated transformation matrix from parent nodes.
  * @param drawCounter Counter for draw commands used for uniform locations.
  * @param vertexArrayCounter Counter for vertex array objects in memory.
+ *
+ * @return `bool` False if a command, vertex array or uniform did not fit (the
+ *         traversal stops there).
  */
-void prepareNode(GPUMemory &memory, CommandBuffer &commandBuffer, const Model &model,
+template<typename Commands>
+bool prepareNode(GPUMemory &memory, Commands &commands, const Model &model,
                  const Node &node, const glm::mat4 &parentMatrix, uint32_t &drawCounter,
                  uint32_t &vertexArrayCounter);
 
@@ -95,6 +120,20 @@ void prepareNode(GPUMemory &memory, CommandBuffer &commandBuffer, const Model &m
 void student_drawModel_vertexShader(OutVertex &outVertex, const InVertex &inVertex,
                                     const ShaderInterface &si);
 
+/**
+ * @brief Batch version of `student_drawModel_vertexShader()`.
+ *
+ * @details Gives the same outputs as the per-vertex shader, but loads the
+ *          uniform matrices only once for the whole batch.
+ *
+ * @param outVertices Output vertices, one per lane.
+ * @param inVertices Input vertices of the batch (SoA).
+ * @param si Shader interface with uniform variables including transformation
+ *           matrices.
+ */
+void student_drawModel_vertexShaderBatch(OutVertex outVertices[], const InVertexBatch &inVertices,
+                                         const ShaderInterface &si);
+
 
 /******************************************************************************/
 /*                                                                            */
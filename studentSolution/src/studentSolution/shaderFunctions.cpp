@@ -1,5 +1,167 @@
 #include<studentSolution/shaderFunctions.hpp>
 
+#include<atomic>
+#include<cmath>
+#include<mutex>
+#include<shared_mutex>
+#include<unordered_map>
+
+
+namespace{
+
+/**
+ * @brief Function that reads one texel of an image (the coordinates are inside of the image)
+ */
+using TexelFetch = glm::vec4(*)(Image const&image,uint32_t x,uint32_t y);
+
+template<ImageLayout layout>
+glm::vec4 fetchGeneric(Image const&img,uint32_t x,uint32_t y){
+  glm::vec4 color = glm::vec4(0.f,0.f,0.f,1.f);
+  if(img.format == Image::U8){
+    auto colorPtr = (uint8_t const*)getTexel(img,x,y,layout);
+    for(uint32_t c=0;c<img.channels;++c)
+      color[c] = colorPtr[img.channelTypes[c]]/255.f;
+  }
+  if(img.format == Image::F32){
+    auto colorPtr = (float const*)getTexel(img,x,y,layout);
+    for(uint32_t c=0;c<img.channels;++c)
+      color[c] = colorPtr[img.channelTypes[c]];
+  }
+  return color;
+}
+
+template<ImageLayout layout>
+glm::vec4 fetchRGBA8(Image const&img,uint32_t x,uint32_t y){
+  auto const p = (uint8_t const*)getTexel(img,x,y,layout);
+  return glm::vec4(p[0]/255.f,p[1]/255.f,p[2]/255.f,p[3]/255.f);
+}
+
+template<ImageLayout layout>
+glm::vec4 fetchRGBA32F(Image const&img,uint32_t x,uint32_t y){
+  auto const p = (float const*)getTexel(img,x,y,layout);
+  return glm::vec4(p[0],p[1],p[2],p[3]);
+}
+
+template<ImageLayout layout>
+glm::vec4 fetchDepth32F(Image const&img,uint32_t x,uint32_t y){
+  return glm::vec4(*(float const*)getTexel(img,x,y,layout),0.f,0.f,1.f);
+}
+
+TexelFetch getTexelFetch(TexelFormat format,ImageLayout layout){
+  static TexelFetch const linear[] = {fetchGeneric<ImageLayout::LINEAR>,fetchRGBA8<ImageLayout::LINEAR>,fetchRGBA32F<ImageLayout::LINEAR>,fetchDepth32F<ImageLayout::LINEAR>};
+  static TexelFetch const tiled [] = {fetchGeneric<ImageLayout::TILED >,fetchRGBA8<ImageLayout::TILED >,fetchRGBA32F<ImageLayout::TILED >,fetchDepth32F<ImageLayout::TILED >};
+  return (layout == ImageLayout::TILED ? tiled : linear)[(uint32_t)format];
+}
+
+/**
+ * @brief Mip chain, memory layout and texel format attached to a texture
+ */
+struct TextureStorage{
+  Texture const*levels    = nullptr                          ;///< levels[0] is the texture itself
+  uint32_t      nofLevels = 1                                ;///< number of levels
+  ImageLayout   layout    = ImageLayout::LINEAR              ;///< layout of all levels
+  TexelFormat   format    = TexelFormat::GENERIC             ;///< texel format of all levels
+  TexelFetch    fetch     = fetchGeneric<ImageLayout::LINEAR>;///< fetch function of the format and layout
+  TextureFilter filter    = TextureFilter::NEAREST           ;///< filtering requested by whoever bound the texture
+};
+
+/**
+ * @brief Storages indexed by data pointer of their level 0
+ */
+struct TextureStorageRegistry{
+  std::shared_mutex                              mutex     ;
+  std::unordered_map<void const*,TextureStorage> storages  ;
+  std::atomic<uint64_t>                          generation{1};///< changed by every (de)registration
+};
+
+TextureStorageRegistry&getTextureStorageRegistry(){
+  static TextureStorageRegistry registry;
+  return registry;
+}
+
+/**
+ * @brief This function finds mip chain, layout and format of a texture.
+ * Shaders sample the same textures many times in a row (often two of them alternately,
+ * e.g. a diffuse texture and a shadow map), so the last two lookups are cached per thread.
+ */
+TextureStorage const&getTextureStorage(Texture const&texture){
+  struct LastLookup{
+    void const*    data       = nullptr;
+    uint64_t       generation = 0      ;
+    TextureStorage storage             ;
+  };
+  static thread_local LastLookup last[2];
+  static thread_local uint32_t   oldest = 0;
+
+  auto&registry = getTextureStorageRegistry();
+  auto const generation = registry.generation.load(std::memory_order_acquire);
+  for(auto const&l:last)
+    if(l.data == texture.img.data && l.generation == generation)return l.storage;
+
+  auto&entry = last[oldest];
+  oldest ^= 1;
+  entry.storage = TextureStorage();
+  {
+    std::shared_lock<std::shared_mutex>lock(registry.mutex);
+    auto const it = registry.storages.find(texture.img.data);
+    if(it != registry.storages.end())entry.storage = it->second;
+  }
+  entry.data       = texture.img.data;
+  entry.generation = generation      ;
+  return entry.storage;
+}
+
+Texture const&getLevel(Texture const&texture,TextureStorage const&storage,uint32_t level){
+  if(level == 0 || !storage.levels)return texture;
+  return storage.levels[level];
+}
+
+glm::vec4 fetchTexel(Texture const&texture,glm::uvec2 const&pix,TexelFetch fetch){
+  if(pix.x>=texture.width || pix.y >=texture.height)return glm::vec4(0.f,0.f,0.f,1.f);
+  return fetch(texture.img,pix.x,pix.y);
+}
+
+uint32_t wrapTexel(int32_t coord,uint32_t size,TextureWrap wrap){
+  if(wrap == TextureWrap::CLAMP)return (uint32_t)glm::clamp(coord,0,(int32_t)size-1);
+  int32_t const m = coord % (int32_t)size;
+  return (uint32_t)(m < 0 ? m + (int32_t)size : m);
+}
+
+/**
+ * @brief This function reads nearest texel of one level (the texel selection of student_read_texture(Clamp))
+ */
+glm::vec4 readLevelNearest(Texture const&level,glm::vec2 const&uv,TextureWrap wrap,TexelFetch fetch){
+  if(!level.img.data)return glm::vec4(0.f);
+  auto uv1 = wrap == TextureWrap::CLAMP ? glm::clamp(uv,0.f,1.f) : glm::fract(glm::fract(uv)+1.f);
+  auto uv2 = uv1*glm::vec2(level.width-1,level.height-1)+0.5f;
+  auto pix = glm::uvec2(uv2);
+  return fetchTexel(level,pix,fetch);
+}
+
+/**
+ * @brief This function reads bilinearly filtered color of one level (texel centers are at (i+0.5)/size)
+ */
+glm::vec4 readLevelBilinear(Texture const&level,glm::vec2 const&uv,TextureWrap wrap,TexelFetch fetch){
+  auto const coord = uv*glm::vec2(level.width,level.height) - .5f;
+  auto const base  = glm::floor(coord);
+  auto const t     = coord - base;
+  auto const x0    = (int32_t)base.x;
+  auto const y0    = (int32_t)base.y;
+
+  auto const texel = [&](int32_t x,int32_t y){
+    return fetch(level.img,wrapTexel(x,level.width,wrap),wrapTexel(y,level.height,wrap));
+  };
+  auto const bottom = glm::mix(texel(x0,y0  ),texel(x0+1,y0  ),t.x);
+  auto const top    = glm::mix(texel(x0,y0+1),texel(x0+1,y0+1),t.x);
+  return glm::mix(bottom,top,t.y);
+}
+
+glm::vec4 readLevel(Texture const&level,glm::vec2 const&uv,TextureSampler const&sampler,TexelFetch fetch){
+  if(sampler.filter == TextureFilter::NEAREST)return readLevelNearest(level,uv,sampler.wrap,fetch);
+  return readLevelBilinear(level,uv,sampler.wrap,fetch);
+}
+
+}
 
 /**
  * @brief This function reads color from texture.
@@ -10,11 +172,7 @@
  * @return color 4 floats
  */
 glm::vec4 student_read_texture(Texture const&texture,glm::vec2 const&uv){
-  if(!texture.img.data)return glm::vec4(0.f);
-  auto uv1 = glm::fract(glm::fract(uv)+1.f);
-  auto uv2 = uv1*glm::vec2(texture.width-1,texture.height-1)+0.5f;
-  auto pix = glm::uvec2(uv2);
-  return student_texelFetch(texture,pix);
+  return readLevelNearest(texture,uv,TextureWrap::REPEAT,getTextureStorage(texture).fetch);
 }
 
 /**
@@ -26,11 +184,7 @@ glm::vec4 student_read_texture(Texture const&texture,glm::vec2 const&uv){
  * @return color 4 floats
  */
 glm::vec4 student_read_textureClamp(Texture const&texture,glm::vec2 const&uv){
-  if(!texture.img.data)return glm::vec4(0.f);
-  auto uv1 = glm::clamp(uv,0.f,1.f);
-  auto uv2 = uv1*glm::vec2(texture.width-1,texture.height-1)+0.5f;
-  auto pix = glm::uvec2(uv2);
-  return student_texelFetch(texture,pix);
+  return readLevelNearest(texture,uv,TextureWrap::CLAMP,getTextureStorage(texture).fetch);
 }
 
 /**
@@ -42,18 +196,74 @@ glm::vec4 student_read_textureClamp(Texture const&texture,glm::vec2 const&uv){
  * @return color 4 floats
  */
 glm::vec4 student_texelFetch(Texture const&texture,glm::uvec2 const&pix){
-  auto&img = texture.img;
-  glm::vec4 color = glm::vec4(0.f,0.f,0.f,1.f);
-  if(pix.x>=texture.width || pix.y >=texture.height)return color;
-  if(img.format == Image::U8){
-    auto colorPtr = (uint8_t*)getPixel(img,pix.x,pix.y);
-    for(uint32_t c=0;c<img.channels;++c)
-      color[c] = colorPtr[img.channelTypes[c]]/255.f;
-  }
-  if(texture.img.format == Image::F32){
-    auto colorPtr = (float*)getPixel(img,pix.x,pix.y);
-    for(uint32_t c=0;c<img.channels;++c)
-      color[c] = colorPtr[img.channelTypes[c]];
-  }
-  return color;
+  return fetchTexel(texture,pix,getTextureStorage(texture).fetch);
+}
+
+void student_setTextureMipmaps(Texture const&texture,Texture const*levels,uint32_t nofLevels,ImageLayout layout){
+  auto&registry = getTextureStorageRegistry();
+  std::unique_lock<std::shared_mutex>lock(registry.mutex);
+  auto const format = getTexelFormat(texture.img);
+  auto&storage = registry.storages[texture.img.data];
+  storage = TextureStorage{levels,nofLevels,layout,format,getTexelFetch(format,layout),storage.filter};
+  registry.generation++;
+}
+
+void student_setTextureFilter(Texture const&texture,TextureFilter filter){
+  if(!texture.img.data)return;
+  auto&registry = getTextureStorageRegistry();
+  std::unique_lock<std::shared_mutex>lock(registry.mutex);
+  //textures without storage read with nearest filtering anyway
+  auto const it = registry.storages.find(texture.img.data);
+  if(it == registry.storages.end() && filter == TextureFilter::NEAREST)return;
+  registry.storages[texture.img.data].filter = filter;
+  registry.generation++;
+}
+
+TextureFilter student_getTextureFilter(Texture const&texture){
+  return getTextureStorage(texture).filter;
+}
+
+void student_removeTextureMipmaps(Texture const&texture){
+  auto&registry = getTextureStorageRegistry();
+  std::unique_lock<std::shared_mutex>lock(registry.mutex);
+  registry.storages.erase(texture.img.data);
+  registry.generation++;
+}
+
+uint32_t student_getNofTextureLevels(Texture const&texture){
+  return getTextureStorage(texture).nofLevels;
+}
+
+ImageLayout student_getTextureLayout(Texture const&texture){
+  return getTextureStorage(texture).layout;
+}
+
+TexelFormat student_getTexelFormat(Texture const&texture){
+  return getTextureStorage(texture).format;
+}
+
+glm::vec4 student_read_textureLod(Texture const&texture,glm::vec2 const&uv,float lod,TextureSampler const&sampler){
+  if(!texture.img.data)return glm::vec4(0.f);
+  auto const storage  = getTextureStorage(texture);
+  auto const maxLevel = (float)(storage.nofLevels-1);
+  lod = std::isnan(lod) ? 0.f : glm::clamp(lod,0.f,maxLevel);
+
+  if(sampler.filter != TextureFilter::TRILINEAR)
+    return readLevel(getLevel(texture,storage,(uint32_t)(lod+.5f)),uv,sampler,storage.fetch);
+
+  auto const level = (uint32_t)lod;
+  auto const t     = lod - (float)level;
+  auto const fine  = readLevel(getLevel(texture,storage,level),uv,sampler,storage.fetch);
+  if(t == 0.f)return fine;
+  return glm::mix(fine,readLevel(getLevel(texture,storage,level+1),uv,sampler,storage.fetch),t);
+}
+
+glm::vec4 student_read_textureGrad(Texture const&texture,glm::vec2 const&uv,glm::vec2 const&dUVdx,glm::vec2 const&dUVdy,TextureSampler const&sampler){
+  //footprint of the pixel in texels of level 0
+  auto const size = glm::vec2(texture.width,texture.height);
+  auto const dx   = dUVdx*size;
+  auto const dy   = dUVdy*size;
+  auto const rho2 = glm::max(glm::dot(dx,dx),glm::dot(dy,dy));
+  auto const lod  = rho2 > 0.f ? .5f*std::log2(rho2) : 0.f;
+  return student_read_textureLod(texture,uv,lod,sampler);
 }
@@ -13,3 +13,203 @@
 glm::vec4 student_read_texture     (Texture const&texture,glm::vec2  const&uv);
 glm::vec4 student_read_textureClamp(Texture const&texture,glm::vec2  const&uv);
 glm::vec4 student_texelFetch       (Texture const&texture,glm::uvec2 const&uv);
+
+/**
+ * @brief Memory layout of texels of a texture
+ */
+enum class ImageLayout : uint8_t{
+  LINEAR, ///< rows of texels (getPixel), Image::pitch is size of a row
+  TILED , ///< rows of 4x4 texel tiles, texels of a tile are stored row by row, Image::pitch is size of a row of tiles
+};
+
+constexpr uint32_t textureTileSize = 4;///< width and height of a tile of ImageLayout::TILED
+
+/**
+ * @brief This function returns pitch (size of a row of tiles) of a tiled image
+ *
+ * @param width width of the image
+ * @param bytesPerPixel size of a texel
+ *
+ * @return pitch, the width is padded to whole tiles
+ */
+inline uint32_t getTiledPitch(uint32_t width,uint32_t bytesPerPixel){
+  return (width+textureTileSize-1)/textureTileSize*textureTileSize*textureTileSize*bytesPerPixel;
+}
+
+/**
+ * @brief This function gets constant pointer to a texel of an image stored in a layout
+ *
+ * @param image image
+ * @param x x coordinates
+ * @param y y coordinates
+ * @param layout memory layout of the image
+ *
+ * @return constant pointer to the start of the texel
+ */
+inline void const*getTexel(Image const&image,uint32_t x,uint32_t y,ImageLayout layout){
+  if(layout == ImageLayout::LINEAR)return getPixel(image,x,y);
+  auto ptr = (uint8_t const*)image.data;
+  ptr += image.pitch*(y/textureTileSize);
+  ptr += image.bytesPerPixel*((x/textureTileSize)*textureTileSize*textureTileSize + (y%textureTileSize)*textureTileSize + x%textureTileSize);
+  return ptr;
+}
+
+/**
+ * @brief Texel formats with their own fetch function (no per-texel conversion through channelTypes)
+ */
+enum class TexelFormat : uint8_t{
+  GENERIC , ///< any image, channels are read through Image::channelTypes
+  RGBA8   , ///< 4 normalized uint8_t channels in RGBA order
+  RGBA32F , ///< 4 float channels in RGBA order
+  DEPTH32F, ///< 1 float channel (depth), read as (d,0,0,1)
+};
+
+/**
+ * @brief This function returns texel format the image is stored in
+ *
+ * @param image image
+ *
+ * @return TexelFormat::GENERIC if the image does not match any of the pre-converted formats
+ */
+inline TexelFormat getTexelFormat(Image const&image){
+  bool const rgbaOrder = image.channelTypes[0] == Image::RED  && image.channelTypes[1] == Image::GREEN &&
+                         image.channelTypes[2] == Image::BLUE && image.channelTypes[3] == Image::ALPHA;
+  if(image.format == Image::U8  && image.channels == 4 && image.bytesPerPixel == 4                && rgbaOrder)return TexelFormat::RGBA8   ;
+  if(image.format == Image::F32 && image.channels == 4 && image.bytesPerPixel == 4*sizeof(float) && rgbaOrder)return TexelFormat::RGBA32F ;
+  if(image.format == Image::F32 && image.channels == 1 && image.bytesPerPixel ==   sizeof(float) && image.channelTypes[0] == Image::RED)return TexelFormat::DEPTH32F;
+  return TexelFormat::GENERIC;
+}
+
+/**
+ * @brief Filtering of mipmapped texture reads
+ */
+enum class TextureFilter : uint8_t{
+  NEAREST  , ///< nearest texel of the nearest level
+  BILINEAR , ///< bilinear filtering of the nearest level
+  TRILINEAR, ///< bilinear filtering of the two nearest levels blended together
+};
+
+/**
+ * @brief Addressing of texture coordinates outside of <0,1>
+ */
+enum class TextureWrap : uint8_t{
+  REPEAT, ///< the texture is repeated (like student_read_texture)
+  CLAMP , ///< coordinates are clamped (like student_read_textureClamp)
+};
+
+/**
+ * @brief Sampler state of mipmapped texture reads
+ */
+struct TextureSampler{
+  TextureFilter filter = TextureFilter::TRILINEAR;///< filtering
+  TextureWrap   wrap   = TextureWrap  ::REPEAT   ;///< addressing
+};
+
+/**
+ * @brief This function attaches mip chain and memory layout to a texture.
+ * The Image struct has no room for them, so they are looked up by the data pointer
+ * of the texture and every copy of the Texture struct shares them.
+ * The fetch function of the texel format (getTexelFormat) and layout is selected here,
+ * reads of textures without attached chain use the generic one.
+ * Chains must not be attached or removed while the GPU is drawing.
+ *
+ * @param texture texture (level 0)
+ * @param levels levels of the chain, levels[0] is the texture itself (the array must outlive the registration)
+ * @param nofLevels number of levels
+ * @param layout memory layout of all levels
+ */
+void student_setTextureMipmaps(Texture const&texture,Texture const*levels,uint32_t nofLevels,ImageLayout layout = ImageLayout::LINEAR);
+
+/**
+ * @brief This function detaches mip chain from a texture
+ *
+ * @param texture texture (level 0)
+ */
+void student_removeTextureMipmaps(Texture const&texture);
+
+/**
+ * @brief This function attaches filtering to a texture, shaders that sample it
+ * read the filter by student_getTextureFilter (like a sampler bound with the texture).
+ * The filter is kept when student_setTextureMipmaps replaces the chain and removed
+ * by student_removeTextureMipmaps.
+ *
+ * @param texture texture (level 0)
+ * @param filter filtering of the texture reads
+ */
+void student_setTextureFilter(Texture const&texture,TextureFilter filter);
+
+/**
+ * @brief This function returns filtering attached to a texture
+ *
+ * @param texture texture
+ *
+ * @return TextureFilter::NEAREST for textures without attached filter
+ */
+TextureFilter student_getTextureFilter(Texture const&texture);
+
+/**
+ * @brief This function returns number of mip levels of a texture
+ *
+ * @param texture texture
+ *
+ * @return 1 for textures without mip chain
+ */
+uint32_t student_getNofTextureLevels(Texture const&texture);
+
+/**
+ * @brief This function returns memory layout of a texture
+ *
+ * @param texture texture
+ *
+ * @return ImageLayout::LINEAR for textures without attached layout
+ */
+ImageLayout student_getTextureLayout(Texture const&texture);
+
+/**
+ * @brief This function returns texel format whose fetch function is used by reads of a texture
+ *
+ * @param texture texture
+ *
+ * @return TexelFormat::GENERIC for textures without attached chain
+ */
+TexelFormat student_getTexelFormat(Texture const&texture);
+
+/**
+ * @brief This function reads color from mipmapped texture at explicit level of detail.
+ *
+ * @param texture texture
+ * @param uv uv coordinates
+ * @param lod level of detail (0 = full resolution, clamped to the mip chain)
+ * @param sampler filtering and addressing
+ *
+ * @return color 4 floats
+ */
+glm::vec4 student_read_textureLod (Texture const&texture,glm::vec2 const&uv,float lod,TextureSampler const&sampler = TextureSampler());
+
+/**
+ * @brief This function reads color from mipmapped texture, level of detail is selected by derivatives of uv coordinates.
+ *
+ * @param texture texture
+ * @param uv uv coordinates
+ * @param dUVdx derivative of uv coordinates along screen x axis
+ * @param dUVdy derivative of uv coordinates along screen y axis
+ * @param sampler filtering and addressing
+ *
+ * @return color 4 floats
+ */
+glm::vec4 student_read_textureGrad(Texture const&texture,glm::vec2 const&uv,glm::vec2 const&dUVdx,glm::vec2 const&dUVdy,TextureSampler const&sampler = TextureSampler());
+
+/**
+ * @brief This function returns screen-space derivatives of an interpolated attribute
+ * of the fragment that is being shaded. The rasterizer computes them exactly from
+ * the barycentric gradients of the triangle (perspective-correct). With quad shading
+ * (GPUSettings::quadShading) they are differences of the 2x2 pixel quad of the fragment
+ * (helper pixels outside of the triangle included), as on a real GPU.
+ *
+ * @param attribute index of the attribute
+ * @param dFdx derivative along screen x axis
+ * @param dFdy derivative along screen y axis
+ *
+ * @return false outside of a fragment shader invocation of the rasterizer or for integer attributes
+ */
+bool student_getAttributeDerivatives(uint32_t attribute,glm::vec4&dFdx,glm::vec4&dFdy);
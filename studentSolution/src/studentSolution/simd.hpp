@@ -0,0 +1,141 @@
+/*!
+ * @file simd.hpp
+ * @brief This file contains thin SIMD wrappers used by the rasterizer.
+ *
+ * @author Jan kalina, xkalinj00@stud.fit.vutbr.cz
+ */
+#pragma once
+
+#include <cstdint>
+
+/*
+ * The implementation is selected during compilation: AVX2 (8 lanes) when
+ * the compiler targets it (see STUDENT_SOLUTION_AVX2 option in CMake), SSE2
+ * (4 lanes, always available on x86-64) or a plain scalar fallback with
+ * 4 lanes. All variants use ordinary IEEE single precision additions and
+ * comparisons, so they give bit-identical results to the scalar code.
+ */
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+
+//! Number of float lanes of the SIMD vector
+constexpr uint32_t simdWidth = 8;
+
+//! SIMD vector of floats
+struct SimdFloat {
+    __m256 value;
+};
+
+inline SimdFloat simdLoad(const float *pValues) { return SimdFloat{_mm256_loadu_ps(pValues)}; }
+inline SimdFloat simdBroadcast(const float value) { return SimdFloat{_mm256_set1_ps(value)}; }
+inline void simdStore(float *pValues, const SimdFloat a) { _mm256_storeu_ps(pValues, a.value); }
+inline SimdFloat simdAdd(const SimdFloat a, const SimdFloat b) { return SimdFloat{_mm256_add_ps(a.value, b.value)}; }
+
+/**
+ * @brief Evaluates the inside test `E > 0 || (E == 0 && topLeft)` for all lanes.
+ *
+ * @return `uint32_t` Bit mask with one bit per lane (bit i = lane i is inside).
+ */
+inline uint32_t simdEdgeInsideMask(const SimdFloat edgeFunction, const bool isTopLeft) {
+    const __m256 zero = _mm256_setzero_ps();
+    __m256 inside = _mm256_cmp_ps(edgeFunction.value, zero, _CMP_GT_OQ);
+    if(isTopLeft) {
+        inside = _mm256_or_ps(inside, _mm256_cmp_ps(edgeFunction.value, zero, _CMP_EQ_OQ));
+    }
+    return static_cast<uint32_t>(_mm256_movemask_ps(inside));
+}
+
+#elif defined(__SSE2__)
+
+//! Number of float lanes of the SIMD vector
+constexpr uint32_t simdWidth = 4;
+
+//! SIMD vector of floats
+struct SimdFloat {
+    __m128 value;
+};
+
+inline SimdFloat simdLoad(const float *pValues) { return SimdFloat{_mm_loadu_ps(pValues)}; }
+inline SimdFloat simdBroadcast(const float value) { return SimdFloat{_mm_set1_ps(value)}; }
+inline void simdStore(float *pValues, const SimdFloat a) { _mm_storeu_ps(pValues, a.value); }
+inline SimdFloat simdAdd(const SimdFloat a, const SimdFloat b) { return SimdFloat{_mm_add_ps(a.value, b.value)}; }
+
+/**
+ * @brief Evaluates the inside test `E > 0 || (E == 0 && topLeft)` for all lanes.
+ *
+ * @return `uint32_t` Bit mask with one bit per lane (bit i = lane i is inside).
+ */
+inline uint32_t simdEdgeInsideMask(const SimdFloat edgeFunction, const bool isTopLeft) {
+    const __m128 zero = _mm_setzero_ps();
+    __m128 inside = _mm_cmpgt_ps(edgeFunction.value, zero);
+    if(isTopLeft) {
+        inside = _mm_or_ps(inside, _mm_cmpeq_ps(edgeFunction.value, zero));
+    }
+    return static_cast<uint32_t>(_mm_movemask_ps(inside));
+}
+
+#else
+
+//! Number of float lanes of the SIMD vector
+constexpr uint32_t simdWidth = 4;
+
+//! SIMD vector of floats (scalar fallback)
+struct SimdFloat {
+    float value[simdWidth];
+};
+
+inline SimdFloat simdLoad(const float *pValues) {
+    SimdFloat result;
+    for(uint32_t iLane = 0; iLane < simdWidth; iLane++) {
+        result.value[iLane] = pValues[iLane];
+    } // for(iLane)
+    return result;
+}
+
+inline SimdFloat simdBroadcast(const float value) {
+    SimdFloat result;
+    for(uint32_t iLane = 0; iLane < simdWidth; iLane++) {
+        result.value[iLane] = value;
+    } // for(iLane)
+    return result;
+}
+
+inline void simdStore(float *pValues, const SimdFloat a) {
+    for(uint32_t iLane = 0; iLane < simdWidth; iLane++) {
+        pValues[iLane] = a.value[iLane];
+    } // for(iLane)
+}
+
+inline SimdFloat simdAdd(const SimdFloat a, const SimdFloat b) {
+    SimdFloat result;
+    for(uint32_t iLane = 0; iLane < simdWidth; iLane++) {
+        result.value[iLane] = a.value[iLane] + b.value[iLane];
+    } // for(iLane)
+    return result;
+}
+
+/**
+ * @brief Evaluates the inside test `E > 0 || (E == 0 && topLeft)` for all lanes.
+ *
+ * @return `uint32_t` Bit mask with one bit per lane (bit i = lane i is inside).
+ */
+inline uint32_t simdEdgeInsideMask(const SimdFloat edgeFunction, const bool isTopLeft) {
+    uint32_t mask = 0;
+    for(uint32_t iLane = 0; iLane < simdWidth; iLane++) {
+        const float value = edgeFunction.value[iLane];
+        if(value > 0 || (value == 0 && isTopLeft)) {
+            mask |= 1u << iLane;
+        }
+    } // for(iLane)
+    return mask;
+}
+
+#endif
+
+/*** end of file simd.hpp ***/
@@ -0,0 +1,102 @@
+/*!
+ * @file threadPool.cpp
+ * @brief This file contains simple thread pool used by the GPU back-ends.
+ *
+ * @author Jan kalina, xkalinj00@stud.fit.vutbr.cz
+ */
+
+#include <studentSolution/threadPool.hpp>
+#include <memory>  // std::unique_ptr
+
+ThreadPool::ThreadPool(const uint32_t nofThreads) {
+    // The caller is worker 0, so we only need to start the helpers
+    for(uint32_t iWorker = 1; iWorker < nofThreads; iWorker++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, iWorker);
+    } // for(iWorker)
+} // ThreadPool()
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    wakeUp.notify_all();
+
+    for(auto &worker : workers) {
+        worker.join();
+    } // for(worker)
+} // ~ThreadPool()
+
+uint32_t ThreadPool::getNofThreads() const {
+    return static_cast<uint32_t>(workers.size()) + 1;
+} // getNofThreads()
+
+void ThreadPool::parallelFor(const uint32_t nofJobs, const Job &job) {
+    // Nothing to share - run the loop directly on the calling thread
+    if(workers.empty() || nofJobs <= 1) {
+        for(uint32_t iJob = 0; iJob < nofJobs; iJob++) {
+            job(iJob, 0);
+        } // for(iJob)
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        currentJob = &job;
+        this->nofJobs = nofJobs;
+        nextJob = 0;
+        busyWorkers = static_cast<uint32_t>(workers.size());
+        generation++;
+    }
+    wakeUp.notify_all();
+
+    // The caller helps with the work instead of just waiting
+    runJobs(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return busyWorkers == 0; });
+    currentJob = nullptr;
+} // parallelFor()
+
+void ThreadPool::workerLoop(const uint32_t iWorker) {
+    uint64_t seenGeneration = 0;
+
+    while(true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [&] { return stop || generation != seenGeneration; });
+            if(stop) {
+                return;
+            }
+            seenGeneration = generation;
+        }
+
+        runJobs(iWorker);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(--busyWorkers == 0) {
+                finished.notify_one();
+            }
+        }
+    } // while(true)
+} // workerLoop()
+
+void ThreadPool::runJobs(const uint32_t iWorker) {
+    for(uint32_t iJob = nextJob.fetch_add(1); iJob < nofJobs; iJob = nextJob.fetch_add(1)) {
+        (*currentJob)(iJob, iWorker);
+    } // for(iJob)
+} // runJobs()
+
+ThreadPool &getThreadPool(const uint32_t nofThreads) {
+    static std::unique_ptr<ThreadPool> pool;
+
+    if(!pool || pool->getNofThreads() != nofThreads) {
+        pool.reset();  // join the old helpers before starting new ones
+        pool = std::make_unique<ThreadPool>(nofThreads);
+    }
+
+    return *pool;
+} // getThreadPool()
+
+/*** end of file threadPool.cpp ***/
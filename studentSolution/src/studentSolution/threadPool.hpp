@@ -0,0 +1,90 @@
+/*!
+ * @file threadPool.hpp
+ * @brief This file contains simple thread pool used by the GPU back-ends.
+ *
+ * @author Jan kalina, xkalinj00@stud.fit.vutbr.cz
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed-size pool of worker threads executing data-parallel loops.
+ *
+ * @details The calling thread always takes part in the work (as worker 0),
+ *          so a pool of one thread has no helper threads at all and simply
+ *          runs the loop in place. Jobs are distributed dynamically using an
+ *          atomic counter, which balances unevenly loaded screen tiles.
+ */
+class ThreadPool {
+    public:
+        /**
+         * @brief Job callback - receives index of the job and index of the
+         *        worker executing it (in range <0, nofThreads)).
+         */
+        using Job = std::function<void(uint32_t iJob, uint32_t iWorker)>;
+
+        /**
+         * @brief Creates the pool and starts `nofThreads - 1` helper threads.
+         *
+         * @param nofThreads Total number of threads including the caller.
+         */
+        explicit ThreadPool(uint32_t nofThreads);
+
+        /**
+         * @brief Stops and joins all helper threads.
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /**
+         * @brief Returns total number of threads including the caller.
+         */
+        uint32_t getNofThreads() const;
+
+        /**
+         * @brief Executes `job` for each index in <0, nofJobs) and waits
+         *        until all of them are finished.
+         *
+         * @param nofJobs Number of jobs.
+         * @param job Callback executed for each job.
+         */
+        void parallelFor(uint32_t nofJobs, const Job &job);
+
+    private:
+        void workerLoop(uint32_t iWorker);
+        void runJobs(uint32_t iWorker);
+
+        std::vector<std::thread> workers;    ///< helper threads (caller is not included)
+        std::mutex               mutex;      ///< guards the members below
+        std::condition_variable  wakeUp;     ///< signals new work or stop request
+        std::condition_variable  finished;   ///< signals that all helpers are done
+        const Job               *currentJob = nullptr;///< job of the running loop
+        uint32_t                 nofJobs = 0;///< number of jobs of the running loop
+        std::atomic<uint32_t>    nextJob{0}; ///< next job to be taken
+        uint32_t                 busyWorkers = 0;///< helpers still working on current loop
+        uint64_t                 generation = 0;///< incremented for each loop
+        bool                     stop = false;///< request for helpers to finish
+};
+
+/**
+ * @brief Returns the shared thread pool with the given number of threads.
+ *
+ * @details The pool is created lazily and re-created when different number
+ *          of threads is requested.
+ *
+ * @param nofThreads Total number of threads including the caller.
+ *
+ * @return `ThreadPool&` Reference to the shared pool.
+ */
+ThreadPool &getThreadPool(uint32_t nofThreads);
+
+/*** end of file threadPool.hpp ***/
@@ -0,0 +1,44 @@
+/*!
+ * @file vertexBatch.cpp
+ * @brief This file contains the batched (SoA) vertex shader interface.
+ *
+ * @author Jan kalina, xkalinj00@stud.fit.vutbr.cz
+ */
+
+#include <studentSolution/vertexBatch.hpp>
+#include <mutex>          // std::mutex, std::lock_guard
+#include <unordered_map>  // std::unordered_map
+
+//! Batch shaders indexed by the per-vertex shader they replace
+struct BatchShaderRegistry {
+    std::mutex mutex;
+    std::unordered_map<VertexShader, BatchVertexShader> shaders;
+};
+
+static BatchShaderRegistry &getBatchShaderRegistry() {
+    // Function-local static, so shaders can be registered during static initialization
+    static BatchShaderRegistry registry;
+    return registry;
+} // getBatchShaderRegistry()
+
+void registerBatchVertexShader(const VertexShader vertexShader, const BatchVertexShader batchVertexShader) {
+    BatchShaderRegistry &registry = getBatchShaderRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    if(batchVertexShader) {
+        registry.shaders[vertexShader] = batchVertexShader;
+    }
+    else {
+        registry.shaders.erase(vertexShader);
+    }
+} // registerBatchVertexShader()
+
+BatchVertexShader findBatchVertexShader(const VertexShader vertexShader) {
+    BatchShaderRegistry &registry = getBatchShaderRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    const auto it = registry.shaders.find(vertexShader);
+    return it != registry.shaders.end() ? it->second : nullptr;
+} // findBatchVertexShader()
+
+/*** end of file vertexBatch.cpp ***/
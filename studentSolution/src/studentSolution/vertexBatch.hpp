@@ -0,0 +1,56 @@
+/*!
+ * @file vertexBatch.hpp
+ * @brief This file contains the batched (SoA) vertex shader interface.
+ *
+ * @author Jan kalina, xkalinj00@stud.fit.vutbr.cz
+ */
+#pragma once
+
+#include <solutionInterface/gpu.hpp>
+
+//! Number of vertices processed by one invocation of a batch vertex shader
+constexpr uint32_t vertexBatchSize = 16;
+
+/**
+ * @brief Input vertices of one batch stored as structure of arrays.
+ *
+ * @details `attributes[a][i]` is attribute `a` of the i-th vertex of the
+ *          batch. Attributes that are not fetched keep the default value of
+ *          `Attrib` (`vec4(1)`), exactly like in `InVertex`.
+ */
+struct InVertexBatch {
+    uint32_t nofVertices = 0;                              ///< number of valid lanes
+    uint32_t gl_VertexID[vertexBatchSize] = {};            ///< vertex ids
+    Attrib   attributes[maxAttribs][vertexBatchSize];      ///< vertex attributes (SoA)
+};
+
+/**
+ * @brief Function type of a batch vertex shader.
+ *
+ * @details Must produce the same outputs as the per-vertex shader it is
+ *          registered for, `outVertices[i]` belongs to lane `i`.
+ */
+using BatchVertexShader = void(*)(OutVertex outVertices[], const InVertexBatch &inVertices, const ShaderInterface &si);
+
+/**
+ * @brief Registers a batch version of a per-vertex shader.
+ *
+ * @details `Program` only holds the per-vertex `VertexShader`, so batch
+ *          shaders are found by the per-vertex function pointer. Registering
+ *          `nullptr` removes the batch version again.
+ *
+ * @param vertexShader Per-vertex shader stored in `Program`.
+ * @param batchVertexShader Equivalent shader working on whole batches.
+ */
+void registerBatchVertexShader(VertexShader vertexShader, BatchVertexShader batchVertexShader);
+
+/**
+ * @brief Finds the batch version of a per-vertex shader.
+ *
+ * @param vertexShader Per-vertex shader stored in `Program`.
+ *
+ * @return `BatchVertexShader` Registered batch shader or `nullptr`.
+ */
+BatchVertexShader findBatchVertexShader(VertexShader vertexShader);
+
+/*** end of file vertexBatch.hpp ***/
@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+
+#include <BasicCamera/OrbitCamera.h>
+#include <BasicCamera/PerspectiveCamera.h>
+#include <examples/modelMethod.hpp>
+#include <framework/application.hpp>
+#include <framework/programContext.hpp>
+#include <tests/benchmarkSuite.hpp>
+#include <tests/testCommon.hpp>
+
+#ifndef CMAKE_ROOT_DIR
+#define CMAKE_ROOT_DIR "."
+#endif//CMAKE_ROOT_DIR
+
+namespace{
+
+/**
+ * @brief One measured case - a method (created by the factory) rendered at one size
+ */
+struct BenchmarkCase{
+  std::string                                     name         ;
+  std::function<std::shared_ptr<Method>(GPUMemory&)>createMethod;
+  std::string                                     modelFile    ;///< model loaded by the model method (empty = not a model case)
+};
+
+std::vector<BenchmarkCase>getBenchmarkCases(){
+  std::vector<BenchmarkCase>cases;
+
+  auto const&methods = ProgramContext::get().methods;
+  for(size_t id=0;id<methods.getNofMethods();++id)
+    cases.push_back({methods.getMethodName(id),[id](GPUMemory&mem){return ProgramContext::get().methods.createMethod(id,mem);},""});
+
+  auto const modelDir = std::filesystem::path(CMAKE_ROOT_DIR "/resources/models");
+  std::vector<std::filesystem::path>models;
+  if(std::filesystem::is_directory(modelDir))
+    for(auto const&entry:std::filesystem::recursive_directory_iterator(modelDir)){
+      auto const extension = entry.path().extension().string();
+      if(entry.is_regular_file() && (extension == ".gltf" || extension == ".glb"))
+        models.push_back(entry.path());
+    }
+  std::sort(models.begin(),models.end());
+
+  for(auto const&model:models)
+    cases.push_back({
+        "model:"+std::filesystem::relative(model,modelDir).generic_string(),
+        [](GPUMemory&mem){return std::make_shared<modelMethod::Method>(mem);},
+        model.string()});
+
+  return cases;
+}
+
+SceneParam getSceneParam(uint32_t width,uint32_t height){
+  auto orbitCamera       = basicCamera::OrbitCamera();
+  auto perspectiveCamera = basicCamera::PerspectiveCamera();
+  glm::vec3 light;
+
+  defaultSceneParameters(orbitCamera,perspectiveCamera,light,width,height);
+
+  SceneParam sceneParam;
+  sceneParam.proj   = perspectiveCamera.getProjection();
+  sceneParam.view   = orbitCamera      .getView      ();
+  sceneParam.camera = glm::vec3(glm::inverse(sceneParam.view)*glm::vec4(0.f,0.f,0.f,1.f));
+  sceneParam.light  = light;
+  return sceneParam;
+}
+
+BenchmarkResult measureCase(BenchmarkCase const&c,uint32_t width,uint32_t height,BenchmarkOptions const&options){
+  auto&modelFile = ProgramContext::get().args.modelFile;
+  auto const oldModelFile = modelFile;
+  if(!c.modelFile.empty())modelFile = c.modelFile;
+
+  auto frame = tests::createFramebuffer(width,height);
+  GPUMemory mem;
+  mem.framebuffers[mem.defaultFramebuffer] = frame.frame;
+
+  std::shared_ptr<Method>method;
+  try{
+    method = c.createMethod(mem);
+  }catch(...){
+    modelFile = oldModelFile;
+    throw;
+  }
+  modelFile = oldModelFile;
+
+  auto const sceneParam = getSceneParam(width,height);
+
+  for(uint32_t i=0;i<options.warmupFrames;++i)
+    method->onDraw(sceneParam);
+
+  std::vector<double>frameTimes;
+  for(uint32_t i=0;i<options.frames;++i){
+    auto const start = std::chrono::steady_clock::now();
+    method->onDraw(sceneParam);
+    auto const end   = std::chrono::steady_clock::now();
+    frameTimes.push_back(std::chrono::duration<double,std::milli>(end-start).count());
+  }
+
+  BenchmarkResult result;
+  result.name   = c.name;
+  result.width  = width ;
+  result.height = height;
+  computeBenchmarkStatistics(result,frameTimes);
+  return result;
+}
+
+bool isJsonFile(std::string const&fileName){
+  return std::filesystem::path(fileName).extension() == ".json";
+}
+
+std::string getCaseKey(std::string const&name,uint32_t width,uint32_t height){
+  return name + " " + std::to_string(width) + "x" + std::to_string(height);
+}
+
+bool writeResults(std::string const&fileName,std::vector<BenchmarkResult>const&results){
+  std::ofstream file(fileName);
+  if(!file){
+    std::cerr << "benchmark: cannot write " << fileName << std::endl;
+    return false;
+  }
+
+  file << std::fixed << std::setprecision(4);
+  if(isJsonFile(fileName)){
+    //one case per line, so the file can be read back without a JSON library
+    file << "[\n";
+    for(size_t i=0;i<results.size();++i){
+      auto const&r = results[i];
+      file << "{\"name\":\"" << r.name << "\",\"width\":" << r.width << ",\"height\":" << r.height << ",\"frames\":" << r.frames;
+      file << ",\"median_ms\":" << r.median << ",\"p95_ms\":" << r.p95 << ",\"mean_ms\":" << r.mean << ",\"stddev_ms\":" << r.stddev << ",\"min_ms\":" << r.min << "}";
+      file << (i+1 < results.size() ? ",\n" : "\n");
+    }
+    file << "]\n";
+  }else{
+    file << "name,width,height,frames,median_ms,p95_ms,mean_ms,stddev_ms,min_ms\n";
+    for(auto const&r:results){
+      file << "\"" << r.name << "\"," << r.width << "," << r.height << "," << r.frames;
+      file << "," << r.median << "," << r.p95 << "," << r.mean << "," << r.stddev << "," << r.min << "\n";
+    }
+  }
+  return static_cast<bool>(file);
+}
+
+std::string getJsonValue(std::string const&line,std::string const&key){
+  auto const keyStart = line.find("\""+key+"\":");
+  if(keyStart == std::string::npos)return "";
+  auto start = keyStart + key.size() + 3;
+  if(start < line.size() && line[start] == '"'){
+    start++;
+    return line.substr(start,line.find('"',start)-start);
+  }
+  auto const end = line.find_first_of(",}",start);
+  return line.substr(start,end-start);
+}
+
+/**
+ * @brief This function reads medians of a baseline written by writeResults
+ *
+ * @return medians indexed by getCaseKey
+ */
+std::map<std::string,double>readBaseline(std::string const&fileName){
+  std::map<std::string,double>medians;
+  std::ifstream file(fileName);
+  if(!file){
+    std::cerr << "benchmark: cannot read baseline " << fileName << std::endl;
+    return medians;
+  }
+
+  bool const json = isJsonFile(fileName);
+  std::string line;
+  while(std::getline(file,line)){
+    try{
+      if(json){
+        auto const name = getJsonValue(line,"name");
+        if(name.empty())continue;
+        medians[getCaseKey(name,std::stoul(getJsonValue(line,"width")),std::stoul(getJsonValue(line,"height")))] = std::stod(getJsonValue(line,"median_ms"));
+      }else{
+        if(line.empty() || line[0] != '"')continue;
+        auto const nameEnd = line.find('"',1);
+        auto const name    = line.substr(1,nameEnd-1);
+        std::stringstream ss(line.substr(nameEnd+2));
+        std::string width,height,frames,median;
+        std::getline(ss,width ,',');
+        std::getline(ss,height,',');
+        std::getline(ss,frames,',');
+        std::getline(ss,median,',');
+        medians[getCaseKey(name,std::stoul(width),std::stoul(height))] = std::stod(median);
+      }
+    }catch(std::exception&){
+      std::cerr << "benchmark: skipping malformed baseline line: " << line << std::endl;
+    }
+  }
+  return medians;
+}
+
+}
+
+void computeBenchmarkStatistics(BenchmarkResult&result,std::vector<double>frameTimes){
+  result.frames = static_cast<uint32_t>(frameTimes.size());
+  if(frameTimes.empty())return;
+
+  std::sort(frameTimes.begin(),frameTimes.end());
+  auto const n = frameTimes.size();
+
+  result.min    = frameTimes.front();
+  result.median = n%2 ? frameTimes[n/2] : (frameTimes[n/2-1] + frameTimes[n/2]) / 2.;
+  //nearest rank
+  result.p95    = frameTimes[static_cast<size_t>(std::ceil(.95*static_cast<double>(n)))-1];
+
+  double sum = 0.;
+  for(auto const&t:frameTimes)sum += t;
+  result.mean = sum / static_cast<double>(n);
+
+  double squares = 0.;
+  for(auto const&t:frameTimes)squares += (t-result.mean)*(t-result.mean);
+  result.stddev = n > 1 ? std::sqrt(squares / static_cast<double>(n-1)) : 0.;
+}
+
+bool runBenchmarkSuite(BenchmarkOptions const&options){
+  std::vector<BenchmarkResult>results;
+
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << std::left << std::setw(48) << "case" << std::setw(12) << "size" << std::right
+            << std::setw(12) << "median[ms]" << std::setw(12) << "p95[ms]" << std::setw(12) << "stddev[ms]" << std::endl;
+
+  for(auto const&c:getBenchmarkCases()){
+    if(!options.filter.empty() && c.name.find(options.filter) == std::string::npos)continue;
+
+    for(size_t i=0;i+1<options.sizes.size();i+=2){
+      if(options.sizes[i] <= 0 || options.sizes[i+1] <= 0)continue;
+      auto const width  = static_cast<uint32_t>(options.sizes[i  ]);
+      auto const height = static_cast<uint32_t>(options.sizes[i+1]);
+      auto const size   = std::to_string(width) + "x" + std::to_string(height);
+
+      std::cout << std::left << std::setw(48) << c.name << std::setw(12) << size << std::right << std::flush;
+      try{
+        auto const result = measureCase(c,width,height,options);
+        std::cout << std::setw(12) << result.median << std::setw(12) << result.p95 << std::setw(12) << result.stddev << std::endl;
+        results.push_back(result);
+      }catch(std::exception&e){
+        std::cout << "  skipped: " << e.what() << std::endl;
+      }
+    }
+  }
+
+  bool success = true;
+  if(!options.outputFile.empty()){
+    success &= writeResults(options.outputFile,results);
+    std::cout << "benchmark results stored to: \"" << options.outputFile << "\"" << std::endl;
+  }
+
+  if(options.baselineFile.empty())return success;
+
+  auto const baseline = readBaseline(options.baselineFile);
+  uint32_t nofRegressions = 0;
+  for(auto const&r:results){
+    auto const it = baseline.find(getCaseKey(r.name,r.width,r.height));
+    if(it == baseline.end()){
+      std::cout << "no baseline: " << getCaseKey(r.name,r.width,r.height) << std::endl;
+      continue;
+    }
+    auto const change = it->second > 0. ? (r.median / it->second - 1.) * 100. : 0.;
+    if(change <= options.regressionThreshold)continue;
+    std::cout << "REGRESSION: " << getCaseKey(r.name,r.width,r.height) << " median " << r.median
+              << " ms, baseline " << it->second << " ms (+" << change << " %)" << std::endl;
+    nofRegressions++;
+  }
+  std::cout << nofRegressions << " regression(s) above " << options.regressionThreshold << " % against \"" << options.baselineFile << "\"" << std::endl;
+
+  return success && nofRegressions == 0;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Settings of the benchmark suite
+ */
+struct BenchmarkOptions{
+  std::vector<int32_t>sizes               = {320,240,640,480};///< pairs of width and height of the framebuffer
+  uint32_t            warmupFrames        = 2                ;///< frames rendered before the measurement
+  uint32_t            frames              = 5                ;///< measured frames
+  std::string         outputFile                             ;///< results are written to this file (.json or .csv, empty = no file)
+  std::string         baselineFile                           ;///< results are compared to this file (.json or .csv, empty = no comparison)
+  float               regressionThreshold = 10.f             ;///< allowed slowdown of the median against the baseline [%]
+  std::string         filter                                 ;///< only cases containing this string are measured (empty = all)
+};
+
+/**
+ * @brief Result of one benchmark case (times are in milliseconds)
+ */
+struct BenchmarkResult{
+  std::string name         ;///< name of the method or model
+  uint32_t    width    = 0 ;///< width of the framebuffer
+  uint32_t    height   = 0 ;///< height of the framebuffer
+  uint32_t    frames   = 0 ;///< number of measured frames
+  double      median   = 0.;///< median frame time
+  double      p95      = 0.;///< 95th percentile of frame times
+  double      mean     = 0.;///< mean frame time
+  double      stddev   = 0.;///< sample standard deviation of frame times
+  double      min      = 0.;///< fastest frame
+};
+
+/**
+ * @brief This function computes statistics of measured frame times
+ *
+ * @param result result that receives the statistics
+ * @param frameTimes times of frames in milliseconds
+ */
+void computeBenchmarkStatistics(BenchmarkResult&result,std::vector<double>frameTimes);
+
+/**
+ * @brief This function renders every registered method and every glTF model
+ * from resources/models at every size and reports frame time statistics
+ *
+ * @param options settings of the suite
+ *
+ * @return false if the output could not be written or a case is slower than the baseline
+ */
+bool runBenchmarkSuite(BenchmarkOptions const&options);
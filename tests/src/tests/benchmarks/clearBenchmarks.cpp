@@ -0,0 +1,37 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#define __FILENAME__ "clearBenchmarks"
+#include <tests/testCommon.hpp>
+
+#include <studentSolution/gpu.hpp>
+
+using namespace tests;
+
+SCENARIO(TEST_NAME,"[.][benchmark][clear]"){
+  auto frame = createFramebuffer(640,480);
+
+  GPUMemory mem;
+  mem.framebuffers[0] = frame.frame;
+
+  ClearColorCommand clearColor;
+  clearColor.value = glm::vec4(.1f,.2f,.3f,1.f);
+  BENCHMARK("handleClearColorCommand 640x480"){
+    runClearColorStage(mem,clearColor);
+    return frame.colorBacking[0];
+  };
+
+  ClearDepthCommand clearDepth;
+  clearDepth.value = .5f;
+  BENCHMARK("handleClearDepthCommand 640x480"){
+    runClearDepthStage(mem,clearDepth);
+    return frame.depthBacking[0];
+  };
+
+  ClearStencilCommand clearStencil;
+  clearStencil.value = 3;
+  BENCHMARK("handleClearStencilCommand 640x480"){
+    runClearStencilStage(mem,clearStencil);
+    return frame.stencilBacking[0];
+  };
+}
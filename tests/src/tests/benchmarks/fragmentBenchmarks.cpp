@@ -0,0 +1,115 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#define __FILENAME__ "fragmentBenchmarks"
+#include <tests/testCommon.hpp>
+
+#include <framework/textureData.hpp>
+#include <studentSolution/gpu.hpp>
+#include <studentSolution/shaderFunctions.hpp>
+
+#include <utility>
+
+using namespace tests;
+
+SCENARIO(TEST_NAME,"[.][benchmark][fragment]"){
+  std::pair<char const*,StencilOp>const operations[] = {
+    {"KEEP"     ,StencilOp::KEEP     },{"ZERO"     ,StencilOp::ZERO     },{"REPLACE",StencilOp::REPLACE},{"INCR"     ,StencilOp::INCR     },
+    {"INCR_WRAP",StencilOp::INCR_WRAP},{"DECR"     ,StencilOp::DECR     },{"DECR_WRAP",StencilOp::DECR_WRAP},{"INVERT" ,StencilOp::INVERT },
+  };
+
+  for(auto const&[name,operation]:operations){
+    BENCHMARK(std::string("executeStencilOperation ")+name+" x1024"){
+      uint8_t values[1024];
+      for(uint32_t i=0;i<1024;++i){
+        values[i] = (uint8_t)i;
+        runStencilOperationStage(values[i],operation,7);
+      }
+      return values[1023];
+    };
+  }
+
+  uint32_t const size = 256;
+  std::vector<uint8_t>data(size*size*4);
+  for(size_t i=0;i<data.size();++i)data[i] = (uint8_t)i;
+
+  Texture texture;
+  texture.width  = size;
+  texture.height = size;
+  texture.img.data          = data.data();
+  texture.img.channels      = 4;
+  texture.img.bytesPerPixel = 4;
+  texture.img.format        = Image::U8;
+  texture.img.pitch         = size*4;
+
+  BENCHMARK("student_texelFetch x1024"){
+    glm::vec4 sum = glm::vec4(0.f);
+    for(uint32_t i=0;i<1024;++i)
+      sum += student_texelFetch(texture,glm::uvec2((i*37)%size,(i*11)%size));
+    return sum;
+  };
+
+  // the same texels through the fetch functions of pre-converted formats (texture above uses the generic one)
+  auto rgba8 = TextureData(size,size,4);
+  std::copy(data.begin(),data.end(),rgba8.memBacking.begin());
+  rgba8.convertFormat();
+
+  auto genericDepth = TextureData(size,size,1,Image::F32);
+  auto depth        = TextureData(size,size,1,Image::F32);
+  for(size_t i=0;i<(size_t)size*size;++i)
+    ((float*)genericDepth.memBacking.data())[i] = ((float*)depth.memBacking.data())[i] = (float)i;
+  depth.convertFormat();
+
+  for(auto const&[name,tex]:{std::pair<char const*,Texture>{"RGBA8",rgba8.texture},{"GENERIC F32x1",genericDepth.texture},{"DEPTH32F",depth.texture}}){
+    BENCHMARK(std::string("student_texelFetch ")+name+" x1024"){
+      glm::vec4 sum = glm::vec4(0.f);
+      for(uint32_t i=0;i<1024;++i)
+        sum += student_texelFetch(tex,glm::uvec2((i*37)%size,(i*11)%size));
+      return sum;
+    };
+  }
+
+  BENCHMARK("read_textureClamp x1024"){
+    glm::vec4 sum = glm::vec4(0.f);
+    for(uint32_t i=0;i<1024;++i)
+      sum += student_read_textureClamp(texture,glm::vec2((float)(i%40)/32.f-.1f,(float)(i/40)/25.f));
+    return sum;
+  };
+
+  // distant surface: neighbouring pixels are 32 texels apart in level 0
+  auto minified = TextureData(2048,2048,4);
+  for(size_t i=0;i<minified.memBacking.size();++i)minified.memBacking[i] = (uint8_t)(i*7);
+  minified.generateMipmaps();
+  glm::vec2 const footprint = glm::vec2(32.f/2048.f);
+
+  BENCHMARK("read_textureClamp minified x1024"){
+    glm::vec4 sum = glm::vec4(0.f);
+    for(uint32_t i=0;i<1024;++i)
+      sum += student_read_textureClamp(minified.texture,glm::vec2((float)(i%32),(float)(i/32))*footprint);
+    return sum;
+  };
+
+  for(auto const&[name,filter]:{std::pair<char const*,TextureFilter>{"NEAREST",TextureFilter::NEAREST},{"BILINEAR",TextureFilter::BILINEAR},{"TRILINEAR",TextureFilter::TRILINEAR}}){
+    BENCHMARK(std::string("read_textureGrad ")+name+" minified x1024"){
+      glm::vec4 sum = glm::vec4(0.f);
+      for(uint32_t i=0;i<1024;++i)
+        sum += student_read_textureGrad(minified.texture,glm::vec2((float)(i%32),(float)(i/32))*footprint,
+                                        glm::vec2(footprint.x,0.f),glm::vec2(0.f,footprint.y),{filter,TextureWrap::CLAMP});
+      return sum;
+    };
+  }
+
+  // texels of a column are in different rows of a linear image, but 4 of them share a tile
+  auto tiled = TextureData(2048,2048,4);
+  std::copy(minified.memBacking.begin(),minified.memBacking.end(),tiled.memBacking.begin());
+  tiled.convertLayout(ImageLayout::TILED);
+
+  for(auto const&[name,tex]:{std::pair<char const*,Texture>{"LINEAR",minified.texture},{"TILED",tiled.texture}}){
+    BENCHMARK(std::string("student_texelFetch ")+name+" columns x1024"){
+      glm::vec4 sum = glm::vec4(0.f);
+      for(uint32_t i=0;i<1024;++i)
+        sum += student_texelFetch(tex,glm::uvec2((i/256)*509,i%256));
+      return sum;
+    };
+  }
+}
@@ -0,0 +1,195 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#define __FILENAME__ "rasterBenchmarks"
+#include <tests/testCommon.hpp>
+
+#include <studentSolution/fragmentShaderTraits.hpp>
+#include <studentSolution/gpu.hpp>
+#include <studentSolution/gpuSettings.hpp>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+using namespace tests;
+
+namespace{
+
+uint32_t const frameSize = 512;
+
+OutVertex createOutVertex(float x,float y){
+  OutVertex out;
+  out.gl_Position = glm::vec4(x,y,.5f,1.f);
+  for(uint32_t i=0;i<4;++i)
+    out.attributes[i].v4 = glm::vec4(x,y,(float)i,1.f);
+  return out;
+}
+
+void fragment(OutFragment&out,InFragment const&in,ShaderInterface const&){
+  out.gl_FragColor = in.attributes[0].v4;
+}
+
+/**
+ * @brief Full screen quad of the draw gl_DrawID, its depth is uniforms[0] + gl_DrawID*uniforms[1]
+ */
+void layerVertex(OutVertex&out,InVertex const&in,ShaderInterface const&si){
+  glm::vec2 const quad[6] = {
+    glm::vec2(-1.f,-1.f),glm::vec2(+1.f,-1.f),glm::vec2(-1.f,+1.f),
+    glm::vec2(-1.f,+1.f),glm::vec2(+1.f,-1.f),glm::vec2(+1.f,+1.f),
+  };
+  float const depth = si.uniforms[0].v1 + (float)si.gl_DrawID*si.uniforms[1].v1;
+  out.gl_Position = glm::vec4(quad[in.gl_VertexID%6],depth,1.f);
+  out.attributes[0].v4 = glm::vec4(depth,(float)si.gl_DrawID,quad[in.gl_VertexID%6]);
+}
+
+}
+
+SCENARIO(TEST_NAME,"[.][benchmark][raster]"){
+  auto frame = createFramebuffer(frameSize,frameSize);
+  // without depth buffer every iteration writes the same pixels
+  frame.frame.depth.data = nullptr;
+
+  GPUMemory mem;
+  mem.framebuffers[0] = frame.frame;
+  mem.programs[0].fragmentShader = fragment;
+  for(uint32_t i=0;i<4;++i)mem.programs[0].vs2fs[i] = AttribType::VEC4;
+
+  // sizes in normalized device coordinates of a 512x512 framebuffer
+  float const px = 2.f/(float)frameSize;
+  OutVertex const small [3] = {createOutVertex(0.f,0.f),createOutVertex(4.f*px,0.f),createOutVertex(0.f,4.f*px)};
+  OutVertex const medium[3] = {createOutVertex(0.f,0.f),createOutVertex(128.f*px,0.f),createOutVertex(0.f,128.f*px)};
+  OutVertex const large [3] = {createOutVertex(-1.f,-1.f),createOutVertex(1.f,-1.f),createOutVertex(-1.f,1.f)};
+  OutVertex const sliver[3] = {createOutVertex(-1.f,-1.f),createOutVertex(1.f,1.f),createOutVertex(-1.f,-1.f+2.f*px)};
+
+  std::pair<char const*,OutVertex const*>const triangles[] = {
+    {"small (8 px)",small},{"medium (8K px)",medium},{"large (128K px)",large},{"sliver (256 px)",sliver},
+  };
+
+  for(auto const&[name,triangle]:triangles){
+    BENCHMARK(std::string("rasterizeTriangleUsingPineda ")+name){
+      runRasterizationStage(mem,triangle);
+      return frame.colorBacking[0];
+    };
+  }
+
+  // shadow map pass: depth buffer only, depth writes blocked so every iteration passes the depth test
+  auto depthFrame = createFramebuffer(frameSize,frameSize);
+  depthFrame.frame.color.data = nullptr;
+  std::fill(depthFrame.depthBacking.begin(),depthFrame.depthBacking.end(),1.f);
+  GPUMemory depthMem = mem;
+  depthMem.framebuffers[0]    = depthFrame.frame;
+  depthMem.blockWrites.depth  = true;
+  declareColorOnlyFragmentShader(fragment);
+
+  for(auto const&[name,depthOnly]:{std::pair<char const*,bool>{"full",false},{"depth-only",true}}){
+    BENCHMARK(std::string("rasterizeTriangleUsingPineda shadow pass ")+name+" large (128K px)"){
+      auto const oldSettings = getGPUSettings();
+      getGPUSettings().depthOnlyFragments = depthOnly;
+      runRasterizationStage(depthMem,large);
+      getGPUSettings() = oldSettings;
+      return depthFrame.depthBacking[0];
+    };
+  }
+  declareColorOnlyFragmentShader(fragment,false);
+
+  // high overdraw: the triangle is behind the whole depth buffer
+  auto occludedFrame = createFramebuffer(frameSize,frameSize);
+  std::fill(occludedFrame.depthBacking.begin(),occludedFrame.depthBacking.end(),0.f);
+  GPUMemory occludedMem = mem;
+  occludedMem.framebuffers[0] = occludedFrame.frame;
+
+  struct OccludedCase{
+    char const*name;
+    bool       lazy;
+    bool       hiZ ;
+  };
+  OccludedCase const occludedCases[] = {{"eager interpolation",false,false},{"depth test",true,false},{"Hi-Z",true,true}};
+  for(auto const&c:occludedCases){
+    BENCHMARK(std::string("rasterizeTriangleUsingPineda occluded ")+c.name+" large (128K px)"){
+      auto const oldSettings = getGPUSettings();
+      getGPUSettings().lazyAttributeInterpolation = c.lazy;
+      getGPUSettings().hierarchicalDepth          = c.hiZ;
+      runRasterizationStage(occludedMem,large);
+      getGPUSettings() = oldSettings;
+      return occludedFrame.colorBacking[0];
+    };
+  }
+
+  // high overdraw: full screen layers sorted by depth, the depth buffer is cleared every frame
+  uint32_t const nofLayers = 8;
+  auto layersFrame = createFramebuffer(frameSize,frameSize);
+  GPUMemory layersMem;
+  layersMem.framebuffers[0]            = layersFrame.frame;
+  layersMem.programs[0].vertexShader   = layerVertex;
+  layersMem.programs[0].fragmentShader = fragment;
+  layersMem.programs[0].vs2fs[0]       = AttribType::VEC4;
+
+  CommandBuffer layers;
+  REQUIRE(pushClearDepthCommand (layers,1.f));
+  REQUIRE(pushBindProgramCommand(layers,0));
+  for(uint32_t i=0;i<nofLayers;++i)
+    REQUIRE(pushDrawCommand(layers,6));
+
+  struct LayerOrder{
+    char const*name;
+    float      firstDepth;
+    float      depthStep;
+  };
+  float const layerStep = 1.6f/(float)nofLayers;
+  for(auto const&order:{LayerOrder{"front-to-back",-.8f,layerStep},{"back-to-front",.8f,-layerStep}})
+    for(auto const&c:occludedCases){
+      BENCHMARK("student_GPU_run "+std::to_string(nofLayers)+" layers "+order.name+" "+c.name+" 512x512"){
+        auto const oldSettings = getGPUSettings();
+        getGPUSettings().lazyAttributeInterpolation = c.lazy;
+        getGPUSettings().hierarchicalDepth          = c.hiZ;
+        layersMem.uniforms[0].v1 = order.firstDepth;
+        layersMem.uniforms[1].v1 = order.depthStep;
+        student_GPU_run(layersMem,layers);
+        getGPUSettings() = oldSettings;
+        return layersFrame.colorBacking[0];
+      };
+    }
+
+  // float attributes are interpolated, integer attributes are taken from the provoking vertex
+  Program program;
+  program.vs2fs[0] = AttribType::FLOAT;
+  program.vs2fs[1] = AttribType::VEC2 ;
+  program.vs2fs[2] = AttribType::VEC3 ;
+  program.vs2fs[3] = AttribType::VEC4 ;
+  Program integerProgram;
+  integerProgram.vs2fs[0] = AttribType::UINT ;
+  integerProgram.vs2fs[1] = AttribType::UVEC2;
+  integerProgram.vs2fs[2] = AttribType::UVEC3;
+  integerProgram.vs2fs[3] = AttribType::UVEC4;
+
+  for(auto const&[name,interpolated]:{std::pair<char const*,Program const*>{"float",&program},{"integer",&integerProgram}}){
+    BENCHMARK(std::string("interpolateFragmentAttributes ")+name+" x1024"){
+      InFragment inFragment;
+      uint32_t sum = 0;
+      for(uint32_t i=0;i<1024;++i){
+        float const l0 = (float)(i%32)/64.f;
+        float const l1 = (float)(i/32)/64.f;
+        runAttributeInterpolationStage(*interpolated,l0,l1,1.f-l0-l1,inFragment,large);
+        sum += inFragment.attributes[3].u4.x;
+      }
+      return sum;
+    };
+  }
+
+  // the same fragments from screen-space planes (perspective correction included)
+  glm::vec3 const largeVertices[3] = {glm::vec3(0.f,0.f,.5f),glm::vec3((float)frameSize,0.f,.5f),glm::vec3(0.f,(float)frameSize,.5f)};
+  float const largeOneOverW[3] = {1.f,.5f,.25f};
+  AttributePlanes planes;
+  runAttributeSetupStage(program,large,largeVertices,largeOneOverW,0,0,planes);
+
+  BENCHMARK("interpolateAttributePlanes x1024"){
+    InFragment inFragment;
+    float sum = 0.f;
+    for(uint32_t i=0;i<1024;++i){
+      runAttributePlaneStage(planes,large,(int)(i%32),(int)(i/32),inFragment);
+      sum += inFragment.attributes[3].v4.x;
+    }
+    return sum;
+  };
+}
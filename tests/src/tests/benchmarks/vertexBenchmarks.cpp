@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#define __FILENAME__ "vertexBenchmarks"
+#include <tests/testCommon.hpp>
+
+#include <studentSolution/gpu.hpp>
+
+#include <utility>
+
+using namespace tests;
+
+namespace{
+
+uint32_t const nofVertices = 1024;
+
+OutVertex createOutVertex(glm::vec4 const&position){
+  OutVertex out;
+  out.gl_Position = position;
+  for(uint32_t i=0;i<maxAttribs;++i)
+    out.attributes[i].v4 = position*(float)(i+1);
+  return out;
+}
+
+}
+
+SCENARIO(TEST_NAME,"[.][benchmark][vertex]"){
+  std::vector<uint32_t>data(4*nofVertices);
+  for(size_t i=0;i<data.size();++i)data[i] = (uint32_t)i;
+
+  GPUMemory mem;
+  mem.buffers[0] = vectorToBuffer(data);
+
+  std::pair<char const*,AttribType>const types[] = {
+    {"FLOAT",AttribType::FLOAT},{"VEC2" ,AttribType::VEC2 },{"VEC3" ,AttribType::VEC3 },{"VEC4" ,AttribType::VEC4 },
+    {"UINT" ,AttribType::UINT },{"UVEC2",AttribType::UVEC2},{"UVEC3",AttribType::UVEC3},{"UVEC4",AttribType::UVEC4},
+  };
+
+  for(auto const&[name,type]:types){
+    mem.vertexArrays[0] = VertexArray();
+    mem.vertexArrays[0].vertexAttrib[0].bufferID = 0;
+    mem.vertexArrays[0].vertexAttrib[0].stride   = 4*sizeof(uint32_t);
+    mem.vertexArrays[0].vertexAttrib[0].type     = type;
+
+    BENCHMARK(std::string("vertexAssemblyUnit ")+name+" x"+std::to_string(nofVertices)){
+      InVertex inVertex;
+      uint32_t sum = 0;
+      for(uint32_t i=0;i<nofVertices;++i){
+        inVertex.gl_VertexID = i;
+        runVertexAssemblyStage(mem,inVertex);
+        sum += inVertex.attributes[0].u1;
+      }
+      return sum;
+    };
+  }
+
+  Program program;
+  for(uint32_t i=0;i<4;++i)program.vs2fs[i] = AttribType::VEC4;
+
+  // near plane is z = -w, vertices are behind it if z < -w
+  OutVertex const front [3] = {createOutVertex(glm::vec4(-1.f,-1.f,0.f,1.f)),createOutVertex(glm::vec4(1.f,-1.f,0.f,1.f)),createOutVertex(glm::vec4(0.f,1.f, 0.f,1.f))};
+  OutVertex const oneOut[3] = {createOutVertex(glm::vec4(-1.f,-1.f,0.f,1.f)),createOutVertex(glm::vec4(1.f,-1.f,0.f,1.f)),createOutVertex(glm::vec4(0.f,1.f,-2.f,1.f))};
+  OutVertex const twoOut[3] = {createOutVertex(glm::vec4(-1.f,-1.f,0.f,1.f)),createOutVertex(glm::vec4(1.f,-1.f,-2.f,1.f)),createOutVertex(glm::vec4(0.f,1.f,-2.f,1.f))};
+  OutVertex const allOut[3] = {createOutVertex(glm::vec4(-1.f,-1.f,-2.f,1.f)),createOutVertex(glm::vec4(1.f,-1.f,-2.f,1.f)),createOutVertex(glm::vec4(0.f,1.f,-2.f,1.f))};
+
+  std::pair<char const*,OutVertex const*>const triangles[] = {
+    {"in front of near plane",front},{"one vertex behind",oneOut},{"two vertices behind",twoOut},{"behind near plane",allOut},
+  };
+
+  for(auto const&[name,triangle]:triangles){
+    BENCHMARK(std::string("clippingSutherlandHodgman ")+name){
+      OutVertex clipped[2][3];
+      return runClippingStage(program,triangle,clipped);
+    };
+  }
+}
@@ -11,7 +11,7 @@ using namespace tests;
 void bindFramebufferTest(){
   MEMCB(100,100);
   mem.framebuffers[0] = Framebuffer{};
-  pushBindFramebufferCommand(cb,3);
+  REQUIRE(pushBindFramebufferCommand(cb,3));
 
   if(memCb->runAndTest(1,true))return;
   
@@ -51,9 +51,9 @@ void bindFramebufferTest(){
 void multipleBindFramebufferTest(){
   MEMCB(100,100);
   mem.framebuffers[0] = Framebuffer{};
-  pushBindFramebufferCommand(cb,3);
-  pushBindFramebufferCommand(cb,8);
-  pushBindFramebufferCommand(cb,4);
+  REQUIRE(pushBindFramebufferCommand(cb,3));
+  REQUIRE(pushBindFramebufferCommand(cb,8));
+  REQUIRE(pushBindFramebufferCommand(cb,4));
 
   if(memCb->runAndTest())return;
   
@@ -11,7 +11,7 @@ using namespace tests;
 void bindProgramTest(){
   MEMCB(100,100);
   mem.framebuffers[0] = Framebuffer{};
-  pushBindProgramCommand(cb,3);
+  REQUIRE(pushBindProgramCommand(cb,3));
 
   if(memCb->runAndTest())return;
   
@@ -35,9 +35,9 @@ void bindProgramTest(){
 void multipleBindProgramTest(){
   MEMCB(100,100);
   mem.framebuffers[0] = Framebuffer{};
-  pushBindProgramCommand(cb,3);
-  pushBindProgramCommand(cb,2);
-  pushBindProgramCommand(cb,8);
+  REQUIRE(pushBindProgramCommand(cb,3));
+  REQUIRE(pushBindProgramCommand(cb,2));
+  REQUIRE(pushBindProgramCommand(cb,8));
 
   if(memCb->runAndTest())return;
   
@@ -11,7 +11,7 @@ using namespace tests;
 void bindVertexArrayTest(){
   MEMCB(100,100);
   mem.framebuffers[0] = Framebuffer{};
-  pushBindVertexArrayCommand(cb,3);
+  REQUIRE(pushBindVertexArrayCommand(cb,3));
 
   if(memCb->runAndTest())return;
   
@@ -36,9 +36,9 @@ void multipleBindVertexArrayTest(){
   MEMCB(100,100);
   mem.framebuffers[0] = Framebuffer{};
   uint32_t correct = 10;
-  pushBindVertexArrayCommand(cb,3);
-  pushBindVertexArrayCommand(cb,2);
-  pushBindVertexArrayCommand(cb,correct);
+  REQUIRE(pushBindVertexArrayCommand(cb,3));
+  REQUIRE(pushBindVertexArrayCommand(cb,2));
+  REQUIRE(pushBindVertexArrayCommand(cb,correct));
 
   if(memCb->runAndTest())return;
   
@@ -12,7 +12,7 @@ using namespace tests;
 void clearColorTest(){
   MEMCB(20,20);
 
-  pushClearColorCommand(cb,glm::vec4(1,1,0,1));
+  REQUIRE(pushClearColorCommand(cb,glm::vec4(1,1,0,1)));
 
   if(memCb->runAndTest())return;
 
@@ -75,7 +75,7 @@ void clearColorTest(){
 void clearDepthTest(){
   MEMCB(20,20);
 
-  pushClearDepthCommand(cb,10e9f);
+  REQUIRE(pushClearDepthCommand(cb,10e9f));
 
   if(memCb->runAndTest())return;
   
@@ -94,7 +94,7 @@ void clearDepthTest(){
 void clearStencilTest(){
   MEMCB(20,20);
 
-  pushClearStencilCommand(cb,17);
+  REQUIRE(pushClearStencilCommand(cb,17));
 
   if(memCb->runAndTest())return;
   
@@ -113,14 +113,14 @@ void clearStencilTest(){
 void multipleClearTest(){
   MEMCB(20,20);
 
-  pushClearColorCommand(cb,glm::vec4(1,1,1,1));
-  pushClearColorCommand(cb,glm::vec4(0,1,1,1));
-  pushClearDepthCommand(cb,2.f);
-  pushClearStencilCommand(cb,3);
-  pushClearColorCommand(cb,glm::vec4(0,0,0,1));
-  pushClearColorCommand(cb,glm::vec4(1,0,1,1));
-  pushClearDepthCommand(cb,10e7f);
-  pushClearStencilCommand(cb,12);
+  REQUIRE(pushClearColorCommand(cb,glm::vec4(1,1,1,1)));
+  REQUIRE(pushClearColorCommand(cb,glm::vec4(0,1,1,1)));
+  REQUIRE(pushClearDepthCommand(cb,2.f));
+  REQUIRE(pushClearStencilCommand(cb,3));
+  REQUIRE(pushClearColorCommand(cb,glm::vec4(0,0,0,1)));
+  REQUIRE(pushClearColorCommand(cb,glm::vec4(1,0,1,1)));
+  REQUIRE(pushClearDepthCommand(cb,10e7f));
+  REQUIRE(pushClearStencilCommand(cb,12));
 
   if(memCb->runAndTest())return;
 
@@ -152,7 +152,7 @@ void clearColorEmptyColor(){
 
   mem.framebuffers[0].color = Image{};
 
-  pushClearColorCommand(cb,glm::vec4(1,0,1,1));
+  REQUIRE(pushClearColorCommand(cb,glm::vec4(1,0,1,1)));
 
   if(memCb->runAndTest())return;
 
@@ -174,7 +174,7 @@ void clearDepthEmptyDepth(){
 
   mem.framebuffers[0].color = Image{};
 
-  pushClearDepthCommand(cb,10e7f);
+  REQUIRE(pushClearDepthCommand(cb,10e7f));
 
   if(memCb->runAndTest())return;
 
@@ -196,7 +196,7 @@ void clearStencilEmptyStencil(){
 
   mem.framebuffers[0].color = Image{};
 
-  pushClearStencilCommand(cb,33);
+  REQUIRE(pushClearStencilCommand(cb,33));
 
   if(memCb->runAndTest())return;
 
@@ -27,10 +27,10 @@ SCENARIO(TEST_NAME){
 
   mem.framebuffers[1] = secondFramebuffer.frame;
 
-  pushBindFramebufferCommand(cb,1);
-  pushClearColorCommand(cb,glm::vec4(0.f,0.f,1.f,1.f));
-  pushBindFramebufferCommand(cb,0);
-  pushClearColorCommand(cb,glm::vec4(1.f,0.f,0.f,1.f));
+  REQUIRE(pushBindFramebufferCommand(cb,1));
+  REQUIRE(pushClearColorCommand(cb,glm::vec4(0.f,0.f,1.f,1.f)));
+  REQUIRE(pushBindFramebufferCommand(cb,0));
+  REQUIRE(pushClearColorCommand(cb,glm::vec4(1.f,0.f,0.f,1.f)));
 
   if(memCb->runAndTest())return;
 
@@ -0,0 +1,201 @@
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "commandStream"
+#include <tests/testCommon.hpp>
+
+#include <tests/draw_raster/util_raster_backends.hpp>
+
+#include <studentSolution/gpu.hpp>
+#include <studentSolution/commandStream.hpp>
+
+#include <iostream>
+#include <memory>
+
+using namespace tests;
+
+namespace{
+
+std::vector<uint32_t> trace;
+
+void traceUser(void*data){
+  trace.push_back(1000000u+(uint32_t)(size_t)data);
+}
+
+void traceVertex(OutVertex&out,InVertex const&in,ShaderInterface const&si){
+  trace.push_back(si.gl_DrawID);
+  float const x = -.9f + .05f*(float)(si.gl_DrawID%30);
+  out.gl_Position = glm::vec4(x + (in.gl_VertexID==1 ? .3f : 0.f),-.5f + (in.gl_VertexID==2 ? .9f : 0.f),.5f,1.f);
+}
+
+void traceFragment(OutFragment&out,InFragment const&,ShaderInterface const&){
+  out.gl_FragColor = glm::vec4(.5f,.25f,.75f,1.f);
+}
+
+/**
+ * @brief Records the same commands into a command buffer or a command stream.
+ */
+template<typename CB>
+void record(CB&cb,CommandBuffer&sub,uint32_t nofDraws){
+  REQUIRE(pushClearColorCommand  (cb,glm::vec4(.1f,.2f,.3f,1.f)));
+  REQUIRE(pushClearDepthCommand  (cb,1.f));
+  REQUIRE(pushBindProgramCommand (cb,0));
+  REQUIRE(pushUserCommand        (cb,traceUser,(void*)1));
+  REQUIRE(pushSubCommand         (cb,&sub));
+  for(uint32_t i=0;i<nofDraws;++i){
+    if(i%7==3)REQUIRE(pushSetDrawIdCommand(cb,100+i));
+    REQUIRE(pushDrawCommand(cb,3));
+  }
+  REQUIRE(pushUserCommand        (cb,traceUser,(void*)2));
+}
+
+struct Result{
+  std::vector<uint32_t>trace;
+  AllocatedFramebuffer frame;
+};
+
+Result runStream(CommandStream const&cs){
+  Result r;
+  r.frame = createFramebuffer(41,23);
+  GPUMemory mem;
+  mem.framebuffers[0] = r.frame.frame;
+  mem.programs[0].vertexShader   = traceVertex  ;
+  mem.programs[0].fragmentShader = traceFragment;
+  trace.clear();
+  student_GPU_run(mem,cs);
+  r.trace = trace;
+  return r;
+}
+
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("growable command stream");
+
+  CommandBuffer sub;
+  REQUIRE(pushBlockWritesCommand(sub,false,false,true));
+  REQUIRE(pushUserCommand       (sub,traceUser,(void*)3));
+
+  // reference - the same commands in a fixed-size command buffer
+  auto cb = std::make_unique<CommandBuffer>();
+  record(*cb,sub,1000);
+  Result expected;
+  expected.frame = createFramebuffer(41,23);
+  {
+    GPUMemory mem;
+    mem.framebuffers[0] = expected.frame.frame;
+    mem.programs[0].vertexShader   = traceVertex  ;
+    mem.programs[0].fragmentShader = traceFragment;
+    trace.clear();
+    student_GPU_run(mem,*cb);
+    expected.trace = trace;
+  }
+
+  CommandStream cs;
+  record(cs,sub,1000);
+  auto const result = runStream(cs);
+
+  // replay after reset must not allocate and must give the same result
+  auto const allocated = cs.getNofAllocatedBytes();
+  cs.reset();
+  record(cs,sub,1000);
+  auto const replayed = runStream(cs);
+  auto const replayedAgain = runStream(cs);
+
+  bool const sameResult   = result.trace == expected.trace && sameFramebuffers(result.frame,expected.frame);
+  bool const sameReplay   = replayed.trace == expected.trace && replayedAgain.trace == expected.trace && sameFramebuffers(replayed.frame,expected.frame);
+  bool const noAllocation = allocated == cs.getNofAllocatedBytes();
+  bool const compact      = cs.getNofBytes() < cb->nofCommands*sizeof(Command)/2;
+
+  if(sameResult && sameReplay && noAllocation && compact)return;
+
+  std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test porovnává spuštění příkazů uložených v CommandStream
+  se spuštěním stejných příkazů uložených v CommandBuffer.
+  Volání shaderů a uživatelských příkazů i výsledný obraz musí být stejné,
+  i po resetu a opakovaném spuštění streamu.
+  Stejný výsledek: )." << sameResult << R".(
+  Stejný výsledek po resetu: )." << sameReplay << R".(
+  Reset neuvolnil paměť: )." << noAllocation << R".(
+  Kompaktní záznam: )." << compact << R".( ()." << cs.getNofBytes() << R".( B))." << std::endl;
+
+  REQUIRE(false);
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("command stream with more commands than command buffer");
+
+  CommandBuffer sub;
+  CommandStream nested;
+  REQUIRE(pushUserCommand(nested,traceUser,(void*)4));
+
+  uint32_t const nofDraws = CommandBuffer::maxCommands + 2500;
+  CommandStream cs;
+  record(cs,sub,nofDraws);
+  REQUIRE(pushSubCommand(cs,&nested));
+  REQUIRE(pushSubCommand(cs,(CommandStream const*)nullptr));
+
+  auto const result = runStream(cs);
+
+  // expected trace - the vertex shader runs 3 times per draw
+  std::vector<uint32_t>expected = {1000001};
+  uint32_t drawID = 0;
+  for(uint32_t i=0;i<nofDraws;++i){
+    if(i%7==3)drawID = 100+i;
+    expected.insert(expected.end(),{drawID,drawID,drawID});
+    drawID++;
+  }
+  expected.push_back(1000002);
+  expected.push_back(1000004);
+
+  bool const allRecorded = cs.getNofCommands() == 5+nofDraws+nofDraws/7+(nofDraws%7>3)+1+2;
+  bool const sameTrace   = result.trace == expected;
+
+  if(allRecorded && sameTrace)return;
+
+  std::cerr << R".(
+  TEST SELHAL!
+
+  CommandStream nesmí být omezen počtem příkazů CommandBuffer::maxCommands.
+  Podstreamy se musí vykonat stejně jako sub command buffery.
+  Všechny příkazy zaznamenány: )." << allRecorded << R".(
+  Správné pořadí volání: )." << sameTrace << std::endl;
+
+  REQUIRE(false);
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("capacity checks of command buffer and command stream");
+
+  // command buffer has fixed size, push helpers must not write out of bounds
+  auto cb = std::make_unique<CommandBuffer>();
+  bool allInserted = true;
+  for(uint32_t i=0;i<CommandBuffer::maxCommands;++i)
+    allInserted &= pushDrawCommand(*cb,3);
+  bool const overflowRejected =
+    !pushDrawCommand          (*cb,3)     &&
+    !pushClearColorCommand    (*cb)       &&
+    !pushSetStencilCommand    (*cb,StencilSettings{}) &&
+    !pushUserCommand          (*cb)       &&
+    cb->nofCommands == CommandBuffer::maxCommands;
+
+  // command stream with capacity limit
+  CommandStream cs(256);
+  uint32_t nofInserted = 0;
+  while(pushDrawCommand(cs,3) && nofInserted < 1000)++nofInserted;
+  bool const limitRespected = nofInserted > 0 && nofInserted < 1000 && cs.getNofBytes() <= 256 && cs.getNofCommands() == nofInserted;
+
+  if(allInserted && overflowRejected && limitRespected)return;
+
+  std::cerr << R".(
+  TEST SELHAL!
+
+  Funkce push*Command nesmí zapisovat mimo CommandBuffer, pokud je plný,
+  a musí vrátit false. CommandStream s omezenou kapacitou ji nesmí překročit.
+  Vloženo maxCommands příkazů: )." << allInserted << R".(
+  Přetečení odmítnuto: )." << overflowRejected << R".(
+  Limit streamu dodržen: )." << limitRespected << std::endl;
+
+  REQUIRE(false);
+}
@@ -0,0 +1,138 @@
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "commandTrace"
+#include <tests/testCommon.hpp>
+
+#include <studentSolution/gpu.hpp>
+#include <studentSolution/gpuSettings.hpp>
+#include <studentSolution/commandTrace.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace tests;
+
+namespace{
+
+void emptyUser(void*){}
+
+void vertex(OutVertex&out,InVertex const&in,ShaderInterface const&si){
+  float const x = -.9f + .2f*(float)(si.gl_DrawID%8);
+  out.gl_Position = glm::vec4(x + (in.gl_VertexID%3==1 ? 1.f : 0.f),-.8f + (in.gl_VertexID%3==2 ? 1.5f : 0.f),.5f,1.f);
+}
+
+void fragment(OutFragment&out,InFragment const&,ShaderInterface const&){
+  out.gl_FragColor = glm::vec4(1.f);
+}
+
+bool isInside(TraceSpan const&inner,TraceSpan const&outer){
+  return inner.startTime >= outer.startTime && inner.startTime + inner.duration <= outer.startTime + outer.duration;
+}
+
+std::vector<TraceSpan>findSpans(std::vector<TraceSpan>const&spans,char const*name){
+  std::vector<TraceSpan>result;
+  for(auto const&span:spans)
+    if(std::strcmp(span.name,name) == 0)result.push_back(span);
+  return result;
+}
+
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("timeline of executed commands");
+
+  auto const fileName = (std::filesystem::temp_directory_path() / "izgCommandTrace.json").string();
+
+  GPUSettings serial;
+  GPUSettings tiled;
+  tiled.nofThreads = 3 ;
+  tiled.tileSize   = 16;
+
+  for(auto const&settings:{serial,tiled}){
+    auto frame = createFramebuffer(67,45);
+    GPUMemory mem;
+    mem.framebuffers[0] = frame.frame;
+    mem.programs[0].vertexShader   = vertex  ;
+    mem.programs[0].fragmentShader = fragment;
+
+    CommandBuffer sub;
+    REQUIRE(pushDrawCommand(sub,3));
+    REQUIRE(pushDrawCommand(sub,6));
+
+    CommandBuffer cb;
+    REQUIRE(pushClearColorCommand (cb,glm::vec4(.1f)));
+    REQUIRE(pushClearDepthCommand (cb,1.f));
+    REQUIRE(pushBindProgramCommand(cb,0));
+    REQUIRE(pushDrawCommand       (cb,3));
+    REQUIRE(pushSetDrawIdCommand  (cb,5));
+    REQUIRE(pushSubCommand        (cb,&sub));
+    REQUIRE(pushUserCommand       (cb,emptyUser));
+    REQUIRE(pushDrawCommand       (cb,3));
+
+    auto const oldSettings = getGPUSettings();
+    getGPUSettings() = settings;
+    startCommandTrace(fileName,2);
+    student_GPU_run(mem,cb);
+    auto const spans = getTraceSpans();
+    student_GPU_run(mem,cb);
+    bool const stopped = !isCommandTraceActive();
+    getGPUSettings() = oldSettings;
+
+    auto const frames = findSpans(spans,"student_GPU_run");
+    auto const draws  = findSpans(spans,"DRAW"           );
+    auto const subs   = findSpans(spans,"SUB_COMMAND"    );
+    auto const users  = findSpans(spans,"USER_COMMAND"   );
+    auto const clears = findSpans(spans,"CLEAR_COLOR"    );
+    auto const tiles  = findSpans(spans,"TILE"           );
+
+    // draws with their draw IDs and vertex counts, draws of the sub command are nested in it
+    bool const allCommands = frames.size() == 1 && draws.size() == 4 && subs.size() == 1 && users.size() == 1 &&
+                             clears.size() == 1 && findSpans(spans,"SET_DRAW_ID").size() == 1;
+    bool drawsOk = allCommands;
+    if(allCommands){
+      uint32_t const drawIDs    [4] = {0,5,6,7};
+      uint32_t const nofVertices[4] = {3,3,6,3};
+      for(size_t i=0;i<4;++i){
+        drawsOk &= std::strcmp(draws[i].argumentNames[0],"drawID") == 0 && draws[i].argumentValues[0] == drawIDs[i];
+        drawsOk &= std::strcmp(draws[i].argumentNames[1],"nofVertices") == 0 && draws[i].argumentValues[1] == nofVertices[i];
+        drawsOk &= isInside(draws[i],frames[0]) && draws[i].track == 0;
+        drawsOk &= isInside(draws[i],subs[0]) == (i == 1 || i == 2);
+      }
+      drawsOk &= isInside(users[0],frames[0]) && !isInside(users[0],subs[0]) && isInside(subs[0],frames[0]);
+    }
+
+    // tiles are rasterized by workers of the tiled back-end only
+    bool tilesOk = settings.nofThreads == 1 ? tiles.empty() : !tiles.empty();
+    for(auto const&tile:tiles)
+      tilesOk &= tile.track < settings.nofThreads && isInside(tile,frames[0]);
+
+    std::ifstream file(fileName);
+    std::stringstream content;
+    content << file.rdbuf();
+    bool const written = stopped && content.str().find("\"traceEvents\"") != std::string::npos &&
+                         content.str().find("\"name\":\"SUB_COMMAND\"") != std::string::npos;
+    file.close();
+    std::filesystem::remove(fileName);
+
+    if(allCommands && drawsOk && tilesOk && written)continue;
+
+    std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test zaznamenává časovou osu spuštěných příkazů (Chrome trace formát).
+  Každý příkaz má být úsek časové osy, kreslení s drawID a počtem vrcholů,
+  příkazy sub command bufferu mají být vnořené do jeho úseku a dlaždice
+  rasterizované pracovními vlákny mají být na stopě svého vlákna.
+  Po posledním zaznamenaném snímku se musí zapsat soubor.
+  Vlákna: )." << settings.nofThreads << R".(
+  Všechny příkazy: )." << allCommands << R".(
+  Kreslení a vnoření: )." << drawsOk << R".(
+  Dlaždice: )." << tilesOk << R".(
+  Soubor zapsán: )." << written << std::endl;
+
+    REQUIRE(false);
+  }
+}
@@ -0,0 +1,332 @@
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "compiledCommands"
+#include <tests/testCommon.hpp>
+
+#include <tests/draw_raster/util_raster_backends.hpp>
+
+#include <studentSolution/gpu.hpp>
+#include <studentSolution/gpuStatistics.hpp>
+
+#include <iostream>
+#include <memory>
+
+using namespace tests;
+
+namespace{
+
+struct Observed{
+  uint32_t drawID     ;
+  uint32_t program    ;
+  uint32_t vertexArray;
+  bool     culling    ;
+  bool     ccw        ;
+  bool     blockColor ;
+  bool     stencil    ;
+  bool operator==(Observed const&o)const{
+    return drawID == o.drawID && program == o.program && vertexArray == o.vertexArray && culling == o.culling &&
+           ccw == o.ccw && blockColor == o.blockColor && stencil == o.stencil;
+  }
+};
+
+std::vector<Observed> trace;
+
+Observed observe(GPUMemory const&mem,uint32_t drawID){
+  return Observed{drawID,mem.activatedProgram,mem.activatedVertexArray,mem.backfaceCulling.enabled,
+    mem.backfaceCulling.frontFaceIsCounterClockWise,mem.blockWrites.color,mem.stencilSettings.enabled};
+}
+
+void observeUser(void*data){
+  trace.push_back(observe(*(GPUMemory const*)data,~0u));
+}
+
+// user command may change the state behind the back of the compiler
+void resetStateUser(void*data){
+  auto&mem = *(GPUMemory*)data;
+  mem.activatedProgram        = 1;
+  mem.backfaceCulling.enabled = false;
+  trace.push_back(observe(mem,~1u));
+}
+
+void vertex(OutVertex&out,InVertex const&in,ShaderInterface const&si){
+  float const x = -.8f + .1f*(float)(si.gl_DrawID%16);
+  out.gl_Position = glm::vec4(x + (in.gl_VertexID%3==1 ? .6f : 0.f),-.7f + (in.gl_VertexID%3==2 ? 1.2f : 0.f),.3f + .02f*(float)(si.gl_DrawID%20),1.f);
+  out.attributes[0].v4 = glm::vec4((float)(si.gl_DrawID%5)/5.f,.5f,1.f,.5f);
+}
+
+void fragment(OutFragment&out,InFragment const&in,ShaderInterface const&){
+  out.gl_FragColor = in.attributes[0].v4;
+}
+
+void invisible(OutVertex&out,InVertex const&,ShaderInterface const&){
+  out.gl_Position = glm::vec4(-2.f,-2.f,0.f,1.f);
+}
+
+struct Scene{
+  CommandBuffer model;
+  CommandBuffer shadow;
+  CommandBuffer frame;
+  GPUMemory*pMem = nullptr;
+
+  void record(GPUMemory&mem){
+    pMem = &mem;
+    model.nofCommands = 0;
+    REQUIRE(pushBindVertexArrayCommand   (model,0));
+    REQUIRE(pushSetBackfaceCullingCommand(model,true));
+    REQUIRE(pushSetFrontFaceCommand      (model,true));
+    REQUIRE(pushDrawCommand              (model,3));
+    REQUIRE(pushBindVertexArrayCommand   (model,0));
+    REQUIRE(pushSetBackfaceCullingCommand(model,true));
+    REQUIRE(pushDrawCommand              (model,3));
+    REQUIRE(pushUserCommand              (model,observeUser,&mem));
+
+    shadow.nofCommands = 0;
+    REQUIRE(pushBindFramebufferCommand(shadow,1));
+    REQUIRE(pushClearDepthCommand     (shadow,1.f));
+    REQUIRE(pushClearColorCommand     (shadow,glm::vec4(.3f)));
+    REQUIRE(pushClearStencilCommand   (shadow,7));
+    REQUIRE(pushBindProgramCommand    (shadow,0));
+    REQUIRE(pushSubCommand            (shadow,&model));
+    REQUIRE(pushBindFramebufferCommand(shadow,0));
+
+    frame.nofCommands = 0;
+    REQUIRE(pushClearColorCommand     (frame,glm::vec4(1.f)));
+    REQUIRE(pushClearColorCommand     (frame,glm::vec4(.1f,.2f,.3f,1.f)));
+    REQUIRE(pushClearDepthCommand     (frame,1.f));
+    REQUIRE(pushBindProgramCommand    (frame,0));
+    REQUIRE(pushBindProgramCommand    (frame,1));
+    REQUIRE(pushBindProgramCommand    (frame,0));
+    REQUIRE(pushSubCommand            (frame,&shadow));
+    REQUIRE(pushSetDrawIdCommand      (frame,0));
+    REQUIRE(pushSetDrawIdCommand      (frame,7));
+    REQUIRE(pushSubCommand            (frame,&model));
+    REQUIRE(pushBlockWritesCommand    (frame,true,false,false));
+    REQUIRE(pushBlockWritesCommand    (frame,false,false,false));
+    REQUIRE(pushSetBackfaceCullingCommand(frame,false));
+    REQUIRE(pushUserCommand           (frame,resetStateUser,&mem));
+    REQUIRE(pushBindProgramCommand    (frame,0));
+    REQUIRE(pushSetBackfaceCullingCommand(frame,true));
+    REQUIRE(pushSubCommand            (frame,&model));
+    REQUIRE(pushSubCommand            (frame,(CommandBuffer*)nullptr));
+    REQUIRE(pushClearStencilCommand   (frame,3));
+    REQUIRE(pushClearDepthCommand     (frame,.5f));
+    REQUIRE(pushSubCommand            (frame,&model));
+    REQUIRE(pushUserCommand           (frame,observeUser,&mem));
+  }
+};
+
+struct Result{
+  std::vector<Observed>trace;
+  AllocatedFramebuffer frames[2];
+  Observed final;
+};
+
+Result render(Scene&scene,bool compiled,bool flipped,uint32_t nofRuns){
+  Result r;
+  r.frames[0] = createFramebuffer(37,29,flipped);
+  r.frames[1] = createFramebuffer(23,19,!flipped);
+  GPUMemory mem;
+  mem.framebuffers[0] = r.frames[0].frame;
+  mem.framebuffers[1] = r.frames[1].frame;
+  mem.programs[0].vertexShader   = vertex   ;
+  mem.programs[0].fragmentShader = fragment ;
+  mem.programs[0].vs2fs[0]       = AttribType::VEC4;
+  mem.programs[1].vertexShader   = invisible;
+  mem.programs[1].fragmentShader = fragment ;
+  scene.record(mem);
+
+  auto const oldSettings = getGPUSettings();
+  getGPUSettings().compiledCommandBuffers = compiled;
+  clearCommandPlanCache();
+  trace.clear();
+  for(uint32_t i=0;i<nofRuns;++i)
+    student_GPU_run(mem,scene.frame);
+  getGPUSettings() = oldSettings;
+
+  r.trace = trace;
+  r.final = observe(mem,mem.gl_DrawID);
+  return r;
+}
+
+bool sameResults(Result const&a,Result const&b){
+  return a.trace == b.trace && a.final == b.final &&
+         sameFramebuffers(a.frames[0],b.frames[0]) && sameFramebuffers(a.frames[1],b.frames[1]);
+}
+
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("compiled command buffers");
+
+  auto scene = std::make_unique<Scene>();
+
+  for(auto flipped:{false,true}){
+    auto const expected = render(*scene,false,flipped,2);
+
+    resetCommandStatistics();
+    auto const result = render(*scene,true,flipped,2);
+    auto const&statistics = getCommandStatistics();
+    bool const cached  = statistics.planCompilations == 1 && statistics.planCacheHits == 1;
+    bool const reduced = statistics.removedCommands > 0 && statistics.foldedClears == 3;
+
+    if(sameResults(expected,result) && cached && reduced)continue;
+
+    std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test porovnává spuštění stromu command bufferů (sub command buffery,
+  nadbytečné změny stavu, uživatelské příkazy měnící stav, více čištění
+  za sebou) s jeho předkompilovaným plochým plánem.
+  Stav GPU viděný uživatelskými příkazy, výsledný stav i obraz musí být
+  stejné. Plán se má zkompilovat jednou a podruhé použít z cache.
+  Otočený framebuffer: )." << flipped << R".(
+  Stejný výsledek: )." << sameResults(expected,result) << R".(
+  Plán použit z cache: )." << cached << R".(
+  Odstraněné příkazy: )." << statistics.removedCommands << R".(
+  Sloučená čištění: )." << statistics.foldedClears << std::endl;
+
+    REQUIRE(false);
+  }
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("compiled command buffers are recompiled after modification");
+
+  auto scene = std::make_unique<Scene>();
+
+  auto renderModified = [&](bool compiled){
+    Result r;
+    r.frames[0] = createFramebuffer(37,29);
+    r.frames[1] = createFramebuffer(23,19);
+    GPUMemory mem;
+    mem.framebuffers[0] = r.frames[0].frame;
+    mem.framebuffers[1] = r.frames[1].frame;
+    mem.programs[0].vertexShader   = vertex  ;
+    mem.programs[0].fragmentShader = fragment;
+    mem.programs[0].vs2fs[0]       = AttribType::VEC4;
+    scene->record(mem);
+
+    auto const oldSettings = getGPUSettings();
+    getGPUSettings().compiledCommandBuffers = compiled;
+    clearCommandPlanCache();
+    trace.clear();
+    student_GPU_run(mem,scene->frame);
+
+    // modify a nested buffer - the cached plan must not be used anymore
+    REQUIRE(pushSetFrontFaceCommand(scene->model,false));
+    REQUIRE(pushDrawCommand        (scene->model,3));
+    scene->shadow.commands[2].data.clearColorCommand.value = glm::vec4(.9f,.1f,.4f,1.f);
+    student_GPU_run(mem,scene->frame);
+    getGPUSettings() = oldSettings;
+
+    r.trace = trace;
+    r.final = observe(mem,mem.gl_DrawID);
+    return r;
+  };
+
+  auto const expected = renderModified(false);
+  resetCommandStatistics();
+  auto const result   = renderModified(true);
+  bool const recompiled = getCommandStatistics().planCompilations == 2;
+
+  if(sameResults(expected,result) && recompiled)return;
+
+  std::cerr << R".(
+  TEST SELHAL!
+
+  Po změně kteréhokoliv command bufferu ve stromu se musí plán zkompilovat
+  znovu a výsledek musí odpovídat změněným příkazům.
+  Stejný výsledek: )." << sameResults(expected,result) << R".(
+  Plán znovu zkompilován: )." << recompiled << std::endl;
+
+  REQUIRE(false);
+}
+
+namespace{
+
+//! Command buffers rewritten by a user command while they are being executed
+struct RewrittenScene{
+  CommandBuffer model;
+  CommandBuffer frame;
+  bool rewritten = false;
+};
+
+RewrittenScene*rewrittenScene = nullptr;
+
+void rewriteUser(void*data){
+  auto&scene = *rewrittenScene;
+  trace.push_back(observe(*(GPUMemory const*)data,~2u));
+  if(scene.rewritten)return;
+  scene.rewritten = true;
+
+  // the rest of the executed buffer and of its parent changes
+  scene.model.nofCommands = 3;
+  REQUIRE(pushSetFrontFaceCommand(scene.model,false));
+  REQUIRE(pushDrawCommand        (scene.model,3));
+  REQUIRE(pushUserCommand        (scene.model,observeUser,data));
+  scene.frame.commands[4].data.setBackfaceCullingCommand.enabled = true;
+}
+
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("compiled command buffers rewritten by a user command");
+
+  auto scene = std::make_unique<RewrittenScene>();
+  rewrittenScene = scene.get();
+
+  auto renderRewritten = [&](bool compiled){
+    Result r;
+    r.frames[0] = createFramebuffer(37,29);
+    r.frames[1] = createFramebuffer(23,19);
+    GPUMemory mem;
+    mem.framebuffers[0] = r.frames[0].frame;
+    mem.framebuffers[1] = r.frames[1].frame;
+    mem.programs[0].vertexShader   = vertex  ;
+    mem.programs[0].fragmentShader = fragment;
+    mem.programs[0].vs2fs[0]       = AttribType::VEC4;
+
+    scene->rewritten = false;
+    scene->model.nofCommands = 0;
+    REQUIRE(pushBindVertexArrayCommand(scene->model,0));
+    REQUIRE(pushDrawCommand           (scene->model,3));
+    REQUIRE(pushUserCommand           (scene->model,rewriteUser,&mem));
+    REQUIRE(pushDrawCommand           (scene->model,3));
+
+    scene->frame.nofCommands = 0;
+    REQUIRE(pushClearColorCommand     (scene->frame,glm::vec4(.1f,.2f,.3f,1.f)));
+    REQUIRE(pushClearDepthCommand     (scene->frame,1.f));
+    REQUIRE(pushBindProgramCommand    (scene->frame,0));
+    REQUIRE(pushSubCommand            (scene->frame,&scene->model));
+    REQUIRE(pushSetBackfaceCullingCommand(scene->frame,false));
+    REQUIRE(pushSubCommand            (scene->frame,&scene->model));
+    REQUIRE(pushUserCommand           (scene->frame,observeUser,&mem));
+
+    auto const oldSettings = getGPUSettings();
+    getGPUSettings().compiledCommandBuffers = compiled;
+    clearCommandPlanCache();
+    trace.clear();
+    for(uint32_t i=0;i<2;++i)
+      student_GPU_run(mem,scene->frame);
+    getGPUSettings() = oldSettings;
+
+    r.trace = trace;
+    r.final = observe(mem,mem.gl_DrawID);
+    return r;
+  };
+
+  auto const expected = renderRewritten(false);
+  auto const result   = renderRewritten(true);
+
+  if(sameResults(expected,result))return;
+
+  std::cerr << R".(
+  TEST SELHAL!
+
+  Uživatelský příkaz přepíše během běhu command buffery, které plán vložil
+  do sebe (zbytek právě prováděného sub command bufferu i jeho rodiče).
+  Zbytek běhu musí provést nové příkazy, stejně jako interpretace stromu.
+  Stejný výsledek: )." << sameResults(expected,result) << std::endl;
+
+  REQUIRE(false);
+}
@@ -13,8 +13,8 @@ void oneEqueue(){
   MEMCB(100,100);
   mem.framebuffers[0] = Framebuffer{};
 
-  pushDrawCommand(cb,3);
-  pushDrawCommand(cb,3);
+  REQUIRE(pushDrawCommand(cb,3));
+  REQUIRE(pushDrawCommand(cb,3));
 
   if(memCb->runAndTest())return;
 
@@ -40,9 +40,9 @@ void multipleEqueue(){
   MEMCB(100,100);
   mem.framebuffers[0] = Framebuffer{};
 
-  pushDrawCommand(cb,3);
-  pushDrawCommand(cb,3);
-  pushDrawCommand(cb,3);
+  REQUIRE(pushDrawCommand(cb,3));
+  REQUIRE(pushDrawCommand(cb,3));
+  REQUIRE(pushDrawCommand(cb,3));
 
   if(memCb->runAndTest(2))return;
 
@@ -64,12 +64,12 @@ void drawAndSetDrawId(){
   MEMCB(100,100);
   mem.framebuffers[0] = Framebuffer{};
 
-  pushDrawCommand(cb,3);
-  pushDrawCommand(cb,3);
-  pushSetDrawIdCommand(cb,30);
-  pushDrawCommand(cb,3);
-  pushDrawCommand(cb,3);
-  pushDrawCommand(cb,3);
+  REQUIRE(pushDrawCommand(cb,3));
+  REQUIRE(pushDrawCommand(cb,3));
+  REQUIRE(pushSetDrawIdCommand(cb,30));
+  REQUIRE(pushDrawCommand(cb,3));
+  REQUIRE(pushDrawCommand(cb,3));
+  REQUIRE(pushDrawCommand(cb,3));
 
   if(memCb->runAndTest())return;
 
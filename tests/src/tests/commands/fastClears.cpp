@@ -0,0 +1,231 @@
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "fastClears"
+#include <tests/testCommon.hpp>
+
+#include <tests/draw_raster/util_raster_backends.hpp>
+#include <studentSolution/gpu.hpp>
+
+#include <cstring>
+#include <iostream>
+
+using namespace tests;
+
+namespace{
+
+uint8_t const paddingByte = 0xab;
+
+struct PaddedFramebuffer{
+  std::vector<uint8_t>color  ;
+  std::vector<uint8_t>depth  ;
+  std::vector<uint8_t>stencil;
+  Framebuffer frame;
+  PaddedFramebuffer(Image::Format format,uint32_t channels,bool bgra,bool flipped){
+    frame.width     = 13;
+    frame.height    = 7;
+    frame.yReversed = flipped;
+
+    uint32_t const channelSize = format == Image::F32 ? 4 : 1;
+    auto&c = frame.color;
+    c.format        = format;
+    c.channels      = channels;
+    c.bytesPerPixel = channels*channelSize + (channels==3 ? 1 : 0); // RGB pixels have an unused byte
+    c.pitch         = frame.width*c.bytesPerPixel + 5;
+    if(bgra){
+      c.channelTypes[0] = Image::BLUE;
+      c.channelTypes[2] = Image::RED ;
+    }
+
+    auto&d = frame.depth;
+    d.channels      = 1;
+    d.format        = Image::F32;
+    d.bytesPerPixel = 4;
+    d.pitch         = frame.width*4 + 3;
+
+    auto&s = frame.stencil;
+    s.channels      = 1;
+    s.bytesPerPixel = 1;
+    s.pitch         = frame.width + 7;
+
+    color  .assign(c.pitch*frame.height,paddingByte);
+    depth  .assign(d.pitch*frame.height,paddingByte);
+    stencil.assign(s.pitch*frame.height,paddingByte);
+    c.data = color  .data();
+    d.data = depth  .data();
+    s.data = stencil.data();
+  }
+};
+
+float selectChannel(glm::vec4 const&color,Image::Channel channel){
+  switch(channel){
+    case Image::RED  :return color.r;
+    case Image::GREEN:return color.g;
+    case Image::BLUE :return color.b;
+    case Image::ALPHA:return color.a;
+  }
+  return 0.f;
+}
+
+bool isClearedCorrectly(PaddedFramebuffer const&f,glm::vec4 const&color,float depth,uint8_t stencil){
+  auto const&c = f.frame.color;
+  uint32_t const channelSize = c.format == Image::F32 ? 4 : 1;
+  for(uint32_t i=0;i<f.color.size();++i){
+    uint32_t const x     = (i%c.pitch)/c.bytesPerPixel;
+    uint32_t const byte  = (i%c.pitch)%c.bytesPerPixel;
+    bool     const isPixel = x < f.frame.width && byte < c.channels*channelSize;
+    if(!isPixel){
+      if(f.color[i] != paddingByte)return false;
+      continue;
+    }
+    float const value = selectChannel(color,c.channelTypes[byte/channelSize]);
+    if(c.format == Image::F32){
+      float stored;
+      std::memcpy(&stored,&f.color[i-byte%4],sizeof(float));
+      if(stored != value)return false;
+    }else{
+      if(f.color[i] != (uint8_t)(glm::clamp(value,0.f,1.f)*255.f+.5f))return false;
+    }
+  }
+
+  auto const&d = f.frame.depth;
+  for(uint32_t i=0;i<f.depth.size();++i){
+    bool const isPixel = (i%d.pitch) < f.frame.width*4;
+    if(!isPixel){
+      if(f.depth[i] != paddingByte)return false;
+      continue;
+    }
+    float stored;
+    std::memcpy(&stored,&f.depth[i-(i%d.pitch)%4],sizeof(float));
+    if(stored != depth)return false;
+  }
+
+  auto const&s = f.frame.stencil;
+  for(uint32_t i=0;i<f.stencil.size();++i){
+    bool const isPixel = (i%s.pitch) < f.frame.width;
+    if(f.stencil[i] != (isPixel ? stencil : paddingByte))return false;
+  }
+  return true;
+}
+
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("fast clears of padded framebuffer layouts");
+
+  glm::vec4 const color   = glm::vec4(.2f,.4f,.6f,.8f);
+  float     const depth   = .75f;
+  uint8_t   const stencil = 42;
+
+  for(auto format:{Image::U8,Image::F32})
+    for(uint32_t channels:{3u,4u})
+      for(auto bgra:{false,true})
+        for(auto flipped:{false,true})
+          for(auto deferred:{false,true}){
+            PaddedFramebuffer f(format,channels,bgra,flipped);
+            GPUMemory mem;
+            mem.framebuffers[0] = f.frame;
+
+            CommandBuffer cb;
+            REQUIRE(pushClearColorCommand  (cb,glm::vec4(1.f)));
+            REQUIRE(pushClearColorCommand  (cb,color  ));
+            REQUIRE(pushClearDepthCommand  (cb,depth  ));
+            REQUIRE(pushClearStencilCommand(cb,stencil));
+
+            auto const oldSettings = getGPUSettings();
+            getGPUSettings().deferredClears = deferred;
+            getGPUSettings().tileSize       = 4;
+            student_GPU_run(mem,cb);
+            getGPUSettings() = oldSettings;
+
+            if(isClearedCorrectly(f,color,depth,stencil))continue;
+
+            std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test zkouší rychlé čištění framebufferu, jehož řádky i pixely
+  obsahují nevyužité bajty. Kanály pixelů musí mít hodnotu čisticího příkazu,
+  nevyužité bajty se nesmí změnit.
+  Formát: )." << (format == Image::F32 ? "F32" : "U8") << R".(
+  Počet kanálů: )." << channels << R".(
+  Pořadí BGRA: )." << bgra << R".(
+  Otočený framebuffer: )." << flipped << R".(
+  Odložené čištění: )." << deferred << std::endl;
+
+            REQUIRE(false);
+          }
+}
+
+namespace{
+
+std::vector<uint8_t> colorSeenByUser;
+
+void copyColorBuffer(void*data){
+  auto const&frame = *(Framebuffer const*)data;
+  auto const begin = (uint8_t const*)frame.color.data;
+  colorSeenByUser.assign(begin,begin+frame.color.pitch*frame.height);
+}
+
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("deferred per-tile clears");
+
+  OrderDependentScene scene;
+
+  for(auto flipped:{false,true}){
+    auto const expected = scene.render(GPUSettings{},flipped);
+
+    for(uint32_t nofThreads:{1u,3u})
+      for(uint32_t tileSize:{5u,64u})
+        for(auto tiled:{false,true}){
+          GPUSettings settings;
+          settings.deferredClears     = true      ;
+          settings.nofThreads         = nofThreads;
+          settings.tileSize           = tileSize  ;
+          settings.tiledRasterization = tiled     ;
+
+          if(sameFramebuffers(expected,scene.render(settings,flipped)))continue;
+
+          std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test porovnává odložené čištění (každá dlaždice se vyčistí až při
+  prvním kreslení do ní nebo na konci) s okamžitým čištěním.
+  Výsledek musí být bit po bitu stejný.
+  Počet vláken: )." << nofThreads << R".(
+  Velikost dlaždice: )." << tileSize << R".(
+  Dlaždicový rasterizér: )." << tiled << R".(
+  Otočený framebuffer: )." << flipped << std::endl;
+
+          REQUIRE(false);
+        }
+  }
+
+  // user commands must see the cleared framebuffer even if nothing was drawn
+  auto frame = createFramebuffer(19,11);
+  GPUMemory mem;
+  mem.framebuffers[0] = frame.frame;
+
+  CommandBuffer cb;
+  REQUIRE(pushClearColorCommand(cb,glm::vec4(.5f,.25f,1.f,1.f)));
+  REQUIRE(pushUserCommand      (cb,copyColorBuffer,&mem.framebuffers[0]));
+
+  auto const oldSettings = getGPUSettings();
+  getGPUSettings().deferredClears = true;
+  student_GPU_run(mem,cb);
+  getGPUSettings() = oldSettings;
+
+  bool seenCleared = colorSeenByUser.size() == frame.colorBacking.size();
+  for(size_t i=0;seenCleared && i<colorSeenByUser.size();i+=3)
+    seenCleared = colorSeenByUser[i] == 128 && colorSeenByUser[i+1] == 64 && colorSeenByUser[i+2] == 255;
+
+  if(seenCleared)return;
+
+  std::cerr << R".(
+  TEST SELHAL!
+
+  Uživatelský příkaz musí vidět vyčištěný framebuffer, i když se do něj
+  před ním nic nekreslilo (odložené čištění se musí zapsat před ním).)." << std::endl;
+
+  REQUIRE(false);
+}
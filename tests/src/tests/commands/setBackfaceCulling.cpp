@@ -14,7 +14,7 @@ SCENARIO(TEST_NAME){
   MEMCB(100,100);
   mem.framebuffers[0] = Framebuffer{};
 
-  pushSetBackfaceCullingCommand(cb,true);
+  REQUIRE(pushSetBackfaceCullingCommand(cb,true));
 
   if(memCb->runAndTest())return;
   
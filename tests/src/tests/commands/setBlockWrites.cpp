@@ -12,7 +12,7 @@ void blockWrites(){
   MEMCB(100,100);
   mem.framebuffers[0] = Framebuffer{};
 
-  pushBlockWritesCommand(cb,true);
+  REQUIRE(pushBlockWritesCommand(cb,true));
 
   if(memCb->runAndTest())return;
   
@@ -37,10 +37,10 @@ void blockWrites(){
 void multipleBlockWrites(){
   MEMCB(100,100);
   mem.framebuffers[0] = Framebuffer{};
-  pushBlockWritesCommand(cb,true);
-  pushBlockWritesCommand(cb,false,true);
-  pushBlockWritesCommand(cb,false,false,true);
-  pushBlockWritesCommand(cb);
+  REQUIRE(pushBlockWritesCommand(cb,true));
+  REQUIRE(pushBlockWritesCommand(cb,false,true));
+  REQUIRE(pushBlockWritesCommand(cb,false,false,true));
+  REQUIRE(pushBlockWritesCommand(cb));
 
   if(memCb->runAndTest())return;
   
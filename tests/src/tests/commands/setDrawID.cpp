@@ -13,7 +13,7 @@ void setDrawId(){
   MEMCB(100,100);
   mem.framebuffers[0] = Framebuffer{};
 
-  pushSetDrawIdCommand(cb,30);
+  REQUIRE(pushSetDrawIdCommand(cb,30));
 
   if(memCb->runAndTest())return;
 
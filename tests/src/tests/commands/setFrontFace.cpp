@@ -14,7 +14,7 @@ SCENARIO(TEST_NAME){
   MEMCB(100,100);
   mem.framebuffers[0] = Framebuffer{};
 
-  pushSetFrontFaceCommand(cb,false);
+  REQUIRE(pushSetFrontFaceCommand(cb,false));
 
   if(memCb->runAndTest())return;
   
@@ -25,7 +25,7 @@ SCENARIO(TEST_NAME){
   s.frontOps.dpfail = StencilOp::DECR;
   s.frontOps.dppass = StencilOp::INCR;
 
-  pushSetStencilCommand(cb,s);
+  REQUIRE(pushSetStencilCommand(cb,s));
 
   if(memCb->runAndTest())return;
   
@@ -12,11 +12,11 @@ void subCommandTest(){
   MEMCB(100,100);
   mem.framebuffers[0] = Framebuffer{};
 
-  pushBindFramebufferCommand(cb,7);
+  REQUIRE(pushBindFramebufferCommand(cb,7));
   CommandBuffer sub;
-  pushBindVertexArrayCommand(sub,50);
-  pushSubCommand(cb,&sub);
-  pushDrawCommand(cb,3);
+  REQUIRE(pushBindVertexArrayCommand(sub,50));
+  REQUIRE(pushSubCommand(cb,&sub));
+  REQUIRE(pushDrawCommand(cb,3));
     
   if(memCb->runAndTest())return;
   
@@ -40,18 +40,18 @@ void subCommandDeepTest(){
   MEMCB(100,100);
   mem.framebuffers[0] = Framebuffer{};
 
-  pushBindFramebufferCommand(cb,7);
+  REQUIRE(pushBindFramebufferCommand(cb,7));
   struct Subs{
     CommandBuffer sub[4];
   };
   auto subs = std::make_shared<Subs>();
   //CommandBuffer sub[4];
-  pushSubCommand(cb          ,subs->sub+0);
-  pushSubCommand(subs->sub[0],subs->sub+1);
-  pushSubCommand(subs->sub[1],subs->sub+2);
-  pushSubCommand(subs->sub[2],subs->sub+3);
-  pushBindVertexArrayCommand(subs->sub[3],50);
-  pushDrawCommand(cb,3);
+  REQUIRE(pushSubCommand(cb          ,subs->sub+0));
+  REQUIRE(pushSubCommand(subs->sub[0],subs->sub+1));
+  REQUIRE(pushSubCommand(subs->sub[1],subs->sub+2));
+  REQUIRE(pushSubCommand(subs->sub[2],subs->sub+3));
+  REQUIRE(pushBindVertexArrayCommand(subs->sub[3],50));
+  REQUIRE(pushDrawCommand(cb,3));
     
   if(memCb->runAndTest())return;
   
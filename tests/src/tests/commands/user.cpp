@@ -25,7 +25,7 @@ SCENARIO(TEST_NAME){
 
   UserData uData;
   uData.mcb = memCb;
-  pushUserCommand(cb,userFce,&uData);
+  REQUIRE(pushUserCommand(cb,userFce,&uData));
 
   if(memCb->runAndTest())return;
   
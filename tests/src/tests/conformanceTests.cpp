@@ -28,10 +28,13 @@ void runConformanceTests(std::string const&model,float mse,int test,bool upTo) {
 #if 1
   Catch::Config cfg;
   auto const&tests = Catch::getAllTestCasesSorted(cfg);
-  auto nofTests = tests.size();
   std::vector<std::string>testNames;
-  for(size_t i=0;i<nofTests;++i)
-    testNames.push_back(tests[i].getTestCaseInfo().name);
+  for(auto const&t:tests){
+    //hidden test cases are microbenchmarks, they are run by runStageBenchmarks
+    if(t.getTestCaseInfo().isHidden())continue;
+    testNames.push_back(t.getTestCaseInfo().name);
+  }
+  auto nofTests = testNames.size();
 
   std::vector<char const*>argv;
   std::vector<std::string>argvs;
@@ -0,0 +1,82 @@
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "attributePlanes"
+#include <tests/testCommon.hpp>
+
+#include <studentSolution/gpu.hpp>
+
+#include <iostream>
+
+using namespace tests;
+
+SCENARIO(TEST_NAME){
+  printTestName("screen-space plane equations of attributes");
+
+  Program program;
+  program.vs2fs[0] = AttribType::FLOAT;
+  program.vs2fs[1] = AttribType::VEC3 ;
+  program.vs2fs[2] = AttribType::UVEC2;
+  program.vs2fs[3] = AttribType::VEC4 ;
+
+  glm::vec3 const vertices[3] = {glm::vec3(3.2f,1.7f,.3f),glm::vec3(61.9f,12.4f,.6f),glm::vec3(20.1f,47.3f,.9f)};
+  float     const oneOverW[3] = {1.f,.125f,.5f};
+
+  OutVertex outVertices[3];
+  for(uint32_t v=0;v<3;++v){
+    outVertices[v].attributes[0].v1 = (float)v*3.f - 1.f;
+    outVertices[v].attributes[1].v3 = glm::vec3((float)v,10.f - (float)v*7.f,.5f);
+    outVertices[v].attributes[2].u2 = glm::uvec2(v+1,7*v+3);
+    outVertices[v].attributes[3].v4 = glm::vec4(-2.f*(float)v,(float)(v*v),100.f,(float)v - .5f);
+  }
+
+  AttributePlanes planes;
+  runAttributeSetupStage(program,outVertices,vertices,oneOverW,3,1,planes);
+
+  auto same = [](glm::vec4 const&a,glm::vec4 const&b){
+    for(int c=0;c<4;++c)
+      if(!equalFloats(a[c],b[c],0.0001f*(1.f+glm::abs(b[c]))))return false;
+    return true;
+  };
+
+  bool planesOk = true;
+  bool flatOk   = true;
+  for(int y=1;y<48;y+=3)
+    for(int x=3;x<62;x+=3){
+      // perspective-correct barycentric coordinates of the pixel center (pixels inside of the triangle)
+      glm::vec2 const p = glm::vec2((float)x+.5f,(float)y+.5f);
+      auto edge = [&](glm::vec3 const&a,glm::vec3 const&b){return (b.x-a.x)*(p.y-a.y) - (b.y-a.y)*(p.x-a.x);};
+      float const area = edge(vertices[0],vertices[1]) + edge(vertices[1],vertices[2]) + edge(vertices[2],vertices[0]);
+      float l[3] = {
+        edge(vertices[1],vertices[2])/area*oneOverW[0],
+        edge(vertices[2],vertices[0])/area*oneOverW[1],
+        edge(vertices[0],vertices[1])/area*oneOverW[2],
+      };
+      if(l[0] < 0.f || l[1] < 0.f || l[2] < 0.f)continue;
+      float const s = l[0]+l[1]+l[2];
+
+      InFragment expected;
+      runAttributeInterpolationStage(program,l[0]/s,l[1]/s,l[2]/s,expected,outVertices);
+      InFragment result;
+      float const w = runAttributePlaneStage(planes,outVertices,x,y,result);
+
+      planesOk &= equalFloats(w,1.f/s,0.0001f*(1.f/s));
+      planesOk &= same(glm::vec4(result.attributes[0].v1,0.f,0.f,0.f),glm::vec4(expected.attributes[0].v1,0.f,0.f,0.f));
+      planesOk &= same(glm::vec4(result.attributes[1].v3,0.f)        ,glm::vec4(expected.attributes[1].v3,0.f)        );
+      planesOk &= same(result.attributes[3].v4,expected.attributes[3].v4);
+      flatOk   &= result.attributes[2].u2 == outVertices[0].attributes[2].u2;
+    }
+
+  if(planesOk && flatOk)return;
+
+  std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test kontroluje interpolaci atributů pomocí rovnic rovin v prostoru
+  obrazovky (atribut/w a 1/w jsou v obrazovce lineární). Výsledek se musí
+  shodovat s perspektivně korektní interpolací barycentrickými souřadnicemi
+  a celočíselné atributy se musí brát z prvního vrcholu.
+  Interpolované atributy: )." << planesOk << R".(
+  Celočíselné atributy: )." << flatOk << std::endl;
+
+  REQUIRE(false);
+}
@@ -0,0 +1,126 @@
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "depthOnlyFragments"
+#include <tests/testCommon.hpp>
+
+#include <tests/draw_raster/util_raster_backends.hpp>
+#include <studentSolution/fragmentShaderTraits.hpp>
+#include <studentSolution/gpu.hpp>
+
+#include <iostream>
+
+using namespace tests;
+
+namespace{
+
+void withoutColor        (AllocatedFramebuffer&f){f.frame.color.data = nullptr;}
+void withoutColorAndDepth(AllocatedFramebuffer&f){f.frame.color.data = nullptr;f.frame.depth.data = nullptr;}
+
+uint32_t nofShaderCalls = 0;
+
+void countingFragmentShader(OutFragment&outFragment,InFragment const&inFragment,ShaderInterface const&si){
+  nofShaderCalls++;
+  fragmentColor(outFragment,inFragment,si);
+}
+
+/**
+ * @brief This function renders the scene with counting shader into framebuffer with color buffer blocked
+ *
+ * @return depth buffer
+ */
+std::vector<float>renderBlockedColor(GPUSettings const&settings){
+  auto frame = createFramebuffer(50,40);
+
+  std::vector<glm::vec4>positions = {
+    glm::vec4(-.9f,-.9f,.2f,1.f),glm::vec4(.9f,-.8f,.6f,1.f),glm::vec4(0.f,.9f,-.4f,1.f),
+    glm::vec4(-.8f,.7f,.1f,1.f),glm::vec4(.2f,-.9f,-.5f,1.f),glm::vec4(.9f,.9f,.7f,1.f),
+  };
+  std::vector<glm::vec4>colors(positions.size(),glm::vec4(1.f));
+
+  GPUMemory mem;
+  mem.framebuffers[0] = frame.frame;
+  mem.buffers[0] = vectorToBuffer(positions);
+  mem.buffers[1] = vectorToBuffer(colors);
+  for(uint32_t a=0;a<2;++a){
+    mem.vertexArrays[0].vertexAttrib[a].bufferID = a;
+    mem.vertexArrays[0].vertexAttrib[a].stride   = sizeof(glm::vec4);
+    mem.vertexArrays[0].vertexAttrib[a].type     = AttribType::VEC4;
+  }
+  mem.programs[0].vertexShader   = vertexPosColor;
+  mem.programs[0].fragmentShader = countingFragmentShader;
+  mem.programs[0].vs2fs[0]       = AttribType::VEC4;
+
+  CommandBuffer cb;
+  REQUIRE(pushClearDepthCommand     (cb,1.f));
+  REQUIRE(pushBindFramebufferCommand(cb,0));
+  REQUIRE(pushBindProgramCommand    (cb,0));
+  REQUIRE(pushBindVertexArrayCommand(cb,0));
+  REQUIRE(pushBlockWritesCommand    (cb,true));
+  REQUIRE(pushDrawCommand           (cb,6));
+
+  auto const oldSettings = getGPUSettings();
+  getGPUSettings() = settings;
+  student_GPU_run(mem,cb);
+  getGPUSettings() = oldSettings;
+
+  return frame.depthBacking;
+}
+
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("depth-only fragments of draws without color writes");
+
+  // the path is selected only for declared shaders
+  declareColorOnlyFragmentShader(fragmentColor);
+  declareColorOnlyFragmentShader(countingFragmentShader);
+
+  GPUSettings full;
+  full.depthOnlyFragments = false;
+  GPUSettings fixedPoint;
+  fixedPoint.fixedPointRasterization = true;
+  GPUSettings tiled;
+  tiled.tiledRasterization = true;
+  tiled.tileSize           = 16;
+
+  OrderDependentScene scene;
+  bool sameOk = true;
+  for(auto const&adjust:{withoutColor,withoutColorAndDepth})
+    for(auto flipped:{false,true})
+      for(auto const&settings:{GPUSettings(),fixedPoint,tiled}){
+        auto reference = settings;
+        reference.depthOnlyFragments = false;
+        sameOk &= sameFramebuffers(scene.render(reference,flipped,adjust),scene.render(settings,flipped,adjust));
+      }
+
+  nofShaderCalls = 0;
+  auto const expected = renderBlockedColor(full);
+  uint32_t const nofFullCalls = nofShaderCalls;
+
+  nofShaderCalls = 0;
+  auto const result = renderBlockedColor(GPUSettings());
+  bool const skipOk = nofFullCalls > 0 && nofShaderCalls == 0 && expected == result;
+
+  declareColorOnlyFragmentShader(countingFragmentShader,false);
+  nofShaderCalls = 0;
+  renderBlockedColor(GPUSettings());
+  bool const undeclaredOk = nofShaderCalls == nofFullCalls;
+
+  declareColorOnlyFragmentShader(fragmentColor,false);
+
+  if(sameOk && skipOk && undeclaredOk)return;
+
+  std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test kontroluje vykreslování pouze hloubky. Když kreslení nezapisuje
+  barvu (framebuffer bez barvy nebo blokované zápisy barvy) a fragment shader
+  je deklarovaný jako shader počítající pouze barvu, GPU nemá interpolovat
+  atributy ani volat shader. Hloubka a stencil musí být bit po bitu stejné
+  jako při plném zpracování fragmentů.
+  Stejný výsledek: )." << sameOk << R".(
+  Shader přeskočen: )." << skipOk << R".(
+  Nedeklarovaný shader se volá: )." << undeclaredOk << std::endl;
+
+  REQUIRE(false);
+}
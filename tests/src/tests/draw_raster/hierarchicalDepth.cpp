@@ -0,0 +1,137 @@
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "hierarchicalDepth"
+#include <tests/testCommon.hpp>
+
+#include <tests/draw_raster/util_raster_backends.hpp>
+#include <studentSolution/gpu.hpp>
+#include <studentSolution/gpuStatistics.hpp>
+
+#include <algorithm>
+#include <iostream>
+
+using namespace tests;
+
+namespace{
+
+void withoutStencil(AllocatedFramebuffer&f){f.frame.stencil.data = nullptr;}
+
+glm::vec4 const quad[6] = {
+  glm::vec4(-1.f,-1.f,0.f,1.f),glm::vec4(+1.f,-1.f,0.f,1.f),glm::vec4(-1.f,+1.f,0.f,1.f),
+  glm::vec4(-1.f,+1.f,0.f,1.f),glm::vec4(+1.f,-1.f,0.f,1.f),glm::vec4(+1.f,+1.f,0.f,1.f),
+};
+
+uint32_t nofShaderCalls = 0;
+
+/**
+ * @brief Draw 0 is a near quad, the other draws are farther quads (behind it)
+ */
+void vertexQuad(OutVertex&out,InVertex const&in,ShaderInterface const&si){
+  out.gl_Position = quad[in.gl_VertexID%6] + glm::vec4(0.f,0.f,si.gl_DrawID == 0 ? -.5f : .2f + .01f*(float)si.gl_DrawID,0.f);
+}
+
+void countingFragment(OutFragment&out,InFragment const&,ShaderInterface const&){
+  nofShaderCalls++;
+  out.gl_FragColor = glm::vec4(1.f);
+}
+
+//! Depth buffer of the frame, written by a user command
+float*userDepth = nullptr;
+size_t userDepthSize = 0;
+
+void raiseDepth(void*){
+  std::fill(userDepth,userDepth+userDepthSize,1.f);
+}
+
+/**
+ * @brief This function draws a near quad, raises the depth buffer by a user command
+ * and draws quads behind the first one
+ *
+ * @return number of fragment shader calls
+ */
+uint32_t renderQuads(GPUSettings const&settings,bool raise){
+  auto frame = createFramebuffer(40,56);
+  userDepth     = frame.depthBacking.data();
+  userDepthSize = frame.depthBacking.size();
+
+  GPUMemory mem;
+  mem.framebuffers[0] = frame.frame;
+  mem.programs[0].vertexShader   = vertexQuad;
+  mem.programs[0].fragmentShader = countingFragment;
+
+  CommandBuffer cb;
+  REQUIRE(pushClearDepthCommand (cb,1.f));
+  REQUIRE(pushBindProgramCommand(cb,0));
+  REQUIRE(pushDrawCommand       (cb,6));
+  if(raise)REQUIRE(pushUserCommand(cb,raiseDepth));
+  REQUIRE(pushDrawCommand       (cb,6));
+  REQUIRE(pushDrawCommand       (cb,6));
+
+  auto const oldSettings = getGPUSettings();
+  getGPUSettings() = settings;
+  nofShaderCalls = 0;
+  student_GPU_run(mem,cb);
+  getGPUSettings() = oldSettings;
+  return nofShaderCalls;
+}
+
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("hierarchical depth buffer (Hi-Z) and early depth test");
+
+  GPUSettings fixedPoint;
+  fixedPoint.fixedPointRasterization = true;
+  GPUSettings scalar;
+  scalar.simdRasterization = false;
+  GPUSettings tiled;
+  tiled.tiledRasterization = true;
+  tiled.nofThreads         = 3;
+  tiled.tileSize           = 16;
+  GPUSettings unalignedTiles = tiled;
+  unalignedTiles.tileSize  = 12;
+  GPUSettings deferred;
+  deferred.deferredClears  = true;
+  deferred.tileSize        = 12;
+
+  OrderDependentScene scene;
+  bool sameOk = true;
+  for(auto const&adjust:{(OrderDependentScene::AdjustFramebuffer)nullptr,withoutStencil})
+    for(auto flipped:{false,true})
+      for(auto const&settings:{GPUSettings(),fixedPoint,scalar,tiled,unalignedTiles,deferred}){
+        auto hiZ = settings;
+        hiZ.hierarchicalDepth = true;
+        sameOk &= sameFramebuffers(scene.render(settings,flipped,adjust),scene.render(hiZ,flipped,adjust));
+      }
+
+  // quads behind the near quad are rejected as whole tiles
+  GPUSettings hiZ;
+  hiZ.hierarchicalDepth = true;
+  resetRasterStatistics();
+  bool occludedOk = renderQuads(GPUSettings(),false) == 56*40 && getRasterStatistics().depthTilesOccluded == 0;
+  occludedOk &= renderQuads(hiZ,false) == 56*40 && getRasterStatistics().depthTilesOccluded == 4*7*5;
+  auto fixedPointHiZ = fixedPoint;
+  fixedPointHiZ.hierarchicalDepth = true;
+  occludedOk &= renderQuads(fixedPointHiZ,false) == 56*40;
+
+  // depth written by a user command (or outside of the GPU) is never trusted
+  bool invalidationOk = true;
+  for(auto const&settings:{hiZ,fixedPointHiZ})
+    invalidationOk &= renderQuads(settings,true) == 56*40*2;
+
+  if(sameOk && occludedOk && invalidationOk)return;
+
+  std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test kontroluje hierarchický hloubkový buffer (Hi-Z) a test hloubky
+  před interpolací atributů. Dlaždice, ve kterých je celý trojúhelník za
+  uloženou maximální hloubkou, se přeskočí. Výsledek musí být bit po bitu
+  stejný jako bez Hi-Z a hloubka zapsaná uživatelským příkazem musí být
+  vzata v úvahu.
+  Stejný výsledek: )." << sameOk << R".(
+  Zakryté dlaždice přeskočeny: )." << occludedOk << R".(
+  Zneplatnění po uživatelském příkazu: )." << invalidationOk << std::endl;
+
+  REQUIRE(false);
+}
@@ -0,0 +1,53 @@
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "hierarchicalRasterization"
+#include <tests/testCommon.hpp>
+
+#include <tests/draw_raster/util_raster_backends.hpp>
+#include <studentSolution/gpuStatistics.hpp>
+
+#include <iostream>
+
+using namespace tests;
+
+SCENARIO(TEST_NAME){
+  printTestName("hierarchical tile rejection and trivial accept");
+
+  OrderDependentScene scene;
+
+  for(auto flipped:{false,true})
+    for(auto tiled:{false,true}){
+      GPUSettings reference;
+      reference.simdRasterization         = false;
+      reference.hierarchicalRasterization = false;
+      reference.tiledRasterization        = tiled;
+      reference.tileSize                  = 16   ;
+
+      GPUSettings hierarchical = reference;
+      hierarchical.simdRasterization         = true;
+      hierarchical.hierarchicalRasterization = true;
+
+      auto const expected = scene.render(reference,flipped);
+      resetRasterStatistics();
+      auto const result   = scene.render(hierarchical,flipped);
+
+      auto const&statistics = getRasterStatistics();
+      bool const allClassesUsed = statistics.blocksOutside > 0 && statistics.blocksInside > 0 && statistics.blocksPartial > 0;
+      bool const tilesRejected  = !tiled || statistics.regionsOutside > 0;
+
+      if(sameFramebuffers(expected,result) && allClassesUsed && tilesRejected)continue;
+
+      std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test porovnává rasterizaci po jednotlivých pixelech s hierarchickou
+  rasterizací, která bloky pixelů rozdělí na bloky zcela venku (přeskočí se),
+  zcela uvnitř (bez testů hran) a částečně pokryté (testy po pixelech).
+  Výsledek musí být bit po bitu stejný a všechny třídy bloků musí nastat.
+  Dlaždice: )." << tiled << R".(
+  Otočený framebuffer: )." << flipped << std::endl;
+      printRasterStatistics(std::cerr);
+
+      REQUIRE(false);
+    }
+}
@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "lazyInterpolation"
+#include <tests/testCommon.hpp>
+
+#include <tests/draw_raster/util_raster_backends.hpp>
+#include <studentSolution/gpu.hpp>
+#include <studentSolution/gpuStatistics.hpp>
+
+#include <iostream>
+
+using namespace tests;
+
+namespace{
+
+void withoutStencil(AllocatedFramebuffer&f){f.frame.stencil.data = nullptr;}
+void withoutDepth  (AllocatedFramebuffer&f){f.frame.depth  .data = nullptr;}
+
+glm::vec4 const quad[6] = {
+  glm::vec4(-1.f,-1.f,0.f,1.f),glm::vec4(+1.f,-1.f,0.f,1.f),glm::vec4(-1.f,+1.f,0.f,1.f),
+  glm::vec4(-1.f,+1.f,0.f,1.f),glm::vec4(+1.f,-1.f,0.f,1.f),glm::vec4(+1.f,+1.f,0.f,1.f),
+};
+
+/**
+ * @brief Draw 0 is a near quad, draws 1 and 2 are behind it, draw 3 fails the stencil test
+ */
+void vertexQuad(OutVertex&out,InVertex const&in,ShaderInterface const&si){
+  out.gl_Position = quad[in.gl_VertexID%6] + glm::vec4(0.f,0.f,si.gl_DrawID == 1 || si.gl_DrawID == 2 ? .5f : -.5f,0.f);
+  out.attributes[0].v4 = out.gl_Position;
+}
+
+void fragmentQuad(OutFragment&out,InFragment const&in,ShaderInterface const&){
+  out.gl_FragColor = in.attributes[0].v4*.5f+.5f;
+}
+
+/**
+ * @brief This function renders the quads, pipeline statistics contain only this frame
+ */
+void renderQuads(GPUSettings const&settings){
+  auto frame = createFramebuffer(40,56);
+
+  GPUMemory mem;
+  mem.framebuffers[0] = frame.frame;
+  mem.programs[0].vertexShader   = vertexQuad;
+  mem.programs[0].fragmentShader = fragmentQuad;
+  mem.programs[0].vs2fs[0]       = AttribType::VEC4;
+
+  StencilSettings never;
+  never.enabled = true;
+  never.func    = StencilFunc::NEVER;
+
+  CommandBuffer cb;
+  REQUIRE(pushClearDepthCommand  (cb,1.f));
+  REQUIRE(pushClearStencilCommand(cb,0));
+  REQUIRE(pushBindProgramCommand (cb,0));
+  REQUIRE(pushDrawCommand        (cb,6));
+  REQUIRE(pushDrawCommand        (cb,6));
+  REQUIRE(pushDrawCommand        (cb,6));
+  REQUIRE(pushSetStencilCommand  (cb,never));
+  REQUIRE(pushDrawCommand        (cb,6));
+
+  auto const oldSettings = getGPUSettings();
+  getGPUSettings() = settings;
+  resetPipelineStatistics();
+  student_GPU_run(mem,cb);
+  getGPUSettings() = oldSettings;
+}
+
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("stencil and depth tests before attribute interpolation");
+
+  GPUSettings fixedPoint;
+  fixedPoint.fixedPointRasterization = true;
+  GPUSettings tiled;
+  tiled.tiledRasterization = true;
+  tiled.nofThreads         = 3;
+  tiled.tileSize           = 16;
+  GPUSettings hiZ;
+  hiZ.hierarchicalDepth    = true;
+
+  OrderDependentScene scene;
+  bool sameOk = true;
+  for(auto const&adjust:{(OrderDependentScene::AdjustFramebuffer)nullptr,withoutStencil,withoutDepth})
+    for(auto flipped:{false,true})
+      for(auto const&settings:{GPUSettings(),fixedPoint,tiled,hiZ}){
+        auto eager = settings;
+        eager.lazyAttributeInterpolation = false;
+        sameOk &= sameFramebuffers(scene.render(eager,flipped,adjust),scene.render(settings,flipped,adjust));
+      }
+
+  // only the fragments of the near quad survive the tests
+  uint32_t const nofPixels = 40*56;
+  auto const&s = getPipelineStatistics();
+  GPUSettings eager;
+  eager.lazyAttributeInterpolation = false;
+  renderQuads(eager);
+  bool countsOk = s.fragmentsGenerated == 4*nofPixels && s.fragmentsInterpolated == 4*nofPixels;
+  renderQuads(GPUSettings());
+  countsOk &= s.fragmentsGenerated     == 4*nofPixels &&
+              s.fragmentsDepthFailed   == 2*nofPixels &&
+              s.fragmentsStencilFailed ==   nofPixels &&
+              s.fragmentsInterpolated  ==   nofPixels &&
+              s.pixelsWritten          ==   nofPixels;
+
+  if(sameOk && countsOk)return;
+
+  std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test kontroluje, že stencil a hloubkový test proběhnou hned po
+  interpolaci hloubky a atributy se interpolují jen pro fragmenty, které
+  testy přežijí. Výsledek musí být bit po bitu stejný jako při interpolaci
+  všech fragmentů.
+  Stejný výsledek: )." << sameOk << R".(
+  Čítače interpolovaných fragmentů: )." << countsOk << std::endl;
+  printPipelineStatistics(std::cerr);
+
+  REQUIRE(false);
+}
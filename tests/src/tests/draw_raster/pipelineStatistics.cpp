@@ -0,0 +1,133 @@
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "pipelineStatistics"
+#include <tests/testCommon.hpp>
+
+#include <studentSolution/gpu.hpp>
+#include <studentSolution/gpuSettings.hpp>
+#include <studentSolution/gpuStatistics.hpp>
+
+#include <iostream>
+
+using namespace tests;
+
+namespace{
+
+glm::vec4 const quad[6] = {
+  glm::vec4(-1.f,-1.f,0.f,1.f),glm::vec4(+1.f,-1.f,0.f,1.f),glm::vec4(-1.f,+1.f,0.f,1.f),
+  glm::vec4(-1.f,+1.f,0.f,1.f),glm::vec4(+1.f,-1.f,0.f,1.f),glm::vec4(+1.f,+1.f,0.f,1.f),
+};
+
+/**
+ * @brief Every draw is a different case of the pipeline (selected by gl_DrawID).
+ */
+void vertex(OutVertex&out,InVertex const&in,ShaderInterface const&si){
+  uint32_t const v = in.gl_VertexID;
+  switch(si.gl_DrawID){
+    case 0 : out.gl_Position = quad[v] + glm::vec4(0.f,0.f, .5f,0.f);break; // passes
+    case 1 : out.gl_Position = quad[v] + glm::vec4(0.f,0.f, .7f,0.f);break; // behind - depth test fails
+    case 2 : out.gl_Position = quad[v] + glm::vec4(0.f,0.f, .2f,0.f);break; // half discarded
+    case 3 : out.gl_Position = quad[(3-v)%3]                        ;break; // clockwise - culled
+    case 4 : out.gl_Position = glm::vec4(.1f,.1f,.5f,1.f)           ;break; // degenerate
+    case 5 : out.gl_Position = quad[v] + glm::vec4(0.f,0.f,-3.f,0.f);break; // behind near plane
+    case 6 : out.gl_Position = glm::vec4(3.f+(float)(v==2),3.f+(float)(v==1),v==1 ? -3.f : .5f,1.f);break; // clipped, off-screen
+    default: out.gl_Position = quad[v] + glm::vec4(0.f,0.f, .1f,0.f);break; // stencil test fails
+  }
+}
+
+void fragment(OutFragment&out,InFragment const&in,ShaderInterface const&si){
+  out.gl_FragColor = glm::vec4(1.f);
+  out.discard      = si.gl_DrawID == 2 && in.gl_FragCoord.x < 4.f;
+}
+
+void render(GPUSettings const&settings,uint32_t nofFrames){
+  auto frame = createFramebuffer(8,8);
+  GPUMemory mem;
+  mem.framebuffers[0] = frame.frame;
+  mem.programs[0].vertexShader   = vertex  ;
+  mem.programs[0].fragmentShader = fragment;
+
+  StencilSettings never;
+  never.enabled = true;
+  never.func    = StencilFunc::NEVER;
+
+  CommandBuffer cb;
+  REQUIRE(pushClearColorCommand  (cb,glm::vec4(0.f)));
+  REQUIRE(pushClearDepthCommand  (cb,1.f));
+  REQUIRE(pushClearStencilCommand(cb,0));
+  REQUIRE(pushSetStencilCommand  (cb,StencilSettings{}));
+  REQUIRE(pushBindProgramCommand (cb,0));
+  REQUIRE(pushDrawCommand        (cb,6));
+  REQUIRE(pushDrawCommand        (cb,6));
+  REQUIRE(pushDrawCommand        (cb,6));
+  REQUIRE(pushSetBackfaceCullingCommand(cb,true));
+  REQUIRE(pushDrawCommand        (cb,3));
+  REQUIRE(pushSetBackfaceCullingCommand(cb,false));
+  REQUIRE(pushDrawCommand        (cb,3));
+  REQUIRE(pushDrawCommand        (cb,6));
+  REQUIRE(pushDrawCommand        (cb,3));
+  REQUIRE(pushSetStencilCommand  (cb,never));
+  REQUIRE(pushDrawCommand        (cb,6));
+
+  auto const oldSettings = getGPUSettings();
+  getGPUSettings() = settings;
+  for(uint32_t i=0;i<nofFrames;++i)
+    student_GPU_run(mem,cb);
+  getGPUSettings() = oldSettings;
+}
+
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("pipeline statistics");
+
+  GPUSettings serial;
+  GPUSettings tiled;
+  tiled.nofThreads         = 3   ;
+  tiled.tiledRasterization = true;
+  tiled.tileSize           = 4   ;
+  GPUSettings other;
+  other.fixedPointRasterization       = true ;
+  other.batchedVertexStage            = true ;
+  other.specializedFragmentOperations = false;
+  other.pipelineTimings               = true ;
+
+  for(auto const&settings:{serial,tiled,other}){
+    resetPipelineStatistics();
+    render(settings,2);
+    auto const&s = getPipelineStatistics();
+
+    // per frame: 4 full-screen quads of 8x8 pixels, the half discarded one writes 32 pixels
+    bool const countsOk =
+      s.frames                 == 2      &&
+      s.verticesShaded         == 2*39   &&
+      s.trianglesIn            == 2*13   &&
+      s.trianglesClipped       == 2*3    &&
+      s.trianglesClippedAway   == 2*2    &&
+      s.trianglesCulled        == 2*1    &&
+      s.trianglesDegenerate    == 2*1    &&
+      s.fragmentsGenerated     == 2*4*64 &&
+      s.fragmentsStencilFailed == 2*64   &&
+      s.fragmentsDepthFailed   == 2*64   &&
+      s.fragmentsDiscarded     == 2*32   &&
+      s.pixelsWritten          == 2*96   ;
+    bool const timesOk = settings.pipelineTimings ? s.frameTime > 0 && s.drawTime > 0 && s.drawTime <= s.frameTime
+                                                  : s.frameTime == 0 && s.drawTime == 0 && s.clearTime == 0;
+
+    if(countsOk && timesOk)continue;
+
+    std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test kontroluje čítače jednotlivých fází pipeline (stínované vrcholy,
+  ořezané, odstraněné a degenerované trojúhelníky, fragmenty zahozené
+  stencil a hloubkovým testem, discard, zapsané pixely) na scéně, kde je
+  počet každého případu známý. Čítače musí být stejné pro všechny back-endy.
+  Vlákna: )." << settings.nofThreads << R".(
+  Čítače správně: )." << countsOk << R".(
+  Časy správně: )." << timesOk << std::endl;
+    printPipelineStatistics(std::cerr);
+
+    REQUIRE(false);
+  }
+}
@@ -0,0 +1,144 @@
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "quadShading"
+#include <tests/testCommon.hpp>
+
+#include <tests/draw_raster/util_raster_backends.hpp>
+#include <studentSolution/gpu.hpp>
+#include <studentSolution/shaderFunctions.hpp>
+
+#include <iostream>
+
+using namespace tests;
+
+namespace{
+
+void withoutDepth(AllocatedFramebuffer&f){f.frame.depth.data = nullptr;}
+
+uint32_t const width  = 16;
+uint32_t const height = 12;
+
+/**
+ * @brief Draw 0 is a full screen quad, draw 1 is a triangle that covers only the center of pixel (5,3)
+ */
+void vertexScreen(OutVertex&out,InVertex const&in,ShaderInterface const&si){
+  glm::vec2 const quad[6] = {
+    glm::vec2(-1.f,-1.f),glm::vec2(+1.f,-1.f),glm::vec2(-1.f,+1.f),
+    glm::vec2(-1.f,+1.f),glm::vec2(+1.f,-1.f),glm::vec2(+1.f,+1.f),
+  };
+  glm::vec2 const pixel[3] = {glm::vec2(5.3f,3.3f),glm::vec2(5.8f,3.4f),glm::vec2(5.5f,3.8f)};
+
+  glm::vec2 const position = si.gl_DrawID == 0 ? quad[in.gl_VertexID%6] : pixel[in.gl_VertexID%3]/glm::vec2(width,height)*2.f-1.f;
+  out.gl_Position = glm::vec4(position,0.f,1.f);
+  out.attributes[0].v2 = position*glm::vec2(3.f,-5.f);
+}
+
+uint32_t  nofShaderCalls = 0;
+glm::vec2 values     [height][width];
+glm::vec4 derivatives[height][width][2];
+
+void recordingFragment(OutFragment&out,InFragment const&in,ShaderInterface const&){
+  nofShaderCalls++;
+  auto const x = (uint32_t)in.gl_FragCoord.x;
+  auto const y = (uint32_t)in.gl_FragCoord.y;
+  values[y][x] = in.attributes[0].v2;
+  student_getAttributeDerivatives(0,derivatives[y][x][0],derivatives[y][x][1]);
+  out.gl_FragColor = glm::vec4(1.f);
+}
+
+void renderDraw(GPUSettings const&settings,uint32_t drawID){
+  auto frame = createFramebuffer(width,height);
+
+  GPUMemory mem;
+  mem.framebuffers[0] = frame.frame;
+  mem.programs[0].vertexShader   = vertexScreen;
+  mem.programs[0].fragmentShader = recordingFragment;
+  mem.programs[0].vs2fs[0]       = AttribType::VEC2;
+
+  CommandBuffer cb;
+  REQUIRE(pushClearDepthCommand (cb,1.f));
+  REQUIRE(pushBindProgramCommand(cb,0));
+  for(uint32_t d=0;d<=drawID;++d)
+    REQUIRE(pushDrawCommand(cb,d == drawID ? 6 : 0));
+
+  auto const oldSettings = getGPUSettings();
+  getGPUSettings() = settings;
+  nofShaderCalls = 0;
+  student_GPU_run(mem,cb);
+  getGPUSettings() = oldSettings;
+}
+
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("2x2 quad shading and derivatives from the quad");
+
+  GPUSettings fixedPoint;
+  fixedPoint.fixedPointRasterization = true;
+  GPUSettings tiled;
+  tiled.tiledRasterization = true;
+  tiled.nofThreads         = 3;
+  tiled.tileSize           = 5;
+  GPUSettings hiZ;
+  hiZ.hierarchicalDepth    = true;
+
+  OrderDependentScene scene;
+  bool sameOk = true;
+  for(auto const&adjust:{(OrderDependentScene::AdjustFramebuffer)nullptr,withoutDepth})
+    for(auto flipped:{false,true})
+      for(auto const&settings:{GPUSettings(),fixedPoint,tiled,hiZ}){
+        auto quads = settings;
+        quads.quadShading = true;
+        sameOk &= sameFramebuffers(scene.render(settings,flipped,adjust),scene.render(quads,flipped,adjust));
+      }
+
+  // derivatives are differences of the recorded neighbours in the quad
+  glm::vec4 const exactX = glm::vec4(3.f*2.f/(float)width,0.f,0.f,0.f);
+  glm::vec4 const exactY = glm::vec4(0.f,-5.f*2.f/(float)height,0.f,0.f);
+  auto near = [](glm::vec4 const&a,glm::vec4 const&b){
+    for(int c=0;c<4;++c)
+      if(!equalFloats(a[c],b[c],0.001f))return false;
+    return true;
+  };
+
+  bool quadOk = true;
+  for(auto const&settings:{GPUSettings(),fixedPoint}){
+    auto quads = settings;
+    quads.quadShading = true;
+    renderDraw(quads,0);
+    quadOk &= nofShaderCalls == width*height;
+    for(uint32_t y=0;y<height;++y)
+      for(uint32_t x=0;x<width;++x){
+        glm::vec2 const dx = values[y][x|1] - values[y][x&~1u];
+        glm::vec2 const dy = values[y|1][x] - values[y&~1u][x];
+        quadOk &= derivatives[y][x][0] == glm::vec4(dx,0.f,0.f);
+        quadOk &= derivatives[y][x][1] == glm::vec4(dy,0.f,0.f);
+        quadOk &= near(derivatives[y][x][0],exactX) && near(derivatives[y][x][1],exactY);
+      }
+  }
+
+  // single covered pixel gets its derivatives from the helper pixels (never shaded)
+  bool helperOk = true;
+  for(auto const&settings:{GPUSettings(),fixedPoint}){
+    auto quads = settings;
+    quads.quadShading = true;
+    renderDraw(quads,1);
+    helperOk &= nofShaderCalls == 1;
+    helperOk &= near(derivatives[3][5][0],exactX) && near(derivatives[3][5][1],exactY);
+  }
+
+  if(sameOk && quadOk && helperOk)return;
+
+  std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test kontroluje rasterizaci a stínování po čtveřicích pixelů 2x2.
+  Obraz musí být bit po bitu stejný jako při stínování po pixelech. Derivace
+  atributů jsou rozdíly hodnot sousedních pixelů ve čtveřici (včetně
+  pomocných pixelů mimo trojúhelník, pro které se shader nevolá).
+  Stejný výsledek: )." << sameOk << R".(
+  Derivace ze čtveřice: )." << quadOk << R".(
+  Pomocné pixely: )." << helperOk << std::endl;
+
+  REQUIRE(false);
+}
@@ -0,0 +1,40 @@
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "simdRasterization"
+#include <tests/testCommon.hpp>
+
+#include <tests/draw_raster/util_raster_backends.hpp>
+
+#include <iostream>
+
+using namespace tests;
+
+SCENARIO(TEST_NAME){
+  printTestName("SIMD block rasterization");
+
+  OrderDependentScene scene;
+
+  for(auto flipped:{false,true})
+    for(auto tiled:{false,true}){
+      GPUSettings scalar;
+      scalar.simdRasterization  = false;
+      scalar.tiledRasterization = tiled;
+      scalar.tileSize           = 13   ;
+
+      GPUSettings simd = scalar;
+      simd.simdRasterization = true;
+
+      if(sameFramebuffers(scene.render(scalar,flipped),scene.render(simd,flipped)))continue;
+
+      std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test porovnává rasterizaci po jednotlivých pixelech s rasterizací
+  bloků pixelů pomocí SIMD instrukcí. Pokrytí (včetně top-left pravidla),
+  hloubka, stencil i barva musí být bit po bitu stejné.
+  Dlaždice: )." << tiled << R".(
+  Otočený framebuffer: )." << flipped << std::endl;
+
+      REQUIRE(false);
+    }
+}
@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "specializedFragmentOperations"
+#include <tests/testCommon.hpp>
+
+#include <tests/draw_raster/util_raster_backends.hpp>
+
+#include <iostream>
+
+using namespace tests;
+
+namespace{
+
+struct FramebufferVariant{
+  char const*                          name  ;
+  OrderDependentScene::AdjustFramebuffer adjust;
+};
+
+void toRGBA(AllocatedFramebuffer&f){
+  auto&c = f.frame.color;
+  f.colorBacking  = std::vector<uint8_t>(f.frame.width*f.frame.height*4,0);
+  c.data          = f.colorBacking.data();
+  c.channels      = 4;
+  c.bytesPerPixel = 4;
+  c.pitch         = f.frame.width*4;
+}
+
+void toBGRA(AllocatedFramebuffer&f){
+  toRGBA(f);
+  f.frame.color.channelTypes[0] = Image::BLUE;
+  f.frame.color.channelTypes[2] = Image::RED ;
+}
+
+void withoutColor  (AllocatedFramebuffer&f){f.frame.color  .data = nullptr;}
+void withoutDepth  (AllocatedFramebuffer&f){f.frame.depth  .data = nullptr;}
+void withoutStencil(AllocatedFramebuffer&f){f.frame.stencil.data = nullptr;}
+
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("per-fragment operations specialized for the draw state");
+
+  OrderDependentScene scene;
+
+  FramebufferVariant const variants[] = {
+    {"RGB8"         ,nullptr       },
+    {"RGBA8"        ,toRGBA        },
+    {"BGRA8"        ,toBGRA        },
+    {"bez barvy"    ,withoutColor  },
+    {"bez hloubky"  ,withoutDepth  },
+    {"bez stencilu" ,withoutStencil},
+  };
+
+  for(auto const&variant:variants)
+    for(auto flipped:{false,true}){
+      GPUSettings generic;
+      generic.specializedFragmentOperations = false;
+
+      auto const expected = scene.render(generic     ,flipped,variant.adjust);
+      auto const result   = scene.render(GPUSettings{},flipped,variant.adjust);
+
+      if(sameFramebuffers(expected,result))continue;
+
+      std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test porovnává per-fragment operace specializované podle stavu GPU
+  (stencil, hloubka, blokované zápisy, formát barvy) s obecnou verzí,
+  která vše kontroluje pro každý fragment znovu.
+  Výsledek musí být bit po bitu stejný.
+  Framebuffer: )." << variant.name << R".(
+  Otočený framebuffer: )." << flipped << std::endl;
+
+      REQUIRE(false);
+    }
+}
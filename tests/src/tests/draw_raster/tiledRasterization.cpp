@@ -0,0 +1,42 @@
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "tiledRasterization"
+#include <tests/testCommon.hpp>
+
+#include <tests/draw_raster/util_raster_backends.hpp>
+
+#include <iostream>
+
+using namespace tests;
+
+SCENARIO(TEST_NAME){
+  printTestName("tile-binned multithreaded rasterization");
+
+  OrderDependentScene scene;
+
+  for(auto flipped:{false,true}){
+    auto const expected = scene.render(GPUSettings{},flipped);
+
+    for(uint32_t nofThreads:{1u,2u,4u})
+      for(uint32_t tileSize:{1u,7u,16u,64u}){
+        GPUSettings settings;
+        settings.nofThreads         = nofThreads;
+        settings.tileSize           = tileSize  ;
+        settings.tiledRasterization = true      ;
+
+        if(sameFramebuffers(expected,scene.render(settings,flipped)))continue;
+
+        std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test porovnává výsledek sériového rasterizéru s rasterizérem,
+  který trojúhelníky třídí do dlaždic obrazovky a kreslí je ve více vláknech.
+  Výsledek musí být bit po bitu stejný (stejné pořadí trojúhelníků v každém pixelu).
+  Počet vláken: )." << nofThreads << R".(
+  Velikost dlaždice: )." << tileSize << R".(
+  Otočený framebuffer: )." << flipped << std::endl;
+
+        REQUIRE(false);
+      }
+  }
+}
@@ -0,0 +1,84 @@
+#include<catch2/catch_test_macros.hpp>
+
+#include<tests/draw_raster/util_raster_backends.hpp>
+
+#include<studentSolution/gpu.hpp>
+
+namespace tests{
+
+OrderDependentScene::OrderDependentScene(){
+  uint32_t seed = 12345;
+  auto random = [&](float mn,float mx){
+    seed = seed*1664525u+1013904223u;
+    return mn + (mx-mn)*(float)(seed>>8)/(float)(1u<<24);
+  };
+  for(uint32_t i=0;i<3*300;++i){
+    positions.push_back(glm::vec4(random(-1.3f,1.3f),random(-1.3f,1.3f),random(-.9f,.9f),1.f));
+    colors   .push_back(glm::vec4(random(0.f,1.f),random(0.f,1.f),random(0.f,1.f),random(0.f,1.f)));
+  }
+}
+
+AllocatedFramebuffer OrderDependentScene::render(GPUSettings const&settings,bool flipped,AdjustFramebuffer adjustFramebuffer){
+  auto frame = createFramebuffer(97,61,flipped);
+  if(adjustFramebuffer)adjustFramebuffer(frame);
+
+  GPUMemory mem;
+  mem.framebuffers[0] = frame.frame;
+  mem.buffers[0] = vectorToBuffer(positions);
+  mem.buffers[1] = vectorToBuffer(colors);
+  for(uint32_t a=0;a<2;++a){
+    mem.vertexArrays[0].vertexAttrib[a].bufferID = a;
+    mem.vertexArrays[0].vertexAttrib[a].stride   = sizeof(glm::vec4);
+    mem.vertexArrays[0].vertexAttrib[a].type     = AttribType::VEC4;
+  }
+  mem.programs[0].vertexShader   = vertexPosColor;
+  mem.programs[0].fragmentShader = fragmentColor;
+  mem.programs[0].vs2fs[0]       = AttribType::VEC4;
+
+  StencilSettings stencil;
+  stencil.enabled = true;
+  stencil.frontOps.dppass = StencilOp::INCR_WRAP;
+  stencil.backOps .dppass = StencilOp::DECR_WRAP;
+  stencil.backOps .dpfail = StencilOp::INVERT;
+
+  CommandBuffer cb;
+  REQUIRE(pushClearColorCommand  (cb,glm::vec4(.1f,.2f,.3f,1.f)));
+  REQUIRE(pushClearDepthCommand  (cb,1.f));
+  REQUIRE(pushClearStencilCommand(cb,7));
+  REQUIRE(pushBindFramebufferCommand(cb,0));
+  REQUIRE(pushBindProgramCommand    (cb,0));
+  REQUIRE(pushBindVertexArrayCommand(cb,0));
+  REQUIRE(pushSetStencilCommand     (cb,stencil));
+  REQUIRE(pushDrawCommand           (cb,3*100));
+  REQUIRE(pushBlockWritesCommand    (cb,false,true,false));
+  REQUIRE(pushDrawCommand           (cb,3*100));
+  REQUIRE(pushBlockWritesCommand    (cb));
+  REQUIRE(pushSetFrontFaceCommand   (cb,false));
+  REQUIRE(pushClearDepthCommand     (cb,.5f));
+  REQUIRE(pushDrawCommand           (cb,3*300));
+
+  StencilSettings compare = stencil;
+  compare.func             = StencilFunc::LEQUAL;
+  compare.refValue         = 8;
+  compare.frontOps.sfail   = StencilOp::REPLACE;
+  compare.backOps .sfail   = StencilOp::INCR;
+  REQUIRE(pushSetStencilCommand     (cb,compare));
+  REQUIRE(pushDrawCommand           (cb,3*100));
+  REQUIRE(pushBlockWritesCommand    (cb,false,false,true));
+  REQUIRE(pushDrawCommand           (cb,3*100));
+
+  auto const oldSettings = getGPUSettings();
+  getGPUSettings() = settings;
+  student_GPU_run(mem,cb);
+  getGPUSettings() = oldSettings;
+
+  return frame;
+}
+
+bool sameFramebuffers(AllocatedFramebuffer const&a,AllocatedFramebuffer const&b){
+  return a.colorBacking   == b.colorBacking  &&
+         a.depthBacking   == b.depthBacking  &&
+         a.stencilBacking == b.stencilBacking;
+}
+
+}
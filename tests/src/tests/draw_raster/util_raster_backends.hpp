@@ -0,0 +1,27 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <tests/testCommon.hpp>
+#include <studentSolution/gpuSettings.hpp>
+
+namespace tests{
+
+/**
+ * @brief Scene with many overlapping (partially off-screen) triangles whose
+ * result depends on the order of triangles in every pixel.
+ * It is used to check that alternative rasterizer back-ends give
+ * bit-identical results.
+ */
+struct OrderDependentScene{
+  using AdjustFramebuffer = void(*)(AllocatedFramebuffer&frame); ///< changes attachments/layout of the framebuffer before rendering
+  OrderDependentScene();
+  std::vector<glm::vec4>positions;
+  std::vector<glm::vec4>colors   ;
+  AllocatedFramebuffer render(GPUSettings const&settings,bool flipped,AdjustFramebuffer adjustFramebuffer = nullptr);
+};
+
+bool sameFramebuffers(AllocatedFramebuffer const&a,AllocatedFramebuffer const&b);
+
+}
@@ -47,14 +47,14 @@ void TestingTriangle::test(uint32_t counter){
     }
   }
 
-  pushClearColorCommand        (cb,initColor);
-  pushClearDepthCommand        (cb,initDepth);
-  pushClearStencilCommand      (cb,initStencil);
-  pushBlockWritesCommand       (cb,blockWrites.color,blockWrites.depth,blockWrites.stencil);
-  pushSetBackfaceCullingCommand(cb,backfaceCulling.enabled);
-  pushSetFrontFaceCommand      (cb,backfaceCulling.frontFaceIsCounterClockWise);
-  pushSetStencilCommand        (cb,stencilSettings);
-  pushDrawCommand              (cb,(uint32_t)verts.size());
+  REQUIRE(pushClearColorCommand        (cb,initColor));
+  REQUIRE(pushClearDepthCommand        (cb,initDepth));
+  REQUIRE(pushClearStencilCommand      (cb,initStencil));
+  REQUIRE(pushBlockWritesCommand       (cb,blockWrites.color,blockWrites.depth,blockWrites.stencil));
+  REQUIRE(pushSetBackfaceCullingCommand(cb,backfaceCulling.enabled));
+  REQUIRE(pushSetFrontFaceCommand      (cb,backfaceCulling.frontFaceIsCounterClockWise));
+  REQUIRE(pushSetStencilCommand        (cb,stencilSettings));
+  REQUIRE(pushDrawCommand              (cb,(uint32_t)verts.size()));
 
   if(memCb->runAndTest()){std::cerr << "  raster test: "<< counter << " - ok." << std::endl;return;}
 
@@ -0,0 +1,139 @@
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "batchedVertexStage"
+#include <tests/testCommon.hpp>
+
+#include <tests/draw_raster/util_raster_backends.hpp>
+#include <studentSolution/gpu.hpp>
+#include <studentSolution/vertexBatch.hpp>
+
+#include <iostream>
+
+using namespace tests;
+
+namespace{
+
+uint32_t nofVertexShaderInvocations = 0;
+uint32_t nofBatchShaderLanes        = 0;
+
+void vertexWithDefaults(OutVertex&out,InVertex const&in,ShaderInterface const&si){
+  nofVertexShaderInvocations++;
+  // attribute 3 is not bound, so it has to keep its default value vec4(1)
+  out.gl_Position      = glm::vec4(in.attributes[0].v3,1.f) + glm::vec4(.1f*si.gl_DrawID,0.f,0.f,0.f);
+  out.attributes[0].v4 = glm::vec4(in.attributes[1].v2,(float)(in.attributes[2].u1%7)/7.f,1.f) * in.attributes[3].v4;
+}
+
+void vertexWithDefaultsBatch(OutVertex outVertices[],InVertexBatch const&inVertices,ShaderInterface const&si){
+  for(uint32_t i=0;i<inVertices.nofVertices;++i){
+    nofBatchShaderLanes++;
+    outVertices[i].gl_Position      = glm::vec4(inVertices.attributes[0][i].v3,1.f) + glm::vec4(.1f*si.gl_DrawID,0.f,0.f,0.f);
+    outVertices[i].attributes[0].v4 = glm::vec4(inVertices.attributes[1][i].v2,(float)(inVertices.attributes[2][i].u1%7)/7.f,1.f) * inVertices.attributes[3][i].v4;
+  }
+}
+
+struct BatchMesh{
+  std::vector<glm::vec3>positions;
+  std::vector<glm::vec2>colors   ;
+  std::vector<uint32_t >ids      ;
+  std::vector<uint16_t >indices  ;
+  BatchMesh(){
+    uint32_t const n = 11;
+    for(uint32_t y=0;y<=n;++y)
+      for(uint32_t x=0;x<=n;++x){
+        positions.push_back(glm::vec3(-.9f+1.6f*x/n,-.9f+1.6f*y/n,(float)(x+y)/(2.f*n)));
+        colors   .push_back(glm::vec2((float)x/n,(float)y/n));
+        ids      .push_back(x*3+y);
+      }
+    for(uint32_t y=0;y<n;++y)
+      for(uint32_t x=0;x<n;++x){
+        uint16_t const a = (uint16_t)(y*(n+1)+x);
+        indices.insert(indices.end(),{a,(uint16_t)(a+1),(uint16_t)(a+n+2),a,(uint16_t)(a+n+2),(uint16_t)(a+n+1)});
+      }
+  }
+
+  AllocatedFramebuffer render(GPUSettings const&settings,bool indexed){
+    auto frame = createFramebuffer(71,59);
+    GPUMemory mem;
+    mem.framebuffers[0] = frame.frame;
+    mem.buffers[0] = vectorToBuffer(positions);
+    mem.buffers[1] = vectorToBuffer(colors);
+    mem.buffers[2] = vectorToBuffer(ids);
+    mem.buffers[3] = vectorToBuffer(indices);
+    mem.vertexArrays[0].vertexAttrib[0] = {0,sizeof(glm::vec3),0,AttribType::VEC3};
+    mem.vertexArrays[0].vertexAttrib[1] = {1,sizeof(glm::vec2),0,AttribType::VEC2};
+    mem.vertexArrays[0].vertexAttrib[2] = {2,sizeof(uint32_t ),0,AttribType::UINT};
+    if(indexed){
+      mem.vertexArrays[0].indexBufferID = 3;
+      mem.vertexArrays[0].indexType     = IndexType::U16;
+    }
+    mem.programs[0].vertexShader   = vertexWithDefaults;
+    mem.programs[0].fragmentShader = fragmentColor;
+    mem.programs[0].vs2fs[0]       = AttribType::VEC4;
+
+    // non-indexed draw ends with an incomplete batch and an incomplete triangle
+    uint32_t const nofVertices = indexed ? (uint32_t)indices.size() : (uint32_t)positions.size();
+
+    CommandBuffer cb;
+    REQUIRE(pushClearColorCommand(cb,glm::vec4(0.f)));
+    REQUIRE(pushClearDepthCommand(cb,1.f));
+    REQUIRE(pushDrawCommand      (cb,nofVertices));
+    REQUIRE(pushDrawCommand      (cb,nofVertices));
+
+    auto const oldSettings = getGPUSettings();
+    getGPUSettings() = settings;
+    student_GPU_run(mem,cb);
+    getGPUSettings() = oldSettings;
+    return frame;
+  }
+};
+
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("batched vertex fetch and vertex shader stage");
+
+  BatchMesh mesh;
+
+  for(auto indexed:{false,true})
+    for(auto cached:{false,true})
+      for(auto batchShader:{false,true}){
+        registerBatchVertexShader(vertexWithDefaults,batchShader?vertexWithDefaultsBatch:nullptr);
+
+        nofVertexShaderInvocations = 0;
+        nofBatchShaderLanes        = 0;
+        GPUSettings perVertex;
+        perVertex.vertexCache = cached;
+        auto const expected = mesh.render(perVertex,indexed);
+        auto const expectedInvocations = nofVertexShaderInvocations;
+
+        nofVertexShaderInvocations = 0;
+        nofBatchShaderLanes        = 0;
+        GPUSettings batched = perVertex;
+        batched.batchedVertexStage = true;
+        auto const result = mesh.render(batched,indexed);
+
+        registerBatchVertexShader(vertexWithDefaults,nullptr);
+
+        bool const sameImage   = sameFramebuffers(expected,result);
+        auto const invocations = nofVertexShaderInvocations + nofBatchShaderLanes;
+        bool const usedBatch   = batchShader ? nofVertexShaderInvocations == 0 : nofBatchShaderLanes == 0;
+
+        if(sameImage && invocations == expectedInvocations && usedBatch)continue;
+
+        std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test porovnává dávkové načítání a stínování vrcholů s původním
+  zpracováním vrchol po vrcholu. Obraz i počet stínovaných vrcholů musí být
+  stejný. Nenačtené atributy musí mít výchozí hodnotu vec4(1).
+  Pokud je zaregistrován dávkový shader, musí se použít místo původního.
+  Indexované kreslení: )." << indexed << R".(
+  Cache vrcholů: )." << cached << R".(
+  Dávkový shader: )." << batchShader << R".(
+  Stejný obraz: )." << sameImage << R".(
+  Počet stínovaných vrcholů: )." << invocations << R".( (očekáváno )." << expectedInvocations << R".()
+  Použit správný shader: )." << usedBatch << std::endl;
+
+        REQUIRE(false);
+      }
+}
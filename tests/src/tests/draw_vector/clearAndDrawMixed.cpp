@@ -29,16 +29,16 @@ SCENARIO(TEST_NAME){
 
   mem.programs[0].vertexShader = vertexEmpty;
 
-  pushClearColorCommand(cb);
-  pushClearDepthCommand(cb);
-  pushDrawCommand(cb,3);
-  pushClearColorCommand(cb);
-  pushClearDepthCommand(cb);
-  pushDrawCommand(cb,6);
-  pushDrawCommand(cb,9);
-  pushClearColorCommand(cb);
-  pushClearDepthCommand(cb);
-  pushDrawCommand(cb,12);
+  REQUIRE(pushClearColorCommand(cb));
+  REQUIRE(pushClearDepthCommand(cb));
+  REQUIRE(pushDrawCommand(cb,3));
+  REQUIRE(pushClearColorCommand(cb));
+  REQUIRE(pushClearDepthCommand(cb));
+  REQUIRE(pushDrawCommand(cb,6));
+  REQUIRE(pushDrawCommand(cb,9));
+  REQUIRE(pushClearColorCommand(cb));
+  REQUIRE(pushClearDepthCommand(cb));
+  REQUIRE(pushDrawCommand(cb,12));
 
   if(memCb->runAndTest())return;
 
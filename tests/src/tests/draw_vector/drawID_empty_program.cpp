@@ -17,8 +17,8 @@ void oneEqueue(){
 
   mem.programs[0].vertexShader = vertexEmpty;
 
-  pushDrawCommand(cb,3);
-  pushDrawCommand(cb,3);
+  REQUIRE(pushDrawCommand(cb,3));
+  REQUIRE(pushDrawCommand(cb,3));
 
   if(memCb->runAndTest())return;
 
@@ -40,9 +40,9 @@ void multipleEqueue(){
 
   mem.programs[0].vertexShader = vertexEmpty;
 
-  pushBindProgramCommand(cb,0);
-  pushBindProgramCommand(cb,1);
-  pushBindProgramCommand(cb,0);
+  REQUIRE(pushBindProgramCommand(cb,0));
+  REQUIRE(pushBindProgramCommand(cb,1));
+  REQUIRE(pushBindProgramCommand(cb,0));
 
   if(memCb->runAndTest(2))return;
 
@@ -65,12 +65,12 @@ void drawAndSetDrawId(){
 
   mem.programs[0].vertexShader = vertexEmpty;
 
-  pushDrawCommand(cb,3);
-  pushDrawCommand(cb,3);
-  pushSetDrawIdCommand(cb,30);
-  pushDrawCommand(cb,3);
-  pushDrawCommand(cb,3);
-  pushDrawCommand(cb,3);
+  REQUIRE(pushDrawCommand(cb,3));
+  REQUIRE(pushDrawCommand(cb,3));
+  REQUIRE(pushSetDrawIdCommand(cb,30));
+  REQUIRE(pushDrawCommand(cb,3));
+  REQUIRE(pushDrawCommand(cb,3));
+  REQUIRE(pushDrawCommand(cb,3));
 
   if(memCb->runAndTest())return;
 
@@ -27,9 +27,9 @@ void indexTest(){
   vao.indexOffset    = 0;
   vao.indexType      = (IndexType)sizeof(T);
 
-  pushBindProgramCommand(cb,4);
-  pushBindVertexArrayCommand(cb,7);
-  pushDrawCommand(cb,(uint32_t)indices.size());
+  REQUIRE(pushBindProgramCommand(cb,4));
+  REQUIRE(pushBindVertexArrayCommand(cb,7));
+  REQUIRE(pushDrawCommand(cb,(uint32_t)indices.size()));
 
   if(memCb->runAndTest())return;
 
@@ -17,8 +17,8 @@ SCENARIO(TEST_NAME){
   auto&prg = mem.programs[7];
   prg.vertexShader   =   vertexEmpty;
 
-  pushBindProgramCommand(cb,7);
-  pushDrawCommand(cb,9);
+  REQUIRE(pushBindProgramCommand(cb,7));
+  REQUIRE(pushDrawCommand(cb,9));
 
   if(memCb->runAndTest())return;
   std::cerr << R".(
@@ -46,9 +46,9 @@ void attributeTest(uint32_t offset = 0,uint32_t stride = sizeof(float)){
   auto nofVerts = (vert.size()-offsetInElements) / strideInElements;
   nofVerts = (nofVerts/3)*3;
 
-  pushBindProgramCommand(cb,8);
-  pushBindVertexArrayCommand(cb,4);
-  pushDrawCommand(cb,(uint32_t)nofVerts);
+  REQUIRE(pushBindProgramCommand(cb,8));
+  REQUIRE(pushBindVertexArrayCommand(cb,4));
+  REQUIRE(pushDrawCommand(cb,(uint32_t)nofVerts));
 
   if(memCb->runAndTest())return;
 
@@ -127,9 +127,9 @@ SCENARIO(TEST_NAME){
   vao.vertexAttrib[3].stride     = sizeof(float)*5;
   vao.vertexAttrib[3].offset     = 7;
 
-  pushBindProgramCommand(cb,2);
-  pushBindVertexArrayCommand(cb,3);
-  pushDrawCommand(cb,3);
+  REQUIRE(pushBindProgramCommand(cb,2));
+  REQUIRE(pushBindVertexArrayCommand(cb,3));
+  REQUIRE(pushDrawCommand(cb,3));
 
   if(memCb->runAndTest())return;
 
@@ -175,9 +175,9 @@ SCENARIO(TEST_NAME){
   vao.indexType     = IndexType::U16;
   vao.indexOffset   = sizeof(uint16_t)*3;
 
-  pushBindProgramCommand(cb,3);
-  pushBindVertexArrayCommand(cb,8);
-  pushDrawCommand(cb,6);
+  REQUIRE(pushBindProgramCommand(cb,3));
+  REQUIRE(pushBindVertexArrayCommand(cb,8));
+  REQUIRE(pushDrawCommand(cb,6));
 
   if(memCb->runAndTest())return;
 
@@ -0,0 +1,115 @@
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "vertexCache"
+#include <tests/testCommon.hpp>
+
+#include <tests/draw_raster/util_raster_backends.hpp>
+#include <studentSolution/gpu.hpp>
+#include <studentSolution/gpuStatistics.hpp>
+
+#include <iostream>
+#include <set>
+
+using namespace tests;
+
+namespace{
+
+uint32_t nofVertexShaderInvocations = 0;
+
+void vertexShiftedByDrawID(OutVertex&out,InVertex const&in,ShaderInterface const&si){
+  nofVertexShaderInvocations++;
+  out.gl_Position      = in.attributes[0].v4 + glm::vec4(.1f*si.gl_DrawID,0.f,0.f,0.f);
+  out.attributes[0].v4 = in.attributes[1].v4;
+}
+
+struct IndexedGrid{
+  std::vector<glm::vec4>positions;
+  std::vector<glm::vec4>colors   ;
+  std::vector<uint32_t >indices  ;
+  IndexedGrid(){
+    uint32_t const n = 9;
+    for(uint32_t y=0;y<=n;++y)
+      for(uint32_t x=0;x<=n;++x){
+        positions.push_back(glm::vec4(-.9f+1.6f*x/n,-.9f+1.6f*y/n,(float)(x+y)/(2.f*n),1.f));
+        colors   .push_back(glm::vec4((float)x/n,(float)y/n,.5f,1.f));
+      }
+    for(uint32_t y=0;y<n;++y)
+      for(uint32_t x=0;x<n;++x){
+        uint32_t const a = y*(n+1)+x;
+        indices.insert(indices.end(),{a,a+1,a+n+2,a,a+n+2,a+n+1});
+      }
+  }
+
+  AllocatedFramebuffer render(GPUSettings const&settings){
+    auto frame = createFramebuffer(67,53);
+    GPUMemory mem;
+    mem.framebuffers[0] = frame.frame;
+    mem.buffers[0] = vectorToBuffer(positions);
+    mem.buffers[1] = vectorToBuffer(colors);
+    mem.buffers[2] = vectorToBuffer(indices);
+    for(uint32_t a=0;a<2;++a){
+      mem.vertexArrays[0].vertexAttrib[a].bufferID = a;
+      mem.vertexArrays[0].vertexAttrib[a].stride   = sizeof(glm::vec4);
+      mem.vertexArrays[0].vertexAttrib[a].type     = AttribType::VEC4;
+    }
+    mem.vertexArrays[0].indexBufferID = 2;
+    mem.vertexArrays[0].indexType     = IndexType::U32;
+    mem.programs[0].vertexShader   = vertexShiftedByDrawID;
+    mem.programs[0].fragmentShader = fragmentColor;
+    mem.programs[0].vs2fs[0]       = AttribType::VEC4;
+
+    CommandBuffer cb;
+    REQUIRE(pushClearColorCommand(cb,glm::vec4(0.f)));
+    REQUIRE(pushClearDepthCommand(cb,1.f));
+    REQUIRE(pushDrawCommand      (cb,(uint32_t)indices.size()));
+    REQUIRE(pushDrawCommand      (cb,(uint32_t)indices.size()));
+
+    auto const oldSettings = getGPUSettings();
+    getGPUSettings() = settings;
+    student_GPU_run(mem,cb);
+    getGPUSettings() = oldSettings;
+    return frame;
+  }
+};
+
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("post-transform vertex cache");
+
+  IndexedGrid grid;
+  auto const nofUniqueVertices = std::set<uint32_t>(grid.indices.begin(),grid.indices.end()).size();
+  auto const nofVertices       = grid.indices.size();
+
+  nofVertexShaderInvocations = 0;
+  auto const expected = grid.render(GPUSettings{});
+  bool const expectedCount = nofVertexShaderInvocations == 2*nofVertices;
+
+  GPUSettings cached;
+  cached.vertexCache = true;
+  nofVertexShaderInvocations = 0;
+  resetVertexStatistics();
+  auto const result = grid.render(cached);
+
+  auto const&statistics = getVertexStatistics();
+  bool const sameImage  = sameFramebuffers(expected,result);
+  bool const onceEach   = nofVertexShaderInvocations == 2*nofUniqueVertices;
+  bool const statsMatch = statistics.cacheMisses == 2*nofUniqueVertices &&
+                          statistics.cacheHits   == 2*(nofVertices-nofUniqueVertices);
+
+  if(expectedCount && sameImage && onceEach && statsMatch)return;
+
+  std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test zkouší cache transformovaných vrcholů pro indexované kreslení.
+  Každý unikátní vrchol se má v rámci jednoho kreslení stínovat jen jednou,
+  mezi kresleními se cache musí zneplatnit (gl_DrawID mění výstup shaderu)
+  a výsledný obraz musí být stejný jako bez cache.
+  Stejný obraz: )." << sameImage << R".(
+  Počet spuštění vertex shaderu: )." << nofVertexShaderInvocations << R".( (očekáváno )." << 2*nofUniqueVertices << R".()
+  Statistiky odpovídají: )." << statsMatch << std::endl;
+  printVertexStatistics(std::cerr);
+
+  REQUIRE(false);
+}
@@ -18,8 +18,8 @@ SCENARIO(TEST_NAME){
   auto&prg = mem.programs[9];
   prg.vertexShader = vertexEmpty;
 
-  pushBindProgramCommand(cb,9);
-  pushDrawCommand(cb,3);
+  REQUIRE(pushBindProgramCommand(cb,9));
+  REQUIRE(pushDrawCommand(cb,3));
 
   if(memCb->runAndTest())return;
 
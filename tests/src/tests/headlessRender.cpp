@@ -0,0 +1,154 @@
+#include <tests/headlessRender.hpp>
+#include <tests/testCommon.hpp>
+#include <framework/application.hpp>
+#include <framework/programContext.hpp>
+
+#include <BasicCamera/OrbitCamera.h>
+#include <BasicCamera/PerspectiveCamera.h>
+
+#include <libs/stb_image/stb_image_write.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace{
+
+/**
+ * @brief This function replaces the first %d (or %0Nd) of the pattern by the frame number,
+ * patterns without it get "_NNNN" before their extension
+ */
+std::string getFrameFileName(std::string const&pattern,uint32_t frame){
+  auto const start = pattern.find('%');
+  if(start != std::string::npos){
+    auto end = start+1;
+    while(end < pattern.size() && std::isdigit((unsigned char)pattern[end]))end++;
+    if(end < pattern.size() && pattern[end] == 'd'){
+      auto const width = end > start+1 ? std::stoi(pattern.substr(start+1,end-start-1)) : 0;
+      std::stringstream ss;
+      ss << pattern.substr(0,start) << std::setfill('0') << std::setw(width) << frame << pattern.substr(end+1);
+      return ss.str();
+    }
+  }
+
+  auto path = std::filesystem::path(pattern);
+  std::stringstream ss;
+  ss << path.stem().string() << "_" << std::setfill('0') << std::setw(4) << frame << path.extension().string();
+  return path.replace_filename(ss.str()).string();
+}
+
+}
+
+std::vector<CameraKeyframe>loadCameraPath(std::string const&fileName){
+  std::vector<CameraKeyframe>path;
+  std::ifstream file(fileName);
+  if(!file){
+    std::cerr << "headless: cannot read camera path " << fileName << std::endl;
+    return path;
+  }
+
+  std::string line;
+  while(std::getline(file,line)){
+    if(line.empty() || line[0] == '#')continue;
+    std::stringstream ss(line);
+    CameraKeyframe keyframe;
+    if(!(ss >> keyframe.frame >> keyframe.xAngle >> keyframe.yAngle >> keyframe.distance)){
+      std::cerr << "headless: skipping malformed camera keyframe: " << line << std::endl;
+      continue;
+    }
+    path.push_back(keyframe);
+  }
+
+  std::stable_sort(path.begin(),path.end(),[](CameraKeyframe const&a,CameraKeyframe const&b){return a.frame < b.frame;});
+  return path;
+}
+
+CameraKeyframe getCameraKeyframe(std::vector<CameraKeyframe>const&path,float frame){
+  if(path.empty())return CameraKeyframe();
+  if(frame <= path.front().frame)return path.front();
+  if(frame >= path.back ().frame)return path.back ();
+
+  size_t next = 1;
+  while(path[next].frame < frame)next++;
+  auto const&a = path[next-1];
+  auto const&b = path[next  ];
+  float const t = (frame - a.frame) / (b.frame - a.frame);
+
+  CameraKeyframe result;
+  result.frame    = frame;
+  result.xAngle   = a.xAngle   + t*(b.xAngle   - a.xAngle  );
+  result.yAngle   = a.yAngle   + t*(b.yAngle   - a.yAngle  );
+  result.distance = a.distance + t*(b.distance - a.distance);
+  return result;
+}
+
+bool renderHeadless(HeadlessOptions const&options){
+  std::vector<CameraKeyframe>path;
+  if(!options.cameraPath.empty()){
+    path = loadCameraPath(options.cameraPath);
+    if(path.empty())return false;
+  }
+
+  auto const&methods = ProgramContext::get().methods;
+  if(methods.getNofMethods() == 0)return false;
+  auto const methodId = std::min<size_t>(options.method,methods.getNofMethods()-1);
+
+  //flipped framebuffer stores rows from top to bottom, as PNG and raw output expect
+  auto aframe = tests::createFramebuffer(options.width,options.height,true);
+  auto&frame = aframe.frame;
+  GPUMemory mem;
+  mem.framebuffers[mem.defaultFramebuffer] = frame;
+  auto method = methods.createMethod(methodId,mem);
+
+  auto orbitCamera       = basicCamera::OrbitCamera();
+  auto perspectiveCamera = basicCamera::PerspectiveCamera();
+  glm::vec3 light;
+  defaultSceneParameters(orbitCamera,perspectiveCamera,light,options.width,options.height);
+
+  bool const toStdout = options.output == "-";
+  std::cerr << "headless: rendering " << options.nofFrames << " frame(s) of \"" << methods.getMethodName(methodId) << "\" at "
+            << options.width << "x" << options.height << std::endl;
+
+  for(uint32_t iFrame=0;iFrame<options.nofFrames;++iFrame){
+    if(!path.empty()){
+      auto const keyframe = getCameraKeyframe(path,(float)iFrame);
+      orbitCamera.setXAngle  (glm::radians(keyframe.xAngle));
+      orbitCamera.setYAngle  (glm::radians(keyframe.yAngle));
+      orbitCamera.setDistance(keyframe.distance            );
+    }
+
+    SceneParam sceneParam;
+    sceneParam.proj   = perspectiveCamera.getProjection();
+    sceneParam.view   = orbitCamera      .getView      ();
+    sceneParam.camera = glm::vec3(glm::inverse(sceneParam.view)*glm::vec4(0.f,0.f,0.f,1.f));
+    sceneParam.light  = light;
+
+    //fixed time step, so animated methods produce the same frames on every run
+    if(iFrame)method->onUpdate(1.f/60.f);
+    method->onDraw(sceneParam);
+
+    auto const nofBytes = (size_t)frame.width*frame.height*frame.color.channels;
+    if(toStdout){
+      if(std::fwrite(frame.color.data,1,nofBytes,stdout) != nofBytes){
+        std::cerr << "headless: cannot write frame " << iFrame << " to stdout" << std::endl;
+        return false;
+      }
+      continue;
+    }
+
+    auto const fileName = getFrameFileName(options.output,iFrame);
+    if(!stbi_write_png(fileName.c_str(),frame.width,frame.height,frame.color.channels,frame.color.data,0)){
+      std::cerr << "headless: cannot write " << fileName << std::endl;
+      return false;
+    }
+  }
+
+  if(toStdout)std::fflush(stdout);
+  else std::cerr << "headless: frames stored to: \"" << options.output << "\"" << std::endl;
+  return true;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Settings of headless rendering
+ */
+struct HeadlessOptions{
+  uint32_t    width      = 500;///< width of frames
+  uint32_t    height     = 500;///< height of frames
+  uint32_t    method     = 0  ;///< id of the rendering method
+  uint32_t    nofFrames  = 1  ;///< number of rendered frames
+  std::string output          ;///< PNG files with %d (or %0Nd) replaced by the frame number (e.g. "frame%04d.png") or "-" for raw RGB on stdout
+  std::string cameraPath      ;///< file with camera keyframes (empty = default camera)
+};
+
+/**
+ * @brief One keyframe of the camera path (angles are in degrees)
+ */
+struct CameraKeyframe{
+  float frame    = 0.f;///< frame of the keyframe
+  float xAngle   = 0.f;///< pitch of the orbit camera
+  float yAngle   = 0.f;///< yaw of the orbit camera
+  float distance = 0.f;///< distance of the orbit camera from its focus
+};
+
+/**
+ * @brief This function reads camera keyframes
+ * Every line contains "frame xAngle yAngle distance", lines starting with # are comments.
+ *
+ * @param fileName file with the camera path
+ *
+ * @return keyframes sorted by frames
+ */
+std::vector<CameraKeyframe>loadCameraPath(std::string const&fileName);
+
+/**
+ * @brief This function interpolates the camera path
+ *
+ * @param path keyframes sorted by frames
+ * @param frame frame
+ *
+ * @return keyframe linearly interpolated between neighbouring keyframes (clamped to the first and last one)
+ */
+CameraKeyframe getCameraKeyframe(std::vector<CameraKeyframe>const&path,float frame);
+
+/**
+ * @brief This function renders frames of a method without window (SDL is not initialized)
+ * and writes them to PNG files or to stdout as raw 8-bit RGB (rows from top to bottom)
+ *
+ * @param options settings of headless rendering
+ *
+ * @return false if the camera path or a frame could not be read or written
+ */
+bool renderHeadless(HeadlessOptions const&options);
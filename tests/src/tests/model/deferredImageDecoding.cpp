@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "deferredImageDecoding"
+#include <tests/testCommon.hpp>
+
+#include <framework/model.hpp>
+#include <libs/stb_image/stb_image_write.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace tests;
+
+namespace{
+
+std::string base64(unsigned char const*data,size_t size){
+  char const*const alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string res;
+  for(size_t i=0;i<size;i+=3){
+    uint32_t v = (uint32_t)data[i]<<16;
+    if(i+1<size)v |= (uint32_t)data[i+1]<<8;
+    if(i+2<size)v |= (uint32_t)data[i+2];
+    res += alphabet[(v>>18)&63];
+    res += alphabet[(v>>12)&63];
+    res += i+1<size ? alphabet[(v>>6)&63] : '=';
+    res += i+2<size ? alphabet[ v    &63] : '=';
+  }
+  return res;
+}
+
+void appendBytes(void*context,void*data,int size){
+  auto&bytes = *(std::vector<unsigned char>*)context;
+  bytes.insert(bytes.end(),(unsigned char*)data,(unsigned char*)data+size);
+}
+
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("deferred decoding of model images");
+
+  // image 0 is a valid png, image 1 has a valid header but no pixel data
+  uint32_t const width  = 64;
+  uint32_t const height = 48;
+  std::vector<uint8_t>pixels(width*height*4);
+  for(size_t i=0;i<pixels.size();++i)
+    pixels[i] = (uint8_t)(i*7+i/13);
+
+  std::vector<unsigned char>png;
+  stbi_write_png_to_func(appendBytes,&png,width,height,4,pixels.data(),width*4);
+  size_t const headerSize = 8+25;//signature + IHDR chunk
+
+  auto const file = (std::filesystem::temp_directory_path() / "izgDeferredImages.gltf").string();
+  std::ofstream(file) << R"({"asset":{"version":"2.0"},"scene":0,"scenes":[{"nodes":[]}],"images":[)"
+    << R"({"uri":"data:image/png;base64,)" << base64(png.data(),png.size())    << R"("},)"
+    << R"({"uri":"data:image/png;base64,)" << base64(png.data(),headerSize) << R"("}]})";
+
+  std::stringstream errors;
+  auto const oldErrors = std::cerr.rdbuf(errors.rdbuf());
+  Model view;
+  ModelData md;
+  md.load(file);
+  md.createModelView(view);
+  std::cerr.rdbuf(oldErrors);
+
+  // createModelView waits for the decoding, texels are complete right after it
+  bool const loaded = view.nofTextures == 2;
+  bool decoded = loaded;
+  if(decoded){
+    auto const&tex = view.textures[0];
+    decoded &= tex.width == width && tex.height == height && tex.img.channels == 4 && tex.img.bytesPerPixel == 4 && tex.img.pitch == width*4;
+    decoded &= tex.img.data && std::memcmp(tex.img.data,pixels.data(),pixels.size()) == 0;
+  }
+
+  // failed decoding is reported and the texture stays empty
+  bool const reported = errors.str().find("image[1]") != std::string::npos && errors.str().find("cannot be decoded") != std::string::npos;
+  bool const empty    = loaded && view.textures[1].width == 0 && view.textures[1].height == 0 && view.textures[1].img.data == nullptr;
+  free(view);
+  std::filesystem::remove(file);
+
+  if(decoded && reported && empty)return;
+
+  std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test načítá model s obrázky vloženými do souboru (data URI), které se
+  dekódují odloženě a paralelně. Po createModelView musí být texely první
+  textury kompletní a stejné jako zapsaný obrázek. Druhý obrázek má jen
+  hlavičku, jeho chyba dekódování musí být vypsána a textura zůstane prázdná.
+  Dekódováno: )." << decoded << R".(
+  Chyba vypsána: )." << reported << R".(
+  Prázdná textura: )." << empty << std::endl;
+
+  REQUIRE(false);
+}
@@ -0,0 +1,142 @@
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "modelCache"
+#include <tests/testCommon.hpp>
+
+#include <framework/modelCache.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using namespace tests;
+
+namespace{
+
+bool sameNode(Node const&a,Node const&b){
+  if(a.mesh != b.mesh || a.nofChildren != b.nofChildren || !equalMat4(a.modelMatrix,b.modelMatrix))return false;
+  for(size_t i=0;i<a.nofChildren;++i)
+    if(!sameNode(a.children[i],b.children[i]))return false;
+  return true;
+}
+
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("binary model cache");
+
+  auto const dir        = std::filesystem::temp_directory_path();
+  auto const sourceFile = (dir / "izgModelCache.gltf").string();
+  auto const cacheFile  = getModelCacheFile(sourceFile);
+  std::ofstream(sourceFile) << "model";
+
+  std::vector<float  >vertices = {0.f,1.f,2.f,3.f,4.f,5.f,6.f,7.f,8.f};
+  std::vector<uint8_t>pixels   = {1,2,3,4,5,6,7,8,9,10,11,12};
+
+  Model model;
+  model.nofRoots = 2;
+  model.roots    = new Node[2];
+  model.roots[0].mesh        = 1;
+  model.roots[0].nofChildren = 2;
+  model.roots[0].children    = new Node[2];
+  model.roots[0].children[0].modelMatrix = glm::mat4(2.f);
+  model.roots[0].children[1].mesh        = 0;
+  model.roots[0].children[1].nofChildren = 1;
+  model.roots[0].children[1].children    = new Node[1];
+  model.roots[0].children[1].children[0].mesh = 1;
+  model.roots[1].modelMatrix = glm::mat4(3.f);
+  model.nofMeshes = 2;
+  model.meshes    = new Mesh[2];
+  model.meshes[0].nofIndices        = 3;
+  model.meshes[0].position.bufferID = 0;
+  model.meshes[0].position.type     = AttribType::VEC3;
+  model.meshes[1].diffuseTexture    = 0;
+  model.meshes[1].diffuseColor      = glm::vec4(.5f);
+  model.nofBuffers = 1;
+  model.buffers    = new Buffer[1];
+  model.buffers[0].data = vertices.data();
+  model.buffers[0].size = vertices.size()*sizeof(float);
+  model.nofTextures = 1;
+  model.textures    = new Texture[1];
+  model.textures[0].width             = 2;
+  model.textures[0].height            = 2;
+  model.textures[0].img.data          = pixels.data();
+  model.textures[0].img.channels      = 3;
+  model.textures[0].img.bytesPerPixel = 3;
+  model.textures[0].img.pitch         = 6;
+
+  bool const written = writeModelCache(cacheFile,model,{sourceFile});
+
+  Model view;
+  MappedModelCache cache;
+  bool const opened = written && cache.open(cacheFile,sourceFile);
+  cache.createModelView(view);
+
+  bool same = opened && view.nofRoots == 2 && view.nofMeshes == 2 && view.nofBuffers == 1 && view.nofTextures == 1;
+  if(same){
+    for(size_t i=0;i<2;++i)
+      same &= sameNode(model.roots[i],view.roots[i]);
+    same &= view.meshes[0].nofIndices == 3 && view.meshes[0].position == model.meshes[0].position;
+    same &= view.meshes[1].diffuseTexture == 0 && equalVec4(view.meshes[1].diffuseColor,glm::vec4(.5f));
+    same &= view.buffers[0].size == model.buffers[0].size && std::memcmp(view.buffers[0].data,vertices.data(),view.buffers[0].size) == 0;
+    same &= view.textures[0].width == 2 && view.textures[0].img.pitch == 6 && std::memcmp(view.textures[0].img.data,pixels.data(),pixels.size()) == 0;
+    // data are not copied, they are in the mapped file
+    same &= view.buffers[0].data != vertices.data() && (uintptr_t)view.buffers[0].data % 64 == 0 && (uintptr_t)view.textures[0].img.data % 64 == 0;
+  }
+  free(view);
+  cache.close();
+
+  // rewritten source with the same content is still valid (checked by the hash)
+  auto const later = [&](){std::filesystem::last_write_time(sourceFile,std::filesystem::last_write_time(sourceFile)+std::chrono::hours(1));};
+  std::ofstream(sourceFile) << "model";
+  later();
+  bool const touched = cache.open(cacheFile,sourceFile);
+  cache.close();
+
+  // corrupted count of nodes (nofNodes*sizeof(node) overflows to 0) is rejected
+  auto const corruptedFile = cacheFile + ".corrupted";
+  std::filesystem::copy_file(cacheFile,corruptedFile,std::filesystem::copy_options::overwrite_existing);
+  {
+    std::fstream corrupted(corruptedFile,std::ios::in|std::ios::out|std::ios::binary);
+    uint64_t const nofNodes = 1ull<<61;
+    corrupted.seekp(56);//CacheHeader::nofNodes
+    corrupted.write((char const*)&nofNodes,sizeof(nofNodes));
+  }
+  bool const corrupted = !cache.open(corruptedFile,sourceFile);
+  cache.close();
+  std::filesystem::remove(corruptedFile);
+
+  // change of the source invalidates the cache (of the same size, too)
+  std::ofstream(sourceFile) << "MODEL";
+  later();
+  bool stale = !cache.open(cacheFile,sourceFile);
+  cache.close();
+  std::ofstream(sourceFile) << "changed model";
+  stale &= !cache.open(cacheFile,sourceFile);
+  cache.close();
+
+  free(model);
+  std::filesystem::remove(sourceFile);
+  std::filesystem::remove(cacheFile);
+
+  if(written && opened && same && touched && corrupted && stale)return;
+
+  std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test ukládá model (strom uzlů, meshe, buffery a textury) do binární
+  cache a znovu ho z ní načítá přes namapovaný soubor. Načtený model musí být
+  stejný, data bufferů a textur musí ležet přímo v souboru (zarovnaná) a po
+  změně zdrojového souboru musí být cache neplatná. Přepsaný soubor se stejným
+  obsahem ji nezneplatní a poškozená hlavička musí být odmítnuta.
+  Zapsáno: )." << written << R".(
+  Otevřeno: )." << opened << R".(
+  Stejný model: )." << same << R".(
+  Platná po přepsání stejným obsahem: )." << touched << R".(
+  Poškozená odmítnuta: )." << corrupted << R".(
+  Neplatná po změně: )." << stale << std::endl;
+
+  REQUIRE(false);
+}
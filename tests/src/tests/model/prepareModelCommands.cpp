@@ -0,0 +1,126 @@
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "prepareModelCommands"
+#include <tests/testCommon.hpp>
+#include <tests/model/createModel.hpp>
+
+#include <solutionInterface/uniformLocations.hpp>
+#include <studentSolution/gpu.hpp>
+#include <studentSolution/prepareModel.hpp>
+
+using namespace tests;
+using namespace tests::model;
+
+namespace{
+
+std::vector<float> trace;
+
+void traceVertex(OutVertex&out,InVertex const&in,ShaderInterface const&si){
+  trace.push_back((float)si.gl_DrawID);
+  trace.push_back(si.uniforms[getUniformLocation(si.gl_DrawID,DIFFUSE_COLOR)].v4.x);
+  out.gl_Position = glm::vec4(in.gl_VertexID==1 ? .5f : 0.f,in.gl_VertexID==2 ? .5f : 0.f,.5f,1.f);
+}
+
+void traceFragment(OutFragment&out,InFragment const&,ShaderInterface const&){
+  out.gl_FragColor = glm::vec4(1.f);
+}
+
+template<typename Commands>
+std::vector<float> runModel(Commands&commands,TestModel const&model){
+  auto frame = createFramebuffer(16,16);
+  GPUMemory mem;
+  student_prepareModel(mem,commands,model);
+  mem.framebuffers[0] = frame.frame;
+  mem.programs[0].vertexShader   = traceVertex  ;
+  mem.programs[0].fragmentShader = traceFragment;
+  trace.clear();
+  student_GPU_run(mem,commands);
+  return trace;
+}
+
+/**
+ * @brief Runs prepareModel and returns what it reported to std::cerr.
+ */
+template<typename Commands>
+std::string prepareModelReport(GPUMemory&mem,Commands&commands,TestModel const&model){
+  std::stringstream report;
+  auto const oldBuffer = std::cerr.rdbuf(report.rdbuf());
+  student_prepareModel(mem,commands,model);
+  std::cerr.rdbuf(oldBuffer);
+  return report.str();
+}
+
+TestModel createRoots(size_t nofRoots){
+  std::vector<NodeI>roots(nofRoots,NodeI(0));
+  return createModel({3},roots);
+}
+
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("prepareModel - command stream");
+
+  auto n0 = NodeI(0);
+  auto n1 = NodeI(1);
+  auto n2 = NodeI(2,{n0,n1});
+  auto n3 = NodeI(3,{n2,NodeI(-1,{n1,n2})});
+  auto model = createModel({
+      MeshI(3,glm::vec4(.1f)),
+      MeshI(6,glm::vec4(.2f),-1,true),
+      MeshI(9,glm::vec4(.3f)),
+      MeshI(3,glm::vec4(.4f),-1,true)},{n3,n2,n1});
+
+  auto cb = std::make_unique<CommandBuffer>();
+  auto const expected = runModel(*cb,model);
+
+  CommandStream cs;
+  auto const result = runModel(cs,model);
+
+  if(!expected.empty() && result == expected)return;
+
+  std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test porovnává model připravený funkcí prepareModel do CommandStream
+  s modelem připravenym do CommandBuffer.
+  Vykreslení obou musí zavolat vertex shader se stejnými gl_DrawID
+  a stejnými uniformními proměnnými.
+  Počet volání vertex shaderu (CommandBuffer): )." << expected.size()/2 << R".(
+  Počet volání vertex shaderu (CommandStream): )." << result.size()/2 << std::endl;
+
+  REQUIRE(false);
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("prepareModel - overflow is reported");
+
+  // only 4 commands are left - the second draw does not fit
+  GPUMemory bufferMem;
+  auto cb = std::make_unique<CommandBuffer>();
+  cb->nofCommands = CommandBuffer::maxCommands-4;
+  auto const bufferReport = prepareModelReport(bufferMem,*cb,createRoots(3));
+  bool const bufferReported = bufferReport.find("does not fit") != std::string::npos && cb->nofCommands <= CommandBuffer::maxCommands;
+
+  // the stream grows, but the uniforms of the draws do not fit into the memory
+  GPUMemory streamMem;
+  CommandStream cs;
+  auto const streamReport = prepareModelReport(streamMem,cs,createRoots(streamMem.maxUniforms));
+  bool const streamReported = streamReport.find("does not fit") != std::string::npos && cs.getNofCommands() < 3*streamMem.maxUniforms;
+
+  if(bufferReported && streamReported)return;
+
+  std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test ověřuje, že prepareModel nahlásí model, který se nevejde
+  do CommandBuffer nebo do uniformních proměnných GPUMemory,
+  místo aby příkazy potichu zahodil nebo zapsal mimo paměť.
+  Nahlášeno pro CommandBuffer: )." << bufferReported << R".(
+  Nahlášeno pro CommandStream: )." << streamReported << std::endl;
+
+  REQUIRE(false);
+}
@@ -0,0 +1,102 @@
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "texelFormats"
+#include <tests/testCommon.hpp>
+
+#include <framework/textureData.hpp>
+#include <studentSolution/shaderFunctions.hpp>
+
+#include <iostream>
+
+using namespace tests;
+
+namespace{
+
+bool equal(glm::vec4 const&a,glm::vec4 const&b){
+  return glm::all(glm::equal(a,b));
+}
+
+TextureData createTexture(uint32_t channels,Image::Format format,bool bgr){
+  auto tex = TextureData(6,5,channels,format);
+  if(bgr && channels >= 3)std::swap(tex.texture.img.channelTypes[0],tex.texture.img.channelTypes[2]);
+  for(uint32_t y=0;y<5;++y)
+    for(uint32_t x=0;x<6;++x)
+      for(uint32_t c=0;c<channels;++c){
+        auto const value = (x*37 + y*101 + c*53)%256;
+        if(format == Image::F32)((float  *)getPixel(tex.texture.img,x,y))[c] = (float)value/7.f;
+        else                    ((uint8_t*)getPixel(tex.texture.img,x,y))[c] = (uint8_t)value;
+      }
+  return tex;
+}
+
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("pre-converted texel formats");
+
+  bool formatOk    = true;
+  bool fetchOk     = true;
+  bool readOk      = true;
+  bool mipmapOk    = true;
+
+  struct Case{
+    uint32_t      channels;
+    Image::Format format  ;
+    bool          bgr     ;
+    TexelFormat   expected;
+  };
+  Case const cases[] = {
+    {1,Image::U8 ,false,TexelFormat::RGBA8   },
+    {2,Image::U8 ,false,TexelFormat::RGBA8   },
+    {3,Image::U8 ,false,TexelFormat::RGBA8   },
+    {3,Image::U8 ,true ,TexelFormat::RGBA8   },
+    {4,Image::U8 ,false,TexelFormat::RGBA8   },
+    {4,Image::U8 ,true ,TexelFormat::RGBA8   },
+    {1,Image::F32,false,TexelFormat::DEPTH32F},
+    {2,Image::F32,false,TexelFormat::RGBA32F },
+    {3,Image::F32,true ,TexelFormat::RGBA32F },
+    {4,Image::F32,false,TexelFormat::RGBA32F },
+  };
+
+  for(auto const&c:cases)
+    for(auto const&layout:{ImageLayout::LINEAR,ImageLayout::TILED}){
+      // the generic reads of the unconverted texture are the reference
+      auto generic   = createTexture(c.channels,c.format,c.bgr);
+      auto converted = createTexture(c.channels,c.format,c.bgr);
+      converted.convertFormat();
+      converted.generateMipmaps();
+      converted.convertLayout(layout);
+
+      auto const gen = generic  .getTexture();
+      auto const con = converted.getTexture();
+      formatOk &= student_getTexelFormat(gen) == TexelFormat::GENERIC && student_getTexelFormat(con) == c.expected;
+      formatOk &= getTexelFormat(con.img) == c.expected;
+
+      for(uint32_t y=0;y<6;++y)
+        for(uint32_t x=0;x<7;++x)
+          fetchOk &= equal(student_texelFetch(con,glm::uvec2(x,y)),student_texelFetch(gen,glm::uvec2(x,y)));
+
+      for(auto const&uv:{glm::vec2(.1f,.2f),glm::vec2(.93f,.71f),glm::vec2(1.3f,-.4f)}){
+        readOk &= equal(student_read_texture     (con,uv),student_read_texture     (gen,uv));
+        readOk &= equal(student_read_textureClamp(con,uv),student_read_textureClamp(gen,uv));
+        mipmapOk &= equal(student_read_textureLod(con,uv,0.f,{TextureFilter::BILINEAR,TextureWrap::REPEAT}),student_read_textureLod(gen,uv,0.f,{TextureFilter::BILINEAR,TextureWrap::REPEAT}));
+      }
+      mipmapOk &= student_getNofTextureLevels(con) == 3;
+    }
+
+  if(formatOk && fetchOk && readOk && mipmapOk)return;
+
+  std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test kontroluje předpřevedené formáty texelů (RGBA8, RGBA32F, DEPTH32F).
+  Textura převedená při načtení musí mít vlastní funkci pro čtení texelu
+  a musí vracet stejné barvy jako obecné čtení přes channelTypes
+  (chybějící kanály jsou 0, alfa 1).
+  Formát: )." << formatOk << R".(
+  student_texelFetch: )." << fetchOk << R".(
+  student_read_texture(Clamp): )." << readOk << R".(
+  Filtrované čtení a mipmapy: )." << mipmapOk << std::endl;
+
+  REQUIRE(false);
+}
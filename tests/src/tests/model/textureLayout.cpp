@@ -0,0 +1,99 @@
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "textureLayout"
+#include <tests/testCommon.hpp>
+
+#include <framework/textureData.hpp>
+#include <studentSolution/shaderFunctions.hpp>
+
+#include <cstring>
+#include <iostream>
+
+using namespace tests;
+
+namespace{
+
+bool equal(glm::vec4 const&a,glm::vec4 const&b){
+  return glm::all(glm::lessThanEqual(glm::abs(a-b),glm::vec4(1e-6f)));
+}
+
+TextureData createTexture(uint32_t w,uint32_t h,uint32_t channels,Image::Format format){
+  auto tex = TextureData(w,h,channels,format);
+  for(uint32_t y=0;y<h;++y)
+    for(uint32_t x=0;x<w;++x)
+      for(uint32_t c=0;c<channels;++c){
+        auto const value = (x*37 + y*101 + c*53)%256;
+        if(format == Image::F32)((float  *)getPixel(tex.texture.img,x,y))[c] = (float)value/255.f;
+        else                    ((uint8_t*)getPixel(tex.texture.img,x,y))[c] = (uint8_t)value;
+      }
+  tex.generateMipmaps();
+  return tex;
+}
+
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("tiled texture layout");
+
+  bool layoutOk    = true;
+  bool fetchOk     = true;
+  bool readOk      = true;
+  bool mipmapOk    = true;
+  bool roundTripOk = true;
+
+  // odd sizes - partial tiles on the right and bottom border
+  for(auto const&size:{glm::uvec2(7,5),glm::uvec2(4,4),glm::uvec2(1,9),glm::uvec2(13,2)})
+    for(auto const&format:{Image::U8,Image::F32}){
+      auto linear = createTexture(size.x,size.y,4,format);
+      auto tiled  = createTexture(size.x,size.y,4,format);
+      tiled.convertLayout(ImageLayout::TILED);
+
+      auto const lin = linear.getTexture();
+      auto const til = tiled .getTexture();
+      layoutOk &= student_getTextureLayout(lin) == ImageLayout::LINEAR && student_getTextureLayout(til) == ImageLayout::TILED;
+      layoutOk &= student_getNofTextureLevels(til) == student_getNofTextureLevels(lin);
+      layoutOk &= til.img.pitch == getTiledPitch(size.x,lin.img.bytesPerPixel);
+
+      for(uint32_t y=0;y<size.y;++y)
+        for(uint32_t x=0;x<size.x;++x)
+          fetchOk &= equal(student_texelFetch(til,glm::uvec2(x,y)),student_texelFetch(lin,glm::uvec2(x,y)));
+
+      for(auto const&uv:{glm::vec2(.1f,.2f),glm::vec2(.93f,.71f),glm::vec2(1.3f,-.4f),glm::vec2(-2.6f,3.05f)}){
+        readOk &= equal(student_read_texture     (til,uv),student_read_texture     (lin,uv));
+        readOk &= equal(student_read_textureClamp(til,uv),student_read_textureClamp(lin,uv));
+        for(auto const&filter:{TextureFilter::NEAREST,TextureFilter::BILINEAR,TextureFilter::TRILINEAR})
+          for(auto const&wrap:{TextureWrap::REPEAT,TextureWrap::CLAMP}){
+            for(auto const&lod:{0.f,.6f,1.f,2.4f,10.f})
+              mipmapOk &= equal(student_read_textureLod(til,uv,lod,{filter,wrap}),student_read_textureLod(lin,uv,lod,{filter,wrap}));
+            mipmapOk &= equal(student_read_textureGrad(til,uv,glm::vec2(.3f,0.f),glm::vec2(0.f,.1f),{filter,wrap}),student_read_textureGrad(lin,uv,glm::vec2(.3f,0.f),glm::vec2(0.f,.1f),{filter,wrap}));
+          }
+      }
+
+      // converting back restores the linear texels of every level
+      tiled.convertLayout(ImageLayout::LINEAR);
+      roundTripOk &= student_getTextureLayout(tiled.getTexture()) == ImageLayout::LINEAR && tiled.mipLevels.size() == linear.mipLevels.size();
+      for(size_t i=0;roundTripOk && i<linear.mipLevels.size();++i){
+        auto const&a = linear.mipLevels[i];
+        auto const&b = tiled .mipLevels[i];
+        roundTripOk &= a.img.pitch == b.img.pitch && std::memcmp(a.img.data,b.img.data,(size_t)a.img.pitch*a.height) == 0;
+      }
+    }
+
+  if(layoutOk && fetchOk && readOk && mipmapOk && roundTripOk)return;
+
+  std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test kontroluje dlaždicové uložení textur (dlaždice 4x4 texelů).
+  Textura převedená do dlaždicového uložení musí vracet stejné texely
+  (student_texelFetch), stejné barvy při čtení (student_read_texture(Clamp))
+  i při čtení mipmap jako textura uložená po řádcích.
+  Převod zpět musí obnovit původní data.
+  Rozložení: )." << layoutOk << R".(
+  student_texelFetch: )." << fetchOk << R".(
+  student_read_texture(Clamp): )." << readOk << R".(
+  Mipmapy: )." << mipmapOk << R".(
+  Převod zpět: )." << roundTripOk << std::endl;
+
+  REQUIRE(false);
+}
@@ -0,0 +1,204 @@
+#include <catch2/catch_test_macros.hpp>
+
+#define __FILENAME__ "textureMipmaps"
+#include <tests/testCommon.hpp>
+
+#include <framework/textureData.hpp>
+#include <studentSolution/gpu.hpp>
+#include <studentSolution/gpuSettings.hpp>
+#include <studentSolution/prepareModel.hpp>
+#include <studentSolution/shaderFunctions.hpp>
+
+#include <iostream>
+#include <vector>
+
+using namespace tests;
+
+namespace{
+
+bool equal(glm::vec4 const&a,glm::vec4 const&b,float eps = 1e-5f){
+  return glm::all(glm::lessThanEqual(glm::abs(a-b),glm::vec4(eps)));
+}
+
+glm::vec4 average(Texture const&level,uint32_t x0,uint32_t y0,uint32_t x1,uint32_t y1){
+  glm::uvec4 sum = glm::uvec4(2);
+  for(auto const&p:{glm::uvec2(x0,y0),glm::uvec2(x1,y0),glm::uvec2(x0,y1),glm::uvec2(x1,y1)})
+    sum += glm::uvec4(student_texelFetch(level,p)*255.f+.5f);
+  return glm::vec4(sum/4u)/255.f;
+}
+
+constexpr uint32_t frameSize = 40;
+
+struct DerivativeSample{
+  bool      written = false;
+  bool      valid   = false;
+  glm::vec2 value         ;
+  glm::vec2 dx            ;
+  glm::vec2 dy            ;
+};
+DerivativeSample derivativeSamples[frameSize][frameSize];
+
+void vertexShader(OutVertex&out,InVertex const&in,ShaderInterface const&){
+  // different w of the vertices - perspective-correct interpolation
+  glm::vec4 const positions[3] = {glm::vec4(-.9f,-.9f,.5f,1.f),glm::vec4(2.7f,-2.7f,1.f,3.f),glm::vec4(-1.8f,1.8f,.5f,2.f)};
+  glm::vec2 const uvs      [3] = {glm::vec2(0.f,0.f),glm::vec2(3.f,.5f),glm::vec2(-1.f,2.f)};
+  out.gl_Position        = positions[in.gl_VertexID];
+  out.attributes[0].v2   = uvs      [in.gl_VertexID];
+  out.attributes[1].u1   = 7u;
+}
+
+void fragmentShader(OutFragment&,InFragment const&in,ShaderInterface const&){
+  auto&sample = derivativeSamples[(uint32_t)in.gl_FragCoord.y][(uint32_t)in.gl_FragCoord.x];
+  glm::vec4 dx,dy,integerDx,integerDy;
+  sample.written = true;
+  sample.valid   = student_getAttributeDerivatives(0,dx,dy) && !student_getAttributeDerivatives(1,integerDx,integerDy);
+  sample.value   = in.attributes[0].v2;
+  sample.dx      = glm::vec2(dx);
+  sample.dy      = glm::vec2(dy);
+}
+
+}
+
+SCENARIO(TEST_NAME){
+  printTestName("mipmapped textures and attribute derivatives");
+
+  // 5x3 -> 2x1 -> 1x1
+  auto tex = TextureData(5,3,4);
+  for(uint32_t y=0;y<3;++y)
+    for(uint32_t x=0;x<5;++x)
+      for(uint32_t c=0;c<4;++c)
+        ((uint8_t*)getPixel(tex.texture.img,x,y))[c] = (uint8_t)(x*50 + y*13 + c*7);
+  tex.generateMipmaps();
+
+  bool chainOk = tex.mipLevels.size() == 3 && student_getNofTextureLevels(tex.getTexture()) == 3;
+  if(chainOk){
+    auto const&l1 = tex.mipLevels[1];
+    auto const&l2 = tex.mipLevels[2];
+    chainOk &= l1.width == 2 && l1.height == 1 && l2.width == 1 && l2.height == 1;
+    chainOk &= equal(student_texelFetch(l1,glm::uvec2(0,0)),average(tex.texture,0,0,1,1));
+    chainOk &= equal(student_texelFetch(l1,glm::uvec2(1,0)),average(tex.texture,2,0,3,1));
+    chainOk &= equal(student_texelFetch(l2,glm::uvec2(0,0)),average(l1,0,0,1,0));
+  }
+
+  // nearest reads of level 0 are the same as student_read_texture(Clamp)
+  bool nearestOk = true;
+  for(auto const&uv:{glm::vec2(.1f,.2f),glm::vec2(.7f,.9f),glm::vec2(1.3f,-.4f)}){
+    nearestOk &= equal(student_read_textureLod(tex.texture,uv,0.f,{TextureFilter::NEAREST,TextureWrap::REPEAT}),student_read_texture     (tex.texture,uv));
+    nearestOk &= equal(student_read_textureLod(tex.texture,uv,0.f,{TextureFilter::NEAREST,TextureWrap::CLAMP }),student_read_textureClamp(tex.texture,uv));
+  }
+  if(chainOk)
+    nearestOk &= equal(student_read_textureLod(tex.texture,glm::vec2(.3f),5.f,{TextureFilter::NEAREST,TextureWrap::CLAMP}),student_texelFetch(tex.mipLevels[2],glm::uvec2(0)));
+
+  // bilinear reads hit texel centers exactly and average between them
+  glm::vec4 const texel00 = student_texelFetch(tex.texture,glm::uvec2(0,0));
+  glm::vec4 const texel10 = student_texelFetch(tex.texture,glm::uvec2(1,0));
+  TextureSampler const bilinear = {TextureFilter::BILINEAR,TextureWrap::CLAMP};
+  bool const bilinearOk = equal(student_read_textureLod(tex.texture,glm::vec2(.5f/5.f,.5f/3.f),0.f,bilinear),texel00) &&
+                          equal(student_read_textureLod(tex.texture,glm::vec2(1.f/5.f,.5f/3.f),0.f,bilinear),(texel00+texel10)/2.f);
+
+  // trilinear reads blend two levels, derivatives select the level
+  TextureSampler const trilinear = {TextureFilter::TRILINEAR,TextureWrap::CLAMP};
+  glm::vec2 const uv = glm::vec2(.35f,.6f);
+  bool const trilinearOk =
+    equal(student_read_textureLod(tex.texture,uv,.25f,trilinear),glm::mix(student_read_textureLod(tex.texture,uv,0.f,bilinear),student_read_textureLod(tex.texture,uv,1.f,bilinear),.25f)) &&
+    equal(student_read_textureGrad(tex.texture,uv,glm::vec2(2.f/5.f,0.f),glm::vec2(0.f,.5f/3.f),trilinear),student_read_textureLod(tex.texture,uv,1.f,trilinear));
+
+  // filtering attached by student_prepareModel travels with the texture and survives a new chain
+  bool filterOk = student_getTextureFilter(tex.getTexture()) == TextureFilter::NEAREST;
+  {
+    Texture texture = tex.getTexture();
+    Model model;
+    model.textures    = &texture;
+    model.nofTextures = 1;
+    GPUMemory mem;
+    CommandBuffer cb;
+    auto const oldSettings = getGPUSettings();
+    getGPUSettings().textureFilter = TextureFilter::BILINEAR;
+    student_prepareModel(mem,cb,model);
+    getGPUSettings() = oldSettings;
+    filterOk &= student_getTextureFilter(mem.textures[0]) == TextureFilter::BILINEAR;
+    student_setTextureMipmaps(tex.mipLevels[0],tex.mipLevels.data(),(uint32_t)tex.mipLevels.size());
+    filterOk &= student_getTextureFilter(texture) == TextureFilter::BILINEAR;
+  }
+
+  // the chain follows moves of the texture data and is removed with it
+  bool lifetimeOk;
+  {
+    auto const texture = tex.getTexture();
+    auto moved = std::move(tex);
+    lifetimeOk = student_getNofTextureLevels(texture) == 3;
+    moved = TextureData(2,2,4);
+    lifetimeOk &= student_getNofTextureLevels(texture) == 1 && student_getNofTextureLevels(moved.getTexture()) == 1;
+    lifetimeOk &= student_getTextureFilter(texture) == TextureFilter::NEAREST;
+  }
+
+  // derivatives computed by the rasterizer match differences of neighbouring fragments
+  glm::vec4 dx,dy;
+  bool derivativesOk = !student_getAttributeDerivatives(0,dx,dy);
+  GPUSettings fixedPoint;
+  fixedPoint.fixedPointRasterization = true;
+  for(auto const&settings:{GPUSettings(),fixedPoint}){
+    for(auto&row:derivativeSamples)
+      for(auto&sample:row)sample = DerivativeSample();
+
+    auto frame = createFramebuffer(frameSize,frameSize);
+    GPUMemory mem;
+    mem.framebuffers[0] = frame.frame;
+    mem.programs[0].vertexShader   = vertexShader  ;
+    mem.programs[0].fragmentShader = fragmentShader;
+    mem.programs[0].vs2fs[0]       = AttribType::VEC2;
+    mem.programs[0].vs2fs[1]       = AttribType::UINT;
+
+    CommandBuffer cb;
+    REQUIRE(pushClearDepthCommand (cb,10e10f));
+    REQUIRE(pushBindProgramCommand(cb,0));
+    REQUIRE(pushDrawCommand       (cb,3));
+
+    auto const oldSettings = getGPUSettings();
+    getGPUSettings() = settings;
+    student_GPU_run(mem,cb);
+    getGPUSettings() = oldSettings;
+
+    uint32_t nofChecked = 0;
+    for(uint32_t y=0;y+1<frameSize;++y)
+      for(uint32_t x=0;x+1<frameSize;++x){
+        auto const&s  = derivativeSamples[y  ][x  ];
+        auto const&sx = derivativeSamples[y  ][x+1];
+        auto const&sy = derivativeSamples[y+1][x  ];
+        if(!s.written)continue;
+        derivativesOk &= s.valid;
+        if(sx.written){
+          derivativesOk &= glm::all(glm::lessThan(glm::abs((sx.value-s.value)-(s.dx+sx.dx)*.5f),glm::vec2(1e-3f)));
+          nofChecked++;
+        }
+        if(sy.written){
+          derivativesOk &= glm::all(glm::lessThan(glm::abs((sy.value-s.value)-(s.dy+sy.dy)*.5f),glm::vec2(1e-3f)));
+          nofChecked++;
+        }
+      }
+    derivativesOk &= nofChecked > 100;
+  }
+
+  if(chainOk && nearestOk && bilinearOk && trilinearOk && filterOk && lifetimeOk && derivativesOk)return;
+
+  std::cerr << R".(
+  TEST SELHAL!
+
+  Tento test kontroluje mipmapy textur a derivace atributů.
+  Mipmapa vzniká průměrováním 2x2 texelů předchozí úrovně až do velikosti 1x1.
+  Čtení bez filtrace na úrovni 0 se musí shodovat se student_read_texture(Clamp),
+  bilineární čtení ve středu texelu vrací texel, trilineární mísí dvě úrovně
+  a úroveň je vybrána podle derivací texturovacích souřadnic. Filtraci
+  textur modelu připojí k texturám student_prepareModel.
+  Derivace atributu spočítané rasterizérem se musí shodovat s rozdíly
+  sousedních fragmentů.
+  Mip řetězec: )." << chainOk << R".(
+  Nejbližší texel: )." << nearestOk << R".(
+  Bilineární filtrace: )." << bilinearOk << R".(
+  Trilineární filtrace: )." << trilinearOk << R".(
+  Filtrace připojená k textuře: )." << filterOk << R".(
+  Životnost řetězce: )." << lifetimeOk << R".(
+  Derivace atributů: )." << derivativesOk << std::endl;
+
+  REQUIRE(false);
+}
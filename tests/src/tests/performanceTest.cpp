@@ -9,6 +9,7 @@
 #include <BasicCamera/PerspectiveCamera.h>
 #include <examples/shadowModel.hpp>
 #include <framework/timer.hpp>
+#include <studentSolution/gpuStatistics.hpp>
 #include <tests/performanceTest.hpp>
 #include <tests/testCommon.hpp>
 
@@ -46,6 +47,10 @@ void runPerformanceTest(size_t framesPerMeasurement) {
   sceneParam.camera = camera;
   sceneParam.light  = light ;
 
+  resetRasterStatistics();
+  resetVertexStatistics();
+  resetCommandStatistics();
+  resetPipelineStatistics();
   for (size_t i   = 0; i < framesPerMeasurement; ++i){
     method->onDraw(sceneParam);
   }
@@ -54,4 +59,10 @@ void runPerformanceTest(size_t framesPerMeasurement) {
   std::cout << "Seconds per frame: " << std::scientific << std::setprecision(10)
             << time << std::endl;
 
+  std::cout << std::fixed << std::setprecision(2);
+  printRasterStatistics(std::cout);
+  printVertexStatistics(std::cout);
+  printCommandStatistics(std::cout);
+  printPipelineStatistics(std::cout);
+
 }
@@ -0,0 +1,18 @@
+#include <catch2/catch_session.hpp>
+
+#include <tests/stageBenchmarks.hpp>
+
+#include <vector>
+
+int runStageBenchmarks(std::string const&testSpec,uint32_t samples){
+  std::vector<std::string>argvs = {
+    "stageBenchmarks",
+    testSpec.empty() ? "[benchmark]" : testSpec,
+    "--benchmark-samples",
+    std::to_string(samples),
+  };
+
+  std::vector<char const*>argv;
+  for(auto const&s:argvs)argv.push_back(s.c_str());
+  return Catch::Session().run((int)argv.size(), argv.data());
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief This function runs Catch2 microbenchmarks of single pipeline stages
+ * (hidden test cases tagged [benchmark], they are not part of conformance tests)
+ *
+ * @param testSpec Catch2 test spec selecting benchmarks (e.g. "[raster]")
+ * @param samples number of samples of each benchmark
+ *
+ * @return result of the Catch2 session (0 = success)
+ */
+int runStageBenchmarks(std::string const&testSpec = "[benchmark]",uint32_t samples = 100);